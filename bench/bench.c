@@ -0,0 +1,162 @@
+/*************************************************************************
+    > File Name: bench.c
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Runner of the micro-benchmarks, the results are written in
+    JSON so that they can be compared between commits with
+    tools/bench_compare.py
+ ************************************************************************/
+
+/* Includes *********************************************************** */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "projconfig.h"
+#include "bench.h"
+#include "cfgdb.h"
+#include "mng.h"
+#include "utils.h"
+
+/* Defines  *********************************************************** */
+#ifndef BENCH_GIT_REV
+#define BENCH_GIT_REV "unknown"
+#endif
+
+#define MAX_RESULTS 128
+
+typedef struct {
+  const char *name;
+  int size;
+  uint64_t iters;
+  uint64_t ns;
+}result_t;
+
+typedef struct {
+  const char *name;
+  void (*run)(void);
+}group_t;
+
+/* Global Variables *************************************************** */
+volatile uintptr_t bench_sink;
+const char *bench_cfg_dir = NULL;
+
+/* Static Variables *************************************************** */
+static result_t results[MAX_RESULTS];
+static int nresults = 0;
+
+static const group_t groups[] = {
+  { "cfgdb", bench_cfgdb },
+  { "cfgfile", bench_cfgfile },
+  { "utils", bench_utils },
+  { "evt", bench_evt },
+};
+
+/* Static Functions Declaractions ************************************* */
+uint64_t bench_now_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+void bench_report(const char *name, int size, uint64_t iters, uint64_t ns)
+{
+  if (nresults == MAX_RESULTS) {
+    return;
+  }
+  results[nresults].name = name;
+  results[nresults].size = size;
+  results[nresults].iters = iters;
+  results[nresults].ns = ns;
+  nresults++;
+  fprintf(stderr, "%-28s %8d %10.1f ns/op\n", name, size,
+          iters ? (double)ns / iters : 0);
+}
+
+void bench_uuid(uint8_t uuid[16], uint32_t idx)
+{
+  memcpy(uuid, "nwmng-simdev", 12);
+  uuid[12] = idx >> 24;
+  uuid[13] = idx >> 16;
+  uuid[14] = idx >> 8;
+  uuid[15] = idx;
+}
+
+static void write_json(FILE *fp)
+{
+  fprintf(fp, "{\n  \"version\": \"%d.%d.%d\",\n  \"git\": \"%s\",\n"
+              "  \"results\": [",
+          PROJ_VERSION_MAJOR, PROJ_VERSION_MINOR, PROJ_VERSION_PATCH,
+          BENCH_GIT_REV);
+  for (int i = 0; i < nresults; i++) {
+    fprintf(fp, "%s\n    { \"name\": \"%s\", \"size\": %d, \"iters\": %llu, "
+                "\"total_ns\": %llu, \"ns_per_op\": %.1f }",
+            i ? "," : "",
+            results[i].name,
+            results[i].size,
+            (unsigned long long)results[i].iters,
+            (unsigned long long)results[i].ns,
+            results[i].iters ? (double)results[i].ns / results[i].iters : 0);
+  }
+  fprintf(fp, "\n  ]\n}\n");
+}
+
+static void usage(const char *name)
+{
+  fprintf(stderr, "Usage: %s [-o result.json] [-f group] [-c dir]\n"
+                  "       -o  write the results to the file instead of stdout\n"
+                  "       -c  also load and update the network generated to the"
+                  " directory by tools/mesh_config_gen.py\n"
+                  "       -f  run the groups with the substring in the name only,"
+                  " the groups are cfgdb, cfgfile, utils and evt\n",
+          name);
+  exit(EXIT_FAILURE);
+}
+
+int main(int argc, char *argv[])
+{
+  int c;
+  FILE *fp = stdout;
+  const char *out = NULL, *filter = NULL;
+
+  while (-1 != (c = getopt(argc, argv, "o:f:c:h"))) {
+    switch (c) {
+      case 'o':
+        out = optarg;
+        break;
+      case 'f':
+        filter = optarg;
+        break;
+      case 'c':
+        bench_cfg_dir = optarg;
+        break;
+      default:
+        usage(argv[0]);
+        break;
+    }
+  }
+
+  /* Logging stays uninitialized, nothing is logged */
+  cfgdb_init();
+  mng_init(NULL);
+
+  for (int i = 0; i < ARR_LEN(groups); i++) {
+    if (filter && !strstr(groups[i].name, filter)) {
+      continue;
+    }
+    groups[i].run();
+  }
+
+  if (out && NULL == (fp = fopen(out, "w"))) {
+    perror(out);
+    return EXIT_FAILURE;
+  }
+  write_json(fp);
+  if (fp != stdout) {
+    fclose(fp);
+  }
+  return 0;
+}
@@ -0,0 +1,62 @@
+/*************************************************************************
+    > File Name: bench.h
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Micro-benchmarks of the hot paths
+ ************************************************************************/
+
+#ifndef BENCH_H
+#define BENCH_H
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+#include <stdint.h>
+
+/* Node numbers the database benchmarks run at */
+#define BENCH_SIZES { 100, 1000, 10000, 100000 }
+/* Unicast addresses end at 0x7fff, so does the nodes tree */
+#define BENCH_MAX_NODES 0x7fff
+/* Largest network the file benchmarks run at, each run rewrites the file */
+#define BENCH_MAX_FILE_NODES 10000
+
+/* Synthetic files are written here */
+#define BENCH_TMP_DIR "/tmp/"
+
+/* Keeps the compiler from optimizing the measured calls away */
+extern volatile uintptr_t bench_sink;
+/* Directory of a network generated by tools/mesh_config_gen.py, NULL if none */
+extern const char *bench_cfg_dir;
+
+uint64_t bench_now_ns(void);
+
+/**
+ * @brief bench_report - add a result to the report
+ *
+ * @param name - name of the benchmark
+ * @param size - number of the nodes or the events the benchmark runs at, 0 if
+ * not applicable
+ * @param iters - operations measured
+ * @param ns - nanoseconds the operations took in total
+ */
+void bench_report(const char *name, int size, uint64_t iters, uint64_t ns);
+
+/**
+ * @brief bench_uuid - synthetic device UUID, "nwmng-simdev" followed by the
+ * index in big endian, same as the virtual devices of hal/ncp_sim
+ */
+void bench_uuid(uint8_t uuid[16], uint32_t idx);
+
+/*
+ * Benchmark groups, run in the order below, each is selected by its name with
+ * the -f option
+ */
+void bench_cfgdb(void);
+void bench_cfgfile(void);
+void bench_utils(void);
+void bench_evt(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif //BENCH_H
@@ -0,0 +1,307 @@
+/*************************************************************************
+    > File Name: bench_cfg.c
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Benchmarks of the config database and the config files
+ ************************************************************************/
+
+/* Includes *********************************************************** */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "projconfig.h"
+#include "bench.h"
+#include "cfgdb.h"
+#include "cfg_keys.h"
+#include "generic_parser.h"
+#include "cfg/parser/json_parser.h"
+
+/* Defines  *********************************************************** */
+/* Coprime to all the sizes, visits the nodes in a scattered order */
+#define STRIDE 7919
+#define SCATTER(i, n) ((uint32_t)(((uint64_t)(i) * STRIDE) % (n)))
+
+typedef err_t (*add_func_t)(node_t *n);
+typedef err_t (*rm_func_t)(node_t *n, bool destory);
+typedef node_t *(*uuid_get_func_t)(const uint8_t *uuid);
+
+/* Global Variables *************************************************** */
+
+/* Static Variables *************************************************** */
+static const int sizes[] = BENCH_SIZES;
+static const char *tmpl_ids[] = { "0x01", "0x11", "0x21" };
+
+/* Static Functions Declaractions ************************************* */
+static node_t **nodes_new(int num, bool addr)
+{
+  node_t **ns = calloc(num, sizeof(node_t *));
+
+  for (int i = 0; i < num; i++) {
+    ns[i] = calloc(1, sizeof(node_t));
+    bench_uuid(ns[i]->uuid, i);
+    if (addr) {
+      ns[i]->addr = i + 1;
+      ns[i]->models.func = (i & 1) ? ONOFF_SV_BIT : 0;
+    }
+  }
+  return ns;
+}
+
+/*
+ * The unprovisioned devices and the backlog are both keyed by the UUID
+ */
+static void bench_uuid_tree(const char *add_name,
+                            const char *get_name,
+                            const char *rm_name,
+                            add_func_t add,
+                            uuid_get_func_t get,
+                            rm_func_t rm,
+                            int num)
+{
+  uint64_t t;
+  node_t **ns = nodes_new(num, false);
+
+  t = bench_now_ns();
+  for (int i = 0; i < num; i++) {
+    add(ns[SCATTER(i, num)]);
+  }
+  bench_report(add_name, num, num, bench_now_ns() - t);
+
+  t = bench_now_ns();
+  for (int i = 0; i < num; i++) {
+    bench_sink = (uintptr_t)get(ns[SCATTER(i, num)]->uuid);
+  }
+  bench_report(get_name, num, num, bench_now_ns() - t);
+
+  t = bench_now_ns();
+  for (int i = 0; i < num; i++) {
+    rm(ns[SCATTER(i, num)], true);
+  }
+  bench_report(rm_name, num, num, bench_now_ns() - t);
+  free(ns);
+}
+
+static void bench_nodes_tree(int num)
+{
+  uint64_t t;
+  int iters;
+  uint16list_t *l;
+  node_t **ns = nodes_new(num, true);
+
+  t = bench_now_ns();
+  for (int i = 0; i < num; i++) {
+    cfgdb_nodes_add(ns[SCATTER(i, num)]);
+  }
+  bench_report("cfgdb_nodes_add", num, num, bench_now_ns() - t);
+
+  t = bench_now_ns();
+  for (int i = 0; i < num; i++) {
+    bench_sink = (uintptr_t)cfgdb_node_get(SCATTER(i, num) + 1);
+  }
+  bench_report("cfgdb_node_get", num, num, bench_now_ns() - t);
+
+  /* Walks the whole tree, run it about a million node visits in total */
+  iters = 1000000 / num + 1;
+  t = bench_now_ns();
+  for (int i = 0; i < iters; i++) {
+    l = get_lights_addrs(ONOFF_SV_BIT);
+    bench_sink = l->len;
+    free(l->data);
+    free(l);
+  }
+  bench_report("get_lights_addrs", num, iters, bench_now_ns() - t);
+
+  t = bench_now_ns();
+  for (int i = 0; i < num; i++) {
+    cfgdb_nodes_remove(ns[SCATTER(i, num)], true);
+  }
+  bench_report("cfgdb_nodes_remove", num, num, bench_now_ns() - t);
+  free(ns);
+}
+
+void bench_cfgdb(void)
+{
+  for (int i = 0; i < ARR_LEN(sizes); i++) {
+    bench_uuid_tree("cfgdb_unpl_add", "cfgdb_unprov_dev_get",
+                    "cfgdb_unpl_remove", cfgdb_unpl_add,
+                    cfgdb_unprov_dev_get, cfgdb_unpl_remove, sizes[i]);
+    bench_uuid_tree("cfgdb_backlog_add", "cfgdb_backlog_get",
+                    "cfgdb_backlog_remove", cfgdb_backlog_add,
+                    cfgdb_backlog_get, cfgdb_backlog_remove, sizes[i]);
+    if (sizes[i] <= BENCH_MAX_NODES) {
+      bench_nodes_tree(sizes[i]);
+    }
+  }
+}
+
+/*
+ * Three quarters of the nodes are provisioned, the templates rotate among the
+ * ones in the template file of the repo
+ */
+static int nwk_file_new(const char *path, int num)
+{
+  uint8_t uuid[16];
+  char uuid_str[33] = { 0 };
+  FILE *fp = fopen(path, "w");
+
+  if (!fp) {
+    return -1;
+  }
+  fprintf(fp, "{\n  \"%s\": \"0x00000000\",\n  \"%s\": [\n    {\n"
+              "      \"%s\": \"0x0000\",\n      \"%s\": [",
+          STR_SYNC_TIME, STR_SUBNETS, STR_REFID, STR_NODES);
+  for (int i = 0; i < num; i++) {
+    bench_uuid(uuid, i);
+    cbuf2str((char *)uuid, 16, 0, uuid_str, sizeof(uuid_str));
+    fprintf(fp, "%s\n        {\n"
+                "          \"%s\": \"%s\",\n"
+                "          \"%s\": \"0x%04x\",\n"
+                "          \"%s\": \"0x00000000\",\n"
+                "          \"%s\": \"%s\",\n"
+                "          \"%s\": \"0x00\",\n"
+                "          \"%s\": \"0x00\",\n"
+                "          \"%s\": \"0x%02x\"\n"
+                "        }",
+            i ? "," : "",
+            STR_UUID, uuid_str,
+            STR_ADDR, (i & 3) ? i + 1 : 0,
+            STR_ERRBITS,
+            STR_TMPL, tmpl_ids[i % ARR_LEN(tmpl_ids)],
+            STR_RMORBL,
+            STR_FUNC,
+            STR_DONE, (i & 3) ? 1 : 0);
+  }
+  fprintf(fp, "\n      ]\n    }\n  ],\n  \"%s\": []\n}\n", STR_BACKLOG);
+  fclose(fp);
+  return 0;
+}
+
+static int file_copy(const char *from, const char *to)
+{
+  char buf[4096];
+  size_t n;
+  FILE *in, *out;
+
+  if (!(in = fopen(from, "r"))) {
+    return -1;
+  }
+  if (!(out = fopen(to, "w"))) {
+    fclose(in);
+    return -1;
+  }
+  while (0 != (n = fread(buf, 1, sizeof(buf), in))) {
+    fwrite(buf, 1, n, out);
+  }
+  fclose(in);
+  fclose(out);
+  return 0;
+}
+
+/*
+ * Loads the generated network and updates the nodes of it, on a copy of the
+ * nodes file since the updates are written through
+ */
+static void bench_cfgfile_gen(void)
+{
+  char path[FILE_PATH_MAX];
+  uint8_t uuid[16];
+  lbitmap_t errbits;
+  uint64_t t;
+  int iters, num;
+
+  snprintf(path, FILE_PATH_MAX, "%s/templates.json", bench_cfg_dir);
+  if (ec_success != json_cfg_open(TEMPLATE_FILE, path, FL_FORCE_RELOAD)) {
+    fprintf(stderr, "Cannot load %s\n", path);
+    return;
+  }
+  snprintf(path, FILE_PATH_MAX, "%s/nwk.json", bench_cfg_dir);
+  if (file_copy(path, BENCH_TMP_DIR "bench_nwk_gen.json")) {
+    fprintf(stderr, "Cannot copy %s\n", path);
+    return;
+  }
+  snprintf(path, FILE_PATH_MAX, BENCH_TMP_DIR "bench_nwk_gen.json");
+  if (ec_success != json_cfg_open(NW_NODES_CFG_FILE, path, FL_FORCE_RELOAD)) {
+    fprintf(stderr, "Cannot load %s\n", path);
+    return;
+  }
+  num = cfgdb_get_devnum(nodes_em) + cfgdb_get_devnum(upl_em)
+        + cfgdb_get_devnum(backlog_em);
+
+  iters = 5;
+  t = bench_now_ns();
+  for (int j = 0; j < iters; j++) {
+    json_cfg_open(NW_NODES_CFG_FILE, path, FL_FORCE_RELOAD);
+  }
+  bench_report("load_cfg_file_gen", num, iters, bench_now_ns() - t);
+
+  iters = 10;
+  t = bench_now_ns();
+  for (int j = 0; j < iters; j++) {
+    /* The generated UUIDs follow the same rule */
+    bench_uuid(uuid, SCATTER(j, cfgdb_get_devnum(nodes_em)
+                             + cfgdb_get_devnum(upl_em)));
+    errbits = j;
+    json_cfg_write(NW_NODES_CFG_FILE, wrt_errbits, uuid, &errbits);
+  }
+  bench_report("json_cfg_write_gen", num, iters, bench_now_ns() - t);
+
+  json_cfg_close(NW_NODES_CFG_FILE);
+  cfgdb_remove_all_nodes();
+  cfgdb_remove_all_upl();
+  unlink(path);
+}
+
+void bench_cfgfile(void)
+{
+  char path[FILE_PATH_MAX];
+  uint8_t uuid[16];
+  lbitmap_t errbits;
+  uint64_t t;
+  int iters;
+  err_t e;
+
+  if (ec_success != (e = json_cfg_open(TEMPLATE_FILE, TMPLATE_FILE_PATH, 0))) {
+    fprintf(stderr, "No template file, the nodes are loaded without\n");
+  }
+
+  for (int i = 0; i < ARR_LEN(sizes); i++) {
+    if (sizes[i] > BENCH_MAX_FILE_NODES) {
+      continue;
+    }
+    snprintf(path, FILE_PATH_MAX, BENCH_TMP_DIR "bench_nwk_%d.json", sizes[i]);
+    if (nwk_file_new(path, sizes[i])) {
+      fprintf(stderr, "Cannot write %s\n", path);
+      return;
+    }
+
+    /* What load_cfg_file does on the nodes file, apart from the lists of the
+     * manager which are not loaded without the NCP target */
+    iters = sizes[i] > 1000 ? 5 : 20;
+    t = bench_now_ns();
+    for (int j = 0; j < iters; j++) {
+      json_cfg_open(NW_NODES_CFG_FILE, path, FL_FORCE_RELOAD);
+    }
+    bench_report("load_cfg_file", sizes[i], iters, bench_now_ns() - t);
+
+    /* A node update is written through to the file */
+    iters = sizes[i] > 1000 ? 10 : 50;
+    t = bench_now_ns();
+    for (int j = 0; j < iters; j++) {
+      bench_uuid(uuid, SCATTER(j, sizes[i]));
+      errbits = j;
+      json_cfg_write(NW_NODES_CFG_FILE, wrt_errbits, uuid, &errbits);
+    }
+    bench_report("json_cfg_write", sizes[i], iters, bench_now_ns() - t);
+
+    json_cfg_close(NW_NODES_CFG_FILE);
+    cfgdb_remove_all_nodes();
+    cfgdb_remove_all_upl();
+    unlink(path);
+  }
+
+  if (bench_cfg_dir) {
+    bench_cfgfile_gen();
+  }
+}
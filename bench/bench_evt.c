@@ -0,0 +1,146 @@
+/*************************************************************************
+    > File Name: bench_evt.c
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Benchmarks of routing the BGAPI events to the handlers
+ ************************************************************************/
+
+/* Includes *********************************************************** */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+#include "bgevt_hdr.h"
+#include "mng.h"
+
+/* Defines  *********************************************************** */
+#define EVT_NUM       100000
+/* Longest synthetic event */
+#define EVT_MAX_LEN   64
+
+enum {
+  evt_beacon,
+  evt_adv_timeout,
+  evt_soft_timer
+};
+
+/* Global Variables *************************************************** */
+
+/* Static Variables *************************************************** */
+/* Bytes bglib reads, in place of the NCP target */
+static struct {
+  uint8_t *buf;
+  size_t len;
+  size_t offs;
+} stream = { 0 };
+
+/* Static Functions Declaractions ************************************* */
+static void stream_output(uint32_t len, uint8_t *data)
+{
+  /* Nothing is sent on the paths measured */
+}
+
+static int32_t stream_input(uint32_t len, uint8_t *data)
+{
+  if (stream.offs + len > stream.len) {
+    return -1;
+  }
+  memcpy(data, stream.buf + stream.offs, len);
+  stream.offs += len;
+  return len;
+}
+
+static int32_t stream_peek(void)
+{
+  return stream.len - stream.offs;
+}
+
+static void evt_put(uint32_t id, const void *payload, uint32_t len)
+{
+  uint32_t hdr = id | ((len & 0xff) << 8) | ((len >> 8) & 0x07);
+
+  memcpy(stream.buf + stream.len, &hdr, BGLIB_MSG_HEADER_LEN);
+  memcpy(stream.buf + stream.len + BGLIB_MSG_HEADER_LEN, payload, len);
+  stream.len += BGLIB_MSG_HEADER_LEN + len;
+}
+
+/*
+ * Beacons of devices not in the network, which the manager hears the most
+ * while adding devices
+ */
+static void beacon_put(uint32_t idx)
+{
+  uint8_t buf[sizeof(struct gecko_msg_mesh_prov_unprov_beacon_evt_t) + 16];
+  struct gecko_msg_mesh_prov_unprov_beacon_evt_t *b = (void *)buf;
+
+  memset(buf, 0, sizeof(buf));
+  b->uuid.len = 16;
+  bench_uuid(b->uuid.data, 0x80000000 | idx);
+  evt_put(gecko_evt_mesh_prov_unprov_beacon_id, buf, sizeof(buf));
+}
+
+static void stream_fill(const uint8_t *mix, int mixlen, int num)
+{
+  uint8_t handle = 0;
+
+  stream.len = stream.offs = 0;
+  for (int i = 0; i < num; i++) {
+    switch (mix[i % mixlen]) {
+      case evt_beacon:
+        beacon_put(i);
+        break;
+      case evt_adv_timeout:
+        evt_put(gecko_evt_le_gap_adv_timeout_id, &handle, 1);
+        break;
+      case evt_soft_timer:
+        evt_put(gecko_evt_hardware_soft_timer_id, &handle, 1);
+        break;
+    }
+  }
+}
+
+static void run(const char *name, const uint8_t *mix, int mixlen)
+{
+  uint64_t t;
+
+  stream_fill(mix, mixlen, EVT_NUM);
+  t = bench_now_ns();
+  while (stream.offs < stream.len) {
+    bgevt_dispenser();
+  }
+  bench_report(name, EVT_NUM, EVT_NUM, bench_now_ns() - t);
+}
+
+void bench_evt(void)
+{
+  mng_t *mng = get_mng();
+  struct gecko_msg_system_boot_evt_t boot = { 0 };
+  static const uint8_t beacons[] = { evt_beacon };
+  static const uint8_t unhandled[] = { evt_soft_timer };
+  static const uint8_t mixed[] = {
+    evt_beacon, evt_beacon, evt_beacon, evt_beacon,
+    evt_beacon, evt_beacon, evt_beacon, evt_beacon,
+    evt_adv_timeout, evt_soft_timer
+  };
+
+  stream.buf = malloc((size_t)EVT_NUM * EVT_MAX_LEN);
+  if (!stream.buf) {
+    return;
+  }
+  BGLIB_INITIALIZE_NONBLOCK(stream_output, stream_input, stream_peek);
+
+  /* The dispenser syncs with the NCP target on the first call */
+  stream.len = stream.offs = 0;
+  evt_put(gecko_evt_system_boot_id, &boot, sizeof(boot));
+  bgevt_dispenser();
+
+  mng->state = adding_devices_em;
+  run("evt_dispatch_beacon", beacons, ARR_LEN(beacons));
+  run("evt_dispatch_unhandled", unhandled, ARR_LEN(unhandled));
+  run("evt_dispatch_mixed", mixed, ARR_LEN(mixed));
+  mng->state = nil;
+
+  free(stream.buf);
+  stream.buf = NULL;
+}
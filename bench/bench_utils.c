@@ -0,0 +1,70 @@
+/*************************************************************************
+    > File Name: bench_utils.c
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Benchmarks of the string conversions used by the parser
+ ************************************************************************/
+
+/* Includes *********************************************************** */
+#include <string.h>
+
+#include "bench.h"
+#include "utils.h"
+
+/* Defines  *********************************************************** */
+#define ITERS 1000000
+
+/* Global Variables *************************************************** */
+
+/* Static Variables *************************************************** */
+
+/* Static Functions Declaractions ************************************* */
+void bench_utils(void)
+{
+  uint64_t t;
+  uint8_t uuid[16];
+  char str[33] = { 0 };
+  uint32_t u32;
+  uint16_t u16;
+  static const char *u32_str = "0x0a1b2c3d";
+  static const char *u16_str = "0x1f2e";
+  static const char *dec_str = "65535";
+
+  bench_uuid(uuid, 0x12345678);
+  cbuf2str((char *)uuid, 16, 0, str, sizeof(str));
+
+  t = bench_now_ns();
+  for (int i = 0; i < ITERS; i++) {
+    str2cbuf(str, 0, (char *)uuid, 16);
+    bench_sink = uuid[i & 15];
+  }
+  bench_report("str2cbuf", 16, ITERS, bench_now_ns() - t);
+
+  t = bench_now_ns();
+  for (int i = 0; i < ITERS; i++) {
+    cbuf2str((char *)uuid, 16, 0, str, sizeof(str));
+    bench_sink = str[i & 31];
+  }
+  bench_report("cbuf2str", 16, ITERS, bench_now_ns() - t);
+
+  t = bench_now_ns();
+  for (int i = 0; i < ITERS; i++) {
+    str2uint(u32_str, strlen(u32_str), &u32, sizeof(u32));
+    bench_sink = u32;
+  }
+  bench_report("str2uint_hex32", 4, ITERS, bench_now_ns() - t);
+
+  t = bench_now_ns();
+  for (int i = 0; i < ITERS; i++) {
+    str2uint(u16_str, strlen(u16_str), &u16, sizeof(u16));
+    bench_sink = u16;
+  }
+  bench_report("str2uint_hex16", 2, ITERS, bench_now_ns() - t);
+
+  t = bench_now_ns();
+  for (int i = 0; i < ITERS; i++) {
+    str2uint(dec_str, strlen(dec_str), &u16, sizeof(u16));
+    bench_sink = u16;
+  }
+  bench_report("str2uint_dec", 2, ITERS, bench_now_ns() - t);
+}
@@ -205,9 +205,12 @@ err_t nodes_bl(uint16_t addr)
   cfgdb_nodes_remove(n, 0);
   n->addr = 0;
   n->done = 0;
+  memset(n->digest, 0, NODE_DIGEST_LEN);
   cfgdb_unpl_add(n);
   e = gp.write(NW_NODES_CFG_FILE, wrt_done, (void *)n->uuid, (void *)&n->done);
   elog(e);
+  e = gp.write(NW_NODES_CFG_FILE, wrt_digest, (void *)n->uuid, (void *)n->digest);
+  elog(e);
   e = gp.write(NW_NODES_CFG_FILE, wrt_node_addr, n->uuid, (void *)&n->addr);
   elog(e);
   return e;
@@ -233,6 +236,25 @@ err_t nodeset_done(uint16_t addr, uint8_t done)
   n->done = done;
   e = gp.write(NW_NODES_CFG_FILE, wrt_done, (void *)n->uuid, (void *)&done);
   elog(e);
+  if (!done) {
+    /* Nothing is known to be applied to a node which isn't done */
+    e = nodeset_digest(addr, NULL);
+  }
+  return e;
+}
+
+err_t nodeset_digest(uint16_t addr, const uint8_t *digest)
+{
+  err_t e;
+  node_t *n;
+  n = cfgdb_node_get(addr);
+  if (digest) {
+    memcpy(n->digest, digest, NODE_DIGEST_LEN);
+  } else {
+    memset(n->digest, 0, NODE_DIGEST_LEN);
+  }
+  e = gp.write(NW_NODES_CFG_FILE, wrt_digest, (void *)n->uuid, (void *)n->digest);
+  elog(e);
   return e;
 }
 
@@ -6,6 +6,7 @@
  ************************************************************************/
 
 /* Includes *********************************************************** */
+#define LOG_MODULE log_mod_json_parser
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
@@ -1326,6 +1327,7 @@ static void __load_node_arr(json_object *pnode, bool backlog)
     uint32_t errbits;
     uint16_t addr;
     uint8_t rmbl, done, func;
+    uint8_t digest[NODE_DIGEST_LEN] = { 0 };
     node_t *t;
 
     json_object_object_get_ex(n, STR_ADDR, &tmp);
@@ -1364,6 +1366,14 @@ static void __load_node_arr(json_object *pnode, bool backlog)
       LOGE("STR to UINT error\n");
       continue;
     }
+    /* Optional, the node is configured as if nothing is applied if invalid */
+    if (json_object_object_get_ex(n, STR_DIGEST, &tmp)) {
+      v = json_object_get_string(tmp);
+      if (ec_success != str2cbuf(v, 0, (char *)digest, NODE_DIGEST_LEN)) {
+        LOGW("Node[%d] digest invalid, ignored.\n", i);
+        memset(digest, 0, NODE_DIGEST_LEN);
+      }
+    }
 
     if (backlog) {
       t = cfgdb_backlog_get((const uint8_t *)uuid);
@@ -1387,6 +1397,7 @@ static void __load_node_arr(json_object *pnode, bool backlog)
     t->rmorbl = rmbl;
     t->err = errbits;
     t->models.func = func;
+    memcpy(t->digest, digest, NODE_DIGEST_LEN);
     if (add) {
       if (e == ec_success) {
         if (backlog) {
@@ -1587,6 +1598,7 @@ err_t json_cfg_flush(int cfg_fd)
  *   - Address [Address]
  *   - Remove or blacklist [RM_Blacklist]
  *   - Done [Done]
+ *   - Digest [Digest]
  * - In Self config scope
  *   - Address
  *   - Sync time
@@ -1773,6 +1785,22 @@ static err_t set_node_done(const void *key,
   return modify_node_field(key, STR_DONE, buf);
 }
 
+static err_t set_node_digest(const void *key,
+                             void *data)
+{
+  /* Key is uuid and data is the digest */
+  char buf[NODE_DIGEST_LEN * 2 + 1] = { 0 };
+  err_t e;
+
+  if (!key || !data) {
+    return err(ec_param_invalid);
+  }
+  if (ec_success != (e = cbuf2str(data, NODE_DIGEST_LEN, 0, buf, sizeof(buf)))) {
+    return e;
+  }
+  return modify_node_field(key, STR_DIGEST, buf);
+}
+
 static err_t nodes_clrctl(void)
 {
   char uint32_zero[] = { '0', 'x', '0', '0', '0', '0', '0', '0', '0', '0', 0 };
@@ -1786,6 +1814,7 @@ static err_t nodes_clrctl(void)
     __kv_replace(node, STR_RMORBL, uint8_zero);
     __kv_replace(node, STR_FUNC, uint8_zero);
     __kv_replace(node, STR_DONE, uint8_zero);
+    json_object_object_del(node, STR_DIGEST);
   }
   if (jcfg.nw.gen.autoflush) {
     json_cfg_flush(NW_NODES_CFG_FILE);
@@ -1825,6 +1854,9 @@ static err_t write_nodes(int wrtype,
     case wrt_done:
       e = set_node_done(key, data);
       break;
+    case wrt_digest:
+      e = set_node_digest(key, data);
+      break;
     default:
       return err(ec_param_invalid);
   }
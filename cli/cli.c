@@ -18,6 +18,7 @@
 #include <signal.h>
 #include <errno.h>
 #include <setjmp.h>
+#include <time.h>
 
 #include <wordexp.h>
 
@@ -27,6 +28,7 @@
 #include "cli.h"
 #include "cfg.h"
 #include "mng.h"
+#include "cmd_ring.h"
 
 #include "startup.h"
 #include "utils.h"
@@ -44,9 +46,13 @@
 
 #define foreach_cmds(i) for (int i = 0; i < cmd_num; i++)
 
+/* us, the batch checks the barriers in steps */
+#define BATCH_POLL_US 1000
+/* Barrier of the batch, not a command */
+#define BATCH_WAIT "wait"
+
 /* Global Variables *************************************************** */
 extern jmp_buf initjmpbuf;
-extern pthread_mutex_t qlock;
 extern err_t cmd_ret;
 
 /* Static Variables *************************************************** */
@@ -106,6 +112,14 @@ const command_t commands[] = {
     NULL },
   { "loglvlset", "[e/w/m/d/v] [1/0]", clicb_loglvlset,
     "Set the log threshold level and if output to stdout" },
+  { "modlvlset", "[default/mng/dev_config/json_parser/hal] [e/w/m/d/v]",
+    clicb_modlvlset, "Set the log threshold level of one module" },
+  { "trace", "[on/off]", clicb_trace,
+    "Write the traces in binary to " CLI_TRACE_FILE_PATH " instead of the log" },
+  { "timeline", "[on/off]", clicb_timeline,
+    "Record the config/provisioning timeline to " CLI_TIMELINE_FILE_PATH },
+  { "capture", "[on/off]", clicb_capture,
+    "Capture the BGAPI frames to " BGAPI_CAPTURE_FILE_PATH },
 
   /* Light Control Commands */
   { "onoff", "[on/off] [addr...]", clicb_onoff,
@@ -122,6 +136,15 @@ const command_t commands[] = {
   /* Debug Commands */
   { "status", NULL, clicb_status,
     "Print the device status" },
+  { "bgstat", "[reset/export]", clicb_bgstat,
+    "Print the BGAPI statistics, reset them or export them to "
+    BGAPI_STAT_FILE_PATH },
+  { "dcdcache", "[clear]", clicb_dcdcache,
+    "Print the cached device types and the templates mapped to them, or"
+    " forget the mappings" },
+  { "shaper", "[rate] [burst]", clicb_shaper,
+    "Print the on-air budget and the messages sent and held back in each"
+    " lane, or set the budget" },
 #ifdef DEMO_EN
   { "demo", "[on/off]", clicb_demo,
     "Start/Stop a quick demo" },
@@ -132,6 +155,8 @@ static wordexp_t args;
 static const size_t cmd_num = sizeof(commands) / sizeof(command_t);
 static char *line = NULL;
 static int reset = 0;
+/* Running a script, no shell to redraw */
+static bool batch = false;
 
 /* Static Functions Declaractions ************************************* */
 char **shell_completion(const char *text, int start, int end);
@@ -518,6 +543,16 @@ static inline int find_cmd_index(const char *cmd)
   return -1;
 }
 
+const command_t *cli_cmd_get(const char *name)
+{
+  foreach_cmds(i){
+    if (!strcmp(name, commands[i].name)) {
+      return &commands[i];
+    }
+  }
+  return NULL;
+}
+
 static void output_nspt(const char *cmd)
 {
   print_text(COLOR_HIGHLIGHT,
@@ -714,8 +749,9 @@ void *cli_mainloop(void *pin)
         goto out;
       }
     } else {
-      /* Need the mng component to handle */
-      cmd_enq(str, ret);
+      /* Need the mng component to handle, which frees the parsed command */
+      cmd_enq(cmd_src_cli, &commands[ret], &w, 0);
+      w.we_wordv = NULL;
     }
 
     out:
@@ -723,7 +759,9 @@ void *cli_mainloop(void *pin)
       add_history(str);
       write_history(RL_HISTORY);
     }
-    wordfree(&w);
+    if (w.we_wordv) {
+      wordfree(&w);
+    }
     if (reset) {
       int r = reset;
       reset = 0;
@@ -734,6 +772,111 @@ void *cli_mainloop(void *pin)
 }
 #endif
 
+/*
+ * Wait until the queued commands are run, and the sync is done if @sync.
+ * @timeout_s 0 waits forever.
+ */
+static bool batch_wait(bool sync, int timeout_s)
+{
+  time_t expired = time(NULL) + timeout_s;
+
+  while (cmd_ring_pending(cmd_src_cli) || (sync && get_mng()->state > configured)) {
+    if (timeout_s && time(NULL) > expired) {
+      return false;
+    }
+    usleep(BATCH_POLL_US);
+  }
+  return true;
+}
+
+int cli_batch(const char *path)
+{
+  /* Kept over a reset, the script goes on from the next line */
+  static FILE *fp = NULL;
+  static int lineno = 0;
+  static char *buf = NULL;
+  static size_t cap = 0;
+  char *str;
+  int ret, timeout;
+  err_t e;
+  wordexp_t w;
+
+  batch = true;
+  if (!fp && NULL == (fp = strcmp(path, "-") ? fopen(path, "r") : stdin)) {
+    fprintf(stderr, "Open script [%s] failed: %s\n", path, strerror(errno));
+    return EXIT_FAILURE;
+  }
+
+  while (-1 != getline(&buf, &cap, fp)) {
+    lineno++;
+    str = stripwhite(buf);
+    if (str[0] == '\0' || str[0] == '#') {
+      continue;
+    }
+    if (wordexp(str, &w, WRDE_NOCMD)) {
+      fprintf(stderr, "Line %d: Can't parse [%s]\n", lineno, str);
+      return EXIT_FAILURE;
+    }
+    if (w.we_wordc == 0) {
+      /* e.g. an unset variable only */
+      wordfree(&w);
+      continue;
+    }
+    if (!strcmp(w.we_wordv[0], BATCH_WAIT)) {
+      timeout = w.we_wordc > 1 ? atoi(w.we_wordv[1]) : 0;
+      wordfree(&w);
+      if (!batch_wait(true, timeout)) {
+        fprintf(stderr, "Line %d: Sync not done in %ds\n", lineno, timeout);
+        return EXIT_FAILURE;
+      }
+    } else if (-1 == (ret = find_cmd_index(str))) {
+      output_nspt(w.we_wordv[0]);
+      wordfree(&w);
+      fprintf(stderr, "Line %d: Invalid command\n", lineno);
+      return EXIT_FAILURE;
+    } else if (ret < 3) {
+      /* Locally handled, after the commands before it */
+      batch_wait(false, 0);
+      if (commands[ret].fn == clicb_quit) {
+        wordfree(&w);
+        break;
+      }
+      e = commands[ret].fn(w.we_wordc, w.we_wordv);
+      wordfree(&w);
+      if (ec_param_invalid == errof(e)) {
+        printf(COLOR_HIGHLIGHT "Invalid Parameter(s)\nUsage: " COLOR_OFF);
+        print_cmd_usage(&commands[ret]);
+        fprintf(stderr, "Line %d: Invalid parameter(s)\n", lineno);
+        return EXIT_FAILURE;
+      }
+      if (ec_success != e) {
+        elog(e);
+        fprintf(stderr, "Line %d: Command failed\n", lineno);
+        return EXIT_FAILURE;
+      }
+      if (reset) {
+        int r = reset;
+        reset = 0;
+        longjmp(initjmpbuf, (r == 2) ? FACTORY_RESET : NORMAL_RESET);
+      }
+    } else {
+      /* The manager frees the parsed command */
+      cmd_enq(cmd_src_cli, &commands[ret], &w, 0);
+    }
+    if (cmd_ring_failed(cmd_src_cli)) {
+      break;
+    }
+  }
+
+  batch_wait(false, 0);
+  if (cmd_ring_failed(cmd_src_cli)) {
+    fprintf(stderr, "Line %d: %u command(s) failed\n",
+            lineno, cmd_ring_failed(cmd_src_cli));
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
 void bt_shell_printf(const char *fmt, ...)
 {
   va_list args;
@@ -751,7 +894,7 @@ void bt_shell_printf(const char *fmt, ...)
   /* return; */
   /* } */
 
-  save_input = !RL_ISSTATE(RL_STATE_DONE);
+  save_input = !batch && !RL_ISSTATE(RL_STATE_DONE);
 
   if (save_input) {
     saved_point = rl_point;
@@ -9,7 +9,11 @@
 #include <stdio.h>
 
 #include "cli.h"
+#include "bgapi_stat.h"
+#include "dcd_cache.h"
+#include "shaper.h"
 #include "logging.h"
+#include "trace.h"
 #include "utils.h"
 /* Defines  *********************************************************** */
 #define DEV_INFO      "Dev Info:\n"
@@ -110,7 +114,7 @@ const char *loglvls[] = { "Assert", "Error", "Warning", "Message", "Debug", "Ver
 void cli_status(const mng_t *mng)
 {
   int used = 0;
-  int loglvl;
+  int loglvl, modlvl;
 
   for (int i = 0; i < MAX_PROV_SESSIONS; i++) {
     if (mng->cache.add[i].busy) {
@@ -128,6 +132,14 @@ void cli_status(const mng_t *mng)
   bt_shell_printf("Node(s) to set state  = %d\n", g_list_length(mng->cache.model_set.nodes));
   bt_shell_printf("Free mode             = %s\n", mng->status.free_mode == 2 ? "On" : "Off");
   bt_shell_printf("Logging Threshold     = %s\n", loglvls[loglvl + 1]);
+  for (int i = log_mod_default + 1; i < log_mod_max; i++) {
+    modlvl = get_logging_mod_lvl_threshold(i);
+    if (modlvl != loglvl) {
+      bt_shell_printf("  %-20s= %s\n", get_logging_mod_name(i), loglvls[modlvl + 1]);
+    }
+  }
+  bt_shell_printf("Dropped log records   = %lu\n", get_logging_dropped());
+  bt_shell_printf("Binary trace          = %s\n", logging_trace_on() ? "On" : "Off");
   bt_shell_printf("[%d-%d-%d-%d] to be [added-configured-removed-blacklisted]\n",
                   g_list_length(mng->lists.add),
                   g_list_length(mng->lists.config),
@@ -135,9 +147,30 @@ void cli_status(const mng_t *mng)
                   g_list_length(mng->lists.bl));
 }
 
+static void print_lat(const char *name, const lat_hist_t *h)
+{
+  if (!h->cnt) {
+    return;
+  }
+  bt_shell_printf("    %-16s: n=%u p50=%.1fms p90=%.1fms p99=%.1fms max=%.1fms\n",
+                  name,
+                  h->cnt,
+                  lat_hist_percentile(h, 50) / 1000.0,
+                  lat_hist_percentile(h, 90) / 1000.0,
+                  lat_hist_percentile(h, 99) / 1000.0,
+                  h->max / 1000.0);
+}
+
 void cli_print_stat(const stat_t *s)
 {
+  static const char *state_names[config_lat_max] = {
+    "get dcd", "add appkey", "bind appkey", "set pub", "add sub", "set config"
+  };
+  static const char *set_names[model_set_lat_max] = {
+    "onoff", "lightness", "color temp"
+  };
   unsigned t, h, m;
+  bool model_set = false;
   if (s->add.time.state == rc_end) {
     /* Add valid, output it */
     t = s->add.time.end - s->add.time.start;
@@ -154,6 +187,7 @@ void cli_print_stat(const stat_t *s)
                     s->add.fail_times,
                     h, m, t
                     );
+    print_lat("provisioning", &s->add.prov_lat);
   }
 
   if (s->bl.time.state == rc_end) {
@@ -190,6 +224,7 @@ void cli_print_stat(const stat_t *s)
                     s->rm.retry_times,
                     h, m, t
                     );
+    print_lat("rm", &s->rm.rm_lat);
   }
 
   if (s->config.time.state == rc_end) {
@@ -223,5 +258,97 @@ void cli_print_stat(const stat_t *s)
                       full_loading_perc
                       );
     }
+    for (int i = 0; i < config_lat_max; i++) {
+      print_lat(state_names[i], &s->config.state_lat[i]);
+    }
+  }
+
+  for (int i = 0; i < model_set_lat_max; i++) {
+    model_set |= s->model_set.lat[i].cnt != 0;
+  }
+  if (model_set) {
+    bt_shell_printf("  Model set summary:\n");
+    for (int i = 0; i < model_set_lat_max; i++) {
+      print_lat(set_names[i], &s->model_set.lat[i]);
+    }
+  }
+}
+
+void cli_print_bgapi_stat(void)
+{
+  const bgapi_cmd_stat_t *cmds[BGAPI_STAT_CMD_SLOTS];
+  const bgapi_evt_stat_t *evts[BGAPI_STAT_EVT_SLOTS];
+  int n;
+
+  n = bgapi_stat_cmds(cmds);
+  bt_shell_printf("  BGAPI commands, by total round-trip time:\n"
+                  "    %-40s %8s %6s %10s %8s %8s %8s %8s\n",
+                  "name", "calls", "errors", "total(ms)",
+                  "p50(ms)", "p90(ms)", "p99(ms)", "max(ms)");
+  for (int i = 0; i < n; i++) {
+    bt_shell_printf("    %-40s %8u %6u %10.1f %8.2f %8.2f %8.2f %8.2f\n",
+                    cmds[i]->name,
+                    cmds[i]->calls,
+                    cmds[i]->errs,
+                    cmds[i]->total_us / 1000.0,
+                    lat_hist_percentile(&cmds[i]->rtt, 50) / 1000.0,
+                    lat_hist_percentile(&cmds[i]->rtt, 90) / 1000.0,
+                    lat_hist_percentile(&cmds[i]->rtt, 99) / 1000.0,
+                    cmds[i]->rtt.max / 1000.0);
+  }
+
+  n = bgapi_stat_evts(evts);
+  bt_shell_printf("  BGAPI events:\n"
+                  "    %-40s %8s %8s %9s\n",
+                  "name", "received", "dropped", "unhandled");
+  for (int i = 0; i < n; i++) {
+    bt_shell_printf("    %-40s %8u %8u %9u\n",
+                    evts[i]->name,
+                    evts[i]->recv,
+                    evts[i]->dropped,
+                    evts[i]->unhandled);
+  }
+  bt_shell_printf("  Event queue high-water mark: %d/%d\n",
+                  bgapi_stat_evt_queue_hwm(), BGLIB_QUEUE_LEN - 1);
+}
+
+void cli_print_dcd_cache(void)
+{
+  const dcd_cache_stat_t *s = dcd_cache_stat();
+  const dcd_t *dcd;
+  uint8_t hits;
+
+  bt_shell_printf("  DCD fetched %u, got from the cache %u,"
+                  " template conflicts %u\n"
+                  "    %-8s %-6s %-6s %-6s %-6s %-8s %-8s %s\n",
+                  s->fetched, s->shortcut, s->conflicts,
+                  "template", "cid", "pid", "vid", "crpl", "features",
+                  "elements", "fetched");
+  for (int t = 0; t <= 0xff; t++) {
+    if (!(dcd = dcd_cache_tmpl(t, &hits))) {
+      continue;
+    }
+    bt_shell_printf("    0x%02x     0x%04x 0x%04x 0x%04x 0x%04x 0x%04x   "
+                    "%-8u %u\n",
+                    t, dcd->cid, dcd->pid, dcd->vid, dcd->crpl,
+                    dcd->feature, dcd->element_cnt, hits);
+  }
+}
+
+void cli_print_shaper(void)
+{
+  static const char *lanes[] = { "interactive", "background", "bulk" };
+  const shaper_stat_t *s = shaper_stat();
+
+  if (!s->rate) {
+    bt_shell_printf("  Shaper off\n");
+  } else {
+    bt_shell_printf("  Shaper %u messages/s, burst %u, tokens %u\n",
+                    s->rate, s->burst, shaper_tokens());
+  }
+  bt_shell_printf("    %-12s %10s %10s\n", "lane", "sent", "deferred");
+  for (int i = 0; i < shp_lane_max; i++) {
+    bt_shell_printf("    %-12s %10u %10u\n",
+                    lanes[i], s->lanes[i].sent, s->lanes[i].deferred);
   }
 }
@@ -6,8 +6,10 @@
  ************************************************************************/
 
 /* Includes *********************************************************** */
+#define LOG_MODULE log_mod_hal
 #include <stdlib.h>
 #include <errno.h>
+#include <unistd.h>
 
 #include "bg_uart_cbs.h"
 #include "logging.h"
@@ -15,13 +17,17 @@
 #include "uart.h"
 #include "socket_handler.h"
 #include "startup.h"
+#include "bgapi_cap.h"
+#include "lat_hist.h"
 
 /* Defines  *********************************************************** */
 
 /* Global Variables *************************************************** */
 
 /* Static Variables *************************************************** */
-static bguart_t bguart = { NULL, NULL, NULL };
+static bguart_t bguart = { NULL, NULL, NULL, NULL };
+/* Transport under the capture */
+static bguart_t lower = { NULL, NULL, NULL, NULL };
 
 /* Static Functions Declaractions ************************************* */
 static void on_message_send(uint32_t msg_len, uint8_t* msg_data)
@@ -36,21 +42,84 @@ static void on_message_send(uint32_t msg_len, uint8_t* msg_data)
   }
 }
 
+static void cap_output(uint32_t msg_len, uint8_t* msg_data)
+{
+  bgapi_cap_tx(msg_len, msg_data);
+  lower.bglib_output(msg_len, msg_data);
+}
+
+static int32_t cap_input(uint32_t msg_len, uint8_t* msg_data)
+{
+  int32_t ret = lower.bglib_input(msg_len, msg_data);
+  if (ret >= 0) {
+    bgapi_cap_rx(msg_len, msg_data);
+  }
+  return ret;
+}
+
+static int32_t sock_wait(int32_t timeout_ms)
+{
+  int32_t n = messagePeek();
+
+  /* poll_update takes 0 as forever */
+  if (n || timeout_ms <= 0) {
+    return n;
+  }
+  poll_update(timeout_ms);
+  return messagePeek();
+}
+
+/* The replay has no descriptor to wait on */
+static int32_t replay_wait(int32_t timeout_ms)
+{
+  uint64_t end = lat_now_us() + (uint64_t)timeout_ms * 1000;
+  int32_t n;
+
+  while (0 == (n = bgapi_replay_peek()) && lat_now_us() < end) {
+    usleep(500);
+  }
+  return n;
+}
+
 void bguart_init(void)
 {
+  err_t e;
   const proj_args_t *arg = getprojargs();
   if (!arg->initialized) {
     return;
   }
 
+  if (arg->replay[0]) {
+    if (ec_success != (e = bgapi_replay_open(arg->replay, arg->replay_speed))) {
+      elog(e);
+      exit(EXIT_FAILURE);
+    }
+    bguart.bglib_input = bgapi_replay_input;
+    bguart.bglib_output = bgapi_replay_output;
+    bguart.bglib_peek = bgapi_replay_peek;
+    bguart.bglib_wait = replay_wait;
+    return;
+  }
+
   if (arg->enc) {
-    bguart.bglib_input = onMessageReceive;
-    bguart.bglib_output = onMessageSend;
-    bguart.bglib_peek = messagePeek;
+    lower.bglib_input = onMessageReceive;
+    lower.bglib_output = onMessageSend;
+    lower.bglib_peek = messagePeek;
+    lower.bglib_wait = sock_wait;
   } else {
-    bguart.bglib_input = uartRx;
-    bguart.bglib_output = on_message_send;
-    bguart.bglib_peek = uartRxPeek;
+    lower.bglib_input = uartRx;
+    lower.bglib_output = on_message_send;
+    lower.bglib_peek = uartRxPeek;
+    lower.bglib_wait = uartRxWait;
+  }
+  /* The frames are captured in plain text, above the encryption */
+  bguart.bglib_input = cap_input;
+  bguart.bglib_output = cap_output;
+  bguart.bglib_peek = lower.bglib_peek;
+  bguart.bglib_wait = lower.bglib_wait;
+
+  if (arg->capture[0] && ec_success != (e = bgapi_cap_start(arg->capture))) {
+    elog(e);
   }
 }
 
@@ -19,6 +19,8 @@ typedef struct {
   void (*bglib_output)(uint32_t len1, uint8_t * data1);
   int32_t (*bglib_input)(uint32_t len1, uint8_t* data1);
   int32_t (*bglib_peek)(void);
+  /* Wait up to the ms for input, returns the bytes to read, 0 on timeout */
+  int32_t (*bglib_wait)(int32_t timeout_ms);
   /* char *ser_sockpath; */
   /* char *client_sockpath; */
 }bguart_t;
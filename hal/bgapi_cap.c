@@ -0,0 +1,356 @@
+/*************************************************************************
+    > File Name: bgapi_cap.c
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Capture and replay of the raw BGAPI frames
+ ************************************************************************/
+
+/* Includes *********************************************************** */
+#define LOG_MODULE log_mod_hal
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <unistd.h>
+
+#include "bgapi_cap.h"
+#include "host_gecko.h"
+#include "lat_hist.h"
+#include "logging.h"
+#include "utils.h"
+
+/* Defines  *********************************************************** */
+#define FILE_HDR_LEN  16
+#define REC_HDR_LEN   24
+#define FLAG_RX       0x01
+#define FRAME_MAX     (BGLIB_MSG_HEADER_LEN + BGLIB_MSG_MAX_PAYLOAD)
+
+/* Longest sleep while waiting a frame, bounds the latency of the CLI */
+#define REPLAY_MAX_WAIT_US  (100 * 1000)
+
+typedef struct {
+  uint32_t len;
+  uint32_t flags;
+  uint64_t ts;
+  const uint8_t *data;
+}cap_rec_t;
+
+/* Global Variables *************************************************** */
+
+/* Static Variables *************************************************** */
+static struct {
+  FILE *fp;
+  uint64_t t0;
+  uint64_t flushed;
+  uint32_t frames;
+  /* Frame being rebuilt from the reads of bglib */
+  uint32_t rx_len;
+  uint8_t rx[FRAME_MAX];
+} cap = { 0 };
+
+static struct {
+  uint8_t *buf;
+  size_t size;
+  size_t offs;
+  double speed;
+  /* Read position in the current frame */
+  uint32_t rd;
+  /* Capture time and local time of the last sent frame */
+  uint64_t base_ts;
+  uint64_t base_us;
+  uint64_t start_us;
+  uint32_t frames;
+  uint32_t diverged;
+  bool done;
+} rp = { 0 };
+
+/* Static Functions Declaractions ************************************* */
+static void put_be32(uint8_t *p, uint32_t v)
+{
+  p[0] = v >> 24;
+  p[1] = v >> 16;
+  p[2] = v >> 8;
+  p[3] = v;
+}
+
+static uint32_t get_be32(const uint8_t *p)
+{
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16)
+         | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static void cap_write(uint32_t flags, uint32_t len, const uint8_t *data)
+{
+  uint8_t hdr[REC_HDR_LEN];
+  uint64_t now = lat_now_us(), ts = now - cap.t0;
+
+  put_be32(hdr, len);
+  put_be32(hdr + 4, len);
+  put_be32(hdr + 8, flags);
+  put_be32(hdr + 12, 0);
+  put_be32(hdr + 16, ts >> 32);
+  put_be32(hdr + 20, ts);
+  fwrite(hdr, REC_HDR_LEN, 1, cap.fp);
+  fwrite(data, len, 1, cap.fp);
+  cap.frames++;
+
+  if (now - cap.flushed >= BGAPI_CAP_FLUSH_MS * 1000) {
+    fflush(cap.fp);
+    cap.flushed = now;
+  }
+}
+
+err_t bgapi_cap_start(const char *path)
+{
+  uint8_t hdr[FILE_HDR_LEN] = "btsnoop";
+
+  bgapi_cap_stop();
+  cap.fp = fopen(path, "wb");
+  if (!cap.fp) {
+    return err(ec_file_ope);
+  }
+  put_be32(hdr + 8, 1);
+  put_be32(hdr + 12, BGAPI_CAP_DATALINK);
+  fwrite(hdr, FILE_HDR_LEN, 1, cap.fp);
+  cap.t0 = cap.flushed = lat_now_us();
+  cap.frames = 0;
+  cap.rx_len = 0;
+  LOGM("Capturing BGAPI frames to %s\n", path);
+  return ec_success;
+}
+
+void bgapi_cap_stop(void)
+{
+  if (!cap.fp) {
+    return;
+  }
+  fclose(cap.fp);
+  cap.fp = NULL;
+  LOGM("BGAPI capture stopped, %u frames\n", cap.frames);
+}
+
+void bgapi_cap_tx(uint32_t len, const uint8_t *data)
+{
+  if (cap.fp) {
+    cap_write(0, len, data);
+  }
+}
+
+/*
+ * bglib drops a byte which is not a valid start of frame and a header with too
+ * long a length, keep them as frames of their own so the replay gives the same
+ * bytes.
+ */
+static uint32_t rx_want(void)
+{
+  uint32_t plen;
+
+  if (cap.rx_len == 0) {
+    return 1;
+  } else if (cap.rx_len == 1 && (cap.rx[0] & 0x78) != gecko_dev_type_gecko) {
+    return 1;
+  } else if (cap.rx_len < BGLIB_MSG_HEADER_LEN) {
+    return BGLIB_MSG_HEADER_LEN;
+  }
+  plen = BGLIB_MSG_LEN(cap.rx[0] | (cap.rx[1] << 8));
+  return plen > BGLIB_MSG_MAX_PAYLOAD ? BGLIB_MSG_HEADER_LEN
+         : BGLIB_MSG_HEADER_LEN + plen;
+}
+
+void bgapi_cap_rx(uint32_t len, const uint8_t *data)
+{
+  uint32_t n;
+
+  if (!cap.fp) {
+    return;
+  }
+  while (len) {
+    n = rx_want() - cap.rx_len;
+    n = n < len ? n : len;
+    memcpy(cap.rx + cap.rx_len, data, n);
+    cap.rx_len += n;
+    data += n;
+    len -= n;
+    if (cap.rx_len == rx_want()) {
+      cap_write(FLAG_RX, cap.rx_len, cap.rx);
+      cap.rx_len = 0;
+    }
+  }
+}
+
+/**
+ * @defgroup replay
+ * @{ */
+static bool rec_at(size_t offs, cap_rec_t *r)
+{
+  if (offs + REC_HDR_LEN > rp.size) {
+    return false;
+  }
+  r->len = get_be32(rp.buf + offs + 4);
+  r->flags = get_be32(rp.buf + offs + 8);
+  r->ts = ((uint64_t)get_be32(rp.buf + offs + 16) << 32)
+          | get_be32(rp.buf + offs + 20);
+  r->data = rp.buf + offs + REC_HDR_LEN;
+  return offs + REC_HDR_LEN + r->len <= rp.size;
+}
+
+static void rec_next(const cap_rec_t *r)
+{
+  rp.offs += REC_HDR_LEN + r->len;
+  rp.rd = 0;
+  rp.frames++;
+}
+
+static void replay_end(void)
+{
+  if (rp.done) {
+    return;
+  }
+  rp.done = true;
+  LOGM("BGAPI replay finished - %u frames in %llu ms, %u diverged\n",
+       rp.frames,
+       (unsigned long long)(lat_now_us() - rp.start_us) / 1000,
+       rp.diverged);
+}
+
+/*
+ * Microseconds before the frame is due, 0 if it's due now
+ */
+static uint64_t rec_wait(const cap_rec_t *r)
+{
+  uint64_t due, now;
+
+  if (rp.speed <= 0 || r->ts <= rp.base_ts) {
+    return 0;
+  }
+  due = rp.base_us + (uint64_t)((r->ts - rp.base_ts) / rp.speed);
+  now = lat_now_us();
+  return due > now ? due - now : 0;
+}
+
+err_t bgapi_replay_open(const char *path, double speed)
+{
+  FILE *fp;
+  long size;
+  err_t e;
+
+  fp = fopen(path, "rb");
+  if (!fp) {
+    return err(ec_file_ope);
+  }
+  fseek(fp, 0, SEEK_END);
+  size = ftell(fp);
+  rewind(fp);
+  if (size < FILE_HDR_LEN) {
+    fclose(fp);
+    return err(ec_format);
+  }
+  free(rp.buf);
+  memset(&rp, 0, sizeof(rp));
+  rp.buf = malloc(size);
+  if (!rp.buf) {
+    fclose(fp);
+    return err(ec_length_leak);
+  }
+  if (1 != fread(rp.buf, size, 1, fp)) {
+    fclose(fp);
+    e = err(ec_file_ope);
+    goto fail;
+  }
+  fclose(fp);
+
+  if (memcmp(rp.buf, "btsnoop", 8)
+      || get_be32(rp.buf + 12) != BGAPI_CAP_DATALINK) {
+    e = err(ec_format);
+    goto fail;
+  }
+  rp.size = size;
+  rp.offs = FILE_HDR_LEN;
+  rp.speed = speed;
+  rp.start_us = rp.base_us = lat_now_us();
+  LOGM("Replaying BGAPI frames from %s, speed %g\n", path, speed);
+  return ec_success;
+
+  fail:
+  free(rp.buf);
+  rp.buf = NULL;
+  return e;
+}
+
+void bgapi_replay_output(uint32_t len, uint8_t *data)
+{
+  cap_rec_t r;
+
+  if (!rec_at(rp.offs, &r)) {
+    replay_end();
+    return;
+  }
+  if (r.flags & FLAG_RX) {
+    /* Sending something not captured, the frames of the NCP target are
+     * released as if it's not sent */
+    rp.diverged++;
+    LOGW("Replay diverged - frame %u expected from the NCP target\n",
+         rp.frames);
+    return;
+  }
+  if (r.len != len || memcmp(r.data, data, len)) {
+    rp.diverged++;
+    LOGW("Replay diverged - frame %u sent differs from the capture\n",
+         rp.frames);
+  }
+  rp.base_ts = r.ts;
+  rp.base_us = lat_now_us();
+  rec_next(&r);
+}
+
+int32_t bgapi_replay_peek(void)
+{
+  cap_rec_t r;
+
+  if (!rec_at(rp.offs, &r)) {
+    replay_end();
+    return 0;
+  }
+  if (!(r.flags & FLAG_RX) || rec_wait(&r)) {
+    return 0;
+  }
+  return r.len - rp.rd;
+}
+
+int32_t bgapi_replay_input(uint32_t len, uint8_t *data)
+{
+  cap_rec_t r;
+  uint32_t n, done = 0;
+  uint64_t w;
+
+  while (done < len) {
+    if (!rec_at(rp.offs, &r)) {
+      replay_end();
+      usleep(REPLAY_MAX_WAIT_US);
+      return -1;
+    }
+    if (!(r.flags & FLAG_RX)) {
+      /*
+       * bglib waits for a frame while the capture expects a frame sent,
+       * it's the same as the NCP target not responding
+       */
+      usleep(REPLAY_MAX_WAIT_US);
+      return -1;
+    }
+    w = rec_wait(&r);
+    if (w) {
+      usleep(w < REPLAY_MAX_WAIT_US ? w : REPLAY_MAX_WAIT_US);
+      continue;
+    }
+    n = r.len - rp.rd;
+    n = n < len - done ? n : len - done;
+    memcpy(data + done, r.data + rp.rd, n);
+    rp.rd += n;
+    done += n;
+    if (rp.rd == r.len) {
+      rec_next(&r);
+    }
+  }
+  return len;
+}
+/**  @} */
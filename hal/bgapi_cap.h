@@ -0,0 +1,83 @@
+/*************************************************************************
+    > File Name: bgapi_cap.h
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Capture and replay of the raw BGAPI frames
+ ************************************************************************/
+
+#ifndef BGAPI_CAP_H
+#define BGAPI_CAP_H
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+#include <stdint.h>
+#include "err.h"
+
+/*
+ * The file format follows btsnoop, all the fields are big endian.
+ *
+ * File header, 16 bytes
+ *   - "btsnoop\0"
+ *   - version, 1
+ *   - datalink, BGAPI_CAP_DATALINK
+ *
+ * Record header, 24 bytes, followed by the frame
+ *   - original length
+ *   - included length, same as the original length
+ *   - flags, bit 0 set if the frame is received from the NCP target
+ *   - dropped records, always 0
+ *   - timestamp in microseconds since the capture started, which differs from
+ *     btsnoop, it's monotonic and not related to the wall time
+ */
+#define BGAPI_CAP_DATALINK  2001
+
+/* Data not yet on the disk is flushed if older than it */
+#define BGAPI_CAP_FLUSH_MS  100
+
+/**
+ * @brief bgapi_cap_start - start capturing the frames to a file, the file is
+ * truncated if it exists
+ *
+ * @param path - file to write
+ *
+ * @return @ref{err_t}
+ */
+err_t bgapi_cap_start(const char *path);
+void bgapi_cap_stop(void);
+
+/**
+ * @brief bgapi_cap_tx - capture a frame sent to the NCP target
+ */
+void bgapi_cap_tx(uint32_t len, const uint8_t *data);
+
+/**
+ * @brief bgapi_cap_rx - capture the data read from the NCP target, the frames
+ * are rebuilt from the partial reads of bglib
+ */
+void bgapi_cap_rx(uint32_t len, const uint8_t *data);
+
+/**
+ * @brief bgapi_replay_open - load a capture to feed back to bglib
+ *
+ * @param path - capture file
+ * @param speed - 1 for the original timing, N for N times faster, 0 for no
+ * delay at all
+ *
+ * @return @ref{err_t}
+ */
+err_t bgapi_replay_open(const char *path, double speed);
+
+/*
+ * Transport of bglib in the replay mode. The frames sent by bglib are matched
+ * against the captured ones and restart the clock, the received frames are
+ * released when they are due relative to the last sent frame.
+ */
+void bgapi_replay_output(uint32_t len, uint8_t *data);
+int32_t bgapi_replay_input(uint32_t len, uint8_t *data);
+int32_t bgapi_replay_peek(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif //BGAPI_CAP_H
@@ -0,0 +1,608 @@
+/* Generated by tools/bgapi_names_gen.py, do not edit */
+#include "host_gecko.h"
+#include "utils.h"
+#include "bgapi_names.h"
+
+const bgapi_name_t bgapi_cmd_names[] = {
+  { gecko_cmd_dfu_reset_id, "dfu_reset" },
+  { gecko_cmd_dfu_flash_set_address_id, "dfu_flash_set_address" },
+  { gecko_cmd_dfu_flash_upload_id, "dfu_flash_upload" },
+  { gecko_cmd_dfu_flash_upload_finish_id, "dfu_flash_upload_finish" },
+  { gecko_cmd_system_hello_id, "system_hello" },
+  { gecko_cmd_system_reset_id, "system_reset" },
+  { gecko_cmd_system_get_bt_address_id, "system_get_bt_address" },
+  { gecko_cmd_system_set_bt_address_id, "system_set_bt_address" },
+  { gecko_cmd_system_set_tx_power_id, "system_set_tx_power" },
+  { gecko_cmd_system_get_random_data_id, "system_get_random_data" },
+  { gecko_cmd_system_halt_id, "system_halt" },
+  { gecko_cmd_system_set_device_name_id, "system_set_device_name" },
+  { gecko_cmd_system_linklayer_configure_id, "system_linklayer_configure" },
+  { gecko_cmd_system_get_counters_id, "system_get_counters" },
+  { gecko_cmd_system_data_buffer_write_id, "system_data_buffer_write" },
+  { gecko_cmd_system_set_identity_address_id, "system_set_identity_address" },
+  { gecko_cmd_system_data_buffer_clear_id, "system_data_buffer_clear" },
+  { gecko_cmd_le_gap_open_id, "le_gap_open" },
+  { gecko_cmd_le_gap_set_mode_id, "le_gap_set_mode" },
+  { gecko_cmd_le_gap_discover_id, "le_gap_discover" },
+  { gecko_cmd_le_gap_end_procedure_id, "le_gap_end_procedure" },
+  { gecko_cmd_le_gap_set_adv_parameters_id, "le_gap_set_adv_parameters" },
+  { gecko_cmd_le_gap_set_conn_parameters_id, "le_gap_set_conn_parameters" },
+  { gecko_cmd_le_gap_set_scan_parameters_id, "le_gap_set_scan_parameters" },
+  { gecko_cmd_le_gap_set_adv_data_id, "le_gap_set_adv_data" },
+  { gecko_cmd_le_gap_set_adv_timeout_id, "le_gap_set_adv_timeout" },
+  { gecko_cmd_le_gap_set_conn_phy_id, "le_gap_set_conn_phy" },
+  { gecko_cmd_le_gap_bt5_set_mode_id, "le_gap_bt5_set_mode" },
+  { gecko_cmd_le_gap_bt5_set_adv_parameters_id, "le_gap_bt5_set_adv_parameters" },
+  { gecko_cmd_le_gap_bt5_set_adv_data_id, "le_gap_bt5_set_adv_data" },
+  { gecko_cmd_le_gap_set_privacy_mode_id, "le_gap_set_privacy_mode" },
+  { gecko_cmd_le_gap_set_advertise_timing_id, "le_gap_set_advertise_timing" },
+  { gecko_cmd_le_gap_set_advertise_channel_map_id, "le_gap_set_advertise_channel_map" },
+  { gecko_cmd_le_gap_set_advertise_report_scan_request_id, "le_gap_set_advertise_report_scan_request" },
+  { gecko_cmd_le_gap_set_advertise_phy_id, "le_gap_set_advertise_phy" },
+  { gecko_cmd_le_gap_set_advertise_configuration_id, "le_gap_set_advertise_configuration" },
+  { gecko_cmd_le_gap_clear_advertise_configuration_id, "le_gap_clear_advertise_configuration" },
+  { gecko_cmd_le_gap_start_advertising_id, "le_gap_start_advertising" },
+  { gecko_cmd_le_gap_stop_advertising_id, "le_gap_stop_advertising" },
+  { gecko_cmd_le_gap_set_discovery_timing_id, "le_gap_set_discovery_timing" },
+  { gecko_cmd_le_gap_set_discovery_type_id, "le_gap_set_discovery_type" },
+  { gecko_cmd_le_gap_start_discovery_id, "le_gap_start_discovery" },
+  { gecko_cmd_le_gap_set_data_channel_classification_id, "le_gap_set_data_channel_classification" },
+  { gecko_cmd_le_gap_connect_id, "le_gap_connect" },
+  { gecko_cmd_le_gap_set_advertise_tx_power_id, "le_gap_set_advertise_tx_power" },
+  { gecko_cmd_le_gap_set_discovery_extended_scan_response_id, "le_gap_set_discovery_extended_scan_response" },
+  { gecko_cmd_le_gap_start_periodic_advertising_id, "le_gap_start_periodic_advertising" },
+  { gecko_cmd_le_gap_stop_periodic_advertising_id, "le_gap_stop_periodic_advertising" },
+  { gecko_cmd_le_gap_set_long_advertising_data_id, "le_gap_set_long_advertising_data" },
+  { gecko_cmd_le_gap_enable_whitelisting_id, "le_gap_enable_whitelisting" },
+  { gecko_cmd_le_gap_set_conn_timing_parameters_id, "le_gap_set_conn_timing_parameters" },
+  { gecko_cmd_sync_open_id, "sync_open" },
+  { gecko_cmd_sync_close_id, "sync_close" },
+  { gecko_cmd_le_connection_set_parameters_id, "le_connection_set_parameters" },
+  { gecko_cmd_le_connection_get_rssi_id, "le_connection_get_rssi" },
+  { gecko_cmd_le_connection_disable_slave_latency_id, "le_connection_disable_slave_latency" },
+  { gecko_cmd_le_connection_set_phy_id, "le_connection_set_phy" },
+  { gecko_cmd_le_connection_close_id, "le_connection_close" },
+  { gecko_cmd_le_connection_set_timing_parameters_id, "le_connection_set_timing_parameters" },
+  { gecko_cmd_le_connection_read_channel_map_id, "le_connection_read_channel_map" },
+  { gecko_cmd_le_connection_set_preferred_phy_id, "le_connection_set_preferred_phy" },
+  { gecko_cmd_gatt_set_max_mtu_id, "gatt_set_max_mtu" },
+  { gecko_cmd_gatt_discover_primary_services_id, "gatt_discover_primary_services" },
+  { gecko_cmd_gatt_discover_primary_services_by_uuid_id, "gatt_discover_primary_services_by_uuid" },
+  { gecko_cmd_gatt_discover_characteristics_id, "gatt_discover_characteristics" },
+  { gecko_cmd_gatt_discover_characteristics_by_uuid_id, "gatt_discover_characteristics_by_uuid" },
+  { gecko_cmd_gatt_set_characteristic_notification_id, "gatt_set_characteristic_notification" },
+  { gecko_cmd_gatt_discover_descriptors_id, "gatt_discover_descriptors" },
+  { gecko_cmd_gatt_read_characteristic_value_id, "gatt_read_characteristic_value" },
+  { gecko_cmd_gatt_read_characteristic_value_by_uuid_id, "gatt_read_characteristic_value_by_uuid" },
+  { gecko_cmd_gatt_write_characteristic_value_id, "gatt_write_characteristic_value" },
+  { gecko_cmd_gatt_write_characteristic_value_without_response_id, "gatt_write_characteristic_value_without_response" },
+  { gecko_cmd_gatt_prepare_characteristic_value_write_id, "gatt_prepare_characteristic_value_write" },
+  { gecko_cmd_gatt_execute_characteristic_value_write_id, "gatt_execute_characteristic_value_write" },
+  { gecko_cmd_gatt_send_characteristic_confirmation_id, "gatt_send_characteristic_confirmation" },
+  { gecko_cmd_gatt_read_descriptor_value_id, "gatt_read_descriptor_value" },
+  { gecko_cmd_gatt_write_descriptor_value_id, "gatt_write_descriptor_value" },
+  { gecko_cmd_gatt_find_included_services_id, "gatt_find_included_services" },
+  { gecko_cmd_gatt_read_multiple_characteristic_values_id, "gatt_read_multiple_characteristic_values" },
+  { gecko_cmd_gatt_read_characteristic_value_from_offset_id, "gatt_read_characteristic_value_from_offset" },
+  { gecko_cmd_gatt_prepare_characteristic_value_reliable_write_id, "gatt_prepare_characteristic_value_reliable_write" },
+  { gecko_cmd_gatt_server_read_attribute_value_id, "gatt_server_read_attribute_value" },
+  { gecko_cmd_gatt_server_read_attribute_type_id, "gatt_server_read_attribute_type" },
+  { gecko_cmd_gatt_server_write_attribute_value_id, "gatt_server_write_attribute_value" },
+  { gecko_cmd_gatt_server_send_user_read_response_id, "gatt_server_send_user_read_response" },
+  { gecko_cmd_gatt_server_send_user_write_response_id, "gatt_server_send_user_write_response" },
+  { gecko_cmd_gatt_server_send_characteristic_notification_id, "gatt_server_send_characteristic_notification" },
+  { gecko_cmd_gatt_server_find_attribute_id, "gatt_server_find_attribute" },
+  { gecko_cmd_gatt_server_set_capabilities_id, "gatt_server_set_capabilities" },
+  { gecko_cmd_gatt_server_set_max_mtu_id, "gatt_server_set_max_mtu" },
+  { gecko_cmd_gatt_server_get_mtu_id, "gatt_server_get_mtu" },
+  { gecko_cmd_hardware_set_soft_timer_id, "hardware_set_soft_timer" },
+  { gecko_cmd_hardware_get_time_id, "hardware_get_time" },
+  { gecko_cmd_hardware_set_lazy_soft_timer_id, "hardware_set_lazy_soft_timer" },
+  { gecko_cmd_flash_ps_erase_all_id, "flash_ps_erase_all" },
+  { gecko_cmd_flash_ps_save_id, "flash_ps_save" },
+  { gecko_cmd_flash_ps_load_id, "flash_ps_load" },
+  { gecko_cmd_flash_ps_erase_id, "flash_ps_erase" },
+  { gecko_cmd_test_dtm_tx_id, "test_dtm_tx" },
+  { gecko_cmd_test_dtm_rx_id, "test_dtm_rx" },
+  { gecko_cmd_test_dtm_end_id, "test_dtm_end" },
+  { gecko_cmd_sm_set_bondable_mode_id, "sm_set_bondable_mode" },
+  { gecko_cmd_sm_configure_id, "sm_configure" },
+  { gecko_cmd_sm_store_bonding_configuration_id, "sm_store_bonding_configuration" },
+  { gecko_cmd_sm_increase_security_id, "sm_increase_security" },
+  { gecko_cmd_sm_delete_bonding_id, "sm_delete_bonding" },
+  { gecko_cmd_sm_delete_bondings_id, "sm_delete_bondings" },
+  { gecko_cmd_sm_enter_passkey_id, "sm_enter_passkey" },
+  { gecko_cmd_sm_passkey_confirm_id, "sm_passkey_confirm" },
+  { gecko_cmd_sm_set_oob_data_id, "sm_set_oob_data" },
+  { gecko_cmd_sm_list_all_bondings_id, "sm_list_all_bondings" },
+  { gecko_cmd_sm_bonding_confirm_id, "sm_bonding_confirm" },
+  { gecko_cmd_sm_set_debug_mode_id, "sm_set_debug_mode" },
+  { gecko_cmd_sm_set_passkey_id, "sm_set_passkey" },
+  { gecko_cmd_sm_use_sc_oob_id, "sm_use_sc_oob" },
+  { gecko_cmd_sm_set_sc_remote_oob_data_id, "sm_set_sc_remote_oob_data" },
+  { gecko_cmd_sm_add_to_whitelist_id, "sm_add_to_whitelist" },
+  { gecko_cmd_sm_set_minimum_key_size_id, "sm_set_minimum_key_size" },
+  { gecko_cmd_homekit_configure_id, "homekit_configure" },
+  { gecko_cmd_homekit_advertise_id, "homekit_advertise" },
+  { gecko_cmd_homekit_delete_pairings_id, "homekit_delete_pairings" },
+  { gecko_cmd_homekit_check_authcp_id, "homekit_check_authcp" },
+  { gecko_cmd_homekit_get_pairing_id_id, "homekit_get_pairing_id" },
+  { gecko_cmd_homekit_send_write_response_id, "homekit_send_write_response" },
+  { gecko_cmd_homekit_send_read_response_id, "homekit_send_read_response" },
+  { gecko_cmd_homekit_gsn_action_id, "homekit_gsn_action" },
+  { gecko_cmd_homekit_event_notification_id, "homekit_event_notification" },
+  { gecko_cmd_homekit_broadcast_action_id, "homekit_broadcast_action" },
+  { gecko_cmd_mesh_node_init_id, "mesh_node_init" },
+  { gecko_cmd_mesh_node_start_unprov_beaconing_id, "mesh_node_start_unprov_beaconing" },
+  { gecko_cmd_mesh_node_stop_unprov_beaconing_id, "mesh_node_stop_unprov_beaconing" },
+  { gecko_cmd_mesh_node_rssi_id, "mesh_node_rssi" },
+  { gecko_cmd_mesh_node_input_oob_request_rsp_id, "mesh_node_input_oob_request_rsp" },
+  { gecko_cmd_mesh_node_get_uuid_id, "mesh_node_get_uuid" },
+  { gecko_cmd_mesh_node_set_provisioning_data_id, "mesh_node_set_provisioning_data" },
+  { gecko_cmd_mesh_node_init_oob_id, "mesh_node_init_oob" },
+  { gecko_cmd_mesh_node_set_ivrecovery_mode_id, "mesh_node_set_ivrecovery_mode" },
+  { gecko_cmd_mesh_node_get_ivrecovery_mode_id, "mesh_node_get_ivrecovery_mode" },
+  { gecko_cmd_mesh_node_set_adv_event_filter_id, "mesh_node_set_adv_event_filter" },
+  { gecko_cmd_mesh_node_get_statistics_id, "mesh_node_get_statistics" },
+  { gecko_cmd_mesh_node_clear_statistics_id, "mesh_node_clear_statistics" },
+  { gecko_cmd_mesh_node_set_net_relay_delay_id, "mesh_node_set_net_relay_delay" },
+  { gecko_cmd_mesh_node_get_net_relay_delay_id, "mesh_node_get_net_relay_delay" },
+  { gecko_cmd_mesh_node_get_ivupdate_state_id, "mesh_node_get_ivupdate_state" },
+  { gecko_cmd_mesh_node_request_ivupdate_id, "mesh_node_request_ivupdate" },
+  { gecko_cmd_mesh_node_get_seq_remaining_id, "mesh_node_get_seq_remaining" },
+  { gecko_cmd_mesh_node_save_replay_protection_list_id, "mesh_node_save_replay_protection_list" },
+  { gecko_cmd_mesh_node_set_uuid_id, "mesh_node_set_uuid" },
+  { gecko_cmd_mesh_node_get_element_address_id, "mesh_node_get_element_address" },
+  { gecko_cmd_mesh_node_static_oob_request_rsp_id, "mesh_node_static_oob_request_rsp" },
+  { gecko_cmd_mesh_node_reset_id, "mesh_node_reset" },
+  { gecko_cmd_mesh_node_set_beacon_reporting_id, "mesh_node_set_beacon_reporting" },
+  { gecko_cmd_mesh_prov_init_id, "mesh_prov_init" },
+  { gecko_cmd_mesh_prov_scan_unprov_beacons_id, "mesh_prov_scan_unprov_beacons" },
+  { gecko_cmd_mesh_prov_provision_device_id, "mesh_prov_provision_device" },
+  { gecko_cmd_mesh_prov_create_network_id, "mesh_prov_create_network" },
+  { gecko_cmd_mesh_prov_get_dcd_id, "mesh_prov_get_dcd" },
+  { gecko_cmd_mesh_prov_get_config_id, "mesh_prov_get_config" },
+  { gecko_cmd_mesh_prov_set_config_id, "mesh_prov_set_config" },
+  { gecko_cmd_mesh_prov_create_appkey_id, "mesh_prov_create_appkey" },
+  { gecko_cmd_mesh_prov_oob_pkey_rsp_id, "mesh_prov_oob_pkey_rsp" },
+  { gecko_cmd_mesh_prov_oob_auth_rsp_id, "mesh_prov_oob_auth_rsp" },
+  { gecko_cmd_mesh_prov_set_oob_requirements_id, "mesh_prov_set_oob_requirements" },
+  { gecko_cmd_mesh_prov_key_refresh_start_id, "mesh_prov_key_refresh_start" },
+  { gecko_cmd_mesh_prov_get_key_refresh_blacklist_id, "mesh_prov_get_key_refresh_blacklist" },
+  { gecko_cmd_mesh_prov_set_key_refresh_blacklist_id, "mesh_prov_set_key_refresh_blacklist" },
+  { gecko_cmd_mesh_prov_appkey_add_id, "mesh_prov_appkey_add" },
+  { gecko_cmd_mesh_prov_appkey_delete_id, "mesh_prov_appkey_delete" },
+  { gecko_cmd_mesh_prov_model_app_bind_id, "mesh_prov_model_app_bind" },
+  { gecko_cmd_mesh_prov_model_app_unbind_id, "mesh_prov_model_app_unbind" },
+  { gecko_cmd_mesh_prov_model_app_get_id, "mesh_prov_model_app_get" },
+  { gecko_cmd_mesh_prov_model_sub_add_id, "mesh_prov_model_sub_add" },
+  { gecko_cmd_mesh_prov_model_pub_set_id, "mesh_prov_model_pub_set" },
+  { gecko_cmd_mesh_prov_provision_gatt_device_id, "mesh_prov_provision_gatt_device" },
+  { gecko_cmd_mesh_prov_ddb_get_id, "mesh_prov_ddb_get" },
+  { gecko_cmd_mesh_prov_ddb_delete_id, "mesh_prov_ddb_delete" },
+  { gecko_cmd_mesh_prov_ddb_add_id, "mesh_prov_ddb_add" },
+  { gecko_cmd_mesh_prov_ddb_list_devices_id, "mesh_prov_ddb_list_devices" },
+  { gecko_cmd_mesh_prov_network_add_id, "mesh_prov_network_add" },
+  { gecko_cmd_mesh_prov_network_delete_id, "mesh_prov_network_delete" },
+  { gecko_cmd_mesh_prov_nettx_get_id, "mesh_prov_nettx_get" },
+  { gecko_cmd_mesh_prov_nettx_set_id, "mesh_prov_nettx_set" },
+  { gecko_cmd_mesh_prov_model_sub_del_id, "mesh_prov_model_sub_del" },
+  { gecko_cmd_mesh_prov_model_sub_add_va_id, "mesh_prov_model_sub_add_va" },
+  { gecko_cmd_mesh_prov_model_sub_del_va_id, "mesh_prov_model_sub_del_va" },
+  { gecko_cmd_mesh_prov_model_sub_set_id, "mesh_prov_model_sub_set" },
+  { gecko_cmd_mesh_prov_model_sub_set_va_id, "mesh_prov_model_sub_set_va" },
+  { gecko_cmd_mesh_prov_heartbeat_publication_get_id, "mesh_prov_heartbeat_publication_get" },
+  { gecko_cmd_mesh_prov_heartbeat_publication_set_id, "mesh_prov_heartbeat_publication_set" },
+  { gecko_cmd_mesh_prov_heartbeat_subscription_get_id, "mesh_prov_heartbeat_subscription_get" },
+  { gecko_cmd_mesh_prov_heartbeat_subscription_set_id, "mesh_prov_heartbeat_subscription_set" },
+  { gecko_cmd_mesh_prov_relay_get_id, "mesh_prov_relay_get" },
+  { gecko_cmd_mesh_prov_relay_set_id, "mesh_prov_relay_set" },
+  { gecko_cmd_mesh_prov_reset_node_id, "mesh_prov_reset_node" },
+  { gecko_cmd_mesh_prov_appkey_get_id, "mesh_prov_appkey_get" },
+  { gecko_cmd_mesh_prov_network_get_id, "mesh_prov_network_get" },
+  { gecko_cmd_mesh_prov_model_sub_clear_id, "mesh_prov_model_sub_clear" },
+  { gecko_cmd_mesh_prov_model_pub_get_id, "mesh_prov_model_pub_get" },
+  { gecko_cmd_mesh_prov_model_pub_set_va_id, "mesh_prov_model_pub_set_va" },
+  { gecko_cmd_mesh_prov_model_pub_set_cred_id, "mesh_prov_model_pub_set_cred" },
+  { gecko_cmd_mesh_prov_model_pub_set_va_cred_id, "mesh_prov_model_pub_set_va_cred" },
+  { gecko_cmd_mesh_prov_model_sub_get_id, "mesh_prov_model_sub_get" },
+  { gecko_cmd_mesh_prov_friend_timeout_get_id, "mesh_prov_friend_timeout_get" },
+  { gecko_cmd_mesh_prov_get_default_configuration_timeout_id, "mesh_prov_get_default_configuration_timeout" },
+  { gecko_cmd_mesh_prov_set_default_configuration_timeout_id, "mesh_prov_set_default_configuration_timeout" },
+  { gecko_cmd_mesh_prov_provision_device_with_address_id, "mesh_prov_provision_device_with_address" },
+  { gecko_cmd_mesh_prov_provision_gatt_device_with_address_id, "mesh_prov_provision_gatt_device_with_address" },
+  { gecko_cmd_mesh_prov_initialize_network_id, "mesh_prov_initialize_network" },
+  { gecko_cmd_mesh_prov_get_key_refresh_appkey_blacklist_id, "mesh_prov_get_key_refresh_appkey_blacklist" },
+  { gecko_cmd_mesh_prov_set_key_refresh_appkey_blacklist_id, "mesh_prov_set_key_refresh_appkey_blacklist" },
+  { gecko_cmd_mesh_prov_stop_scan_unprov_beacons_id, "mesh_prov_stop_scan_unprov_beacons" },
+  { gecko_cmd_mesh_proxy_connect_id, "mesh_proxy_connect" },
+  { gecko_cmd_mesh_proxy_disconnect_id, "mesh_proxy_disconnect" },
+  { gecko_cmd_mesh_proxy_set_filter_type_id, "mesh_proxy_set_filter_type" },
+  { gecko_cmd_mesh_proxy_allow_id, "mesh_proxy_allow" },
+  { gecko_cmd_mesh_proxy_deny_id, "mesh_proxy_deny" },
+  { gecko_cmd_mesh_vendor_model_send_id, "mesh_vendor_model_send" },
+  { gecko_cmd_mesh_vendor_model_set_publication_id, "mesh_vendor_model_set_publication" },
+  { gecko_cmd_mesh_vendor_model_clear_publication_id, "mesh_vendor_model_clear_publication" },
+  { gecko_cmd_mesh_vendor_model_publish_id, "mesh_vendor_model_publish" },
+  { gecko_cmd_mesh_vendor_model_init_id, "mesh_vendor_model_init" },
+  { gecko_cmd_mesh_vendor_model_deinit_id, "mesh_vendor_model_deinit" },
+  { gecko_cmd_mesh_health_client_get_id, "mesh_health_client_get" },
+  { gecko_cmd_mesh_health_client_clear_id, "mesh_health_client_clear" },
+  { gecko_cmd_mesh_health_client_test_id, "mesh_health_client_test" },
+  { gecko_cmd_mesh_health_client_get_period_id, "mesh_health_client_get_period" },
+  { gecko_cmd_mesh_health_client_set_period_id, "mesh_health_client_set_period" },
+  { gecko_cmd_mesh_health_client_get_attention_id, "mesh_health_client_get_attention" },
+  { gecko_cmd_mesh_health_client_set_attention_id, "mesh_health_client_set_attention" },
+  { gecko_cmd_mesh_health_server_set_fault_id, "mesh_health_server_set_fault" },
+  { gecko_cmd_mesh_health_server_clear_fault_id, "mesh_health_server_clear_fault" },
+  { gecko_cmd_mesh_health_server_test_response_id, "mesh_health_server_test_response" },
+  { gecko_cmd_mesh_generic_client_get_id, "mesh_generic_client_get" },
+  { gecko_cmd_mesh_generic_client_set_id, "mesh_generic_client_set" },
+  { gecko_cmd_mesh_generic_client_publish_id, "mesh_generic_client_publish" },
+  { gecko_cmd_mesh_generic_client_get_params_id, "mesh_generic_client_get_params" },
+  { gecko_cmd_mesh_generic_client_init_id, "mesh_generic_client_init" },
+  { gecko_cmd_mesh_generic_server_response_id, "mesh_generic_server_response" },
+  { gecko_cmd_mesh_generic_server_update_id, "mesh_generic_server_update" },
+  { gecko_cmd_mesh_generic_server_publish_id, "mesh_generic_server_publish" },
+  { gecko_cmd_mesh_generic_server_init_id, "mesh_generic_server_init" },
+  { gecko_cmd_coex_set_options_id, "coex_set_options" },
+  { gecko_cmd_coex_get_counters_id, "coex_get_counters" },
+  { gecko_cmd_coex_set_parameters_id, "coex_set_parameters" },
+  { gecko_cmd_coex_set_directional_priority_pulse_id, "coex_set_directional_priority_pulse" },
+  { gecko_cmd_mesh_test_get_nettx_id, "mesh_test_get_nettx" },
+  { gecko_cmd_mesh_test_set_nettx_id, "mesh_test_set_nettx" },
+  { gecko_cmd_mesh_test_get_relay_id, "mesh_test_get_relay" },
+  { gecko_cmd_mesh_test_set_relay_id, "mesh_test_set_relay" },
+  { gecko_cmd_mesh_test_set_adv_scan_params_id, "mesh_test_set_adv_scan_params" },
+  { gecko_cmd_mesh_test_set_ivupdate_test_mode_id, "mesh_test_set_ivupdate_test_mode" },
+  { gecko_cmd_mesh_test_get_ivupdate_test_mode_id, "mesh_test_get_ivupdate_test_mode" },
+  { gecko_cmd_mesh_test_set_segment_send_delay_id, "mesh_test_set_segment_send_delay" },
+  { gecko_cmd_mesh_test_set_ivupdate_state_id, "mesh_test_set_ivupdate_state" },
+  { gecko_cmd_mesh_test_send_beacons_id, "mesh_test_send_beacons" },
+  { gecko_cmd_mesh_test_bind_local_model_app_id, "mesh_test_bind_local_model_app" },
+  { gecko_cmd_mesh_test_unbind_local_model_app_id, "mesh_test_unbind_local_model_app" },
+  { gecko_cmd_mesh_test_add_local_model_sub_id, "mesh_test_add_local_model_sub" },
+  { gecko_cmd_mesh_test_del_local_model_sub_id, "mesh_test_del_local_model_sub" },
+  { gecko_cmd_mesh_test_add_local_model_sub_va_id, "mesh_test_add_local_model_sub_va" },
+  { gecko_cmd_mesh_test_del_local_model_sub_va_id, "mesh_test_del_local_model_sub_va" },
+  { gecko_cmd_mesh_test_get_local_model_sub_id, "mesh_test_get_local_model_sub" },
+  { gecko_cmd_mesh_test_set_local_model_pub_id, "mesh_test_set_local_model_pub" },
+  { gecko_cmd_mesh_test_set_local_model_pub_va_id, "mesh_test_set_local_model_pub_va" },
+  { gecko_cmd_mesh_test_get_local_model_pub_id, "mesh_test_get_local_model_pub" },
+  { gecko_cmd_mesh_test_set_local_heartbeat_subscription_id, "mesh_test_set_local_heartbeat_subscription" },
+  { gecko_cmd_mesh_test_get_local_heartbeat_subscription_id, "mesh_test_get_local_heartbeat_subscription" },
+  { gecko_cmd_mesh_test_get_local_heartbeat_publication_id, "mesh_test_get_local_heartbeat_publication" },
+  { gecko_cmd_mesh_test_set_local_heartbeat_publication_id, "mesh_test_set_local_heartbeat_publication" },
+  { gecko_cmd_mesh_test_set_local_config_id, "mesh_test_set_local_config" },
+  { gecko_cmd_mesh_test_get_local_config_id, "mesh_test_get_local_config" },
+  { gecko_cmd_mesh_test_add_local_key_id, "mesh_test_add_local_key" },
+  { gecko_cmd_mesh_test_del_local_key_id, "mesh_test_del_local_key" },
+  { gecko_cmd_mesh_test_update_local_key_id, "mesh_test_update_local_key" },
+  { gecko_cmd_mesh_test_set_sar_config_id, "mesh_test_set_sar_config" },
+  { gecko_cmd_mesh_test_get_element_seqnum_id, "mesh_test_get_element_seqnum" },
+  { gecko_cmd_mesh_test_set_adv_bearer_state_id, "mesh_test_set_adv_bearer_state" },
+  { gecko_cmd_mesh_test_get_key_count_id, "mesh_test_get_key_count" },
+  { gecko_cmd_mesh_test_get_key_id, "mesh_test_get_key" },
+  { gecko_cmd_mesh_test_prov_get_device_key_id, "mesh_test_prov_get_device_key" },
+  { gecko_cmd_mesh_test_prov_prepare_key_refresh_id, "mesh_test_prov_prepare_key_refresh" },
+  { gecko_cmd_mesh_test_cancel_segmented_tx_id, "mesh_test_cancel_segmented_tx" },
+  { gecko_cmd_mesh_test_set_iv_index_id, "mesh_test_set_iv_index" },
+  { gecko_cmd_mesh_test_set_element_seqnum_id, "mesh_test_set_element_seqnum" },
+  { gecko_cmd_mesh_test_set_model_option_id, "mesh_test_set_model_option" },
+  { gecko_cmd_mesh_lpn_init_id, "mesh_lpn_init" },
+  { gecko_cmd_mesh_lpn_deinit_id, "mesh_lpn_deinit" },
+  { gecko_cmd_mesh_lpn_configure_id, "mesh_lpn_configure" },
+  { gecko_cmd_mesh_lpn_establish_friendship_id, "mesh_lpn_establish_friendship" },
+  { gecko_cmd_mesh_lpn_poll_id, "mesh_lpn_poll" },
+  { gecko_cmd_mesh_lpn_terminate_friendship_id, "mesh_lpn_terminate_friendship" },
+  { gecko_cmd_mesh_lpn_config_id, "mesh_lpn_config" },
+  { gecko_cmd_mesh_friend_init_id, "mesh_friend_init" },
+  { gecko_cmd_mesh_friend_deinit_id, "mesh_friend_deinit" },
+  { gecko_cmd_mesh_config_client_cancel_request_id, "mesh_config_client_cancel_request" },
+  { gecko_cmd_mesh_config_client_get_request_status_id, "mesh_config_client_get_request_status" },
+  { gecko_cmd_mesh_config_client_get_default_timeout_id, "mesh_config_client_get_default_timeout" },
+  { gecko_cmd_mesh_config_client_set_default_timeout_id, "mesh_config_client_set_default_timeout" },
+  { gecko_cmd_mesh_config_client_add_netkey_id, "mesh_config_client_add_netkey" },
+  { gecko_cmd_mesh_config_client_remove_netkey_id, "mesh_config_client_remove_netkey" },
+  { gecko_cmd_mesh_config_client_list_netkeys_id, "mesh_config_client_list_netkeys" },
+  { gecko_cmd_mesh_config_client_add_appkey_id, "mesh_config_client_add_appkey" },
+  { gecko_cmd_mesh_config_client_remove_appkey_id, "mesh_config_client_remove_appkey" },
+  { gecko_cmd_mesh_config_client_list_appkeys_id, "mesh_config_client_list_appkeys" },
+  { gecko_cmd_mesh_config_client_bind_model_id, "mesh_config_client_bind_model" },
+  { gecko_cmd_mesh_config_client_unbind_model_id, "mesh_config_client_unbind_model" },
+  { gecko_cmd_mesh_config_client_list_bindings_id, "mesh_config_client_list_bindings" },
+  { gecko_cmd_mesh_config_client_get_model_pub_id, "mesh_config_client_get_model_pub" },
+  { gecko_cmd_mesh_config_client_set_model_pub_id, "mesh_config_client_set_model_pub" },
+  { gecko_cmd_mesh_config_client_set_model_pub_va_id, "mesh_config_client_set_model_pub_va" },
+  { gecko_cmd_mesh_config_client_add_model_sub_id, "mesh_config_client_add_model_sub" },
+  { gecko_cmd_mesh_config_client_add_model_sub_va_id, "mesh_config_client_add_model_sub_va" },
+  { gecko_cmd_mesh_config_client_remove_model_sub_id, "mesh_config_client_remove_model_sub" },
+  { gecko_cmd_mesh_config_client_remove_model_sub_va_id, "mesh_config_client_remove_model_sub_va" },
+  { gecko_cmd_mesh_config_client_set_model_sub_id, "mesh_config_client_set_model_sub" },
+  { gecko_cmd_mesh_config_client_set_model_sub_va_id, "mesh_config_client_set_model_sub_va" },
+  { gecko_cmd_mesh_config_client_clear_model_sub_id, "mesh_config_client_clear_model_sub" },
+  { gecko_cmd_mesh_config_client_list_subs_id, "mesh_config_client_list_subs" },
+  { gecko_cmd_mesh_config_client_get_heartbeat_pub_id, "mesh_config_client_get_heartbeat_pub" },
+  { gecko_cmd_mesh_config_client_set_heartbeat_pub_id, "mesh_config_client_set_heartbeat_pub" },
+  { gecko_cmd_mesh_config_client_get_heartbeat_sub_id, "mesh_config_client_get_heartbeat_sub" },
+  { gecko_cmd_mesh_config_client_set_heartbeat_sub_id, "mesh_config_client_set_heartbeat_sub" },
+  { gecko_cmd_mesh_config_client_get_beacon_id, "mesh_config_client_get_beacon" },
+  { gecko_cmd_mesh_config_client_set_beacon_id, "mesh_config_client_set_beacon" },
+  { gecko_cmd_mesh_config_client_get_default_ttl_id, "mesh_config_client_get_default_ttl" },
+  { gecko_cmd_mesh_config_client_set_default_ttl_id, "mesh_config_client_set_default_ttl" },
+  { gecko_cmd_mesh_config_client_get_gatt_proxy_id, "mesh_config_client_get_gatt_proxy" },
+  { gecko_cmd_mesh_config_client_set_gatt_proxy_id, "mesh_config_client_set_gatt_proxy" },
+  { gecko_cmd_mesh_config_client_get_relay_id, "mesh_config_client_get_relay" },
+  { gecko_cmd_mesh_config_client_set_relay_id, "mesh_config_client_set_relay" },
+  { gecko_cmd_mesh_config_client_get_network_transmit_id, "mesh_config_client_get_network_transmit" },
+  { gecko_cmd_mesh_config_client_set_network_transmit_id, "mesh_config_client_set_network_transmit" },
+  { gecko_cmd_mesh_config_client_get_identity_id, "mesh_config_client_get_identity" },
+  { gecko_cmd_mesh_config_client_set_identity_id, "mesh_config_client_set_identity" },
+  { gecko_cmd_mesh_config_client_get_friend_id, "mesh_config_client_get_friend" },
+  { gecko_cmd_mesh_config_client_set_friend_id, "mesh_config_client_set_friend" },
+  { gecko_cmd_mesh_config_client_get_lpn_polltimeout_id, "mesh_config_client_get_lpn_polltimeout" },
+  { gecko_cmd_mesh_config_client_get_dcd_id, "mesh_config_client_get_dcd" },
+  { gecko_cmd_mesh_config_client_reset_node_id, "mesh_config_client_reset_node" },
+  { gecko_cmd_l2cap_coc_send_connection_request_id, "l2cap_coc_send_connection_request" },
+  { gecko_cmd_l2cap_coc_send_connection_response_id, "l2cap_coc_send_connection_response" },
+  { gecko_cmd_l2cap_coc_send_le_flow_control_credit_id, "l2cap_coc_send_le_flow_control_credit" },
+  { gecko_cmd_l2cap_coc_send_disconnection_request_id, "l2cap_coc_send_disconnection_request" },
+  { gecko_cmd_l2cap_coc_send_data_id, "l2cap_coc_send_data" },
+  { gecko_cmd_cte_transmitter_enable_cte_response_id, "cte_transmitter_enable_cte_response" },
+  { gecko_cmd_cte_transmitter_disable_cte_response_id, "cte_transmitter_disable_cte_response" },
+  { gecko_cmd_cte_transmitter_start_connectionless_cte_id, "cte_transmitter_start_connectionless_cte" },
+  { gecko_cmd_cte_transmitter_stop_connectionless_cte_id, "cte_transmitter_stop_connectionless_cte" },
+  { gecko_cmd_cte_transmitter_set_dtm_parameters_id, "cte_transmitter_set_dtm_parameters" },
+  { gecko_cmd_cte_transmitter_clear_dtm_parameters_id, "cte_transmitter_clear_dtm_parameters" },
+  { gecko_cmd_cte_receiver_configure_id, "cte_receiver_configure" },
+  { gecko_cmd_cte_receiver_start_iq_sampling_id, "cte_receiver_start_iq_sampling" },
+  { gecko_cmd_cte_receiver_stop_iq_sampling_id, "cte_receiver_stop_iq_sampling" },
+  { gecko_cmd_cte_receiver_start_connectionless_iq_sampling_id, "cte_receiver_start_connectionless_iq_sampling" },
+  { gecko_cmd_cte_receiver_stop_connectionless_iq_sampling_id, "cte_receiver_stop_connectionless_iq_sampling" },
+  { gecko_cmd_cte_receiver_set_dtm_parameters_id, "cte_receiver_set_dtm_parameters" },
+  { gecko_cmd_cte_receiver_clear_dtm_parameters_id, "cte_receiver_clear_dtm_parameters" },
+  { gecko_cmd_mesh_sensor_server_init_id, "mesh_sensor_server_init" },
+  { gecko_cmd_mesh_sensor_server_deinit_id, "mesh_sensor_server_deinit" },
+  { gecko_cmd_mesh_sensor_server_send_descriptor_status_id, "mesh_sensor_server_send_descriptor_status" },
+  { gecko_cmd_mesh_sensor_server_send_status_id, "mesh_sensor_server_send_status" },
+  { gecko_cmd_mesh_sensor_server_send_column_status_id, "mesh_sensor_server_send_column_status" },
+  { gecko_cmd_mesh_sensor_server_send_series_status_id, "mesh_sensor_server_send_series_status" },
+  { gecko_cmd_mesh_sensor_setup_server_send_cadence_status_id, "mesh_sensor_setup_server_send_cadence_status" },
+  { gecko_cmd_mesh_sensor_setup_server_send_settings_status_id, "mesh_sensor_setup_server_send_settings_status" },
+  { gecko_cmd_mesh_sensor_setup_server_send_setting_status_id, "mesh_sensor_setup_server_send_setting_status" },
+  { gecko_cmd_mesh_sensor_client_init_id, "mesh_sensor_client_init" },
+  { gecko_cmd_mesh_sensor_client_deinit_id, "mesh_sensor_client_deinit" },
+  { gecko_cmd_mesh_sensor_client_get_descriptor_id, "mesh_sensor_client_get_descriptor" },
+  { gecko_cmd_mesh_sensor_client_get_id, "mesh_sensor_client_get" },
+  { gecko_cmd_mesh_sensor_client_get_column_id, "mesh_sensor_client_get_column" },
+  { gecko_cmd_mesh_sensor_client_get_series_id, "mesh_sensor_client_get_series" },
+  { gecko_cmd_mesh_sensor_client_get_cadence_id, "mesh_sensor_client_get_cadence" },
+  { gecko_cmd_mesh_sensor_client_set_cadence_id, "mesh_sensor_client_set_cadence" },
+  { gecko_cmd_mesh_sensor_client_get_settings_id, "mesh_sensor_client_get_settings" },
+  { gecko_cmd_mesh_sensor_client_get_setting_id, "mesh_sensor_client_get_setting" },
+  { gecko_cmd_mesh_sensor_client_set_setting_id, "mesh_sensor_client_set_setting" },
+  { gecko_cmd_mesh_lc_client_init_id, "mesh_lc_client_init" },
+  { gecko_cmd_mesh_lc_client_get_mode_id, "mesh_lc_client_get_mode" },
+  { gecko_cmd_mesh_lc_client_set_mode_id, "mesh_lc_client_set_mode" },
+  { gecko_cmd_mesh_lc_client_get_om_id, "mesh_lc_client_get_om" },
+  { gecko_cmd_mesh_lc_client_set_om_id, "mesh_lc_client_set_om" },
+  { gecko_cmd_mesh_lc_client_get_light_onoff_id, "mesh_lc_client_get_light_onoff" },
+  { gecko_cmd_mesh_lc_client_set_light_onoff_id, "mesh_lc_client_set_light_onoff" },
+  { gecko_cmd_mesh_lc_client_get_property_id, "mesh_lc_client_get_property" },
+  { gecko_cmd_mesh_lc_client_set_property_id, "mesh_lc_client_set_property" },
+  { gecko_cmd_mesh_lc_server_init_id, "mesh_lc_server_init" },
+  { gecko_cmd_mesh_lc_server_deinit_id, "mesh_lc_server_deinit" },
+  { gecko_cmd_mesh_lc_server_update_mode_id, "mesh_lc_server_update_mode" },
+  { gecko_cmd_mesh_lc_server_update_om_id, "mesh_lc_server_update_om" },
+  { gecko_cmd_mesh_lc_server_update_light_onoff_id, "mesh_lc_server_update_light_onoff" },
+  { gecko_cmd_mesh_lc_server_init_all_properties_id, "mesh_lc_server_init_all_properties" },
+  { gecko_cmd_mesh_lc_server_set_publish_mask_id, "mesh_lc_server_set_publish_mask" },
+  { gecko_cmd_mesh_lc_server_set_regulator_interval_id, "mesh_lc_server_set_regulator_interval" },
+  { gecko_cmd_mesh_lc_setup_server_update_property_id, "mesh_lc_setup_server_update_property" },
+  { gecko_cmd_mesh_scene_client_init_id, "mesh_scene_client_init" },
+  { gecko_cmd_mesh_scene_client_get_id, "mesh_scene_client_get" },
+  { gecko_cmd_mesh_scene_client_get_register_id, "mesh_scene_client_get_register" },
+  { gecko_cmd_mesh_scene_client_recall_id, "mesh_scene_client_recall" },
+  { gecko_cmd_mesh_scene_client_store_id, "mesh_scene_client_store" },
+  { gecko_cmd_mesh_scene_client_delete_id, "mesh_scene_client_delete" },
+  { gecko_cmd_mesh_scene_server_init_id, "mesh_scene_server_init" },
+  { gecko_cmd_mesh_scene_server_deinit_id, "mesh_scene_server_deinit" },
+  { gecko_cmd_mesh_scene_setup_server_init_id, "mesh_scene_setup_server_init" },
+  { gecko_cmd_user_message_to_target_id, "user_message_to_target" },
+};
+const int bgapi_cmd_names_num = ARR_LEN(bgapi_cmd_names);
+
+const bgapi_name_t bgapi_evt_names[] = {
+  { gecko_evt_dfu_boot_id, "dfu_boot" },
+  { gecko_evt_dfu_boot_failure_id, "dfu_boot_failure" },
+  { gecko_evt_system_boot_id, "system_boot" },
+  { gecko_evt_system_external_signal_id, "system_external_signal" },
+  { gecko_evt_system_awake_id, "system_awake" },
+  { gecko_evt_system_hardware_error_id, "system_hardware_error" },
+  { gecko_evt_system_error_id, "system_error" },
+  { gecko_evt_le_gap_scan_response_id, "le_gap_scan_response" },
+  { gecko_evt_le_gap_adv_timeout_id, "le_gap_adv_timeout" },
+  { gecko_evt_le_gap_scan_request_id, "le_gap_scan_request" },
+  { gecko_evt_le_gap_extended_scan_response_id, "le_gap_extended_scan_response" },
+  { gecko_evt_le_gap_periodic_advertising_status_id, "le_gap_periodic_advertising_status" },
+  { gecko_evt_sync_opened_id, "sync_opened" },
+  { gecko_evt_sync_closed_id, "sync_closed" },
+  { gecko_evt_sync_data_id, "sync_data" },
+  { gecko_evt_le_connection_opened_id, "le_connection_opened" },
+  { gecko_evt_le_connection_closed_id, "le_connection_closed" },
+  { gecko_evt_le_connection_parameters_id, "le_connection_parameters" },
+  { gecko_evt_le_connection_rssi_id, "le_connection_rssi" },
+  { gecko_evt_le_connection_phy_status_id, "le_connection_phy_status" },
+  { gecko_evt_gatt_mtu_exchanged_id, "gatt_mtu_exchanged" },
+  { gecko_evt_gatt_service_id, "gatt_service" },
+  { gecko_evt_gatt_characteristic_id, "gatt_characteristic" },
+  { gecko_evt_gatt_descriptor_id, "gatt_descriptor" },
+  { gecko_evt_gatt_characteristic_value_id, "gatt_characteristic_value" },
+  { gecko_evt_gatt_descriptor_value_id, "gatt_descriptor_value" },
+  { gecko_evt_gatt_procedure_completed_id, "gatt_procedure_completed" },
+  { gecko_evt_gatt_server_attribute_value_id, "gatt_server_attribute_value" },
+  { gecko_evt_gatt_server_user_read_request_id, "gatt_server_user_read_request" },
+  { gecko_evt_gatt_server_user_write_request_id, "gatt_server_user_write_request" },
+  { gecko_evt_gatt_server_characteristic_status_id, "gatt_server_characteristic_status" },
+  { gecko_evt_gatt_server_execute_write_completed_id, "gatt_server_execute_write_completed" },
+  { gecko_evt_hardware_soft_timer_id, "hardware_soft_timer" },
+  { gecko_evt_test_dtm_completed_id, "test_dtm_completed" },
+  { gecko_evt_sm_passkey_display_id, "sm_passkey_display" },
+  { gecko_evt_sm_passkey_request_id, "sm_passkey_request" },
+  { gecko_evt_sm_confirm_passkey_id, "sm_confirm_passkey" },
+  { gecko_evt_sm_bonded_id, "sm_bonded" },
+  { gecko_evt_sm_bonding_failed_id, "sm_bonding_failed" },
+  { gecko_evt_sm_list_bonding_entry_id, "sm_list_bonding_entry" },
+  { gecko_evt_sm_list_all_bondings_complete_id, "sm_list_all_bondings_complete" },
+  { gecko_evt_sm_confirm_bonding_id, "sm_confirm_bonding" },
+  { gecko_evt_homekit_setupcode_display_id, "homekit_setupcode_display" },
+  { gecko_evt_homekit_paired_id, "homekit_paired" },
+  { gecko_evt_homekit_pair_verified_id, "homekit_pair_verified" },
+  { gecko_evt_homekit_connection_opened_id, "homekit_connection_opened" },
+  { gecko_evt_homekit_connection_closed_id, "homekit_connection_closed" },
+  { gecko_evt_homekit_identify_id, "homekit_identify" },
+  { gecko_evt_homekit_write_request_id, "homekit_write_request" },
+  { gecko_evt_homekit_read_request_id, "homekit_read_request" },
+  { gecko_evt_homekit_disconnection_required_id, "homekit_disconnection_required" },
+  { gecko_evt_homekit_pairing_removed_id, "homekit_pairing_removed" },
+  { gecko_evt_homekit_setuppayload_display_id, "homekit_setuppayload_display" },
+  { gecko_evt_mesh_node_initialized_id, "mesh_node_initialized" },
+  { gecko_evt_mesh_node_provisioned_id, "mesh_node_provisioned" },
+  { gecko_evt_mesh_node_config_get_id, "mesh_node_config_get" },
+  { gecko_evt_mesh_node_config_set_id, "mesh_node_config_set" },
+  { gecko_evt_mesh_node_display_output_oob_id, "mesh_node_display_output_oob" },
+  { gecko_evt_mesh_node_input_oob_request_id, "mesh_node_input_oob_request" },
+  { gecko_evt_mesh_node_provisioning_started_id, "mesh_node_provisioning_started" },
+  { gecko_evt_mesh_node_provisioning_failed_id, "mesh_node_provisioning_failed" },
+  { gecko_evt_mesh_node_key_added_id, "mesh_node_key_added" },
+  { gecko_evt_mesh_node_model_config_changed_id, "mesh_node_model_config_changed" },
+  { gecko_evt_mesh_node_reset_id, "mesh_node_reset" },
+  { gecko_evt_mesh_node_ivrecovery_needed_id, "mesh_node_ivrecovery_needed" },
+  { gecko_evt_mesh_node_changed_ivupdate_state_id, "mesh_node_changed_ivupdate_state" },
+  { gecko_evt_mesh_node_static_oob_request_id, "mesh_node_static_oob_request" },
+  { gecko_evt_mesh_node_key_removed_id, "mesh_node_key_removed" },
+  { gecko_evt_mesh_node_key_updated_id, "mesh_node_key_updated" },
+  { gecko_evt_mesh_node_heartbeat_id, "mesh_node_heartbeat" },
+  { gecko_evt_mesh_node_heartbeat_start_id, "mesh_node_heartbeat_start" },
+  { gecko_evt_mesh_node_heartbeat_stop_id, "mesh_node_heartbeat_stop" },
+  { gecko_evt_mesh_node_beacon_received_id, "mesh_node_beacon_received" },
+  { gecko_evt_mesh_prov_initialized_id, "mesh_prov_initialized" },
+  { gecko_evt_mesh_prov_provisioning_failed_id, "mesh_prov_provisioning_failed" },
+  { gecko_evt_mesh_prov_device_provisioned_id, "mesh_prov_device_provisioned" },
+  { gecko_evt_mesh_prov_unprov_beacon_id, "mesh_prov_unprov_beacon" },
+  { gecko_evt_mesh_prov_dcd_status_id, "mesh_prov_dcd_status" },
+  { gecko_evt_mesh_prov_config_status_id, "mesh_prov_config_status" },
+  { gecko_evt_mesh_prov_oob_pkey_request_id, "mesh_prov_oob_pkey_request" },
+  { gecko_evt_mesh_prov_oob_auth_request_id, "mesh_prov_oob_auth_request" },
+  { gecko_evt_mesh_prov_oob_display_input_id, "mesh_prov_oob_display_input" },
+  { gecko_evt_mesh_prov_ddb_list_id, "mesh_prov_ddb_list" },
+  { gecko_evt_mesh_prov_heartbeat_publication_status_id, "mesh_prov_heartbeat_publication_status" },
+  { gecko_evt_mesh_prov_heartbeat_subscription_status_id, "mesh_prov_heartbeat_subscription_status" },
+  { gecko_evt_mesh_prov_relay_status_id, "mesh_prov_relay_status" },
+  { gecko_evt_mesh_prov_uri_id, "mesh_prov_uri" },
+  { gecko_evt_mesh_prov_node_reset_id, "mesh_prov_node_reset" },
+  { gecko_evt_mesh_prov_appkey_list_id, "mesh_prov_appkey_list" },
+  { gecko_evt_mesh_prov_appkey_list_end_id, "mesh_prov_appkey_list_end" },
+  { gecko_evt_mesh_prov_network_list_id, "mesh_prov_network_list" },
+  { gecko_evt_mesh_prov_network_list_end_id, "mesh_prov_network_list_end" },
+  { gecko_evt_mesh_prov_model_pub_status_id, "mesh_prov_model_pub_status" },
+  { gecko_evt_mesh_prov_key_refresh_phase_update_id, "mesh_prov_key_refresh_phase_update" },
+  { gecko_evt_mesh_prov_key_refresh_node_update_id, "mesh_prov_key_refresh_node_update" },
+  { gecko_evt_mesh_prov_key_refresh_complete_id, "mesh_prov_key_refresh_complete" },
+  { gecko_evt_mesh_prov_model_sub_addr_id, "mesh_prov_model_sub_addr" },
+  { gecko_evt_mesh_prov_model_sub_addr_end_id, "mesh_prov_model_sub_addr_end" },
+  { gecko_evt_mesh_prov_friend_timeout_status_id, "mesh_prov_friend_timeout_status" },
+  { gecko_evt_mesh_proxy_connected_id, "mesh_proxy_connected" },
+  { gecko_evt_mesh_proxy_disconnected_id, "mesh_proxy_disconnected" },
+  { gecko_evt_mesh_proxy_filter_status_id, "mesh_proxy_filter_status" },
+  { gecko_evt_mesh_vendor_model_receive_id, "mesh_vendor_model_receive" },
+  { gecko_evt_mesh_health_client_server_status_id, "mesh_health_client_server_status" },
+  { gecko_evt_mesh_health_client_server_status_period_id, "mesh_health_client_server_status_period" },
+  { gecko_evt_mesh_health_client_server_status_attention_id, "mesh_health_client_server_status_attention" },
+  { gecko_evt_mesh_health_server_attention_id, "mesh_health_server_attention" },
+  { gecko_evt_mesh_health_server_test_request_id, "mesh_health_server_test_request" },
+  { gecko_evt_mesh_generic_client_server_status_id, "mesh_generic_client_server_status" },
+  { gecko_evt_mesh_generic_server_client_request_id, "mesh_generic_server_client_request" },
+  { gecko_evt_mesh_generic_server_state_changed_id, "mesh_generic_server_state_changed" },
+  { gecko_evt_mesh_generic_server_state_recall_id, "mesh_generic_server_state_recall" },
+  { gecko_evt_mesh_test_local_heartbeat_subscription_complete_id, "mesh_test_local_heartbeat_subscription_complete" },
+  { gecko_evt_mesh_lpn_friendship_established_id, "mesh_lpn_friendship_established" },
+  { gecko_evt_mesh_lpn_friendship_failed_id, "mesh_lpn_friendship_failed" },
+  { gecko_evt_mesh_lpn_friendship_terminated_id, "mesh_lpn_friendship_terminated" },
+  { gecko_evt_mesh_friend_friendship_established_id, "mesh_friend_friendship_established" },
+  { gecko_evt_mesh_friend_friendship_terminated_id, "mesh_friend_friendship_terminated" },
+  { gecko_evt_mesh_config_client_request_modified_id, "mesh_config_client_request_modified" },
+  { gecko_evt_mesh_config_client_netkey_status_id, "mesh_config_client_netkey_status" },
+  { gecko_evt_mesh_config_client_netkey_list_id, "mesh_config_client_netkey_list" },
+  { gecko_evt_mesh_config_client_netkey_list_end_id, "mesh_config_client_netkey_list_end" },
+  { gecko_evt_mesh_config_client_appkey_status_id, "mesh_config_client_appkey_status" },
+  { gecko_evt_mesh_config_client_appkey_list_id, "mesh_config_client_appkey_list" },
+  { gecko_evt_mesh_config_client_appkey_list_end_id, "mesh_config_client_appkey_list_end" },
+  { gecko_evt_mesh_config_client_binding_status_id, "mesh_config_client_binding_status" },
+  { gecko_evt_mesh_config_client_bindings_list_id, "mesh_config_client_bindings_list" },
+  { gecko_evt_mesh_config_client_bindings_list_end_id, "mesh_config_client_bindings_list_end" },
+  { gecko_evt_mesh_config_client_model_pub_status_id, "mesh_config_client_model_pub_status" },
+  { gecko_evt_mesh_config_client_model_sub_status_id, "mesh_config_client_model_sub_status" },
+  { gecko_evt_mesh_config_client_subs_list_id, "mesh_config_client_subs_list" },
+  { gecko_evt_mesh_config_client_subs_list_end_id, "mesh_config_client_subs_list_end" },
+  { gecko_evt_mesh_config_client_heartbeat_pub_status_id, "mesh_config_client_heartbeat_pub_status" },
+  { gecko_evt_mesh_config_client_heartbeat_sub_status_id, "mesh_config_client_heartbeat_sub_status" },
+  { gecko_evt_mesh_config_client_beacon_status_id, "mesh_config_client_beacon_status" },
+  { gecko_evt_mesh_config_client_default_ttl_status_id, "mesh_config_client_default_ttl_status" },
+  { gecko_evt_mesh_config_client_gatt_proxy_status_id, "mesh_config_client_gatt_proxy_status" },
+  { gecko_evt_mesh_config_client_relay_status_id, "mesh_config_client_relay_status" },
+  { gecko_evt_mesh_config_client_network_transmit_status_id, "mesh_config_client_network_transmit_status" },
+  { gecko_evt_mesh_config_client_identity_status_id, "mesh_config_client_identity_status" },
+  { gecko_evt_mesh_config_client_friend_status_id, "mesh_config_client_friend_status" },
+  { gecko_evt_mesh_config_client_lpn_polltimeout_status_id, "mesh_config_client_lpn_polltimeout_status" },
+  { gecko_evt_mesh_config_client_dcd_data_id, "mesh_config_client_dcd_data" },
+  { gecko_evt_mesh_config_client_dcd_data_end_id, "mesh_config_client_dcd_data_end" },
+  { gecko_evt_mesh_config_client_reset_status_id, "mesh_config_client_reset_status" },
+  { gecko_evt_l2cap_coc_connection_request_id, "l2cap_coc_connection_request" },
+  { gecko_evt_l2cap_coc_connection_response_id, "l2cap_coc_connection_response" },
+  { gecko_evt_l2cap_coc_le_flow_control_credit_id, "l2cap_coc_le_flow_control_credit" },
+  { gecko_evt_l2cap_coc_channel_disconnected_id, "l2cap_coc_channel_disconnected" },
+  { gecko_evt_l2cap_coc_data_id, "l2cap_coc_data" },
+  { gecko_evt_l2cap_command_rejected_id, "l2cap_command_rejected" },
+  { gecko_evt_cte_receiver_iq_report_id, "cte_receiver_iq_report" },
+  { gecko_evt_mesh_sensor_server_get_request_id, "mesh_sensor_server_get_request" },
+  { gecko_evt_mesh_sensor_server_get_column_request_id, "mesh_sensor_server_get_column_request" },
+  { gecko_evt_mesh_sensor_server_get_series_request_id, "mesh_sensor_server_get_series_request" },
+  { gecko_evt_mesh_sensor_server_publish_id, "mesh_sensor_server_publish" },
+  { gecko_evt_mesh_sensor_setup_server_get_cadence_request_id, "mesh_sensor_setup_server_get_cadence_request" },
+  { gecko_evt_mesh_sensor_setup_server_set_cadence_request_id, "mesh_sensor_setup_server_set_cadence_request" },
+  { gecko_evt_mesh_sensor_setup_server_get_settings_request_id, "mesh_sensor_setup_server_get_settings_request" },
+  { gecko_evt_mesh_sensor_setup_server_get_setting_request_id, "mesh_sensor_setup_server_get_setting_request" },
+  { gecko_evt_mesh_sensor_setup_server_set_setting_request_id, "mesh_sensor_setup_server_set_setting_request" },
+  { gecko_evt_mesh_sensor_setup_server_publish_id, "mesh_sensor_setup_server_publish" },
+  { gecko_evt_mesh_sensor_client_descriptor_status_id, "mesh_sensor_client_descriptor_status" },
+  { gecko_evt_mesh_sensor_client_cadence_status_id, "mesh_sensor_client_cadence_status" },
+  { gecko_evt_mesh_sensor_client_settings_status_id, "mesh_sensor_client_settings_status" },
+  { gecko_evt_mesh_sensor_client_setting_status_id, "mesh_sensor_client_setting_status" },
+  { gecko_evt_mesh_sensor_client_status_id, "mesh_sensor_client_status" },
+  { gecko_evt_mesh_sensor_client_column_status_id, "mesh_sensor_client_column_status" },
+  { gecko_evt_mesh_sensor_client_series_status_id, "mesh_sensor_client_series_status" },
+  { gecko_evt_mesh_sensor_client_publish_id, "mesh_sensor_client_publish" },
+  { gecko_evt_mesh_lc_client_mode_status_id, "mesh_lc_client_mode_status" },
+  { gecko_evt_mesh_lc_client_om_status_id, "mesh_lc_client_om_status" },
+  { gecko_evt_mesh_lc_client_light_onoff_status_id, "mesh_lc_client_light_onoff_status" },
+  { gecko_evt_mesh_lc_client_property_status_id, "mesh_lc_client_property_status" },
+  { gecko_evt_mesh_lc_server_mode_updated_id, "mesh_lc_server_mode_updated" },
+  { gecko_evt_mesh_lc_server_om_updated_id, "mesh_lc_server_om_updated" },
+  { gecko_evt_mesh_lc_server_light_onoff_updated_id, "mesh_lc_server_light_onoff_updated" },
+  { gecko_evt_mesh_lc_server_occupancy_updated_id, "mesh_lc_server_occupancy_updated" },
+  { gecko_evt_mesh_lc_server_ambient_lux_level_updated_id, "mesh_lc_server_ambient_lux_level_updated" },
+  { gecko_evt_mesh_lc_server_linear_output_updated_id, "mesh_lc_server_linear_output_updated" },
+  { gecko_evt_mesh_lc_setup_server_set_property_id, "mesh_lc_setup_server_set_property" },
+  { gecko_evt_mesh_scene_client_status_id, "mesh_scene_client_status" },
+  { gecko_evt_mesh_scene_client_register_status_id, "mesh_scene_client_register_status" },
+  { gecko_evt_mesh_scene_server_get_id, "mesh_scene_server_get" },
+  { gecko_evt_mesh_scene_server_register_get_id, "mesh_scene_server_register_get" },
+  { gecko_evt_mesh_scene_server_recall_id, "mesh_scene_server_recall" },
+  { gecko_evt_mesh_scene_server_publish_id, "mesh_scene_server_publish" },
+  { gecko_evt_mesh_scene_setup_server_store_id, "mesh_scene_setup_server_store" },
+  { gecko_evt_mesh_scene_setup_server_delete_id, "mesh_scene_setup_server_delete" },
+  { gecko_evt_mesh_scene_setup_server_publish_id, "mesh_scene_setup_server_publish" },
+  { gecko_evt_user_message_to_host_id, "user_message_to_host" },
+};
+const int bgapi_evt_names_num = ARR_LEN(bgapi_evt_names);
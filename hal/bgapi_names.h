@@ -0,0 +1,30 @@
+/*************************************************************************
+    > File Name: bgapi_names.h
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Names of the BGAPI command and event IDs, the tables are
+    > generated into bgapi_names.c by tools/bgapi_names_gen.py
+ ************************************************************************/
+
+#ifndef BGAPI_NAMES_H
+#define BGAPI_NAMES_H
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+#include <stdint.h>
+
+typedef struct {
+  uint32_t id;
+  const char *name;
+}bgapi_name_t;
+
+extern const bgapi_name_t bgapi_cmd_names[];
+extern const int bgapi_cmd_names_num;
+extern const bgapi_name_t bgapi_evt_names[];
+extern const int bgapi_evt_names_num;
+
+#ifdef __cplusplus
+}
+#endif
+#endif //BGAPI_NAMES_H
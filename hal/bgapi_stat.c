@@ -0,0 +1,229 @@
+/*************************************************************************
+    > File Name: bgapi_stat.c
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Per message ID statistics of the BGAPI traffic
+ ************************************************************************/
+
+/* Includes *********************************************************** */
+#define LOG_MODULE log_mod_hal
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bgapi_stat.h"
+#include "bgapi_names.h"
+#include "logging.h"
+#include "utils.h"
+
+/* Defines  *********************************************************** */
+#define MSG_ID(hdr) BGLIB_MSG_ID(hdr)
+/* Class and method of the ID, the low byte is the same for all the IDs of a
+ * kind */
+#define SLOT_OF(id, slots) ((((id) >> 16) * 40503u) & ((slots) - 1))
+
+/* Global Variables *************************************************** */
+
+/* Static Variables *************************************************** */
+static bgapi_cmd_stat_t *cmd_slots[BGAPI_STAT_CMD_SLOTS];
+static bgapi_evt_stat_t *evt_slots[BGAPI_STAT_EVT_SLOTS];
+static int evt_queue_hwm = 0;
+
+/* Static Functions Declaractions ************************************* */
+static const char *name_of(const bgapi_name_t *names, int num, uint32_t id)
+{
+  for (int i = 0; i < num; i++) {
+    if (names[i].id == id) {
+      return names[i].name;
+    }
+  }
+  return "unknown";
+}
+
+/*
+ * Find the entry of an ID, create it on the first use. Open addressing with
+ * linear probing, the entries are never removed except on reset.
+ */
+static void *lookup(void **slots,
+                    int num,
+                    size_t size,
+                    uint32_t id,
+                    const bgapi_name_t *names,
+                    int nnames)
+{
+  uint32_t *e;
+  int i = SLOT_OF(id, num);
+
+  for (int n = 0; n < num; n++, i = (i + 1) & (num - 1)) {
+    e = slots[i];
+    if (!e) {
+      e = calloc(1, size);
+      if (!e) {
+        return NULL;
+      }
+      /* id and name are the first members of both entry types */
+      ((bgapi_cmd_stat_t *)e)->id = id;
+      ((bgapi_cmd_stat_t *)e)->name = name_of(names, nnames, id);
+      slots[i] = e;
+      return e;
+    }
+    if (*e == id) {
+      return e;
+    }
+  }
+  return NULL;
+}
+
+void bgapi_stat_cmd(uint32_t hdr,
+                    const struct gecko_cmd_packet *rsp,
+                    uint64_t start_us)
+{
+  uint64_t us;
+  bgapi_cmd_stat_t *s = lookup((void **)cmd_slots, BGAPI_STAT_CMD_SLOTS,
+                               sizeof(bgapi_cmd_stat_t), MSG_ID(hdr),
+                               bgapi_cmd_names, bgapi_cmd_names_num);
+  if (!s) {
+    return;
+  }
+  s->calls++;
+  s->tx_bytes += BGLIB_MSG_HEADER_LEN + BGLIB_MSG_LEN(hdr);
+  if (!rsp) {
+    return;
+  }
+  s->rx_bytes += BGLIB_MSG_HEADER_LEN + BGLIB_MSG_LEN(rsp->header);
+  /* The responses carrying a result start with it */
+  if (BGLIB_MSG_LEN(rsp->header) >= sizeof(uint16_t)
+      && (rsp->data.payload[0] || rsp->data.payload[1])) {
+    s->errs++;
+  }
+  us = lat_now_us() - start_us;
+  s->total_us += us;
+  lat_hist_record(&s->rtt, us);
+}
+
+void bgapi_stat_evt(uint32_t hdr, int what)
+{
+  bgapi_evt_stat_t *s = lookup((void **)evt_slots, BGAPI_STAT_EVT_SLOTS,
+                               sizeof(bgapi_evt_stat_t), MSG_ID(hdr),
+                               bgapi_evt_names, bgapi_evt_names_num);
+  if (!s) {
+    return;
+  }
+  switch (what) {
+    case bgapi_evt_recv:
+      s->recv++;
+      s->rx_bytes += BGLIB_MSG_HEADER_LEN + BGLIB_MSG_LEN(hdr);
+      break;
+    case bgapi_evt_dropped:
+      s->dropped++;
+      break;
+    case bgapi_evt_unhandled:
+      s->unhandled++;
+      break;
+  }
+}
+
+void bgapi_stat_evt_queue(int len)
+{
+  if (len > evt_queue_hwm) {
+    evt_queue_hwm = len;
+  }
+}
+
+int bgapi_stat_evt_queue_hwm(void)
+{
+  return evt_queue_hwm;
+}
+
+void bgapi_stat_reset(void)
+{
+  evt_queue_hwm = 0;
+  for (int i = 0; i < BGAPI_STAT_CMD_SLOTS; i++) {
+    free(cmd_slots[i]);
+    cmd_slots[i] = NULL;
+  }
+  for (int i = 0; i < BGAPI_STAT_EVT_SLOTS; i++) {
+    free(evt_slots[i]);
+    evt_slots[i] = NULL;
+  }
+}
+
+static int cmd_cmp(const void *a, const void *b)
+{
+  const bgapi_cmd_stat_t *x = *(const bgapi_cmd_stat_t **)a;
+  const bgapi_cmd_stat_t *y = *(const bgapi_cmd_stat_t **)b;
+
+  if (x->total_us != y->total_us) {
+    return x->total_us < y->total_us ? 1 : -1;
+  }
+  return x->calls < y->calls ? 1 : x->calls > y->calls ? -1 : 0;
+}
+
+static int evt_cmp(const void *a, const void *b)
+{
+  const bgapi_evt_stat_t *x = *(const bgapi_evt_stat_t **)a;
+  const bgapi_evt_stat_t *y = *(const bgapi_evt_stat_t **)b;
+
+  return x->recv < y->recv ? 1 : x->recv > y->recv ? -1 : 0;
+}
+
+int bgapi_stat_cmds(const bgapi_cmd_stat_t **out)
+{
+  int n = 0;
+
+  for (int i = 0; i < BGAPI_STAT_CMD_SLOTS; i++) {
+    if (cmd_slots[i]) {
+      out[n++] = cmd_slots[i];
+    }
+  }
+  qsort(out, n, sizeof(*out), cmd_cmp);
+  return n;
+}
+
+int bgapi_stat_evts(const bgapi_evt_stat_t **out)
+{
+  int n = 0;
+
+  for (int i = 0; i < BGAPI_STAT_EVT_SLOTS; i++) {
+    if (evt_slots[i]) {
+      out[n++] = evt_slots[i];
+    }
+  }
+  qsort(out, n, sizeof(*out), evt_cmp);
+  return n;
+}
+
+err_t bgapi_stat_export(const char *path)
+{
+  FILE *fp;
+  const bgapi_cmd_stat_t *cmds[BGAPI_STAT_CMD_SLOTS];
+  const bgapi_evt_stat_t *evts[BGAPI_STAT_EVT_SLOTS];
+  int n;
+
+  fp = fopen(path, "w");
+  if (!fp) {
+    return err(ec_file_ope);
+  }
+  fprintf(fp, "type,id,name,count,errors,dropped,unhandled,tx_bytes,rx_bytes,"
+          "total_us,p50_us,p90_us,p99_us,max_us\n");
+  n = bgapi_stat_cmds(cmds);
+  for (int i = 0; i < n; i++) {
+    fprintf(fp, "cmd,0x%08x,%s,%u,%u,0,0,%llu,%llu,%llu,%llu,%llu,%llu,%llu\n",
+            cmds[i]->id, cmds[i]->name, cmds[i]->calls, cmds[i]->errs,
+            (unsigned long long)cmds[i]->tx_bytes,
+            (unsigned long long)cmds[i]->rx_bytes,
+            (unsigned long long)cmds[i]->total_us,
+            (unsigned long long)lat_hist_percentile(&cmds[i]->rtt, 50),
+            (unsigned long long)lat_hist_percentile(&cmds[i]->rtt, 90),
+            (unsigned long long)lat_hist_percentile(&cmds[i]->rtt, 99),
+            (unsigned long long)cmds[i]->rtt.max);
+  }
+  n = bgapi_stat_evts(evts);
+  for (int i = 0; i < n; i++) {
+    fprintf(fp, "evt,0x%08x,%s,%u,0,%u,%u,0,%llu,0,0,0,0,0\n",
+            evts[i]->id, evts[i]->name, evts[i]->recv, evts[i]->dropped,
+            evts[i]->unhandled, (unsigned long long)evts[i]->rx_bytes);
+  }
+  fclose(fp);
+  return ec_success;
+}
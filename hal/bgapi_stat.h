@@ -0,0 +1,122 @@
+/*************************************************************************
+    > File Name: bgapi_stat.h
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Per message ID statistics of the BGAPI traffic
+ ************************************************************************/
+
+#ifndef BGAPI_STAT_H
+#define BGAPI_STAT_H
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+#include <stdint.h>
+#include "host_gecko.h"
+#include "lat_hist.h"
+#include "err.h"
+
+/* Distinct command and event IDs can be recorded */
+#define BGAPI_STAT_CMD_SLOTS  256
+#define BGAPI_STAT_EVT_SLOTS  128
+
+typedef struct {
+  uint32_t id;
+  const char *name;
+  uint32_t calls;
+  /* Responses with a non-zero result */
+  uint32_t errs;
+  uint64_t tx_bytes;
+  uint64_t rx_bytes;
+  /* Sum of the round-trip times */
+  uint64_t total_us;
+  lat_hist_t rtt;
+}bgapi_cmd_stat_t;
+
+typedef struct {
+  uint32_t id;
+  const char *name;
+  uint32_t recv;
+  /* Dropped since the event queue of bglib was full */
+  uint32_t dropped;
+  /* Not handled by any handler in bgevt_dispenser */
+  uint32_t unhandled;
+  uint64_t rx_bytes;
+}bgapi_evt_stat_t;
+
+enum {
+  bgapi_evt_recv,
+  bgapi_evt_dropped,
+  bgapi_evt_unhandled
+};
+
+/**
+ * @brief bgapi_stat_cmd - record a command, called by bglib
+ *
+ * @param hdr - header of the command
+ * @param rsp - response, NULL if the command has no response
+ * @param start_us - time the command was sent, from lat_now_us
+ */
+void bgapi_stat_cmd(uint32_t hdr,
+                    const struct gecko_cmd_packet *rsp,
+                    uint64_t start_us);
+
+/**
+ * @brief bgapi_stat_evt - record an event
+ *
+ * @param hdr - header of the event
+ * @param what - bgapi_evt_recv/dropped/unhandled
+ */
+void bgapi_stat_evt(uint32_t hdr, int what);
+
+/**
+ * @brief bgapi_stat_evt_queue - record the length of the event queue of
+ * bglib after an event is queued
+ *
+ * @param len - number of the events in the queue
+ */
+void bgapi_stat_evt_queue(int len);
+
+/**
+ * @brief bgapi_stat_evt_queue_hwm - get the high-water mark of the event
+ * queue of bglib
+ *
+ * @return the max number of the events ever in the queue
+ */
+int bgapi_stat_evt_queue_hwm(void);
+
+void bgapi_stat_reset(void);
+
+/**
+ * @brief bgapi_stat_cmds - get the command statistics
+ *
+ * @param out - filled with the statistics, sorted by the total round-trip time
+ * in descending order, must hold BGAPI_STAT_CMD_SLOTS pointers
+ *
+ * @return number of the commands
+ */
+int bgapi_stat_cmds(const bgapi_cmd_stat_t **out);
+
+/**
+ * @brief bgapi_stat_evts - get the event statistics
+ *
+ * @param out - filled with the statistics, sorted by the received times in
+ * descending order, must hold BGAPI_STAT_EVT_SLOTS pointers
+ *
+ * @return number of the events
+ */
+int bgapi_stat_evts(const bgapi_evt_stat_t **out);
+
+/**
+ * @brief bgapi_stat_export - write the statistics to a CSV file
+ *
+ * @param path - file path
+ *
+ * @return @ref{err_t}
+ */
+err_t bgapi_stat_export(const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+#endif //BGAPI_STAT_H
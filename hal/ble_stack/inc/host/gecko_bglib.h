@@ -127,4 +127,16 @@ extern void(*bglib_output)(uint32_t len1, uint8_t* data1);
 extern int32_t (*bglib_input)(uint32_t len1, uint8_t* data1);
 extern int32_t(*bglib_peek)(void);
 
+/**
+ * Pipelined commands - gecko_send_command writes the command built in
+ * gecko_cmd_msg without waiting for its response, gecko_recv_response waits
+ * for the responses in the order the commands are sent. The NCP target still
+ * handles the commands one by one, so only the ones not depending on the
+ * results of each other can be sent ahead.
+ * @param hdr header of the command the response is for
+ * @param start_us when the command is sent, for the latency statistics
+ */
+void gecko_send_command(void);
+struct gecko_cmd_packet* gecko_recv_response(uint32_t hdr, uint64_t start_us);
+
 #endif
@@ -15,6 +15,7 @@
  ******************************************************************************/
 
 #include "gecko_bglib.h"
+#include "bgapi_stat.h"
 
 struct gecko_cmd_packet* gecko_wait_message(void)//wait for event from system
 {
@@ -47,10 +48,12 @@ struct gecko_cmd_packet* gecko_wait_message(void)//wait for event from system
         uint8_t tmp_payload[BGLIB_MSG_MAX_PAYLOAD];
         bglib_input(msg_length, tmp_payload);
       }
+      bgapi_stat_evt(header, bgapi_evt_dropped);
       return 0;      //NO ROOM IN QUEUE
     }
     pck = &gecko_queue[gecko_queue_w];
     gecko_queue_w = (gecko_queue_w + 1) % BGLIB_QUEUE_LEN;
+    bgapi_stat_evt_queue((gecko_queue_w + BGLIB_QUEUE_LEN - gecko_queue_r) % BGLIB_QUEUE_LEN);
   } else if ((header & 0xf8) == gecko_dev_type_gecko) {//response
     retVal = pck = gecko_rsp_msg;
   } else {
@@ -68,6 +71,9 @@ struct gecko_cmd_packet* gecko_wait_message(void)//wait for event from system
       return 0;
     }
   }
+  if (!retVal) {
+    bgapi_stat_evt(header, bgapi_evt_recv);
+  }
 
   // Using retVal avoid double handling of event msg types in outer function
   return retVal;
@@ -132,13 +138,27 @@ struct gecko_cmd_packet* gecko_wait_response(void)
 
 void gecko_handle_command(uint32_t hdr, void* data)
 {
+  uint64_t start = lat_now_us();
   //packet in gecko_cmd_msg is waiting for output
   bglib_output(BGLIB_MSG_HEADER_LEN + BGLIB_MSG_LEN(gecko_cmd_msg->header), (uint8_t*)gecko_cmd_msg);
-  gecko_wait_response();
+  bgapi_stat_cmd(hdr, gecko_wait_response(), start);
+}
+
+void gecko_send_command(void)
+{
+  bglib_output(BGLIB_MSG_HEADER_LEN + BGLIB_MSG_LEN(gecko_cmd_msg->header), (uint8_t*)gecko_cmd_msg);
+}
+
+struct gecko_cmd_packet* gecko_recv_response(uint32_t hdr, uint64_t start_us)
+{
+  struct gecko_cmd_packet* p = gecko_wait_response();
+  bgapi_stat_cmd(hdr, p, start_us);
+  return p;
 }
 
 void gecko_handle_command_noresponse(uint32_t hdr, void* data)
 {
   //packet in gecko_cmd_msg is waiting for output
   bglib_output(BGLIB_MSG_HEADER_LEN + BGLIB_MSG_LEN(gecko_cmd_msg->header), (uint8_t*)gecko_cmd_msg);
+  bgapi_stat_cmd(hdr, NULL, 0);
 }
@@ -83,6 +83,13 @@ int32_t uartRxNonBlocking(uint32_t dataLength, uint8_t* data);
  **************************************************************************************************/
 int32_t uartRxPeek(void);
 
+/***********************************************************************************************//**
+ *  \brief  Wait until there is data in the input buffer or the timeout elapses.
+ *  \param[in]  timeoutMs Maximum time to wait, in milliseconds.
+ *  \return  The number of bytes in the input buffer, 0 on timeout or -1 on failure.
+ **************************************************************************************************/
+int32_t uartRxWait(int32_t timeoutMs);
+
 /***********************************************************************************************//**
  *  \brief  Write data to serial port. The function will block until
  *          the desired amount has been written or an error occurs.
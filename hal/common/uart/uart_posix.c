@@ -23,6 +23,7 @@
 #include <fcntl.h>
 #include <termios.h>
 #include <sys/ioctl.h>
+#include <poll.h>
 
 #include "uart.h"
 
@@ -146,6 +147,27 @@ int32_t uartRxPeek(void)
   return bytesInBuf;
 }
 
+int32_t uartRxWait(int32_t timeoutMs)
+{
+  struct pollfd pfd;
+  int ret;
+
+  if (serialHandle == -1) {
+    return -1;
+  }
+
+  pfd.fd = serialHandle;
+  pfd.events = POLLIN;
+  do {
+    ret = poll(&pfd, 1, timeoutMs);
+  } while (ret == -1 && errno == EINTR);
+
+  if (ret <= 0) {
+    return ret;
+  }
+  return uartRxPeek();
+}
+
 int32_t uartTx(uint32_t dataLength, uint8_t* data)
 {
   /** The amount of bytes written. */
@@ -167,6 +167,21 @@ int32_t uartRxPeek(void)
   return (int32_t)comStat.cbInQue;
 }
 
+int32_t uartRxWait(int32_t timeoutMs)
+{
+  DWORD start = GetTickCount();
+  int32_t ret;
+
+  /* The port isn't opened overlapped, so poll the input buffer */
+  while (0 == (ret = uartRxPeek())) {
+    if ((int32_t)(GetTickCount() - start) >= timeoutMs) {
+      break;
+    }
+    Sleep(1);
+  }
+  return ret;
+}
+
 int32_t uartTx(uint32_t dataLength, uint8_t* data)
 {
   /** Variable for storing function return values. */
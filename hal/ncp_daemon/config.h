@@ -20,4 +20,10 @@
 
 #define MAX_PACKET_SIZE 512
 
+// data queued for a client which does not read, packets are dropped beyond
+#define SL_CLIENT_TXBUF_SIZE (MAX_PACKET_SIZE * 32)
+
+// ms to wait for the response of a command
+#define SL_CLIENT_CMD_TIMEOUT 3000
+
 #endif
@@ -28,15 +28,15 @@
 #include <errno.h>
 #include <string.h>
 #include <unistd.h>
+#include <signal.h>
 #include "uart.h"
 #include "sl_poll.h"
 #include "sl_bgapi.h"
 #include "config.h"
 #include "sl_security.h"
+#include "sl_client.h"
 
-int enc_socket = -1;
 int enc_server_socket = -1;
-int unenc_socket = -1;
 int unenc_server_socket = -1;
 int serial_handle = -1;
 sl_bgapi_context_t uart_bgapi;
@@ -111,27 +111,6 @@ int create_domain_socket_server(char *fname)
   sl_poll_add(sock);
   return sock;
 }
-// accept incoming socket, close old socket if exist
-int accept_domain_socket(int server, int oldsock)
-{
-  int n;
-  struct sockaddr_un client_sockaddr;
-  socklen_t socklen = sizeof(client_sockaddr);
-  memset(&client_sockaddr, 0, sizeof(struct sockaddr_un));
-  // new connection, close previout socket if exist
-  if (oldsock >= 0) {
-    close(oldsock);
-    sl_poll_remove(oldsock);
-  }
-  // accept connection request
-  n = accept(server, (struct sockaddr *) &client_sockaddr, &socklen);
-  if (n < 0) {
-    return -1;
-  }
-
-  return n;
-}
-
 /**
  * The main program.
  */
@@ -143,6 +122,8 @@ int main(int argc, char* argv[])
     printf(USAGE, argv[0]);
     exit(EXIT_FAILURE);
   }
+  //a client going away must not terminate the daemon
+  signal(SIGPIPE, SIG_IGN);
   if (sl_poll_init() < 0) {
     printf("Socket initialization error\n");
     exit(EXIT_FAILURE);
@@ -164,7 +145,7 @@ int main(int argc, char* argv[])
 
   while (1) {
     nticks = sl_poll_ticks();
-    tosleep = 0;//ncp_mux_update_timeout(&mux,nticks-ticks);
+    tosleep = sl_client_timeout(nticks);
     ticks = nticks;
 
     sl_poll_wait(tosleep);
@@ -176,17 +157,28 @@ int main(int argc, char* argv[])
 //this callback is called when received bgapi packet needs to be forwarded
 void sl_bgapi_process_packet_cb(sl_bgapi_context_t *ctx, char *buf, int len, int encrypted)
 {
-  if (encrypted) {//if packet is encrypted, forward to encrypted socket
-    if (enc_socket >= 0) {
-      send(enc_socket, buf, len, 0);
-    }
-  } else {//unencrypted data, send to both sockets
-    if (unenc_socket >= 0) {
-      send(unenc_socket, buf, len, 0);
-    }
-    if (enc_socket >= 0) {
-      send(enc_socket, buf, len, 0);
+  //encrypted packets only go to encrypted clients, unencrypted ones to all
+  sl_client_forward(buf, len, encrypted);
+}
+//this callback is called when a client command is sent to the NCP
+void sl_client_write_ncp_cb(char *buf, unsigned len, int encrypted)
+{
+  //room for the nonce counter and tag
+  char tbuf[MAX_PACKET_SIZE + 16];
+  char *ptr = buf;
+
+  if (encrypted) {
+    sl_security_encrypt_packet(buf, tbuf, &len);
+    ptr = tbuf;
+  }
+  while (len) {
+    int l = write(serial_handle, ptr, len);
+    if (l < 0) {
+      printf("serial write failed %d\n", errno);
+      return;
     }
+    len -= l;
+    ptr += l;
   }
 }
 //this callback is called when security state changes
@@ -194,24 +186,13 @@ void sl_security_state_change_cb(t_sl_security_state state)
 {
   switch (state) {
     case sl_security_state_encrypted:
-      //move encrypted socket to be polled if not already
-      if (!sl_poll_is_polled(enc_socket)) {//
-        printf("link encrypted\n");
-        sl_poll_add(enc_socket);
-      }
+      //pending commands of encrypted clients are sent from now on
+      printf("link encrypted\n");
       break;
     case sl_security_state_unencrypted:
-      //security state is unencrypted
-      if (enc_socket >= 0) {
-        // move encrypted socket to unpolled state
-        if (sl_poll_is_polled(enc_socket)) {//
-          printf("link not encrypted\n");
-          sl_poll_remove(enc_socket);
-        }
-        //start security handshake
-        sl_security_start();
-      }
-
+      //start security handshake if there is an encrypted client
+      printf("link not encrypted\n");
+      sl_client_security_start();
       break;
     default:
       break;
@@ -222,80 +203,33 @@ void sl_security_state_change_cb(t_sl_security_state state)
 int sl_poll_cb(int fd, int revents)
 {
   char buf[MAX_PACKET_SIZE];
+  sl_client_t *c;
 
   // encrypted server socket event
   if ((revents & POLLIN) && (fd == enc_server_socket)) {
-    enc_socket = accept_domain_socket(enc_server_socket, enc_socket);
-    printf("Host connected to encrypted socket\n");
-    if (sl_security_state() == sl_security_state_encrypted) {
-      //already encrypted, add to poll list
-      if (sl_poll_add(enc_socket) < 0) {
-        //failed to add to poll list
-        close(enc_socket);
-      }
+    if (sl_client_accept(enc_server_socket, 1)) {
+      printf("Host connected to encrypted socket\n");
+      sl_client_security_start();
     }
-    sl_security_start();
+    return 0;
   }
   // unencrypted server socket event
   if ((revents & POLLIN) && (fd == unenc_server_socket)) {
-    unenc_socket = accept_domain_socket(unenc_server_socket, unenc_socket);
-    printf("Host connected to unencrypted socket\n");
-    // and add it to poll list
-    if (sl_poll_add(unenc_socket) < 0) {
-      //failed to add to poll list
-      close(unenc_socket);
+    if (sl_client_accept(unenc_server_socket, 0)) {
+      printf("Host connected to unencrypted socket\n");
     }
+    return 0;
   }
   // Serial port event
   if ((revents & POLLIN) && (fd == serial_handle)) {
     int len = read(serial_handle, buf, sizeof(buf));
     printf("%d<", len); fflush(stdout);
     sl_bgapi_recv_data(&uart_bgapi, buf, len);
+    return 0;
   }
-  // Host encrypted socket event
-  if ((revents & POLLIN) && (fd == enc_socket)) {
-    //receive data after the packet
-    int len = recv(fd, buf, sizeof(buf), 0);
-    printf("%d>", len); fflush(stdout);
-
-    if (len == 0) {
-      //socket closed
-      printf("Host encrypted disconnected\n");
-      close(fd);
-      sl_poll_remove(fd);
-      enc_socket = -1;
-      return -1;
-    } else if (len < 0) {
-      return 0;
-    } else {
-      //ENCRYPT
-      char tbuf[MAX_PACKET_SIZE];
-      unsigned tlen = len;
-
-      sl_security_encrypt_packet(buf, tbuf, &tlen);
-
-      //
-      write(serial_handle, tbuf, (size_t)tlen);
-    }
-  }
-  // Host unencrypted socket event
-  if ((revents & POLLIN) && (fd == unenc_socket)) {
-    //receive data after the packet
-    int len = recv(fd, buf, sizeof(buf), 0);
-    printf("%d>", len); fflush(stdout);
-
-    if (len == 0) {
-      //socket closed
-      printf("Host unencrypted disconnected\n");
-      close(fd);
-      sl_poll_remove(fd);
-      unenc_socket = -1;
-      return -1;
-    } else if (len < 0) {
-      return 0;
-    } else {
-      write(serial_handle, buf, (size_t)len);
-    }
+  // Host socket event
+  if ((c = sl_client_find(fd)) != NULL) {
+    return sl_client_event(c, revents);
   }
   return 0;
 }
@@ -37,6 +37,7 @@ void sl_bgapi_reset(sl_bgapi_context_t *ctx)
 void sl_bgapi_recv_data(sl_bgapi_context_t *ctx, char *buf, int len)
 {
   uint32_t hdr;
+  unsigned ofs = 0;
 
   if (ctx->recv_len + len > sizeof(ctx->recv_buf)) {//buffer overflowing, move old data to at least fit new data
     memmove(&ctx->recv_buf[0], &ctx->recv_buf[ctx->recv_len], sizeof(ctx->recv_buf) - ctx->recv_len);
@@ -49,40 +50,41 @@ void sl_bgapi_recv_data(sl_bgapi_context_t *ctx, char *buf, int len)
     return;
   }
   //validate packet
-  while (ctx->recv_len > BGLIB_MSG_HEADER_LEN) {
-    memcpy(&hdr, ctx->recv_buf, BGLIB_MSG_HEADER_LEN);
-    if (((ctx->recv_buf[0] & 0x20) == 0) || (BGLIB_MSG_LEN(hdr) > BGLIB_MSG_MAX_PAYLOAD)) {
+  while (ctx->recv_len - ofs > BGLIB_MSG_HEADER_LEN) {
+    memcpy(&hdr, &ctx->recv_buf[ofs], BGLIB_MSG_HEADER_LEN);
+    if (((ctx->recv_buf[ofs] & 0x20) == 0) || (BGLIB_MSG_LEN(hdr) > BGLIB_MSG_MAX_PAYLOAD)) {
       //invalid packet, drop 1st byte
-      ctx->recv_len--;
-      memmove(&ctx->recv_buf[0], &ctx->recv_buf[1], ctx->recv_len - 1);
+      ofs++;
       continue;
     }
     unsigned packet_len = BGLIB_MSG_LEN(hdr) + BGLIB_MSG_HEADER_LEN;
-    if (packet_len > ctx->recv_len) {//not enough data for a packet
-      return;
+    if (packet_len > ctx->recv_len - ofs) {//not enough data for a packet
+      break;
     }
     if (BGLIB_MSG_ENCRYPTED(hdr)) {
       tlen = packet_len;
 
-      sl_security_decrypt_packet(&ctx->recv_buf[0], tbuf, &tlen);
+      sl_security_decrypt_packet(&ctx->recv_buf[ofs], tbuf, &tlen);
 
-      sl_bgapi_process_packet_cb(ctx, tbuf, tlen, 1);
+      if (tlen) {
+        sl_bgapi_process_packet_cb(ctx, tbuf, tlen, 1);
+      }
     } else {
       switch (BGLIB_MSG_ID(hdr)) {
         case gecko_rsp_user_message_to_target_id:
           //response to security handshake
           if (packet_len == 80
-              && ctx->recv_buf[4] == 0 && ctx->recv_buf[5] == 0
-              && ctx->recv_buf[6] == 0x49 && ctx->recv_buf[7] == 0x0) {
+              && ctx->recv_buf[ofs + 4] == 0 && ctx->recv_buf[ofs + 5] == 0
+              && ctx->recv_buf[ofs + 6] == 0x49 && ctx->recv_buf[ofs + 7] == 0x0) {
             uint8_t public[64];
             uint8_t target_iv_to_target[4];
             uint8_t target_iv_to_host[4];
-            memcpy(public, &ctx->recv_buf[8], 64);
-            memcpy(target_iv_to_target, &ctx->recv_buf[72], 4);
-            memcpy(target_iv_to_host, &ctx->recv_buf[76], 4);
+            memcpy(public, &ctx->recv_buf[ofs + 8], 64);
+            memcpy(target_iv_to_target, &ctx->recv_buf[ofs + 72], 4);
+            memcpy(target_iv_to_host, &ctx->recv_buf[ofs + 76], 4);
             sl_security_increase_security_rsp(public, target_iv_to_target, target_iv_to_host);
           } else {
-            printf("NCP Encryption Failed 0x%02x%02x\n", ctx->recv_buf[5], ctx->recv_buf[4]);
+            printf("NCP Encryption Failed 0x%02x%02x\n", ctx->recv_buf[ofs + 5], ctx->recv_buf[ofs + 4]);
           }
           break;
         case gecko_evt_system_boot_id:
@@ -93,13 +95,13 @@ void sl_bgapi_recv_data(sl_bgapi_context_t *ctx, char *buf, int len)
           break;
       }
       //process packet
-      sl_bgapi_process_packet_cb(ctx, &ctx->recv_buf[0], packet_len, 0);
+      sl_bgapi_process_packet_cb(ctx, &ctx->recv_buf[ofs], packet_len, 0);
     }
-
-    //drop packet from buffer
-    memmove(&ctx->recv_buf[0], &ctx->recv_buf[packet_len], ctx->recv_len - packet_len);
-    ctx->recv_len -= packet_len;
+    ofs += packet_len;
   }
+  //drop processed packets from buffer
+  memmove(&ctx->recv_buf[0], &ctx->recv_buf[ofs], ctx->recv_len - ofs);
+  ctx->recv_len -= ofs;
 }
 void sl_bgapi_context_init(sl_bgapi_context_t *ctx, int fd)
 {
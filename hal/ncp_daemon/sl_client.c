@@ -0,0 +1,352 @@
+/*************************************************************************
+    > File Name: sl_client.c
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Local clients sharing the NCP through the daemon.
+    >
+    > BGAPI responses carry no reference to the command, so only one command
+    > is in flight to the NCP at a time. Each client may have one pending
+    > command, reading from it stops until the command is sent, and clients
+    > are served round robin. Data to clients is queued per client, a client
+    > which does not read only loses its own packets.
+ ************************************************************************/
+
+/* Includes *********************************************************** */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "host_gecko.h"
+#include "sl_client.h"
+#include "sl_poll.h"
+#include "sl_security.h"
+
+/* Static Variables *************************************************** */
+static sl_client_t *clients = NULL;
+/* Next client to serve */
+static sl_client_t *rr_next = NULL;
+/* Command in flight, owner is NULL if the client closed meanwhile */
+static int busy = 0;
+static sl_client_t *owner = NULL;
+static int deadline = 0;
+static int security_pending = 0;
+
+/* Static Functions Declaractions ************************************* */
+static unsigned frame_len(sl_client_t *c)
+{
+  uint32_t hdr;
+  unsigned len;
+
+  if (c->rx_len < BGLIB_MSG_HEADER_LEN) {
+    return 0;
+  }
+  memcpy(&hdr, c->rx_buf, BGLIB_MSG_HEADER_LEN);
+  len = BGLIB_MSG_LEN(hdr) + BGLIB_MSG_HEADER_LEN;
+  return len <= c->rx_len ? len : 0;
+}
+
+static void drop_frame(sl_client_t *c, unsigned len)
+{
+  memmove(c->rx_buf, c->rx_buf + len, c->rx_len - len);
+  c->rx_len -= len;
+}
+
+static void update_events(sl_client_t *c)
+{
+  int events = (frame_len(c) ? 0 : POLLIN) | (c->tx_len ? POLLOUT : 0);
+  sl_poll_modify(c->fd, events);
+}
+
+static int flush(sl_client_t *c)
+{
+  while (c->tx_len) {
+    int n = send(c->fd, c->tx_buf + c->tx_head, c->tx_len, 0);
+    if (n < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        break;
+      }
+      return -1;
+    }
+    c->tx_head += n;
+    c->tx_len -= n;
+  }
+  if (!c->tx_len) {
+    c->tx_head = 0;
+  }
+  return 0;
+}
+
+static void queue(sl_client_t *c, char *buf, int len)
+{
+  if (c->tx_head + c->tx_len + len > sizeof(c->tx_buf)) {
+    memmove(c->tx_buf, c->tx_buf + c->tx_head, c->tx_len);
+    c->tx_head = 0;
+  }
+  if (c->tx_len + len > sizeof(c->tx_buf)) {
+    //client does not keep up, drop instead of blocking the others
+    if (c->dropped++ % 100 == 0) {
+      printf("client %d slow, %u packets dropped\n", c->fd, c->dropped);
+    }
+    return;
+  }
+  int was_empty = !c->tx_len;
+  memcpy(c->tx_buf + c->tx_head + c->tx_len, buf, len);
+  c->tx_len += len;
+  if (was_empty) {
+    flush(c);
+    if (c->tx_len) {
+      update_events(c);
+    }
+  }
+}
+
+/* Handle the daemon control frames at the head of rx, drop invalid data */
+static void process_rx(sl_client_t *c)
+{
+  uint32_t hdr;
+  unsigned len;
+
+  while (c->rx_len >= BGLIB_MSG_HEADER_LEN) {
+    uint8_t type = (uint8_t)c->rx_buf[0];
+    memcpy(&hdr, c->rx_buf, BGLIB_MSG_HEADER_LEN);
+    len = BGLIB_MSG_LEN(hdr) + BGLIB_MSG_HEADER_LEN;
+    if (len > MAX_PACKET_SIZE
+        || (type != SL_CLIENT_CTRL_TYPE
+            && ((type & gecko_dev_type_gecko) == 0 || (type & gecko_msg_type_evt)))) {
+      printf("client %d sent invalid data\n", c->fd);
+      c->rx_len = 0;
+      return;
+    }
+    if (type != SL_CLIENT_CTRL_TYPE || len > c->rx_len) {
+      return;
+    }
+    if (c->rx_buf[2] == SL_CLIENT_CTRL_FILTER
+        && len == BGLIB_MSG_HEADER_LEN + SL_CLIENT_FILTER_LEN) {
+      memcpy(c->filter, c->rx_buf + BGLIB_MSG_HEADER_LEN, SL_CLIENT_FILTER_LEN);
+    }
+    drop_frame(c, len);
+  }
+}
+
+/* Command which the NCP does not respond to */
+static int no_response(char *buf)
+{
+  uint32_t hdr;
+  memcpy(&hdr, buf, BGLIB_MSG_HEADER_LEN);
+  return BGLIB_MSG_ID(hdr) == gecko_cmd_system_reset_id
+         || BGLIB_MSG_ID(hdr) == gecko_cmd_dfu_reset_id;
+}
+
+static void inflight_done(void)
+{
+  busy = 0;
+  owner = NULL;
+}
+
+sl_client_t *sl_client_accept(int server, int encrypted)
+{
+  struct sockaddr_un client_sockaddr;
+  socklen_t socklen = sizeof(client_sockaddr);
+  sl_client_t *c, **pp;
+  int fd;
+
+  fd = accept(server, (struct sockaddr *) &client_sockaddr, &socklen);
+  if (fd < 0) {
+    return NULL;
+  }
+  c = calloc(1, sizeof(sl_client_t));
+  if (!c || fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) < 0
+      || sl_poll_add(fd) < 0) {
+    free(c);
+    close(fd);
+    return NULL;
+  }
+  c->fd = fd;
+  c->encrypted = encrypted;
+  memset(c->filter, 0xff, sizeof(c->filter));
+
+  //append, so the round robin order is the order of connecting
+  for (pp = &clients; *pp; pp = &(*pp)->next) ;
+  *pp = c;
+  return c;
+}
+
+void sl_client_close(sl_client_t *c)
+{
+  sl_client_t **pp;
+
+  for (pp = &clients; *pp; pp = &(*pp)->next) {
+    if (*pp == c) {
+      *pp = c->next;
+      break;
+    }
+  }
+  if (rr_next == c) {
+    rr_next = c->next;
+  }
+  if (owner == c) {
+    //response still comes, it is dropped then
+    owner = NULL;
+  }
+  sl_poll_remove(c->fd);
+  close(c->fd);
+  free(c);
+}
+
+sl_client_t *sl_client_find(int fd)
+{
+  for (sl_client_t *c = clients; c; c = c->next) {
+    if (c->fd == fd) {
+      return c;
+    }
+  }
+  return NULL;
+}
+
+int sl_client_event(sl_client_t *c, int revents)
+{
+  if (revents & POLLOUT) {
+    if (flush(c) < 0) {
+      sl_client_close(c);
+      return -1;
+    }
+  }
+  if (revents & (POLLIN | POLLHUP | POLLERR)) {
+    int len = 0;
+    if (c->rx_len < sizeof(c->rx_buf)) {
+      len = recv(c->fd, c->rx_buf + c->rx_len, sizeof(c->rx_buf) - c->rx_len, 0);
+    }
+    if (len == 0 || (len < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+      printf("Host %s disconnected\n", c->encrypted ? "encrypted" : "unencrypted");
+      sl_client_close(c);
+      return -1;
+    }
+    if (len > 0) {
+      printf("%d>", len); fflush(stdout);
+      c->rx_len += len;
+      process_rx(c);
+    }
+  }
+  update_events(c);
+  sl_client_schedule();
+  return 0;
+}
+
+void sl_client_forward(char *buf, int len, int encrypted)
+{
+  uint8_t type = (uint8_t)buf[0];
+
+  if ((type & gecko_msg_type_evt) == 0) {
+    //response
+    if (!busy) {
+      sl_client_schedule();
+      return;
+    }
+    if (owner && (!encrypted || owner->encrypted)) {
+      queue(owner, buf, len);
+    }
+    inflight_done();
+    sl_client_schedule();
+    return;
+  }
+
+  uint32_t hdr;
+  memcpy(&hdr, buf, BGLIB_MSG_HEADER_LEN);
+  if (BGLIB_MSG_ID(hdr) == gecko_evt_system_boot_id
+      || BGLIB_MSG_ID(hdr) == gecko_evt_dfu_boot_id) {
+    //NCP reset, command in flight is lost
+    inflight_done();
+  }
+
+  uint8_t cls = (uint8_t)buf[2];
+  for (sl_client_t *c = clients; c; c = c->next) {
+    if (encrypted && !c->encrypted) {
+      continue;
+    }
+    if (c->filter[cls / 8] & (1 << (cls % 8))) {
+      queue(c, buf, len);
+    }
+  }
+  sl_client_schedule();
+}
+
+void sl_client_schedule(void)
+{
+  sl_client_t *c;
+  unsigned len;
+
+  if (busy) {
+    return;
+  }
+  if (security_pending) {
+    security_pending = 0;
+    sl_security_start();
+    if (sl_security_state() == sl_security_state_increase_security) {
+      //handshake command is in flight, its response goes to nobody
+      busy = 1;
+      deadline = sl_poll_ticks() + SL_CLIENT_CMD_TIMEOUT;
+      return;
+    }
+  }
+  if (!clients) {
+    return;
+  }
+  if (!rr_next) {
+    rr_next = clients;
+  }
+
+  c = rr_next;
+  do {
+    len = frame_len(c);
+    if (len && (!c->encrypted
+                || sl_security_state() == sl_security_state_encrypted)) {
+      rr_next = c->next;
+      if (!no_response(c->rx_buf)) {
+        busy = 1;
+        owner = c;
+        deadline = sl_poll_ticks() + SL_CLIENT_CMD_TIMEOUT;
+      }
+      sl_client_write_ncp_cb(c->rx_buf, len, c->encrypted);
+      drop_frame(c, len);
+      process_rx(c);
+      update_events(c);
+      if (!busy) {
+        sl_client_schedule();
+      }
+      return;
+    }
+    c = c->next ? c->next : clients;
+  } while (c != rr_next);
+}
+
+int sl_client_timeout(int now)
+{
+  if (!busy) {
+    return 0;
+  }
+  if (now - deadline >= 0) {
+    printf("NCP response timeout\n");
+    inflight_done();
+    sl_client_schedule();
+    return busy ? SL_CLIENT_CMD_TIMEOUT : 0;
+  }
+  return deadline - now;
+}
+
+void sl_client_security_start(void)
+{
+  for (sl_client_t *c = clients; c; c = c->next) {
+    if (c->encrypted) {
+      security_pending = 1;
+      sl_client_schedule();
+      return;
+    }
+  }
+}
@@ -0,0 +1,111 @@
+/*************************************************************************
+    > File Name: sl_client.h
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Local clients sharing the NCP through the daemon
+ ************************************************************************/
+
+#ifndef SL_CLIENT_H
+#define SL_CLIENT_H
+
+#include <stdint.h>
+#include "config.h"
+
+/*
+ * Daemon control frame, sent by a client like a BGAPI command but with
+ * message type 0x00 in the first header byte, it is never forwarded to the
+ * NCP.
+ *   byte 0: SL_CLIENT_CTRL_TYPE
+ *   byte 1: payload length
+ *   byte 2: opcode
+ *   byte 3: 0
+ *
+ * SL_CLIENT_CTRL_FILTER sets the event filter, the payload is a 32 bytes
+ * bitmap where bit n (byte n / 8, bit n % 8) subscribes to events of BGAPI
+ * class ID n. A new client is subscribed to all classes. Command responses
+ * always go to the client which sent the command.
+ */
+#define SL_CLIENT_CTRL_TYPE 0x00
+#define SL_CLIENT_CTRL_FILTER 0x01
+#define SL_CLIENT_FILTER_LEN 32
+
+typedef struct sl_client{
+  struct sl_client *next;
+  int fd;
+  int encrypted;
+  uint8_t filter[SL_CLIENT_FILTER_LEN];
+  /* Received data, the first complete frame is the pending command */
+  unsigned rx_len;
+  char rx_buf[MAX_PACKET_SIZE * 2];
+  /* Data the client did not take yet */
+  unsigned tx_head;
+  unsigned tx_len;
+  char tx_buf[SL_CLIENT_TXBUF_SIZE];
+  unsigned dropped;
+}sl_client_t;
+
+/***********************************************************************************************//**
+ *  \brief  Accept a client on a server socket.
+ *  \param  server Listening socket.
+ *  \param encrypted Commands of the client are encrypted before sent to the NCP.
+ *  \return  the new client, NULL on failure.
+ **************************************************************************************************/
+sl_client_t *sl_client_accept(int server, int encrypted);
+
+/***********************************************************************************************//**
+ *  \brief  Close a client, its pending command is dropped.
+ *  \param  c client.
+ **************************************************************************************************/
+void sl_client_close(sl_client_t *c);
+
+/***********************************************************************************************//**
+ *  \brief  Find the client using a file descriptor.
+ *  \param  fd File descriptor.
+ *  \return  the client, NULL if fd is not a client.
+ **************************************************************************************************/
+sl_client_t *sl_client_find(int fd);
+
+/***********************************************************************************************//**
+ *  \brief  Handle poll events of a client.
+ *  \param  c client.
+ *  \param revents Poll events.
+ *  \return  0 on success, -1 if the client is closed.
+ **************************************************************************************************/
+int sl_client_event(sl_client_t *c, int revents);
+
+/***********************************************************************************************//**
+ *  \brief  Forward a packet from the NCP. Responses go to the client which sent the command,
+ *          events to all clients subscribed to the class.
+ *  \param  buf packet.
+ *  \param len Length of packet.
+ *  \param encrypted Packet was encrypted on the link, only encrypted clients get it.
+ **************************************************************************************************/
+void sl_client_forward(char *buf, int len, int encrypted);
+
+/***********************************************************************************************//**
+ *  \brief  Send the next pending command to the NCP if none is in flight. Clients are
+ *          served round robin, one command each.
+ **************************************************************************************************/
+void sl_client_schedule(void);
+
+/***********************************************************************************************//**
+ *  \brief  Check the in flight command for timeout.
+ *  \param  now Current ticks in ms.
+ *  \return  ms until the in flight command times out, 0 if none is in flight.
+ **************************************************************************************************/
+int sl_client_timeout(int now);
+
+/***********************************************************************************************//**
+ *  \brief  Start the security handshake once no command is in flight.
+ **************************************************************************************************/
+void sl_client_security_start(void);
+
+/***********************************************************************************************//**
+ *  \brief  Callback to write a command to the NCP.
+ *  \param  buf command.
+ *  \param len Length of command.
+ *  \param encrypted Command needs to be encrypted.
+ **************************************************************************************************/
+void sl_client_write_ncp_cb(char *buf, unsigned len, int encrypted);
+
+#endif
@@ -28,16 +28,69 @@
 #include <string.h>
 #include <unistd.h>
 #include <poll.h>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
 #include "sl_poll.h"
 
-static struct pollfd polled[SL_POLL_MAX];
+#ifdef __linux__
+/* epoll keeps the interest list in the kernel, only ready descriptors are
+ * returned so the cost does not grow with the number of clients */
+static int epfd = -1;
+static struct epoll_event ready[SL_POLL_EVENTS];
+static int num_ready = 0;
+
+static int epoll_set(int op, int fd, int events)
+{
+  struct epoll_event ev;
+  memset(&ev, 0, sizeof(ev));
+  ev.events = (events & POLLIN ? EPOLLIN : 0) | (events & POLLOUT ? EPOLLOUT : 0);
+  ev.data.fd = fd;
+  return epoll_ctl(epfd, op, fd, &ev);
+}
+
+int sl_poll_add(int fd)
+{
+  return epoll_set(EPOLL_CTL_ADD, fd, POLLIN);
+}
+int sl_poll_modify(int fd, int events)
+{
+  return epoll_set(EPOLL_CTL_MOD, fd, events);
+}
+void sl_poll_remove(int fd)
+{
+  struct epoll_event ev;
+  epoll_ctl(epfd, EPOLL_CTL_DEL, fd, &ev);
+  //drop events of fd which are not dispatched yet
+  for (int i = 0; i < num_ready; i++) {
+    if (ready[i].data.fd == fd) {
+      ready[i].events = 0;
+    }
+  }
+}
+int sl_poll_init()
+{
+  epfd = epoll_create1(EPOLL_CLOEXEC);
+  return epfd < 0 ? -1 : 0;
+}
+#else
+/* poll() fallback for platforms without epoll, the table grows on demand */
+static struct pollfd *polled = NULL;
 static int max_polled = 0;
+static int cap_polled = 0;
 static int update_polled = 0;
 
 int sl_poll_add(int fd)
 {
-  if (max_polled >= SL_POLL_MAX) {
-    return -1;
+  if (max_polled >= cap_polled) {
+    int cap = cap_polled ? cap_polled * 2 : SL_POLL_EVENTS;
+    struct pollfd *p = realloc(polled, cap * sizeof(struct pollfd));
+    if (!p) {
+      return -1;
+    }
+    polled = p;
+    cap_polled = cap;
   }
   polled[max_polled].fd = fd;
   polled[max_polled].events = POLLIN;
@@ -45,30 +98,33 @@ int sl_poll_add(int fd)
   max_polled++;
   return 0;
 }
+int sl_poll_modify(int fd, int events)
+{
+  for (int i = 0; i < max_polled; i++) {
+    if (polled[i].fd == fd) {
+      polled[i].events = events;
+      return 0;
+    }
+  }
+  return -1;
+}
 void sl_poll_remove(int fd)
 {
   int i;
   for (i = 0; i < max_polled; i++) {
     if (polled[i].fd == fd) {
       polled[i].fd = -1;
+      polled[i].revents = 0;
       update_polled = 1;
       return;
     }
   }
 }
-int sl_poll_is_polled(int fd)
-{
-  for (int i = 0; i < max_polled; i++) {
-    if (polled[i].fd == fd) {
-      return 1;
-    }
-  }
-  return 0;
-}
 int sl_poll_init()
 {
   return 0;
 }
+#endif
 int sl_poll_ticks(void*_hw)
 {
   struct timeval tv;
@@ -78,6 +134,30 @@ int sl_poll_ticks(void*_hw)
 
   return (tv.tv_sec * 1000) + (tv.tv_usec / 1000);
 }
+#ifdef __linux__
+int sl_poll_wait(int timeout)
+{
+  num_ready = epoll_wait(epfd, ready, SL_POLL_EVENTS, timeout == 0 ? -1 : timeout);
+  if (num_ready < 0) {
+    num_ready = 0;
+    return -1;
+  }
+  return num_ready;
+}
+int sl_poll_update()
+{
+  for (int i = 0; i < num_ready; i++) {
+    if (ready[i].events == 0) {
+      continue;
+    }
+    //EPOLLIN/OUT/ERR/HUP have the same values as their POLL counterparts
+    sl_poll_cb(ready[i].data.fd, ready[i].events);
+  }
+  num_ready = 0;
+
+  return 0;
+}
+#else
 int sl_poll_wait(int timeout)
 {
   int result;
@@ -93,6 +173,7 @@ int sl_poll_wait(int timeout)
       w++;
     }
     max_polled = w;
+    update_polled = 0;
   }
 
   result = poll(polled, max_polled, timeout == 0 ? -1 : timeout);
@@ -100,8 +181,10 @@ int sl_poll_wait(int timeout)
 }
 int sl_poll_update()
 {
-  for (int i = 0; i < max_polled; i++) {
-    if (polled[i].revents == 0) {
+  //callbacks may add descriptors, only dispatch the ones which were polled
+  int n = max_polled;
+  for (int i = 0; i < n; i++) {
+    if (polled[i].fd == -1 || polled[i].revents == 0) {
       continue;
     }
 
@@ -110,3 +193,4 @@ int sl_poll_update()
 
   return 0;
 }
+#endif
@@ -18,16 +18,17 @@
  #ifndef SL_POLL_H
 #define SL_POLL_H
 
-//max number of descriptors to poll
-#define SL_POLL_MAX 10
+//max number of ready descriptors handled per wait
+#define SL_POLL_EVENTS 32
 
 int sl_poll_init();
 int sl_poll_ticks();
 int sl_poll_wait(int timeout);
 int sl_poll_update();
 int sl_poll_add(int fd);
+//events is a mask of POLLIN and POLLOUT
+int sl_poll_modify(int fd, int events);
 void sl_poll_remove(int fd);
 int sl_poll_cb(int fd, int revents);
-int sl_poll_is_polled(int fd);
 
 #endif
@@ -186,6 +186,53 @@ static EVP_PKEY *ec_key(const public_key_t *key,
   return result;
 }
 
+/* Cipher contexts of the current security session. The key schedule is set up
+ * once when the session key is derived, each packet only loads a new nonce. */
+static EVP_CIPHER_CTX *ccm_enc = NULL;
+static EVP_CIPHER_CTX *ccm_dec = NULL;
+
+static void ccm_session_close(void)
+{
+  if (ccm_enc) {
+    EVP_CIPHER_CTX_free(ccm_enc);
+    ccm_enc = NULL;
+  }
+  if (ccm_dec) {
+    EVP_CIPHER_CTX_free(ccm_dec);
+    ccm_dec = NULL;
+  }
+}
+
+static errorcode_t ccm_session_open(const uint8_t *key)
+{
+  ccm_session_close();
+
+  ccm_enc = EVP_CIPHER_CTX_new();
+  ccm_dec = EVP_CIPHER_CTX_new();
+  if (!ccm_enc || !ccm_dec) {
+    ccm_session_close();
+    return bg_err_out_of_memory;
+  }
+
+  if (EVP_EncryptInit_ex(ccm_enc, EVP_aes_128_ccm(), NULL, NULL, NULL) != 1
+      || EVP_CIPHER_CTX_ctrl(ccm_enc, EVP_CTRL_CCM_SET_IVLEN,
+                             NONCE_LEN, NULL) != 1
+      || EVP_CIPHER_CTX_ctrl(ccm_enc, EVP_CTRL_CCM_SET_TAG,
+                             MAC_LEN, NULL) != 1
+      || EVP_EncryptInit_ex(ccm_enc, NULL, NULL, key, NULL) != 1
+      || EVP_DecryptInit_ex(ccm_dec, EVP_aes_128_ccm(), NULL, NULL, NULL) != 1
+      || EVP_CIPHER_CTX_ctrl(ccm_dec, EVP_CTRL_CCM_SET_IVLEN,
+                             NONCE_LEN, NULL) != 1
+      || EVP_CIPHER_CTX_ctrl(ccm_dec, EVP_CTRL_CCM_SET_TAG,
+                             MAC_LEN, NULL) != 1
+      || EVP_DecryptInit_ex(ccm_dec, NULL, NULL, key, NULL) != 1) {
+    ccm_session_close();
+    return bg_err_unspecified;
+  }
+
+  return bg_err_success;
+}
+
 static errorcode_t ecdh_secret(const public_key_t *remote_ec_key)
 {
   EVP_PKEY_CTX *ctxt = NULL;
@@ -242,7 +289,7 @@ static errorcode_t ecdh_secret(const public_key_t *remote_ec_key)
   }
 
   memcpy(ccm_key, hash, KEY_SIZE);
-  e = bg_err_success;
+  e = ccm_session_open(ccm_key);
 
   out:
   if (secret_ptr) {
@@ -261,37 +308,27 @@ static errorcode_t ecdh_secret(const public_key_t *remote_ec_key)
   return e;
 }
 
-static errorcode_t aes_ccm_encrypt(const uint8_t *key, const uint8_t *nonce,
+static errorcode_t aes_ccm_encrypt(EVP_CIPHER_CTX *ccm, const uint8_t *nonce,
                                    const uint8_t *plain_text, const size_t text_len,
                                    const uint8_t *additional, const size_t additional_len,
                                    uint8_t *cipher_text, uint8_t *mac)
 {
-  EVP_CIPHER_CTX *ccm = NULL;
   int len;
-  errorcode_t r;
 
-  ccm = EVP_CIPHER_CTX_new();
   if (!ccm) {
-    r = bg_err_unspecified;
-    goto out;
+    return bg_err_wrong_state;
   }
 
-  if (EVP_EncryptInit_ex(ccm, EVP_aes_128_ccm(), NULL, NULL, NULL) != 1
-      || EVP_CIPHER_CTX_ctrl(ccm, EVP_CTRL_CCM_SET_IVLEN,
-                             NONCE_LEN, NULL) != 1
-      || EVP_CIPHER_CTX_ctrl(ccm, EVP_CTRL_CCM_SET_TAG,
-                             MAC_LEN, NULL) != 1
-      || EVP_EncryptInit_ex(ccm, NULL, NULL, key, nonce) != 1) {
-    r = bg_err_unspecified;
-    goto out;
+  // Key is already loaded, only the nonce changes per packet
+  if (EVP_EncryptInit_ex(ccm, NULL, NULL, NULL, nonce) != 1) {
+    return bg_err_unspecified;
   }
 
   // Provide the total plain text length
   if (EVP_EncryptUpdate(ccm,
                         NULL, &len,
                         NULL, text_len) != 1) {
-    r = bg_err_unspecified;
-    goto out;
+    return bg_err_unspecified;
   }
 
   // Provide any AAD data. This can be called zero or one times as required
@@ -299,13 +336,11 @@ static errorcode_t aes_ccm_encrypt(const uint8_t *key, const uint8_t *nonce,
     if (EVP_EncryptUpdate(ccm,
                           NULL, &len,
                           additional, additional_len) != 1) {
-      r = bg_err_unspecified;
-      goto out;
+      return bg_err_unspecified;
     }
   }
   if (len != additional_len) {
-    r = bg_err_unspecified;
-    goto out;
+    return bg_err_unspecified;
   }
 
   /* Provide the message to be encrypted, and obtain the encrypted output.
@@ -313,62 +348,43 @@ static errorcode_t aes_ccm_encrypt(const uint8_t *key, const uint8_t *nonce,
   if (EVP_EncryptUpdate(ccm,
                         cipher_text, &len,
                         plain_text, text_len) != 1) {
-    r = bg_err_unspecified;
-    goto out;
+    return bg_err_unspecified;
   }
   if (len != text_len) {
-    r = bg_err_unspecified;
-    goto out;
+    return bg_err_unspecified;
   }
 
   // Get the tag
   if (EVP_CIPHER_CTX_ctrl(ccm, EVP_CTRL_CCM_GET_TAG,
                           MAC_LEN, mac) != 1) {
-    r = bg_err_unspecified;
-    goto out;
-  }
-
-  r = bg_err_success;
-
-  out:
-  if (ccm) {
-    EVP_CIPHER_CTX_free(ccm);
+    return bg_err_unspecified;
   }
 
-  return r;
+  return bg_err_success;
 }
 
-static errorcode_t aes_ccm_decrypt(const uint8_t *key, const uint8_t *nonce,
+static errorcode_t aes_ccm_decrypt(EVP_CIPHER_CTX *ccm, const uint8_t *nonce,
                                    const uint8_t *cipher_text, const size_t text_len,
                                    const uint8_t *additional, const size_t additional_len,
                                    uint8_t *plain_text, const uint8_t *mac)
 {
-  EVP_CIPHER_CTX *ccm = NULL;
   int len;
-  errorcode_t r;
 
-  ccm = EVP_CIPHER_CTX_new();
   if (!ccm) {
-    r = bg_err_unspecified;
-    goto out;
+    return bg_err_wrong_state;
   }
 
-  if (EVP_DecryptInit_ex(ccm, EVP_aes_128_ccm(), NULL, NULL, NULL) != 1
-      || EVP_CIPHER_CTX_ctrl(ccm, EVP_CTRL_CCM_SET_IVLEN,
-                             NONCE_LEN, NULL) != 1
+  if (EVP_DecryptInit_ex(ccm, NULL, NULL, NULL, nonce) != 1
       || EVP_CIPHER_CTX_ctrl(ccm, EVP_CTRL_CCM_SET_TAG,
-                             MAC_LEN, (void *)mac) != 1
-      || EVP_DecryptInit_ex(ccm, NULL, NULL, key, nonce) != 1) {
-    r = bg_err_unspecified;
-    goto out;
+                             MAC_LEN, (void *)mac) != 1) {
+    return bg_err_unspecified;
   }
 
   // Provide the total plain text length
   if (EVP_DecryptUpdate(ccm,
                         NULL, &len,
                         NULL, text_len) != 1) {
-    r = bg_err_unspecified;
-    goto out;
+    return bg_err_unspecified;
   }
 
   // Provide any AAD data. This can be called zero or one times as required
@@ -376,13 +392,11 @@ static errorcode_t aes_ccm_decrypt(const uint8_t *key, const uint8_t *nonce,
     if (EVP_DecryptUpdate(ccm,
                           NULL, &len,
                           additional, additional_len) != 1) {
-      r = bg_err_unspecified;
-      goto out;
+      return bg_err_unspecified;
     }
   }
   if (len != additional_len) {
-    r = bg_err_unspecified;
-    goto out;
+    return bg_err_unspecified;
   }
 
   /* Provide the message to be decrypted, and obtain the decrypted output.
@@ -390,22 +404,13 @@ static errorcode_t aes_ccm_decrypt(const uint8_t *key, const uint8_t *nonce,
   if (EVP_DecryptUpdate(ccm,
                         plain_text, &len,
                         cipher_text, text_len) != 1) {
-    r = bg_err_bt_authentication_failure;
-    goto out;
+    return bg_err_bt_authentication_failure;
   }
   if (len != text_len) {
-    r = bg_err_unspecified;
-    goto out;
-  }
-
-  r = bg_err_success;
-
-  out:
-  if (ccm) {
-    EVP_CIPHER_CTX_free(ccm);
+    return bg_err_unspecified;
   }
 
-  return r;
+  return bg_err_success;
 }
 
 static void increase_counter(conn_nonce_t* counter)
@@ -432,6 +437,7 @@ int sl_security_init()
 
 void sl_security_reset()
 {
+  ccm_session_close();
   change_state(sl_security_state_unencrypted);
 }
 
@@ -521,7 +527,7 @@ void sl_security_decrypt_packet(char *src, char *dst, unsigned *len)
   memcpy(auth_data + 2, &nonce.counter, 4);
   auth_data[6] = nonce.counter_hi;
 
-  errorcode_t err = aes_ccm_decrypt(ccm_key, (uint8_t *)&nonce,
+  errorcode_t err = aes_ccm_decrypt(ccm_dec, (uint8_t *)&nonce,
                                     (uint8_t *)src + 2, *len - 2,
                                     auth_data, 7,
                                     (uint8_t *)dst, (uint8_t *)src + *len);
@@ -549,7 +555,7 @@ void sl_security_encrypt_packet(char *src, char *dst, unsigned *len)
   memcpy(auth_data + 2, &sec_counter_out.counter, 4);
   auth_data[6] = sec_counter_out.counter_hi;
 
-  errorcode_t err = aes_ccm_encrypt(ccm_key, (uint8_t *)&sec_counter_out,
+  errorcode_t err = aes_ccm_encrypt(ccm_enc, (uint8_t *)&sec_counter_out,
                                     (uint8_t *)src + 2, *len - 2,
                                     auth_data, 7,
                                     (uint8_t *)dst, (uint8_t *)dst + *len - 2);
@@ -0,0 +1,306 @@
+/*************************************************************************
+    > File Name: sl_security_bench.c
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Packets per second of the NCP security layer per payload
+    > size, compared with the UART budget.
+    >
+    > The bench plays the NCP target: it answers the security handshake with
+    > its own key pair, so it derives the same session key and can produce
+    > target to host packets and check host to target packets.
+ ************************************************************************/
+
+/* Includes *********************************************************** */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <openssl/opensslv.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+
+#include "host_gecko.h"
+#include "sl_security.h"
+#include "sl_bgapi.h"
+#include "config.h"
+
+/* Defines  *********************************************************** */
+#if OPENSSL_VERSION_NUMBER < 0x30000000L
+#error "sl_security_bench needs the EVP_PKEY APIs of OpenSSL 3"
+#endif
+
+#define KEY_SIZE 16
+#define PUBLIC_KEY_SIZE 64
+#define NONCE_LEN 13
+#define MAC_LEN 4
+#define SEC_OVERHEAD 9
+
+#define DEFAULT_BAUD_RATE 115200
+#define DEFAULT_ITERATIONS 20000
+
+/* Static Variables *************************************************** */
+static const unsigned payload_sizes[] = { 0, 8, 16, 32, 64, 128, 200, 240 };
+
+static uint8_t host_pub[PUBLIC_KEY_SIZE];
+static uint8_t host_iv_to_target[4];
+static uint8_t host_iv_to_host[4];
+static uint8_t target_iv_to_target[4];
+static uint8_t target_iv_to_host[4];
+static uint8_t session_key[KEY_SIZE];
+static uint32_t target_counter = 0;
+
+/* Static Functions Declaractions ************************************* */
+static double now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+ * Reference AES-CCM with a fresh cipher context per packet, this is how the
+ * security layer worked before the session contexts were cached.
+ */
+static int ref_ccm(int enc, const uint8_t *nonce,
+                   const uint8_t *in, int in_len,
+                   const uint8_t *aad, int aad_len,
+                   uint8_t *out, uint8_t *mac)
+{
+  EVP_CIPHER_CTX *ccm = EVP_CIPHER_CTX_new();
+  int len, ret = -1;
+
+  if (!ccm) {
+    return -1;
+  }
+  if (EVP_CipherInit_ex(ccm, EVP_aes_128_ccm(), NULL, NULL, NULL, enc) != 1
+      || EVP_CIPHER_CTX_ctrl(ccm, EVP_CTRL_CCM_SET_IVLEN, NONCE_LEN, NULL) != 1
+      || EVP_CIPHER_CTX_ctrl(ccm, EVP_CTRL_CCM_SET_TAG, MAC_LEN,
+                             enc ? NULL : mac) != 1
+      || EVP_CipherInit_ex(ccm, NULL, NULL, session_key, nonce, enc) != 1
+      || EVP_CipherUpdate(ccm, NULL, &len, NULL, in_len) != 1
+      || EVP_CipherUpdate(ccm, NULL, &len, aad, aad_len) != 1
+      || EVP_CipherUpdate(ccm, out, &len, in, in_len) != 1) {
+    goto out;
+  }
+  if (enc && EVP_CIPHER_CTX_ctrl(ccm, EVP_CTRL_CCM_GET_TAG, MAC_LEN, mac) != 1) {
+    goto out;
+  }
+  ret = 0;
+
+  out:
+  EVP_CIPHER_CTX_free(ccm);
+  return ret;
+}
+
+static void fill_nonce(uint8_t *nonce, uint32_t counter,
+                       const uint8_t *host_iv, const uint8_t *target_iv)
+{
+  memcpy(nonce, &counter, 4);
+  nonce[4] = 0;
+  memcpy(nonce + 5, host_iv, 4);
+  memcpy(nonce + 9, target_iv, 4);
+}
+
+/* Plain BGAPI event with the given payload length */
+static unsigned fill_plain(char *pkt, unsigned payload)
+{
+  pkt[0] = 0xa0;
+  pkt[1] = payload;
+  pkt[2] = 0x14;
+  pkt[3] = 0x00;
+  for (unsigned i = 0; i < payload; i++) {
+    pkt[BGLIB_MSG_HEADER_LEN + i] = (char)i;
+  }
+  return payload + BGLIB_MSG_HEADER_LEN;
+}
+
+/* Encrypt a packet as the target does when sending to the host */
+static unsigned target_encrypt(const char *src, unsigned len, char *dst)
+{
+  uint8_t nonce[NONCE_LEN], aad[7];
+
+  dst[0] = src[0] | (1 << 6);
+  dst[1] = src[1] + SEC_OVERHEAD;
+  fill_nonce(nonce, target_counter, host_iv_to_host, target_iv_to_host);
+  memcpy(aad, dst, 2);
+  memcpy(aad + 2, &target_counter, 4);
+  aad[6] = 0;
+  ref_ccm(1, nonce, (uint8_t *)src + 2, len - 2, aad, sizeof(aad),
+          (uint8_t *)dst + 2, (uint8_t *)dst + len);
+  memcpy(dst + len + MAC_LEN, aad + 2, 5);
+  target_counter++;
+  return len + SEC_OVERHEAD;
+}
+
+/* Check a packet the host sent to the target */
+static int target_verify(const char *src, unsigned len, const char *plain)
+{
+  uint8_t nonce[NONCE_LEN], aad[7], out[MAX_PACKET_SIZE];
+  uint32_t counter;
+  unsigned plen = len - SEC_OVERHEAD;
+
+  memcpy(&counter, src + plen + MAC_LEN, 4);
+  fill_nonce(nonce, counter, host_iv_to_target, target_iv_to_target);
+  memcpy(aad, src, 2);
+  memcpy(aad + 2, src + plen + MAC_LEN, 5);
+  if (ref_ccm(0, nonce, (uint8_t *)src + 2, plen - 2, aad, sizeof(aad),
+              out, (uint8_t *)src + plen) != 0) {
+    return -1;
+  }
+  return memcmp(out, plain + 2, plen - 2) ? -1 : 0;
+}
+
+static int handshake(void)
+{
+  EVP_PKEY *key = EVP_PKEY_Q_keygen(NULL, NULL, "EC", "P-256");
+  EVP_PKEY *peer = NULL;
+  EVP_PKEY_CTX *ctx = NULL;
+  uint8_t oct[1 + PUBLIC_KEY_SIZE], secret[32], hash[EVP_MAX_MD_SIZE];
+  uint8_t *pub = NULL;
+  size_t secret_len = sizeof(secret);
+  int ret = -1;
+
+  if (!key) {
+    goto out;
+  }
+  sl_security_start();
+  if (sl_security_state() != sl_security_state_increase_security) {
+    goto out;
+  }
+
+  /* Shared secret from the target side */
+  oct[0] = 0x04; /* uncompressed point */
+  memcpy(oct + 1, host_pub, PUBLIC_KEY_SIZE);
+  peer = EVP_PKEY_new();
+  if (!peer || EVP_PKEY_copy_parameters(peer, key) != 1
+      || EVP_PKEY_set1_encoded_public_key(peer, oct, sizeof(oct)) != 1) {
+    goto out;
+  }
+  ctx = EVP_PKEY_CTX_new(key, NULL);
+  if (!ctx || EVP_PKEY_derive_init(ctx) != 1
+      || EVP_PKEY_derive_set_peer(ctx, peer) != 1
+      || EVP_PKEY_derive(ctx, secret, &secret_len) != 1
+      || secret_len != sizeof(secret)
+      || EVP_Digest(secret, secret_len, hash, NULL, EVP_sha256(), NULL) != 1) {
+    goto out;
+  }
+  memcpy(session_key, hash, KEY_SIZE);
+
+  if (EVP_PKEY_get1_encoded_public_key(key, &pub) != sizeof(oct)
+      || RAND_bytes(target_iv_to_target, 4) != 1
+      || RAND_bytes(target_iv_to_host, 4) != 1) {
+    goto out;
+  }
+  sl_security_increase_security_rsp(pub + 1, target_iv_to_target, target_iv_to_host);
+  if (sl_security_state() == sl_security_state_encrypted) {
+    ret = 0;
+  }
+
+  out:
+  OPENSSL_free(pub);
+  EVP_PKEY_CTX_free(ctx);
+  EVP_PKEY_free(peer);
+  EVP_PKEY_free(key);
+  return ret;
+}
+
+static void bench_size(unsigned payload, int iterations, uint32_t baud)
+{
+  char plain[MAX_PACKET_SIZE], enc[MAX_PACKET_SIZE], dec[MAX_PACKET_SIZE];
+  char *tpkts;
+  unsigned len, tlen;
+  uint8_t nonce[NONCE_LEN], aad[7], mac[MAC_LEN];
+  double t, ref_pps, enc_pps, dec_pps;
+  int i, fails = 0;
+
+  len = fill_plain(plain, payload);
+  memset(nonce, 0, sizeof(nonce));
+  memset(aad, 0, sizeof(aad));
+
+  /* Per packet context, the old behaviour */
+  t = now();
+  for (i = 0; i < iterations; i++) {
+    ref_ccm(1, nonce, (uint8_t *)plain + 2, len - 2, aad, sizeof(aad),
+            (uint8_t *)enc + 2, mac);
+  }
+  ref_pps = iterations / (now() - t);
+
+  /* Cached session context, one packet at a time */
+  t = now();
+  for (i = 0; i < iterations; i++) {
+    tlen = len;
+    sl_security_encrypt_packet(plain, enc, &tlen);
+    if (!tlen) {
+      fails++;
+    }
+  }
+  enc_pps = iterations / (now() - t);
+  if (target_verify(enc, tlen, plain)) {
+    fails++;
+  }
+
+  /* Target to host direction */
+  tpkts = malloc((size_t)iterations * MAX_PACKET_SIZE);
+  if (!tpkts) {
+    return;
+  }
+  for (i = 0; i < iterations; i++) {
+    target_encrypt(plain, len, tpkts + (size_t)i * MAX_PACKET_SIZE);
+  }
+  t = now();
+  for (i = 0; i < iterations; i++) {
+    tlen = len + SEC_OVERHEAD;
+    sl_security_decrypt_packet(tpkts + (size_t)i * MAX_PACKET_SIZE, dec, &tlen);
+    if (tlen != len) {
+      fails++;
+    }
+  }
+  dec_pps = iterations / (now() - t);
+  if (memcmp(dec, plain, len)) {
+    fails++;
+  }
+  free(tpkts);
+
+  printf("%7u %10.0f %10.0f %10.0f %10.0f %6d\n",
+         payload, ref_pps, enc_pps, dec_pps,
+         baud / 10.0 / (len + SEC_OVERHEAD), fails);
+}
+
+/* Stubs of the daemon side */
+int sl_bgapi_user_cmd_increase_security(uint8_t *public_key, uint8_t *iv_to_target, uint8_t *iv_to_host)
+{
+  memcpy(host_pub, public_key, PUBLIC_KEY_SIZE);
+  memcpy(host_iv_to_target, iv_to_target, 4);
+  memcpy(host_iv_to_host, iv_to_host, 4);
+  return 0;
+}
+
+void sl_security_state_change_cb(t_sl_security_state state)
+{
+}
+
+int main(int argc, char* argv[])
+{
+  uint32_t baud = argc > 1 ? (uint32_t)atoi(argv[1]) : DEFAULT_BAUD_RATE;
+  int iterations = argc > 2 ? atoi(argv[2]) : DEFAULT_ITERATIONS;
+
+  if (!baud || iterations <= 0) {
+    printf("Usage: %s [baud rate] [iterations]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  if (handshake()) {
+    printf("security handshake failed\n");
+    return EXIT_FAILURE;
+  }
+
+  printf("packets per second, %d iterations, UART budget at %u baud\n",
+         iterations, baud);
+  printf("%7s %10s %10s %10s %10s %6s\n",
+         "payload", "ref_enc", "enc", "dec", "uart", "fails");
+  for (unsigned i = 0; i < sizeof(payload_sizes) / sizeof(payload_sizes[0]); i++) {
+    bench_size(payload_sizes[i], iterations, baud);
+  }
+  sl_security_reset();
+  return EXIT_SUCCESS;
+}
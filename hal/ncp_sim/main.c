@@ -0,0 +1,428 @@
+/*************************************************************************
+    > File Name: main.c
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Simulated NCP target. Speaks BGAPI on a pseudo terminal,
+    > or on a Unix domain socket like the unencrypted socket of ncp_daemon,
+    > so nwmng attaches to it in insecure or secure mode without any change.
+ ************************************************************************/
+
+/* Includes *********************************************************** */
+/* posix_openpt and friends */
+#define _XOPEN_SOURCE 600
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <termios.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "sim.h"
+
+/* Defines  *********************************************************** */
+/* Data the host does not take is dropped beyond */
+#define TXBUF_SIZE (1024 * 1024)
+#define STAT_INTERVAL 5000
+
+/* Global Variables *************************************************** */
+sim_cfg_t sim_cfg = {
+  .devices = 1000,
+  .dcd = sim_dcd_mixed,
+  .lat_min = 50,
+  .lat_max = 200,
+  .lat_lpn = 1000,
+  .prov_ms = 500,
+  .beacon_ms = 1000,
+  .queue_depth = 8,
+  .prov_sessions = 4,
+  .timeout_ms = 5000,
+  .kr_phase_ms = 500,
+};
+
+/* Static Variables *************************************************** */
+static const char *dcd_names[] = { "light", "ctl", "sensor", "lpn", "mixed" };
+
+/* Host side, the pty master or the connected client */
+static int io_fd = -1;
+static int pty_slave = -1;
+static int server_fd = -1;
+static const char *sock_path = NULL;
+static const char *link_path = NULL;
+static int verbose = 0;
+static int baud = 0;
+static volatile sig_atomic_t stop = 0;
+
+static uint8_t rx_buf[MAX_PACKET_SIZE * 4];
+static unsigned rx_len = 0;
+static uint8_t *tx_buf = NULL;
+static unsigned tx_head = 0, tx_len = 0;
+static unsigned long tx_dropped = 0;
+/* Bytes the baud rate allows to send now */
+static double tx_credit = 0;
+static uint32_t tx_last = 0;
+
+/* Static Functions Declaractions ************************************* */
+uint32_t sim_now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+void sim_send(const struct gecko_cmd_packet *pkt)
+{
+  unsigned len = BGLIB_MSG_HEADER_LEN + BGLIB_MSG_LEN(pkt->header);
+
+  if (io_fd < 0) {
+    return;
+  }
+  if (tx_head + tx_len + len > TXBUF_SIZE) {
+    memmove(tx_buf, tx_buf + tx_head, tx_len);
+    tx_head = 0;
+  }
+  if (tx_len + len > TXBUF_SIZE) {
+    if (tx_dropped++ % 1000 == 0) {
+      printf("host does not read, %lu packets dropped\n", tx_dropped);
+    }
+    return;
+  }
+  memcpy(tx_buf + tx_head + tx_len, pkt, len);
+  tx_len += len;
+  sim_stat.evts++;
+}
+
+void sim_drop_tx(void)
+{
+  tx_head = 0;
+  tx_len = 0;
+  if (pty_slave >= 0) {
+    /* Also what the host did not read from the pty yet */
+    tcflush(pty_slave, TCIFLUSH);
+  }
+}
+
+static int flush(void)
+{
+  unsigned len = tx_len;
+
+  if (baud) {
+    uint32_t now = sim_now();
+    tx_credit += (now - tx_last) * (baud / 10) / 1000.0;
+    tx_last = now;
+    /* Do not save up more than 100 ms of line time */
+    if (tx_credit > baud / 100) {
+      tx_credit = baud / 100;
+    }
+    if (len > tx_credit) {
+      len = (unsigned)tx_credit;
+    }
+  }
+  if (!len) {
+    return 0;
+  }
+  int n = write(io_fd, tx_buf + tx_head, len);
+  if (n < 0) {
+    return errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1;
+  }
+  tx_head += n;
+  tx_len -= n;
+  tx_credit -= n;
+  if (!tx_len) {
+    tx_head = 0;
+  }
+  return 0;
+}
+
+/* Handle the complete commands in rx, drop invalid data */
+static void process_rx(void)
+{
+  struct gecko_cmd_packet pkt;
+  uint32_t hdr;
+  unsigned len;
+
+  while (rx_len >= BGLIB_MSG_HEADER_LEN) {
+    memcpy(&hdr, rx_buf, BGLIB_MSG_HEADER_LEN);
+    len = BGLIB_MSG_LEN(hdr) + BGLIB_MSG_HEADER_LEN;
+    if ((rx_buf[0] & gecko_dev_type_gecko) == 0 || (rx_buf[0] & gecko_msg_type_evt)
+        || len > MAX_PACKET_SIZE) {
+      /* Resync on the next byte */
+      memmove(rx_buf, rx_buf + 1, --rx_len);
+      continue;
+    }
+    if (len > rx_len) {
+      return;
+    }
+    memset(&pkt, 0, sizeof(pkt));
+    memcpy(&pkt, rx_buf, len);
+    memmove(rx_buf, rx_buf + len, rx_len - len);
+    rx_len -= len;
+    sim_mesh_cmd(&pkt);
+  }
+}
+
+static int open_pty(void)
+{
+  struct termios tio;
+  const char *name;
+
+  io_fd = posix_openpt(O_RDWR | O_NOCTTY);
+  if (io_fd < 0 || grantpt(io_fd) || unlockpt(io_fd) || !(name = ptsname(io_fd))) {
+    perror("pty");
+    return -1;
+  }
+  /* Keep the slave open, or the master reads EIO when the host closes it */
+  pty_slave = open(name, O_RDWR | O_NOCTTY);
+  if (pty_slave < 0 || tcgetattr(pty_slave, &tio)) {
+    perror(name);
+    return -1;
+  }
+  cfmakeraw(&tio);
+  tcsetattr(pty_slave, TCSANOW, &tio);
+  fcntl(io_fd, F_SETFL, fcntl(io_fd, F_GETFL) | O_NONBLOCK);
+
+  if (link_path) {
+    unlink(link_path);
+    if (symlink(name, link_path)) {
+      perror(link_path);
+      return -1;
+    }
+    name = link_path;
+  }
+  printf("NCP simulator on %s, run nwmng with -m i -p %s\n", name, name);
+  return 0;
+}
+
+static int open_server(void)
+{
+  struct sockaddr_un addr;
+
+  server_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (server_fd < 0) {
+    perror("socket");
+    return -1;
+  }
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, sock_path, sizeof(addr.sun_path) - 1);
+  unlink(sock_path);
+  if (bind(server_fd, (struct sockaddr *)&addr, sizeof(addr))
+      || listen(server_fd, 1)) {
+    perror(sock_path);
+    return -1;
+  }
+  printf("NCP simulator on %s, run nwmng with -m s -s %s -e 0\n", sock_path, sock_path);
+  return 0;
+}
+
+static void close_client(void)
+{
+  printf("Host disconnected\n");
+  close(io_fd);
+  io_fd = -1;
+  rx_len = 0;
+  tx_head = 0;
+  tx_len = 0;
+}
+
+static void on_signal(int sig)
+{
+  stop = 1;
+}
+
+static int parse_range(const char *s, int *min, int *max)
+{
+  if (sscanf(s, "%d,%d", min, max) == 2) {
+    return *min >= 0 && *max >= *min ? 0 : -1;
+  }
+  if (sscanf(s, "%d", min) == 1 && *min >= 0) {
+    *max = *min;
+    return 0;
+  }
+  return -1;
+}
+
+static void usage(const char *name)
+{
+  printf("Usage: %s [options]\n"
+         "  -s <path>     Serve on a Unix domain socket instead of a pty\n"
+         "  -p <path>     Symlink to the pty slave\n"
+         "  -n <num>      Virtual devices, default %d\n"
+         "  -d <profile>  DCD of the devices, light/ctl/sensor/lpn/mixed, default mixed\n"
+         "  -l <min,max>  Config latency in ms, default %d,%d\n"
+         "  -L <ms>       Config latency of low power nodes, default %d\n"
+         "  -P <ms>       Provisioning time, default %d\n"
+         "  -b <ms>       Beacon interval per device, default %d\n"
+         "  -c <num>      Concurrent provisioning sessions, default %d\n"
+         "  -q <num>      Config requests in flight before out of memory, default %d\n"
+         "  -o <pct>      Out of memory injection\n"
+         "  -t <pct>      Timeout injection\n"
+         "  -f <pct>      Provisioning failure injection\n"
+         "  -T <ms>       Time until a request times out, default %d\n"
+         "  -k <ms>       Key refresh phase duration, default %d\n"
+         "  -B <baud>     Limit the data rate to the host like a UART\n"
+         "  -r <seed>     Random seed\n"
+         "  -v            Print statistics every %d seconds\n",
+         name, sim_cfg.devices, sim_cfg.lat_min, sim_cfg.lat_max,
+         sim_cfg.lat_lpn, sim_cfg.prov_ms, sim_cfg.beacon_ms,
+         sim_cfg.prov_sessions, sim_cfg.queue_depth, sim_cfg.timeout_ms,
+         sim_cfg.kr_phase_ms, STAT_INTERVAL / 1000);
+}
+
+static int parse_args(int argc, char *argv[])
+{
+  int opt, i;
+
+  while ((opt = getopt(argc, argv, "s:p:n:d:l:L:P:b:c:q:o:t:f:T:k:B:r:vh")) != -1) {
+    switch (opt) {
+      case 's': sock_path = optarg; break;
+      case 'p': link_path = optarg; break;
+      case 'n': sim_cfg.devices = atoi(optarg); break;
+      case 'd':
+        for (i = 0; i < sim_dcd_max && strcmp(optarg, dcd_names[i]); i++) ;
+        if (i == sim_dcd_max) {
+          return -1;
+        }
+        sim_cfg.dcd = i;
+        break;
+      case 'l':
+        if (parse_range(optarg, &sim_cfg.lat_min, &sim_cfg.lat_max)) {
+          return -1;
+        }
+        break;
+      case 'L': sim_cfg.lat_lpn = atoi(optarg); break;
+      case 'P': sim_cfg.prov_ms = atoi(optarg); break;
+      case 'b': sim_cfg.beacon_ms = atoi(optarg); break;
+      case 'c': sim_cfg.prov_sessions = atoi(optarg); break;
+      case 'q': sim_cfg.queue_depth = atoi(optarg); break;
+      case 'o': sim_cfg.oom_pct = atoi(optarg); break;
+      case 't': sim_cfg.timeout_pct = atoi(optarg); break;
+      case 'f': sim_cfg.prov_fail_pct = atoi(optarg); break;
+      case 'T': sim_cfg.timeout_ms = atoi(optarg); break;
+      case 'k': sim_cfg.kr_phase_ms = atoi(optarg); break;
+      case 'B': baud = atoi(optarg); break;
+      case 'r': sim_cfg.seed = strtoul(optarg, NULL, 0); break;
+      case 'v': verbose = 1; break;
+      default: return -1;
+    }
+  }
+  if (sim_cfg.devices <= 0 || sim_cfg.beacon_ms <= 0 || sim_cfg.queue_depth <= 0
+      || sim_cfg.prov_sessions <= 0 || baud < 0) {
+    return -1;
+  }
+  if (!sim_cfg.seed) {
+    sim_cfg.seed = (unsigned int)time(NULL);
+  }
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  struct pollfd fds[2];
+  uint32_t start, next_stat;
+  int timeout, n;
+
+  if (parse_args(argc, argv)) {
+    usage(argv[0]);
+    return EXIT_FAILURE;
+  }
+  tx_buf = malloc(TXBUF_SIZE);
+  if (!tx_buf || sim_mesh_init()) {
+    fprintf(stderr, "out of memory\n");
+    return EXIT_FAILURE;
+  }
+  if (sock_path ? open_server() : open_pty()) {
+    return EXIT_FAILURE;
+  }
+  printf("%d devices, DCD %s, seed %u\n", sim_cfg.devices,
+         dcd_names[sim_cfg.dcd], sim_cfg.seed);
+  fflush(stdout);
+
+  signal(SIGINT, on_signal);
+  signal(SIGTERM, on_signal);
+  signal(SIGPIPE, SIG_IGN);
+  start = sim_now();
+  next_stat = start + STAT_INTERVAL;
+  tx_last = start;
+
+  while (!stop) {
+    uint32_t now = sim_now();
+    timeout = sim_sched_run(now);
+    if (io_fd >= 0 && tx_len && flush() < 0) {
+      close_client();
+    }
+    if (verbose && (int32_t)(now - next_stat) >= 0) {
+      sim_mesh_print_stat(now - start);
+      next_stat += STAT_INTERVAL;
+    }
+    if (verbose) {
+      int t = (int32_t)(next_stat - now);
+      timeout = timeout < 0 || t < timeout ? t : timeout;
+    }
+    /* Waiting for line time */
+    if (baud && tx_len && (timeout < 0 || timeout > 1)) {
+      timeout = 1;
+    }
+
+    n = 0;
+    if (io_fd >= 0) {
+      fds[n].fd = io_fd;
+      fds[n].events = POLLIN | (tx_len && !baud ? POLLOUT : 0);
+      n++;
+    } else if (server_fd >= 0) {
+      fds[n].fd = server_fd;
+      fds[n].events = POLLIN;
+      n++;
+    }
+    if (poll(fds, n, timeout) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      perror("poll");
+      break;
+    }
+    if (!n || !fds[0].revents) {
+      continue;
+    }
+    if (fds[0].fd == server_fd) {
+      io_fd = accept(server_fd, NULL, NULL);
+      if (io_fd >= 0) {
+        fcntl(io_fd, F_SETFL, fcntl(io_fd, F_GETFL) | O_NONBLOCK);
+        printf("Host connected\n");
+      }
+      continue;
+    }
+    if (fds[0].revents & POLLOUT && flush() < 0) {
+      close_client();
+      continue;
+    }
+    if (fds[0].revents & (POLLIN | POLLHUP | POLLERR)) {
+      int len = read(io_fd, rx_buf + rx_len, sizeof(rx_buf) - rx_len);
+      if (len == 0 || (len < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+        if (sock_path) {
+          close_client();
+        }
+        continue;
+      }
+      if (len > 0) {
+        rx_len += len;
+        process_rx();
+      }
+    }
+  }
+
+  sim_mesh_print_stat(sim_now() - start);
+  if (sock_path) {
+    unlink(sock_path);
+  }
+  if (link_path) {
+    unlink(link_path);
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,136 @@
+/*************************************************************************
+    > File Name: sim.h
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Simulated NCP target, shared definitions
+ ************************************************************************/
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include "host_gecko.h"
+
+#define MAX_PACKET_SIZE (BGLIB_MSG_HEADER_LEN + BGLIB_MSG_MAX_PAYLOAD)
+
+/* Unprovisioned device UUID is SIM_UUID_PREFIX followed by the big endian
+ * device index from 0, e.g. 6e776d6e672d73696d64657600000001 is device 1 */
+#define SIM_UUID_PREFIX "nwmng-simdev"
+#define SIM_UUID_PREFIX_LEN 12
+
+enum {
+  sim_dcd_light,
+  sim_dcd_ctl,
+  sim_dcd_sensor,
+  sim_dcd_lpn,
+  sim_dcd_mixed,
+  sim_dcd_max
+};
+
+typedef struct {
+  int devices;
+  int dcd;
+  /* Config client latency of a normal node and of a low power node, ms */
+  int lat_min;
+  int lat_max;
+  int lat_lpn;
+  int prov_ms;
+  int beacon_ms;
+  /* Failure injection in percent */
+  int oom_pct;
+  int timeout_pct;
+  int prov_fail_pct;
+  /* Config requests in flight before out of memory is returned */
+  int queue_depth;
+  /* Concurrent provisioning sessions */
+  int prov_sessions;
+  int timeout_ms;
+  int kr_phase_ms;
+  unsigned int seed;
+}sim_cfg_t;
+
+typedef struct {
+  unsigned long cmds;
+  unsigned long evts;
+  unsigned long beacons;
+  unsigned long provisioned;
+  unsigned long prov_failed;
+  unsigned long cc_cmds;
+  unsigned long cc_oom;
+  unsigned long cc_timeouts;
+  unsigned long resets;
+  unsigned long key_refreshes;
+}sim_stat_t;
+
+extern sim_cfg_t sim_cfg;
+extern sim_stat_t sim_stat;
+
+/***********************************************************************************************//**
+ *  \brief  Current ticks in ms, monotonic.
+ **************************************************************************************************/
+uint32_t sim_now(void);
+
+/***********************************************************************************************//**
+ *  \brief  Send a response or an event to the host.
+ *  \param  pkt Packet, the length is taken from the header.
+ **************************************************************************************************/
+void sim_send(const struct gecko_cmd_packet *pkt);
+
+typedef void (*sim_cb_t)(void *arg);
+
+/***********************************************************************************************//**
+ *  \brief  Drop the data not sent to the host yet, used on reset.
+ **************************************************************************************************/
+void sim_drop_tx(void);
+
+/***********************************************************************************************//**
+ *  \brief  Run a callback later.
+ *  \param  delay Delay in ms.
+ *  \param  cb Callback.
+ *  \param  arg Argument of the callback, not owned by the scheduler.
+ **************************************************************************************************/
+void sim_sched(uint32_t delay, sim_cb_t cb, void *arg);
+
+/***********************************************************************************************//**
+ *  \brief  Send a packet later, the packet is copied.
+ *  \param  delay Delay in ms.
+ *  \param  pkt Packet.
+ *  \param  cb Callback after the packet is sent, may be NULL.
+ *  \param  arg Argument of the callback.
+ **************************************************************************************************/
+void sim_sched_pkt(uint32_t delay,
+                   const struct gecko_cmd_packet *pkt,
+                   sim_cb_t cb,
+                   void *arg);
+
+/***********************************************************************************************//**
+ *  \brief  Run the due callbacks.
+ *  \param  now Current ticks in ms.
+ *  \return  ms until the next callback is due, -1 if none is scheduled.
+ **************************************************************************************************/
+int sim_sched_run(uint32_t now);
+
+/***********************************************************************************************//**
+ *  \brief  Drop everything scheduled, used on reset.
+ **************************************************************************************************/
+void sim_sched_clear(void);
+
+/***********************************************************************************************//**
+ *  \brief  Create the virtual devices.
+ *  \return  0 on success, -1 on failure.
+ **************************************************************************************************/
+int sim_mesh_init(void);
+
+/***********************************************************************************************//**
+ *  \brief  Handle a command from the host.
+ *  \param  pkt Command.
+ **************************************************************************************************/
+void sim_mesh_cmd(const struct gecko_cmd_packet *pkt);
+
+/***********************************************************************************************//**
+ *  \brief  Print the statistics.
+ *  \param  elapsed ms since start.
+ **************************************************************************************************/
+void sim_mesh_print_stat(uint32_t elapsed);
+
+#endif
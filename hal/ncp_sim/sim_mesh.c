@@ -0,0 +1,769 @@
+/*************************************************************************
+    > File Name: sim_mesh.c
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Virtual mesh network behind the simulated NCP.
+    >
+    > Only what the provisioner sees is modeled: unprovisioned beacons,
+    > provisioning, the device database, config client requests with their
+    > status events and key refresh. Nothing is encrypted and no mesh packet
+    > is built, the devices answer after a latency drawn per request. Out of
+    > memory, timeouts and provisioning failures are injected at the rates
+    > given on the command line.
+ ************************************************************************/
+
+/* Includes *********************************************************** */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+#include "sim.h"
+
+/* Defines  *********************************************************** */
+#define BEACON_TICK 10
+#define BOOT_DELAY 100
+/* Devices the stack takes into the key refresh blacklist at a time */
+#define KR_BL_MAX 32
+#define UNICAST_MAX 0x8000
+#define PROV_FAIL_REASON 0x04
+
+#define SIM_CID 0x02ff
+#define SIM_VID 0x0001
+#define SIM_CRPL 0x0020
+#define DCD_MAX_LEN 64
+
+enum {
+  dev_unprov,
+  dev_proving,
+  dev_node,
+  /* Provisioned but not in the network anymore, never answers */
+  dev_orphan
+};
+
+typedef struct {
+  uint8_t uuid[16];
+  uint8_t devkey[16];
+  uint8_t dcd;
+  uint8_t state;
+  uint8_t in_ddb;
+  uint8_t bl;
+  /* Times out in the running key refresh */
+  uint8_t kr_stuck;
+  uint8_t elements;
+  uint16_t addr;
+  uint32_t next_beacon;
+}sim_dev_t;
+
+typedef struct {
+  uint8_t elements;
+  uint8_t len;
+  uint8_t data[DCD_MAX_LEN];
+}sim_dcd_t;
+
+/* Config client command and the status event it is answered with */
+typedef struct {
+  uint32_t cmd;
+  uint32_t evt;
+  uint16_t len;
+}cc_map_t;
+
+/* Global Variables *************************************************** */
+sim_stat_t sim_stat;
+
+/* Static Variables *************************************************** */
+static sim_dev_t *devs = NULL;
+static uint32_t *addr_map = NULL;
+static sim_dcd_t dcds[sim_dcd_mixed];
+static uint32_t rnd_state = 1;
+static struct gecko_cmd_packet out;
+
+static struct {
+  int created;
+  uint16_t addr;
+  uint32_t ivi;
+  uint16_t next_addr;
+  uint16_t appkeys;
+  uint8_t netkey[16];
+  int scanning;
+  int beacon_tick;
+  int kr;
+  int bl_num;
+  int prov_busy;
+  int cc_busy;
+  uint32_t handle;
+}net;
+
+#define CC(c, e)                                   \
+  { gecko_cmd_mesh_config_client_##c##_id,         \
+    gecko_evt_mesh_config_client_##e##_id,         \
+    sizeof(struct gecko_msg_mesh_config_client_##e##_evt_t) }
+static const cc_map_t cc_map[] = {
+  CC(get_dcd, dcd_data_end),
+  CC(add_appkey, appkey_status),
+  CC(remove_appkey, appkey_status),
+  CC(bind_model, binding_status),
+  CC(unbind_model, binding_status),
+  CC(add_model_sub, model_sub_status),
+  CC(set_model_sub, model_sub_status),
+  CC(remove_model_sub, model_sub_status),
+  CC(set_model_pub, model_pub_status),
+  CC(set_beacon, beacon_status),
+  CC(set_default_ttl, default_ttl_status),
+  CC(set_friend, friend_status),
+  CC(set_gatt_proxy, gatt_proxy_status),
+  CC(set_network_transmit, network_transmit_status),
+  CC(set_relay, relay_status),
+  CC(reset_node, reset_status),
+};
+
+/* Static Functions Declaractions ************************************* */
+static uint32_t rnd(void)
+{
+  /* xorshift32, repeatable with the same seed */
+  rnd_state ^= rnd_state << 13;
+  rnd_state ^= rnd_state >> 17;
+  rnd_state ^= rnd_state << 5;
+  return rnd_state;
+}
+
+static int hit(int pct)
+{
+  return pct > 0 && (int)(rnd() % 100) < pct;
+}
+
+static uint32_t latency(const sim_dev_t *d)
+{
+  if (d->dcd == sim_dcd_lpn) {
+    return sim_cfg.lat_lpn;
+  }
+  return sim_cfg.lat_min + rnd() % (sim_cfg.lat_max - sim_cfg.lat_min + 1);
+}
+
+static void rand_key(uint8_t *key)
+{
+  for (int i = 0; i < 16; i++) {
+    key[i] = (uint8_t)rnd();
+  }
+}
+
+static void put16(sim_dcd_t *d, uint16_t v)
+{
+  d->data[d->len++] = v & 0xff;
+  d->data[d->len++] = v >> 8;
+}
+
+static void dcd_begin(sim_dcd_t *d, uint16_t pid, uint16_t features)
+{
+  memset(d, 0, sizeof(sim_dcd_t));
+  put16(d, SIM_CID);
+  put16(d, pid);
+  put16(d, SIM_VID);
+  put16(d, SIM_CRPL);
+  put16(d, features);
+}
+
+static void dcd_elem(sim_dcd_t *d,
+                     const uint16_t *sig,
+                     int nsig,
+                     const uint16_t *vnd,
+                     int nvnd)
+{
+  put16(d, 0);
+  d->data[d->len++] = nsig;
+  d->data[d->len++] = nvnd;
+  for (int i = 0; i < nsig; i++) {
+    put16(d, sig[i]);
+  }
+  /* Vendor models are pairs of company and model ID */
+  for (int i = 0; i < nvnd; i++) {
+    put16(d, vnd[2 * i]);
+    put16(d, vnd[2 * i + 1]);
+  }
+  d->elements++;
+}
+
+static void dcd_init(void)
+{
+  static const uint16_t light[] = { 0x0000, 0x0002, 0x1000, 0x1300, 0x1301 };
+  static const uint16_t ctl[] = { 0x0000, 0x0002, 0x1000, 0x1300, 0x1301, 0x1303, 0x1304 };
+  static const uint16_t ctl_temp[] = { 0x1306 };
+  static const uint16_t sensor[] = { 0x0000, 0x0002, 0x1100, 0x1101 };
+  static const uint16_t lpn[] = { 0x0000, 0x0002, 0x1001, 0x1302 };
+  static const uint16_t lpn_vnd[] = { SIM_CID, 0x0001 };
+
+  dcd_begin(&dcds[sim_dcd_light], 0x0001, 0x0007);
+  dcd_elem(&dcds[sim_dcd_light], light, 5, NULL, 0);
+
+  dcd_begin(&dcds[sim_dcd_ctl], 0x0002, 0x0007);
+  dcd_elem(&dcds[sim_dcd_ctl], ctl, 7, NULL, 0);
+  dcd_elem(&dcds[sim_dcd_ctl], ctl_temp, 1, NULL, 0);
+
+  dcd_begin(&dcds[sim_dcd_sensor], 0x0003, 0x0003);
+  dcd_elem(&dcds[sim_dcd_sensor], sensor, 4, NULL, 0);
+
+  dcd_begin(&dcds[sim_dcd_lpn], 0x0004, 0x0008);
+  dcd_elem(&dcds[sim_dcd_lpn], lpn, 4, lpn_vnd, 1);
+}
+
+static sim_dev_t *dev_by_uuid(const uint8_t *uuid)
+{
+  uint32_t idx;
+
+  if (memcmp(uuid, SIM_UUID_PREFIX, SIM_UUID_PREFIX_LEN)) {
+    return NULL;
+  }
+  idx = ((uint32_t)uuid[12] << 24) | ((uint32_t)uuid[13] << 16)
+        | ((uint32_t)uuid[14] << 8) | uuid[15];
+  return idx < (uint32_t)sim_cfg.devices ? &devs[idx] : NULL;
+}
+
+static sim_dev_t *dev_by_addr(uint16_t addr)
+{
+  if (addr >= UNICAST_MAX || !addr_map[addr]) {
+    return NULL;
+  }
+  return &devs[addr_map[addr] - 1];
+}
+
+static void map_addr(sim_dev_t *d, int on)
+{
+  for (int i = 0; i < d->elements; i++) {
+    if (d->addr + i < UNICAST_MAX) {
+      addr_map[d->addr + i] = on ? (uint32_t)(d - devs) + 1 : 0;
+    }
+  }
+}
+
+static void *begin(uint32_t id)
+{
+  memset(&out, 0, sizeof(out));
+  out.header = id;
+  return &out.data;
+}
+
+static void finish(unsigned len)
+{
+  out.header |= ((len & 0xff) << 8) | ((len & 0x700) >> 8);
+}
+
+static void send_out(unsigned len)
+{
+  finish(len);
+  sim_send(&out);
+}
+
+static void rsp_result(uint32_t id, uint16_t result)
+{
+  uint16_t *r = begin(id);
+  *r = result;
+  send_out(sizeof(uint16_t));
+}
+
+static void send_boot(void *arg)
+{
+  struct gecko_msg_system_boot_evt_t *e = begin(gecko_evt_system_boot_id);
+  e->major = 2;
+  e->minor = 13;
+  e->patch = 6;
+  e->build = 1;
+  send_out(sizeof(*e));
+}
+
+static void beacon_tick(void *arg)
+{
+  uint32_t now = sim_now();
+
+  if (!net.scanning) {
+    net.beacon_tick = 0;
+    return;
+  }
+  for (int i = 0; i < sim_cfg.devices; i++) {
+    sim_dev_t *d = &devs[i];
+    if (d->state != dev_unprov || (int32_t)(d->next_beacon - now) > 0) {
+      continue;
+    }
+    /* Jitter of 10%, so the beacons spread over the interval */
+    d->next_beacon = now + sim_cfg.beacon_ms - sim_cfg.beacon_ms / 10
+                     + rnd() % (sim_cfg.beacon_ms / 5 + 1);
+    struct gecko_msg_mesh_prov_unprov_beacon_evt_t *e =
+      begin(gecko_evt_mesh_prov_unprov_beacon_id);
+    e->bearer = 0;
+    memcpy(e->address.addr, d->uuid + 10, sizeof(e->address.addr));
+    e->uuid.len = 16;
+    memcpy(e->uuid.data, d->uuid, 16);
+    send_out(sizeof(*e) + 16);
+    sim_stat.beacons++;
+  }
+  sim_sched(BEACON_TICK, beacon_tick, NULL);
+}
+
+static void system_reset(void)
+{
+  sim_sched_clear();
+  sim_drop_tx();
+  net.scanning = 0;
+  net.beacon_tick = 0;
+  net.kr = 0;
+  net.bl_num = 0;
+  net.prov_busy = 0;
+  net.cc_busy = 0;
+  for (int i = 0; i < sim_cfg.devices; i++) {
+    if (devs[i].state == dev_proving) {
+      devs[i].state = dev_unprov;
+    }
+    devs[i].bl = 0;
+  }
+  sim_stat.resets++;
+  sim_sched(BOOT_DELAY, send_boot, NULL);
+}
+
+static void factory_reset(void)
+{
+  memset(addr_map, 0, UNICAST_MAX * sizeof(uint32_t));
+  for (int i = 0; i < sim_cfg.devices; i++) {
+    devs[i].state = dev_unprov;
+    devs[i].in_ddb = 0;
+    devs[i].addr = 0;
+    devs[i].kr_stuck = 0;
+  }
+  net.created = 0;
+  net.addr = 0;
+  net.ivi = 0;
+  net.next_addr = 0;
+  net.appkeys = 0;
+}
+
+static void prov_done(void *arg)
+{
+  sim_dev_t *d = arg;
+
+  net.prov_busy--;
+  if (d->state != dev_proving) {
+    return;
+  }
+  if (hit(sim_cfg.prov_fail_pct) || net.next_addr + d->elements > UNICAST_MAX) {
+    struct gecko_msg_mesh_prov_provisioning_failed_evt_t *e =
+      begin(gecko_evt_mesh_prov_provisioning_failed_id);
+    d->state = dev_unprov;
+    e->reason = PROV_FAIL_REASON;
+    e->uuid.len = 16;
+    memcpy(e->uuid.data, d->uuid, 16);
+    send_out(sizeof(*e) + 16);
+    sim_stat.prov_failed++;
+    return;
+  }
+
+  d->state = dev_node;
+  d->in_ddb = 1;
+  d->kr_stuck = 0;
+  d->addr = net.next_addr;
+  net.next_addr += d->elements;
+  rand_key(d->devkey);
+  map_addr(d, 1);
+
+  struct gecko_msg_mesh_prov_device_provisioned_evt_t *e =
+    begin(gecko_evt_mesh_prov_device_provisioned_id);
+  e->address = d->addr;
+  e->uuid.len = 16;
+  memcpy(e->uuid.data, d->uuid, 16);
+  send_out(sizeof(*e) + 16);
+  sim_stat.provisioned++;
+}
+
+static void provision_device(const struct gecko_msg_mesh_prov_provision_device_cmd_t *c)
+{
+  sim_dev_t *d = c->uuid.len == 16 ? dev_by_uuid(c->uuid.data) : NULL;
+  uint16_t result = bg_err_success;
+
+  if (!net.created) {
+    result = bg_err_wrong_state;
+  } else if (!d) {
+    result = bg_err_mesh_does_not_exist;
+  } else if (d->in_ddb || d->state == dev_proving) {
+    result = bg_err_mesh_already_exists;
+  } else if (net.prov_busy >= sim_cfg.prov_sessions || hit(sim_cfg.oom_pct)) {
+    result = bg_err_out_of_memory;
+  }
+  rsp_result(gecko_rsp_mesh_prov_provision_device_id, result);
+  if (result != bg_err_success) {
+    return;
+  }
+  if (d->state == dev_unprov) {
+    d->state = dev_proving;
+  }
+  net.prov_busy++;
+  sim_sched(sim_cfg.prov_ms / 2 + rnd() % (sim_cfg.prov_ms + 1), prov_done, d);
+}
+
+static void cc_done(void *arg)
+{
+  net.cc_busy--;
+}
+
+static void send_dcd(sim_dev_t *d, uint32_t handle, uint32_t delay)
+{
+  const sim_dcd_t *dcd = &dcds[d->dcd];
+  struct gecko_msg_mesh_config_client_dcd_data_evt_t *e =
+    begin(gecko_evt_mesh_config_client_dcd_data_id);
+
+  e->handle = handle;
+  e->page = 0;
+  e->data.len = dcd->len;
+  memcpy(e->data.data, dcd->data, dcd->len);
+  finish(sizeof(*e) + dcd->len);
+  sim_sched_pkt(delay, &out, NULL, NULL);
+}
+
+static void config_client(const cc_map_t *m, const struct gecko_cmd_packet *pkt)
+{
+  /* All config client commands start with netkey index and server address */
+  uint16_t server = pkt->data.cmd_mesh_config_client_get_dcd.server_address;
+  sim_dev_t *d = dev_by_addr(server);
+  struct gecko_msg_mesh_config_client_get_dcd_rsp_t *r;
+  struct gecko_msg_mesh_config_client_appkey_status_evt_t *e;
+  uint16_t result = bg_err_success;
+  uint32_t delay, handle;
+
+  sim_stat.cc_cmds++;
+  if (net.cc_busy >= sim_cfg.queue_depth || hit(sim_cfg.oom_pct)) {
+    r = begin(m->cmd);
+    r->result = bg_err_out_of_memory;
+    send_out(sizeof(*r));
+    sim_stat.cc_oom++;
+    return;
+  }
+
+  handle = ++net.handle;
+  r = begin(m->cmd);
+  r->result = bg_err_success;
+  r->handle = handle;
+  send_out(sizeof(*r));
+
+  if (!d || d->state != dev_node || hit(sim_cfg.timeout_pct)) {
+    result = bg_err_timeout;
+    delay = sim_cfg.timeout_ms;
+    sim_stat.cc_timeouts++;
+  } else {
+    delay = latency(d);
+    if (m->cmd == gecko_cmd_mesh_config_client_get_dcd_id) {
+      send_dcd(d, handle, delay);
+    } else if (m->cmd == gecko_cmd_mesh_config_client_reset_node_id) {
+      /* Node forgets the network and beacons again, the DDB entry stays */
+      d->state = dev_unprov;
+      map_addr(d, 0);
+    }
+  }
+
+  /* Every status event starts with result and handle, the rest is 0 */
+  e = begin(m->evt);
+  e->result = result;
+  e->handle = handle;
+  finish(m->len);
+  net.cc_busy++;
+  sim_sched_pkt(delay, &out, cc_done, NULL);
+}
+
+static void ddb_get(const struct gecko_msg_mesh_prov_ddb_get_cmd_t *c)
+{
+  sim_dev_t *d = c->uuid.len == 16 ? dev_by_uuid(c->uuid.data) : NULL;
+  struct gecko_msg_mesh_prov_ddb_get_rsp_t *r = begin(gecko_rsp_mesh_prov_ddb_get_id);
+
+  if (!d || !d->in_ddb) {
+    r->result = bg_err_mesh_does_not_exist;
+  } else {
+    r->result = bg_err_success;
+    memcpy(r->device_key.data, d->devkey, 16);
+    r->netkey_index = 0;
+    r->address = d->addr;
+    r->elements = d->elements;
+  }
+  send_out(sizeof(*r));
+}
+
+static void ddb_delete(const struct gecko_msg_mesh_prov_ddb_delete_cmd_t *c)
+{
+  sim_dev_t *d = dev_by_uuid(c->uuid.data);
+
+  if (!d || !d->in_ddb) {
+    rsp_result(gecko_rsp_mesh_prov_ddb_delete_id, bg_err_mesh_does_not_exist);
+    return;
+  }
+  d->in_ddb = 0;
+  if (d->state == dev_node) {
+    /* Still has the network keys, but nobody talks to it anymore */
+    d->state = dev_orphan;
+    map_addr(d, 0);
+  }
+  rsp_result(gecko_rsp_mesh_prov_ddb_delete_id, bg_err_success);
+}
+
+static void ddb_list(void)
+{
+  struct gecko_msg_mesh_prov_ddb_list_devices_rsp_t *r;
+  uint16_t count = 0;
+
+  for (int i = 0; i < sim_cfg.devices; i++) {
+    count += devs[i].in_ddb;
+  }
+  r = begin(gecko_rsp_mesh_prov_ddb_list_devices_id);
+  r->result = bg_err_success;
+  r->count = count;
+  send_out(sizeof(*r));
+
+  for (int i = 0; i < sim_cfg.devices; i++) {
+    if (!devs[i].in_ddb) {
+      continue;
+    }
+    struct gecko_msg_mesh_prov_ddb_list_evt_t *e = begin(gecko_evt_mesh_prov_ddb_list_id);
+    memcpy(e->uuid.data, devs[i].uuid, 16);
+    e->address = devs[i].addr;
+    e->elements = devs[i].elements;
+    send_out(sizeof(*e));
+  }
+}
+
+static void set_bl(const struct gecko_msg_mesh_prov_set_key_refresh_blacklist_cmd_t *c)
+{
+  sim_dev_t *d = c->uuid.len == 16 ? dev_by_uuid(c->uuid.data) : NULL;
+  uint16_t result = bg_err_success;
+
+  if (!d || !d->in_ddb) {
+    result = bg_err_mesh_does_not_exist;
+  } else if (c->status && !d->bl && net.bl_num >= KR_BL_MAX) {
+    result = bg_err_out_of_memory;
+  } else if (c->status != d->bl) {
+    d->bl = c->status ? 1 : 0;
+    net.bl_num += d->bl ? 1 : -1;
+  }
+  rsp_result(gecko_rsp_mesh_prov_set_key_refresh_blacklist_id, result);
+}
+
+static void kr_node_update(const sim_dev_t *d, uint8_t phase, uint32_t delay)
+{
+  struct gecko_msg_mesh_prov_key_refresh_node_update_evt_t *e =
+    begin(gecko_evt_mesh_prov_key_refresh_node_update_id);
+  e->key = 0;
+  e->phase = phase;
+  e->uuid.len = 16;
+  memcpy(e->uuid.data, d->uuid, 16);
+  finish(sizeof(*e) + 16);
+  sim_sched_pkt(delay, &out, NULL, NULL);
+}
+
+static void kr_done(void *arg)
+{
+  net.kr = 0;
+  net.bl_num = 0;
+  for (int i = 0; i < sim_cfg.devices; i++) {
+    if (devs[i].bl) {
+      devs[i].bl = 0;
+      if (devs[i].state == dev_node) {
+        devs[i].state = dev_orphan;
+        map_addr(&devs[i], 0);
+      }
+    }
+  }
+  rand_key(net.netkey);
+  sim_stat.key_refreshes++;
+}
+
+static void key_refresh_start(void)
+{
+  struct gecko_msg_mesh_prov_key_refresh_phase_update_evt_t *p;
+  struct gecko_msg_mesh_prov_key_refresh_complete_evt_t *c;
+  uint32_t delay = 0;
+
+  if (net.kr || !net.created) {
+    rsp_result(gecko_rsp_mesh_prov_key_refresh_start_id, bg_err_wrong_state);
+    return;
+  }
+  rsp_result(gecko_rsp_mesh_prov_key_refresh_start_id, bg_err_success);
+  net.kr = 1;
+
+  /* A node which times out stays in the phase it reached */
+  for (int i = 0; i < sim_cfg.devices; i++) {
+    devs[i].kr_stuck = hit(sim_cfg.timeout_pct);
+  }
+  for (uint8_t phase = 1; phase <= 2; phase++) {
+    delay += sim_cfg.kr_phase_ms;
+    for (int i = 0; i < sim_cfg.devices; i++) {
+      if (devs[i].state == dev_node && !devs[i].bl
+          && (!devs[i].kr_stuck || phase == 1)) {
+        kr_node_update(&devs[i], phase, delay);
+      }
+    }
+    p = begin(gecko_evt_mesh_prov_key_refresh_phase_update_id);
+    p->key = 0;
+    p->phase = phase;
+    finish(sizeof(*p));
+    sim_sched_pkt(delay, &out, NULL, NULL);
+  }
+  delay += sim_cfg.kr_phase_ms;
+  for (int i = 0; i < sim_cfg.devices; i++) {
+    if (devs[i].state == dev_node && !devs[i].bl && !devs[i].kr_stuck) {
+      kr_node_update(&devs[i], 0, delay);
+    }
+  }
+  c = begin(gecko_evt_mesh_prov_key_refresh_complete_id);
+  c->key = 0;
+  c->result = bg_err_success;
+  finish(sizeof(*c));
+  sim_sched_pkt(delay, &out, kr_done, NULL);
+}
+
+int sim_mesh_init(void)
+{
+  devs = calloc(sim_cfg.devices, sizeof(sim_dev_t));
+  addr_map = calloc(UNICAST_MAX, sizeof(uint32_t));
+  if (!devs || !addr_map) {
+    return -1;
+  }
+  rnd_state = sim_cfg.seed ? sim_cfg.seed : 1;
+  dcd_init();
+  for (int i = 0; i < sim_cfg.devices; i++) {
+    sim_dev_t *d = &devs[i];
+    memcpy(d->uuid, SIM_UUID_PREFIX, SIM_UUID_PREFIX_LEN);
+    d->uuid[12] = (uint8_t)(i >> 24);
+    d->uuid[13] = (uint8_t)(i >> 16);
+    d->uuid[14] = (uint8_t)(i >> 8);
+    d->uuid[15] = (uint8_t)i;
+    if (sim_cfg.dcd == sim_dcd_mixed) {
+      int m = i % 10;
+      d->dcd = m < 6 ? sim_dcd_light : m < 8 ? sim_dcd_ctl
+               : m < 9 ? sim_dcd_sensor : sim_dcd_lpn;
+    } else {
+      d->dcd = sim_cfg.dcd;
+    }
+    d->elements = dcds[d->dcd].elements;
+  }
+  rand_key(net.netkey);
+  return 0;
+}
+
+void sim_mesh_cmd(const struct gecko_cmd_packet *pkt)
+{
+  uint32_t id = BGLIB_MSG_ID(pkt->header);
+
+  sim_stat.cmds++;
+  for (size_t i = 0; i < sizeof(cc_map) / sizeof(cc_map[0]); i++) {
+    if (cc_map[i].cmd == id) {
+      config_client(&cc_map[i], pkt);
+      return;
+    }
+  }
+
+  switch (id) {
+    case gecko_cmd_system_reset_id:
+      /* No response, the boot event tells the host it is done */
+      system_reset();
+      break;
+    case gecko_cmd_flash_ps_erase_all_id:
+      factory_reset();
+      rsp_result(id, bg_err_success);
+      break;
+    case gecko_cmd_mesh_prov_init_id: {
+      rsp_result(id, bg_err_success);
+      struct gecko_msg_mesh_prov_initialized_evt_t *e =
+        begin(gecko_evt_mesh_prov_initialized_id);
+      e->networks = net.created;
+      e->address = net.addr;
+      e->ivi = net.ivi;
+      send_out(sizeof(*e));
+    }
+    break;
+    case gecko_cmd_mesh_prov_initialize_network_id:
+      if (net.created) {
+        rsp_result(id, bg_err_mesh_already_initialized);
+        break;
+      }
+      net.addr = pkt->data.cmd_mesh_prov_initialize_network.address;
+      net.ivi = pkt->data.cmd_mesh_prov_initialize_network.ivi;
+      rsp_result(id, bg_err_success);
+      break;
+    case gecko_cmd_mesh_prov_create_network_id: {
+      struct gecko_msg_mesh_prov_create_network_rsp_t *r = begin(id);
+      r->result = net.created ? bg_err_mesh_already_exists : bg_err_success;
+      r->network_id = 0;
+      send_out(sizeof(*r));
+      if (!net.created) {
+        net.created = 1;
+        if (!net.addr) {
+          net.addr = 1;
+        }
+        net.next_addr = net.addr + 1;
+      }
+    }
+    break;
+    case gecko_cmd_mesh_prov_create_appkey_id: {
+      struct gecko_msg_mesh_prov_create_appkey_rsp_t *r = begin(id);
+      r->result = bg_err_success;
+      r->appkey_index = net.appkeys++;
+      r->key.len = 16;
+      rand_key(r->key.data);
+      send_out(sizeof(*r) + 16);
+    }
+    break;
+    case gecko_cmd_mesh_prov_scan_unprov_beacons_id:
+      net.scanning = 1;
+      if (!net.beacon_tick) {
+        net.beacon_tick = 1;
+        sim_sched(BEACON_TICK, beacon_tick, NULL);
+      }
+      rsp_result(id, bg_err_success);
+      break;
+    case gecko_cmd_mesh_prov_stop_scan_unprov_beacons_id:
+      net.scanning = 0;
+      rsp_result(id, bg_err_success);
+      break;
+    case gecko_cmd_mesh_prov_provision_device_id:
+      provision_device(&pkt->data.cmd_mesh_prov_provision_device);
+      break;
+    case gecko_cmd_mesh_prov_ddb_get_id:
+      ddb_get(&pkt->data.cmd_mesh_prov_ddb_get);
+      break;
+    case gecko_cmd_mesh_prov_ddb_delete_id:
+      ddb_delete(&pkt->data.cmd_mesh_prov_ddb_delete);
+      break;
+    case gecko_cmd_mesh_prov_ddb_list_devices_id:
+      ddb_list();
+      break;
+    case gecko_cmd_mesh_prov_set_key_refresh_blacklist_id:
+      set_bl(&pkt->data.cmd_mesh_prov_set_key_refresh_blacklist);
+      break;
+    case gecko_cmd_mesh_prov_key_refresh_start_id:
+      key_refresh_start();
+      break;
+    case gecko_cmd_mesh_test_get_key_id: {
+      struct gecko_msg_mesh_test_get_key_rsp_t *r = begin(id);
+      r->result = bg_err_success;
+      r->id = pkt->data.cmd_mesh_test_get_key.index;
+      r->network = 0;
+      memcpy(r->key.data, net.netkey, 16);
+      send_out(sizeof(*r));
+    }
+    break;
+    default:
+      /* Model client init, set default timeout etc., result only */
+      rsp_result(id, bg_err_success);
+      break;
+  }
+}
+
+void sim_mesh_print_stat(uint32_t elapsed)
+{
+  unsigned long nodes = 0;
+  double min = elapsed / 60000.0;
+
+  for (int i = 0; i < sim_cfg.devices; i++) {
+    nodes += devs[i].state == dev_node;
+  }
+  printf("[%6u.%03us] nodes %lu/%d, provisioned %lu (%.1f/min), prov failed %lu, "
+         "config %lu, oom %lu, timeout %lu, beacons %lu, kr %lu, resets %lu\n",
+         elapsed / 1000, elapsed % 1000, nodes, sim_cfg.devices,
+         sim_stat.provisioned, min > 0 ? sim_stat.provisioned / min : 0.0,
+         sim_stat.prov_failed, sim_stat.cc_cmds, sim_stat.cc_oom,
+         sim_stat.cc_timeouts, sim_stat.beacons, sim_stat.key_refreshes,
+         sim_stat.resets);
+  fflush(stdout);
+}
@@ -0,0 +1,153 @@
+/*************************************************************************
+    > File Name: sim_sched.c
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Timer queue of the simulated NCP. Everything the target
+    > does later, e.g. a status event after the config latency, is a timer.
+    > Timers are kept in a binary min heap, timers due at the same time run
+    > in the order they are added, so events of one procedure keep order.
+ ************************************************************************/
+
+/* Includes *********************************************************** */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim.h"
+
+/* Defines  *********************************************************** */
+#define HEAP_INIT_SIZE 1024
+
+typedef struct {
+  uint32_t due;
+  uint32_t seq;
+  sim_cb_t cb;
+  void *arg;
+  int has_pkt;
+  struct gecko_cmd_packet pkt;
+}sim_timer_t;
+
+/* Static Variables *************************************************** */
+static sim_timer_t **heap = NULL;
+static size_t heap_len = 0;
+static size_t heap_size = 0;
+static uint32_t seq = 0;
+
+/* Static Functions Declaractions ************************************* */
+static int before(const sim_timer_t *a, const sim_timer_t *b)
+{
+  int32_t d = (int32_t)(a->due - b->due);
+  return d < 0 || (d == 0 && (int32_t)(a->seq - b->seq) < 0);
+}
+
+static void swap(size_t i, size_t j)
+{
+  sim_timer_t *t = heap[i];
+  heap[i] = heap[j];
+  heap[j] = t;
+}
+
+static void sift_up(size_t i)
+{
+  while (i && before(heap[i], heap[(i - 1) / 2])) {
+    swap(i, (i - 1) / 2);
+    i = (i - 1) / 2;
+  }
+}
+
+static void sift_down(size_t i)
+{
+  for (;;) {
+    size_t l = 2 * i + 1, r = l + 1, m = i;
+    if (l < heap_len && before(heap[l], heap[m])) {
+      m = l;
+    }
+    if (r < heap_len && before(heap[r], heap[m])) {
+      m = r;
+    }
+    if (m == i) {
+      return;
+    }
+    swap(i, m);
+    i = m;
+  }
+}
+
+static sim_timer_t *add(uint32_t delay)
+{
+  sim_timer_t *t;
+
+  if (heap_len == heap_size) {
+    size_t n = heap_size ? heap_size * 2 : HEAP_INIT_SIZE;
+    sim_timer_t **p = realloc(heap, n * sizeof(sim_timer_t *));
+    if (!p) {
+      return NULL;
+    }
+    heap = p;
+    heap_size = n;
+  }
+  t = calloc(1, sizeof(sim_timer_t));
+  if (!t) {
+    return NULL;
+  }
+  t->due = sim_now() + delay;
+  t->seq = seq++;
+  heap[heap_len] = t;
+  sift_up(heap_len++);
+  return t;
+}
+
+void sim_sched(uint32_t delay, sim_cb_t cb, void *arg)
+{
+  sim_timer_t *t = add(delay);
+  if (!t) {
+    fprintf(stderr, "timer dropped, out of memory\n");
+    return;
+  }
+  t->cb = cb;
+  t->arg = arg;
+}
+
+void sim_sched_pkt(uint32_t delay,
+                   const struct gecko_cmd_packet *pkt,
+                   sim_cb_t cb,
+                   void *arg)
+{
+  sim_timer_t *t = add(delay);
+  if (!t) {
+    fprintf(stderr, "packet dropped, out of memory\n");
+    return;
+  }
+  t->cb = cb;
+  t->arg = arg;
+  t->has_pkt = 1;
+  memcpy(&t->pkt, pkt, BGLIB_MSG_HEADER_LEN + BGLIB_MSG_LEN(pkt->header));
+}
+
+int sim_sched_run(uint32_t now)
+{
+  while (heap_len) {
+    sim_timer_t *t = heap[0];
+    int32_t d = (int32_t)(t->due - now);
+    if (d > 0) {
+      return d;
+    }
+    heap[0] = heap[--heap_len];
+    sift_down(0);
+    if (t->has_pkt) {
+      sim_send(&t->pkt);
+    }
+    if (t->cb) {
+      t->cb(t->arg);
+    }
+    free(t);
+  }
+  return -1;
+}
+
+void sim_sched_clear(void)
+{
+  while (heap_len) {
+    free(heap[--heap_len]);
+  }
+}
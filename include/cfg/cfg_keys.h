@@ -49,6 +49,7 @@ extern "C"
 #define STR_FUNC                          "Functionality"
 #define STR_ERRBITS                       "Err"
 #define STR_TMPL                          "Template ID"
+#define STR_DIGEST                        "Digest"
 #define STR_SNB                           "Secure Network Beacon"
 #define STR_LPN                           "Low Power"
 #define STR_PROXY                         "Proxy"
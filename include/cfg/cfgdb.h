@@ -98,6 +98,9 @@ typedef struct {
   uint16list_t *sublist;
 }mesh_config_t;
 
+/* Length of the digest of the configuration applied to a node */
+#define NODE_DIGEST_LEN 16
+
 /**
  * @brief Node structure, all the configuration of a node will be loaded to the
  * structure, all fields with pointer type are optional to present, the others
@@ -109,6 +112,8 @@ typedef struct {
   uint8_t done;
   uint8_t rmorbl; /* Remove or blacklist state */
   lbitmap_t err;
+  /* Of the configuration last applied, all 0 if unknown, see cfg_digest.h */
+  uint8_t digest[NODE_DIGEST_LEN];
   uint8_t *tmpl;
   mesh_config_t config;
   struct {
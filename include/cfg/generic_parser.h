@@ -31,6 +31,7 @@ enum {
   wrt_node_rmall,
   wrt_node_rmblclr,
   wrt_done,
+  wrt_digest,
   /* For prov cfg file */
   wrt_prov_addr,
   wrt_prov_ivi,
@@ -114,6 +115,7 @@ err_t upl_nodeset_addr(const uint8_t *uuid, uint16_t addr);
 err_t nodeset_errbits(uint16_t addr, lbitmap_t err);
 err_t nodeset_done(uint16_t addr, uint8_t done);
 err_t nodeset_func(uint16_t addr, uint8_t func);
+err_t nodeset_digest(uint16_t addr, const uint8_t *digest);
 err_t nodes_rm(uint16_t addr);
 err_t nodes_bl(uint16_t addr);
 const char *nodeget_cfgstr(uint16_t addr);
@@ -72,6 +72,20 @@ err_t cli_init(void *p);
 err_t cli_proc_init(int child_num, const pid_t *pids);
 int cli_proc(int argc, char *argv[]);
 void *cli_mainloop(void *pIn);
+/**
+ * @brief cli_batch - run the commands in a script instead of the shell, one
+ * per line. Blank lines and lines starting with '#' are skipped. The commands
+ * for the manager are queued without waiting for each other, 'wait [timeout]'
+ * waits until they're run and the sync is done, and a CLI local command waits
+ * for the commands before it. The script stops at the first error.
+ *
+ * @param path - the script, "-" for stdin
+ *
+ * @return EXIT_SUCCESS if all the commands succeed, EXIT_FAILURE otherwise
+ */
+int cli_batch(const char *path);
+/* The command of the name in the command table, NULL if not found */
+const command_t *cli_cmd_get(const char *name);
 
 /**
  * @brief bt_shell_printf - command to print message on shell without prompt
@@ -92,6 +106,9 @@ void cli_print_modelset_done(uint16_t addr, uint8_t type, uint8_t value);
 void cli_list_nodes(uint16list_t *ul);
 void cli_status(const mng_t *mng);
 void cli_print_stat(const stat_t *s);
+void cli_print_bgapi_stat(void);
+void cli_print_dcd_cache(void);
+void cli_print_shaper(void);
 /**  @} */
 
 #ifdef __cplusplus
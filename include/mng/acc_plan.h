@@ -0,0 +1,137 @@
+/*************************************************************************
+    > File Name: acc_plan.h
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Configuration plans, the operations of the model
+    configuring states compiled from the DCD and the configuration of a node
+ ************************************************************************/
+
+#ifndef ACC_PLAN_H
+#define ACC_PLAN_H
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+#include <stdint.h>
+#include "mng.h"
+
+/* States with a plan, in the order of the acc states from addappkey_em */
+enum {
+  plan_addappkey,
+  plan_bindappkey,
+  plan_setpub,
+  plan_addsub,
+  plan_state_max
+};
+
+/*
+ * The operation a state is executing is iterators[PLAN_OP_ITERATOR_INDEX],
+ * which the entry of the state sets to 0
+ */
+#define PLAN_OP_ITERATOR_INDEX  0
+
+typedef struct {
+  uint8_t elem;
+  /* The first subscription of a model is set, which overwrites the list */
+  uint8_t set;
+  /*
+   * Remove the app key, or clear the subscriptions of the model. Left from a
+   * configuration before, so only the nodes configured before run it
+   */
+  uint8_t del;
+  /* SIG_VENDOR_ID for the SIG models */
+  uint16_t vd;
+  uint16_t md;
+  /* App key reference ID to add or bind, or address to subscribe */
+  uint16_t arg;
+}acc_op_t;
+
+/*
+ * Nodes with the same DCD and the same app keys, publication and
+ * subscriptions share a plan, it's never changed or freed once compiled
+ */
+typedef struct acc_plan {
+  /* What the plan is compiled from */
+  uint32_t hash;
+  const dcd_t *dcd;
+  uint8_t pub;
+  uint8_t bind_num;
+  uint8_t sub_num;
+  uint16_t *binds;
+  uint16_t *subs;
+
+  struct {
+    uint16_t num;
+    /* The last ones of the operations, which have del set */
+    uint16_t del;
+    acc_op_t *ops;
+  }st[plan_state_max];
+}acc_plan_t;
+
+/**
+ * @brief acc_plan_get - get the plan of the node, compile it if no node
+ * sharing it is seen before. The app keys not in the provisioner config and
+ * the duplicated app keys and addresses are left out. The other app keys of
+ * the provisioner are removed, and the subscriptions are cleared if there are
+ * none, by the nodes configured before.
+ *
+ * @param node - the node, its DCD is got
+ * @param dcd - DCD of the node
+ *
+ * @return the plan, NULL if out of memory
+ */
+const acc_plan_t *acc_plan_get(const node_t *node, const dcd_t *dcd);
+
+/**
+ * @brief acc_plan_ops - number of the operations of the state the node runs
+ *
+ * @param cache - config cache of the node
+ * @param s - plan state, @ref{plan_xxx}
+ */
+static inline int acc_plan_ops(const config_cache_t *cache, int s)
+{
+  return cache->plan->st[s].num
+         - (cache->node->done ? 0 : cache->plan->st[s].del);
+}
+
+/**
+ * @brief acc_plan_op - the operation the state of the cache is executing
+ *
+ * @param cache - config cache in one of the states with a plan
+ * @param s - plan state, @ref{plan_xxx}
+ *
+ * @return the operation, NULL if all done
+ */
+static inline const acc_op_t *acc_plan_op(const config_cache_t *cache, int s)
+{
+  int i = cache->iterators[PLAN_OP_ITERATOR_INDEX];
+  return (i < acc_plan_ops(cache, s)) ? &cache->plan->st[s].ops[i] : NULL;
+}
+
+/**
+ * @brief acc_plan_next - move to the next operation of the state
+ *
+ * @return 1 if all the operations of the state are done, 0 otherwise
+ */
+static inline int acc_plan_next(config_cache_t *cache, int s)
+{
+  return ++cache->iterators[PLAN_OP_ITERATOR_INDEX] >= acc_plan_ops(cache, s);
+}
+
+/**
+ * @brief acc_plan_remaining - number of the config messages the node still
+ * needs to send, including the features of the Set Config state
+ *
+ * @return the number, -1 if unknown since the DCD isn't got
+ */
+int acc_plan_remaining(const config_cache_t *cache);
+
+/**
+ * @brief acc_plan_num - number of the plans compiled
+ */
+int acc_plan_num(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif //ACC_PLAN_H
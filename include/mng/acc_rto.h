@@ -0,0 +1,80 @@
+/*************************************************************************
+    > File Name: acc_rto.h
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Adaptive timeouts of the config client, estimated from the
+    response time of each node and each class of nodes
+ ************************************************************************/
+
+#ifndef ACC_RTO_H
+#define ACC_RTO_H
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+#include <stdint.h>
+#include "mng.h"
+
+/* The NCP target has a timeout for the LPNs and one for the others */
+enum {
+  rto_normal,
+  rto_lpn,
+  rto_lane_max
+};
+
+typedef struct {
+  /* Smoothed round-trip time and its variation, ms */
+  int32_t srtt;
+  int32_t rttvar;
+  uint32_t samples;
+}rtt_est_t;
+
+/**
+ * @brief acc_rto_init - set the timeouts the NCP target is configured with,
+ * which are used until the first response of the class is seen
+ *
+ * @param normal - config client timeout of the normal nodes in ms
+ * @param lpn - config client timeout of the LPNs in ms
+ */
+void acc_rto_init(uint32_t normal, uint32_t lpn);
+
+/**
+ * @brief acc_rto_arm - called right before a config client request is sent
+ * to the node, work out the timeout of the node and set the config client
+ * timeout of the NCP target to the one of the lane if it moved by a step
+ */
+void acc_rto_arm(config_cache_t *cache);
+
+/**
+ * @brief acc_rto_on_status - called on the first event of the request
+ *
+ * @param cache - config cache of the node
+ * @param result - result of the event, bg_err_timeout if the node didn't
+ * respond in time
+ */
+void acc_rto_on_status(config_cache_t *cache, uint16_t result);
+
+/**
+ * @brief acc_rto_guard - guard time of the request in seconds, how long the
+ * NCP target may take to raise the event, at least the timeout of the node
+ */
+uint32_t acc_rto_guard(const config_cache_t *cache);
+
+/**
+ * @brief acc_rto_lane - estimation of all the nodes in the lane
+ *
+ * @param lane - @ref{rto_xxx}
+ *
+ * @return the estimation, NULL if no response in the lane is seen
+ */
+const rtt_est_t *acc_rto_lane(int lane);
+
+/**
+ * @brief acc_rto_of - the timeout the estimation gives, in ms
+ */
+uint32_t acc_rto_of(const rtt_est_t *est);
+
+#ifdef __cplusplus
+}
+#endif
+#endif //ACC_RTO_H
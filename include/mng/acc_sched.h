@@ -0,0 +1,50 @@
+/*************************************************************************
+    > File Name: acc_sched.h
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Scheduler of the config slots, the nodes waiting to be
+    configured are classified by how long they may hold a slot
+ ************************************************************************/
+
+#ifndef ACC_SCHED_H
+#define ACC_SCHED_H
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+#include <glib.h>
+#include "mng.h"
+
+enum {
+  /* Normal nodes, answering within the normal timeout */
+  sched_fast,
+  /* LPNs and the nodes of which the DCD is unknown yet */
+  sched_slow,
+  sched_class_max
+};
+
+/**
+ * @brief acc_sched_class - classify the node
+ *
+ * @param node - the node
+ * @param dcd - DCD of the node, NULL to use the one of its template if known
+ *
+ * @return @ref{sched_xxx}
+ */
+int acc_sched_class(const node_t *node, const dcd_t *dcd);
+
+/**
+ * @brief acc_sched_pick - pick the node to load to a free config slot, the
+ * node expected to send the fewest config messages in the class allowed
+ *
+ * @param list - nodes waiting to be configured
+ * @param used - config slots used by each class
+ *
+ * @return the link of the node in the list, NULL if none may be loaded
+ */
+GList *acc_sched_pick(GList *list, const int used[sched_class_max]);
+
+#ifdef __cplusplus
+}
+#endif
+#endif //ACC_SCHED_H
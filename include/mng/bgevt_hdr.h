@@ -11,13 +11,45 @@
 extern "C"
 {
 #endif
+#include <stdbool.h>
 #include "gecko_bglib.h"
 
 typedef int (*bgevt_hdr)(const struct gecko_cmd_packet *evt);
 
 void conn_ncptarget(void);
 void sync_host_and_ncp_target(void);
+/**
+ * @brief attach_ncp_target - synchronize with the NCP target without resetting
+ * it, for the warm restart
+ *
+ * @return true if synchronized, either attached to the running NCP target or
+ * it booted meanwhile, false if the NCP target doesn't respond properly
+ */
+bool attach_ncp_target(void);
+/* If the NCP target kept running since the last synchronization */
+bool ncp_target_attached(void);
 void bgevt_dispenser(void);
+/**
+ * @brief bgevt_wait - wait for the event, the other events received meanwhile
+ * are dropped, only for the startup before the handlers can take them
+ *
+ * @param id - ID of the event
+ * @param timeout_ms - 0 to only check the events received already
+ *
+ * @return the event, NULL on timeout
+ */
+struct gecko_cmd_packet *bgevt_wait(uint32_t id, uint32_t timeout_ms);
+/**
+ * @brief bgevt_wait_keep - wait for the event like @ref{bgevt_wait}, the other
+ * events received meanwhile are kept and handled by the next
+ * @ref{bgevt_dispenser} in the order received, for the waits while running
+ *
+ * @param id - ID of the event
+ * @param timeout_ms - 0 to only check the events received already
+ *
+ * @return the event, valid until the next event is got, NULL on timeout
+ */
+struct gecko_cmd_packet *bgevt_wait_keep(uint32_t id, uint32_t timeout_ms);
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,68 @@
+/*************************************************************************
+    > File Name: cfg_digest.h
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Digest of the configuration applied to a node, so that the
+    nodes of which the template and overrides are unchanged aren't configured
+    again
+ ************************************************************************/
+
+#ifndef CFG_DIGEST_H
+#define CFG_DIGEST_H
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+#include <stdint.h>
+#include "cfgdb.h"
+#include "err.h"
+
+/* Parts of the digest, each re-runs its own config states if changed */
+enum {
+  /* Add App Key and Bind App Key */
+  dg_appkey,
+  /* Set Pub */
+  dg_pub,
+  /* Add Sub */
+  dg_sub,
+  /* Set Config */
+  dg_config,
+  dg_max
+};
+
+#define DG_ALL  ((1 << dg_max) - 1)
+
+/**
+ * @brief cfg_digest_redo - get the parts of the configuration the node needs
+ *
+ * @param node - the node
+ *
+ * @return bitmap of the parts, @ref{dg_xxx}. DG_ALL if the node isn't done,
+ * 0 if it's done and either nothing changed since or the digest is unknown
+ */
+uint8_t cfg_digest_redo(const node_t *node);
+
+/**
+ * @brief cfg_digest_applied - record the current configuration of the node as
+ * applied, in the nodes config file
+ *
+ * @param node - the node configured successfully
+ *
+ * @return @ref{err_t}
+ */
+err_t cfg_digest_applied(const node_t *node);
+
+/**
+ * @brief cfg_digest_str - format the parts the node needs, like "pub|sub"
+ *
+ * @param redo - bitmap returned by @ref{cfg_digest_redo}
+ * @param buf - at least 32 bytes
+ *
+ * @return buf
+ */
+const char *cfg_digest_str(uint8_t redo, char *buf);
+
+#ifdef __cplusplus
+}
+#endif
+#endif //CFG_DIGEST_H
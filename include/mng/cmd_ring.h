@@ -0,0 +1,112 @@
+/*************************************************************************
+    > File Name: cmd_ring.h
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Commands from the CLI and RPC threads to the manager thread,
+    in a bounded single producer single consumer ring per source
+ ************************************************************************/
+
+#ifndef CMD_RING_H
+#define CMD_RING_H
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+#include <stdbool.h>
+#include <stdint.h>
+#include <wordexp.h>
+#include "err.h"
+#include "cli.h"
+
+/* Each source is one thread */
+enum {
+  cmd_src_cli,
+  cmd_src_rpc,
+  cmd_src_max
+};
+
+typedef struct {
+  const command_t *cmd;
+  /* The parsed command, argv[0] is the name */
+  wordexp_t w;
+  /* @ref{cmd_src_xxx} */
+  int src;
+  /* Meaning to the source only */
+  uint32_t tag;
+}cmd_t;
+
+/**
+ * @brief cmd_ring_init - create the descriptor waking the manager, only the
+ * first call does it
+ *
+ * @return @ref{err_t}
+ */
+err_t cmd_ring_init(void);
+
+/**
+ * @brief cmd_enq - queue a parsed command and wake the manager, only called by
+ * the thread of the source. Waits while the ring of the source is full.
+ *
+ * @param src - @ref{cmd_src_xxx}
+ * @param cmd - the command to run
+ * @param w - the parsed command, taken over by the ring, the caller mustn't
+ * free it
+ * @param tag - given back with the command
+ */
+void cmd_enq(int src, const command_t *cmd, const wordexp_t *w, uint32_t tag);
+
+/**
+ * @brief cmd_try_enq - queue a parsed command and wake the manager unless the
+ * ring of the source is full, only called by the thread of the source
+ *
+ * @param src - @ref{cmd_src_xxx}
+ * @param cmd - the command to run
+ * @param w - the parsed command, taken over by the ring if queued
+ * @param tag - given back with the command
+ *
+ * @return false if the ring is full, w is left to the caller
+ */
+bool cmd_try_enq(int src, const command_t *cmd, const wordexp_t *w, uint32_t tag);
+
+/**
+ * @brief cmd_deq - take the oldest command of a source, the sources take turns,
+ * only called by the manager thread
+ *
+ * @param c - set to the command, c->w is freed by the caller with wordfree
+ *
+ * @return false if no command is queued
+ */
+bool cmd_deq(cmd_t *c);
+
+/**
+ * @brief cmd_done - record the command taken by @ref{cmd_deq} is run, only
+ * called by the manager thread
+ *
+ * @param c - the command
+ * @param e - what the command returned
+ */
+void cmd_done(const cmd_t *c, err_t e);
+
+/**
+ * @brief cmd_ring_pending - commands queued by the source and not run yet,
+ * only called by the thread of the source
+ */
+uint32_t cmd_ring_pending(int src);
+
+/**
+ * @brief cmd_ring_failed - commands of the source run by the manager which
+ * returned an error since the start
+ */
+uint32_t cmd_ring_failed(int src);
+
+/**
+ * @brief cmd_ring_wait - sleep until a command is queued or the timeout
+ *
+ * @param timeout_ms - maximum time to sleep
+ */
+void cmd_ring_wait(int timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif
+#endif //CMD_RING_H
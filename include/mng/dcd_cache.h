@@ -0,0 +1,96 @@
+/*************************************************************************
+    > File Name: dcd_cache.h
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Cache of the composition data page 0, shared by the nodes
+    of the same device type
+ ************************************************************************/
+
+#ifndef DCD_CACHE_H
+#define DCD_CACHE_H
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+#include <stdint.h>
+#include "mng.h"
+#include "err.h"
+
+/*
+ * Nodes of a template fetch the DCD until this many of them have returned the
+ * same composition, the later nodes of the template take it from the cache
+ */
+#define DCD_CACHE_CONFIRM 2
+/*
+ * One node in this many of a confirmed template still fetches the DCD, so a
+ * template bound to another product is found and stops being shortcut
+ */
+#define DCD_CACHE_RECHECK 16
+
+typedef struct {
+  /* Nodes of which the DCD was fetched */
+  uint32_t fetched;
+  /* Nodes which skipped getting the DCD */
+  uint32_t shortcut;
+  /* Templates of which the nodes returned different compositions */
+  uint32_t conflicts;
+}dcd_cache_stat_t;
+
+/**
+ * @brief dcd_cache_init - load the cache from the file, the file is written
+ * whenever a device type or a template mapping is learned
+ *
+ * @param path - path of the cache file, NULL to keep it in memory only
+ */
+void dcd_cache_init(const char *path);
+
+/**
+ * @brief dcd_cache_add - parse the composition data page 0 and return the
+ * cached DCD of the same CID/PID/VID/CRPL, add it to the cache if it's a new
+ * device type
+ *
+ * @param data - composition data page 0, without the page number
+ * @param len - length of the data
+ *
+ * @return the shared DCD, NULL if the data is malformed or out of memory
+ */
+const dcd_t *dcd_cache_add(const uint8_t *data, uint8_t len);
+
+/**
+ * @brief dcd_cache_learn - record the DCD fetched from the node against the
+ * template of the node
+ */
+void dcd_cache_learn(const node_t *node, const dcd_t *dcd);
+
+/**
+ * @brief dcd_cache_lookup - get the DCD of the node without asking it
+ *
+ * @return the DCD the template of the node is confirmed to have, NULL if the
+ * DCD needs to be fetched, which it is for the first node of the template in
+ * a run, for the nodes failed before and for one in DCD_CACHE_RECHECK nodes
+ */
+const dcd_t *dcd_cache_lookup(const node_t *node);
+
+/**
+ * @brief dcd_cache_tmpl - get the DCD a template maps to
+ *
+ * @param refid - template reference ID
+ * @param hits - number of the nodes of the template the DCD was fetched
+ * from in this run, the mapping loaded from the file may have none
+ *
+ * @return the DCD, NULL if the template isn't confirmed to map to one
+ */
+const dcd_t *dcd_cache_tmpl(uint8_t refid, uint8_t *hits);
+
+/**
+ * @brief dcd_cache_forget - forget all the template mappings so that the DCD
+ * of every node is fetched again, the DCDs still in use stay valid
+ */
+err_t dcd_cache_forget(void);
+
+const dcd_cache_stat_t *dcd_cache_stat(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif //DCD_CACHE_H
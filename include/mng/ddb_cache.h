@@ -0,0 +1,78 @@
+/*************************************************************************
+    > File Name: ddb_cache.h
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Copy of the device database of the NCP target, read with a
+    single list query and kept until the NCP target resets
+ ************************************************************************/
+
+#ifndef DDB_CACHE_H
+#define DDB_CACHE_H
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+#include <stdbool.h>
+#include <stdint.h>
+#include "err.h"
+
+/**
+ * @brief ddb_cache_sync - list the devices in the DDB of the NCP target if the
+ * cache isn't valid. The other events received meanwhile are kept for the
+ * next @ref{bgevt_dispenser}.
+ *
+ * @return @ref{err_t}, the cache isn't valid on error
+ */
+err_t ddb_cache_sync(void);
+
+/**
+ * @brief ddb_cache_valid - if the cache holds all the devices in the DDB
+ */
+bool ddb_cache_valid(void);
+
+/**
+ * @brief ddb_cache_has - if the device is in the DDB, only meaningful while
+ * the cache is valid
+ */
+bool ddb_cache_has(const uint8_t *uuid);
+
+/**
+ * @brief ddb_cache_add - record the device provisioned
+ */
+void ddb_cache_add(const uint8_t *uuid, uint16_t addr);
+
+/**
+ * @brief ddb_cache_del - record the device deleted from the DDB
+ */
+void ddb_cache_del(const uint8_t *uuid);
+
+/**
+ * @brief ddb_cache_invalidate - forget the cache, the DDB is listed again on
+ * the next sync
+ */
+void ddb_cache_invalidate(void);
+
+/**
+ * @brief ddb_cache_dev_hash - hash of a device, the digest is the sum of the
+ * hashes of the devices so that it doesn't depend on the order
+ */
+uint32_t ddb_cache_dev_hash(const uint8_t *uuid, uint16_t addr);
+
+/**
+ * @brief ddb_cache_digest - digest of the devices in the cache
+ *
+ * @param count - set to the number of devices, -1 if the cache isn't valid
+ *
+ * @return sum of @ref{ddb_cache_dev_hash} of the devices
+ */
+uint32_t ddb_cache_digest(int *count);
+
+/**
+ * @brief ddb_cache_dump - log the devices in the cache
+ */
+void ddb_cache_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif //DDB_CACHE_H
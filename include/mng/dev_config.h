@@ -15,6 +15,8 @@ extern "C"
 #include <stdint.h>
 
 #include "mng.h"
+#include "stat.h"
+#include "timeline.h"
 #include "gecko_bglib.h"
 #include "logging.h"
 
@@ -90,6 +92,8 @@ typedef enum {
   on_timeout_em,
   on_oom_em,
   on_guard_timer_expired_em,
+  /* Held back by the traffic shaper when it was to be sent first */
+  on_throttled_em,
   retry_on_max_em
 } retry_reason_t;
 
@@ -117,6 +121,8 @@ enum {
   asr_bgapi,
   asr_unspec,
   asr_notfnd,
+  /* Not sent, no token in the lane of the traffic shaper */
+  asr_throttled,
 };
 
 typedef enum {
@@ -165,12 +171,30 @@ static inline void err_set_to_rm_end(config_cache_t *cache,
 
 void timer_set(config_cache_t *cache, bool enable);
 extern const char *state_names[];
+
+/* Index of the cache in the config/rm slots */
+static inline int cache_slot(const config_cache_t *cache)
+{
+  return (int)(cache - get_mng()->cache.config.cache);
+}
+
 static inline void oom_set(config_cache_t *cache)
 {
   BIT_SET(cache->flags, OOM_BIT_OFFSET);
+  stat_oom(oom_config);
+  TL_INSTANT(tl_lane_config + cache_slot(cache), "oom", "node", cache->node->addr);
   LOGW(OOM_SET_MSG, cache->node->addr, state_names[cache->state]);
 }
 
+/**
+ * @brief acc_shape - called right before a config client request is sent to
+ * the node, take a token of the traffic shaper for it
+ *
+ * @return true if the request may be sent, otherwise the cache is marked
+ * throttled and the engine resends the request once the lane has a token
+ */
+bool acc_shape(config_cache_t *cache);
+
 int dev_config_hdr(const struct gecko_cmd_packet *e);
 bool acc_loop(void *p);
 void acc_init(bool use_default);
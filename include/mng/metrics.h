@@ -0,0 +1,43 @@
+/*************************************************************************
+    > File Name: metrics.h
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Metrics endpoint in the Prometheus text format
+ ************************************************************************/
+
+#ifndef METRICS_H
+#define METRICS_H
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+#include "err.h"
+#include "mng.h"
+
+/* The snapshot the endpoint serves is refreshed at this interval */
+#define METRICS_PUBLISH_MS  1000
+
+/**
+ * @brief metrics_start - start serving the metrics over HTTP, the requests
+ * are handled in a thread of its own and never touch the live state
+ *
+ * @param endpoint - TCP port on 127.0.0.1 if it's a number, otherwise the
+ * path of a Unix domain socket
+ *
+ * @return @ref{err_t}
+ */
+err_t metrics_start(const char *endpoint);
+
+/**
+ * @brief metrics_publish - aggregate the counters into the snapshot served by
+ * the endpoint, called in every round of the main loop and does nothing until
+ * METRICS_PUBLISH_MS elapsed or if the endpoint is not started
+ *
+ * @param mng - the manager
+ */
+void metrics_publish(const mng_t *mng);
+
+#ifdef __cplusplus
+}
+#endif
+#endif //METRICS_H
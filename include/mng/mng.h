@@ -22,15 +22,19 @@ typedef struct {
   bool busy;
   time_t expired;
   uint8_t uuid[16];
+  /* us, when the beacon which started provisioning is received */
+  uint64_t beacon_us;
 }add_cache_t;
 
 #define EVER_RETRIED_BIT_OFFSET 7
 #define WAITING_RESPONSE_BIT_OFFSET 6
 #define OOM_BIT_OFFSET  5
+#define THROTTLED_BIT_OFFSET  4
 
 #define WAITING_RESPONSE_BIT_MASK  (1 << WAITING_RESPONSE_BIT_OFFSET)
 #define EVER_RETRIED_BIT_MASK  (1 << EVER_RETRIED_BIT_OFFSET)
 #define OOM_BIT_MASK  (1 << OOM_BIT_OFFSET)
+#define THROTTLED_BIT_MASK  (1 << THROTTLED_BIT_OFFSET)
 #define GUARD_TIMER_EXPIRED_BIT_MASK  (1 << GUARD_TIMER_EXPIRED_OFFSET)
 
 #define WAIT_RESPONSE(x)  IS_BIT_SET((x)->flags, WAITING_RESPONSE_BIT_OFFSET)
@@ -48,6 +52,10 @@ typedef struct {
     BIT_CLR((x)->flags, OOM_BIT_OFFSET); \
   } while (0)
 
+#define THROTTLED(x) IS_BIT_SET((x)->flags, THROTTLED_BIT_OFFSET)
+#define THROTTLED_SET(x) BIT_SET((x)->flags, THROTTLED_BIT_OFFSET)
+#define THROTTLED_CLEAR(x) BIT_CLR((x)->flags, THROTTLED_BIT_OFFSET)
+
 #define RETRY_CLEAR(x)                            \
   do {                                            \
     BIT_CLR((x)->flags, EVER_RETRIED_BIT_OFFSET); \
@@ -66,16 +74,28 @@ typedef struct {
   vendor_model_t *vm;
 }elem_t;
 
+/* Composition data page 0, immutable once parsed and shared by the nodes */
 typedef struct {
+  uint16_t cid;
+  uint16_t pid;
+  uint16_t vid;
+  uint16_t crpl;
   uint16_t feature;
   uint8_t element_cnt;
   elem_t *elems;
+  /* enum value - see {CTL_SV_BIT} */
+  uint8_t func;
+  /* The raw page, to tell if a device type changes and to save the cache */
+  uint8_t len;
+  uint8_t *raw;
 }dcd_t;
 
 #define ITERATOR_NUM  3
 typedef struct {
   int state;
   int next_state;
+  /* us, when the current state is entered */
+  uint64_t state_start;
   /* NULL if not in use */
   node_t *node;
   /* POSIX timer is not supported by macOS, so use the less efficient way to
@@ -88,7 +108,22 @@ typedef struct {
     uint32_t bgevt;
     uint16_t general;
   }err_cache;
-  dcd_t dcd;
+  /* Owned by the DCD cache, NULL until got */
+  const dcd_t *dcd;
+  /* Compiled with the DCD, see acc_plan.h */
+  const struct acc_plan *plan;
+  /* Parts of the config to apply, see cfg_digest.h */
+  uint8_t redo;
+  /* Class of the node, see acc_sched.h */
+  uint8_t cls;
+  /* Timeouts of the node in a row, see acc_rto.h */
+  uint8_t backoff;
+  /* Timeout of the node with its backoff, guards the request, ms */
+  uint32_t rto_ms;
+  /* us, when the request is sent, 0 once it's answered */
+  uint64_t req_us;
+  /* Reason to resend the throttled request with, see shaper.h */
+  uint8_t deferred;
   uint32_t cc_handle; /* Config Client Handle returned by bgcall */
   struct {
     uint16_t vd;
@@ -168,6 +203,8 @@ typedef struct {
     struct {
       uint8_t type;
       uint8_t value;
+      /* us, when the set command is given */
+      uint64_t start;
       GList *nodes;
     }model_set;
   }cache;
@@ -186,13 +223,12 @@ err_t init_ncp(void *p);
 err_t clr_all(void *p);
 
 void *mng_mainloop(void *p);
+/* The main loop returns after the current iteration, join it to wait */
+void mng_stop(void);
 mng_t *get_mng(void);
 
 err_t ipc_get_provcfg(void *p);
 
-void cmd_enq(const char *str, int offs);
-wordexp_t *cmd_deq(int *offs);
-
 int dev_add_hdr(const struct gecko_cmd_packet *evt);
 int bl_hdr(const struct gecko_cmd_packet *e);
 
@@ -214,6 +250,13 @@ DECLARE_CB(lightness);
 DECLARE_CB(ct);
 DECLARE_CB(status);
 DECLARE_CB(loglvlset);
+DECLARE_CB(modlvlset);
+DECLARE_CB(trace);
+DECLARE_CB(timeline);
+DECLARE_CB(capture);
+DECLARE_CB(bgstat);
+DECLARE_CB(dcdcache);
+DECLARE_CB(shaper);
 #ifdef DEMO_EN
 DECLARE_CB(demo);
 #endif
@@ -0,0 +1,84 @@
+/*************************************************************************
+    > File Name: rpc.h
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: JSON-RPC 2.0 control socket, one request or reply per line,
+    with the progress of the manager streamed as notifications
+ ************************************************************************/
+
+#ifndef RPC_H
+#define RPC_H
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+#include <stdbool.h>
+#include <stdint.h>
+#include "err.h"
+#include "cmd_ring.h"
+
+/* Events of a node notified to the clients */
+enum {
+  rpc_evt_provisioned,
+  rpc_evt_prov_failed,
+  rpc_evt_configured,
+  rpc_evt_config_failed,
+  rpc_evt_removed,
+  rpc_evt_max
+};
+
+/**
+ * @brief rpc_start - start serving the clients on a Unix domain socket, the
+ * server runs in a thread of its own and passes the requests to the manager
+ * through the command ring
+ *
+ * @param path - path of the socket
+ *
+ * @return @ref{err_t}
+ */
+err_t rpc_start(const char *path);
+
+/**
+ * @brief rpc_on_done - reply to the request the command comes from, called by
+ * the manager after running a command from the RPC source
+ *
+ * @param c - the command, before its arguments are freed
+ * @param e - what the command returned
+ */
+void rpc_on_done(const cmd_t *c, err_t e);
+
+/**
+ * @brief rpc_notify_node - notify the clients of an event of a node, only
+ * called by the manager thread
+ *
+ * @param evt - @ref{rpc_evt_xxx}
+ * @param uuid - UUID of the node, NULL if not known
+ * @param addr - address of the node, 0 if not known
+ * @param result - reason of a failure, 0 otherwise
+ */
+void rpc_notify_node(int evt, const uint8_t *uuid, uint16_t addr,
+                     uint32_t result);
+
+/**
+ * @brief rpc_notify_model_set - notify the clients of a model set sent to a
+ * node, only called by the manager thread
+ *
+ * @param addr - address of the node
+ * @param type - @ref{ONOFF_SV_BIT}, @ref{LIGHTNESS_SV_BIT} or @ref{CTL_SV_BIT}
+ * @param value - value set
+ * @param result - BGAPI result of sending the message
+ * @param last - if it's the last node of the set
+ */
+void rpc_notify_model_set(uint16_t addr, uint8_t type, uint8_t value,
+                          uint16_t result, bool last);
+
+/**
+ * @brief rpc_notify_sync_done - notify the clients that the sync is done, only
+ * called by the manager thread
+ */
+void rpc_notify_sync_done(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif //RPC_H
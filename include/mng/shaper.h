@@ -0,0 +1,77 @@
+/*************************************************************************
+    > File Name: shaper.h
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Token bucket shaping the messages sent to the mesh, with
+    priority lanes sharing the budget
+ ************************************************************************/
+
+#ifndef SHAPER_H
+#define SHAPER_H
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+#include <stdbool.h>
+#include <stdint.h>
+#include "err.h"
+
+/* From the highest priority to the lowest */
+enum {
+  /* Model sets issued by the user */
+  shp_interactive,
+  /* Provisioning and configuring the nodes */
+  shp_background,
+  /* Node reset */
+  shp_bulk,
+  shp_lane_max
+};
+
+typedef struct {
+  /* Messages per second, 0 if not shaped */
+  uint32_t rate;
+  uint32_t burst;
+  struct {
+    uint32_t sent;
+    /* Times the lane started waiting for a token */
+    uint32_t deferred;
+  }lanes[shp_lane_max];
+}shaper_stat_t;
+
+/**
+ * @brief shaper_set - set the on-air budget, the bucket is filled
+ *
+ * @param rate - messages per second, 0 to disable shaping
+ * @param burst - depth of the bucket, must be greater than the tokens reserved
+ * for the lanes above the bulk one
+ *
+ * @return @ref{err_t}
+ */
+err_t shaper_set(uint32_t rate, uint32_t burst);
+
+/**
+ * @brief shaper_ready - if the lane may send a message now, no token is taken
+ */
+bool shaper_ready(int lane);
+
+/**
+ * @brief shaper_take - take a token for a message in the lane
+ *
+ * @param lane - @ref{shp_xxx}
+ *
+ * @return true if the message may be sent, false if it should be held back
+ * and tried again later
+ */
+bool shaper_take(int lane);
+
+/**
+ * @brief shaper_tokens - whole tokens in the bucket
+ */
+uint32_t shaper_tokens(void);
+
+const shaper_stat_t *shaper_stat(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif //SHAPER_H
@@ -13,7 +13,9 @@ extern "C"
 #endif
 #include <sys/time.h>
 #include <time.h>
+#include <stdint.h>
 #include "mng.h"
+#include "lat_hist.h"
 
 enum {
   rc_idle,
@@ -21,6 +23,24 @@ enum {
   rc_end,
 };
 
+/* Configuring states with a latency histogram, in the order of acc states */
+enum {
+  lat_get_dcd,
+  lat_addappkey,
+  lat_bindappkey,
+  lat_setpub,
+  lat_addsub,
+  lat_setconfig,
+  config_lat_max
+};
+
+enum {
+  lat_set_onoff,
+  lat_set_lightness,
+  lat_set_ctl,
+  model_set_lat_max
+};
+
 typedef struct {
   int state;
   time_t start;
@@ -31,12 +51,15 @@ struct __add{
   unsigned dev_cnt;
   unsigned fail_times;
   measure_time_t time;
+  /* From the unprovisioned beacon to provisioned */
+  lat_hist_t prov_lat;
 };
 
 struct __rm{
   unsigned dev_cnt;
   unsigned retry_times;
   measure_time_t time;
+  lat_hist_t rm_lat;
 };
 
 struct __bl{
@@ -51,6 +74,27 @@ struct __config{
     time_t time;
     measure_time_t meas;
   } full_loading;
+  /* Time a node spends in each state, retries included */
+  lat_hist_t state_lat[config_lat_max];
+};
+
+struct __model_set{
+  /* From the set command to the message sent to the node */
+  lat_hist_t lat[model_set_lat_max];
+};
+
+enum {
+  oom_prov,
+  oom_config,
+  oom_max
+};
+
+/* Counters since the program started, not cleared by stat_reset */
+struct __total{
+  unsigned long oom[oom_max];
+  unsigned long prov_failures;
+  unsigned long config_retries;
+  unsigned long rm_retries;
 };
 
 typedef struct {
@@ -58,6 +102,8 @@ typedef struct {
   struct __rm rm;
   struct __bl bl;
   struct __config config;
+  struct __model_set model_set;
+  struct __total total;
 }stat_t;
 
 const stat_t *get_stat(void);
@@ -67,6 +113,7 @@ void stat_add_start(void);
 void stat_add_end(void);
 void stat_add_one_dev(void);
 void stat_add_failed(void);
+void stat_prov_lat(uint64_t start_us);
 
 void stat_config_start(void);
 void stat_config_end(void);
@@ -89,6 +136,22 @@ void stat_config_retry(void);
  */
 void stat_config_loading_record(const mng_t *mng);
 
+/**
+ * @brief stat_state_lat - record the time a node spent in a state of the
+ * config engine, states without a histogram are ignored
+ *
+ * @param state - acc state, see @ref{acc_state_emt}
+ * @param start_us - time the node entered the state
+ */
+void stat_state_lat(int state, uint64_t start_us);
+
+/**
+ * @brief stat_oom - count an out of memory returned by the NCP target
+ *
+ * @param src - oom_prov or oom_config
+ */
+void stat_oom(int src);
+
 void stat_bl_start(void);
 void stat_bl_end(void);
 
@@ -96,6 +159,14 @@ void stat_rm_start(void);
 void stat_rm_end(void);
 void stat_rm_one_dev(void);
 void stat_rm_retry(void);
+
+/**
+ * @brief stat_model_set_lat - record the latency of setting a light
+ *
+ * @param type - ONOFF_SV_BIT, LIGHTNESS_SV_BIT or CTL_SV_BIT
+ * @param start_us - time the set command was given
+ */
+void stat_model_set_lat(uint8_t type, uint64_t start_us);
 #ifdef __cplusplus
 }
 #endif
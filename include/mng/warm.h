@@ -0,0 +1,32 @@
+/*************************************************************************
+    > File Name: warm.h
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Check if the running NCP target agrees with the config, so
+    that it can be attached to without reset
+ ************************************************************************/
+
+#ifndef WARM_H
+#define WARM_H
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+#include "err.h"
+#include "mng.h"
+
+/**
+ * @brief warm_validate - check the network, IV index, keys and DDB of the
+ * running NCP target against the provisioner config and the nodes of the
+ * config. The IV index the NCP target moved on to is persisted.
+ *
+ * @param mng - the manager, active_appkey_num of the subnet is set on success
+ *
+ * @return @ref{err_t}, ec_state if the NCP target doesn't agree
+ */
+err_t warm_validate(mng_t *mng);
+
+#ifdef __cplusplus
+}
+#endif
+#endif //WARM_H
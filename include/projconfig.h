@@ -23,7 +23,16 @@ extern "C"
 #define PROJ_VERSION_PATCH  0
 
 #define FILE_PATH_MAX 108
+/* Seconds to keep resetting the NCP target until it boots */
 #define MAXSLEEP (60 * 5)
+/*
+ * The NCP target is reset again if no boot event is received in the backoff,
+ * which doubles from the min to the max on each reset
+ */
+#define NCP_RESET_BACKOFF_MIN_MS 200
+#define NCP_RESET_BACKOFF_MAX_MS 3200
+/* How long the NCP target may take to initialize the provisioner */
+#define NCP_PROV_INIT_TIMEOUT_MS 30000
 
 #ifndef SRC_ROOT_DIR
 #if __APPLE__ == 1
@@ -48,7 +57,12 @@ extern "C"
 #endif
 
 #define CONFIG_CACHE_FILE_PATH  PROJ_DIR ".config"
+#define DCD_CACHE_FILE_PATH  PROJ_DIR ".dcd_cache"
 #define TMPLATE_FILE_PATH PROJ_DIR "tools/mesh_config/templates.json"
+#define CLI_TRACE_FILE_PATH PROJ_DIR "logs/cli.trc"
+#define CLI_TIMELINE_FILE_PATH PROJ_DIR "logs/timeline.json"
+#define BGAPI_CAPTURE_FILE_PATH PROJ_DIR "logs/bgapi.snoop"
+#define BGAPI_STAT_FILE_PATH PROJ_DIR "logs/bgapi_stat.csv"
 #define CLI_LOG_FILE_PATH PROJ_DIR "logs/cli.log"
 
 /*
@@ -62,6 +76,14 @@ extern "C"
  */
 #define MAX_CONCURRENT_CONFIG_NODES 6
 
+/*
+ * The config slots reserved for each class of nodes, see acc_sched.h. Fast
+ * nodes never take the slots reserved for the slow ones and vice versa, the
+ * rest are taken by whichever class has nodes waiting.
+ */
+#define CONFIG_SLOTS_FAST_RESERVED 2
+#define CONFIG_SLOTS_SLOW_RESERVED 1
+
 /*
  * Typically, each config client bg call will have an event raised no matter
  * because of the status received or timeout occurs, this is the driver of the
@@ -74,8 +96,53 @@ extern "C"
  */
 #define CONFIG_NO_RSP_TIMEOUT 3
 
+/*
+ * Bounds of the config client timeouts estimated from the response time of
+ * the nodes, see acc_rto.h. The NCP target is only set again if the timeout
+ * of a lane changes by a step.
+ */
+#define CONFIG_RTO_MIN_MS 1000
+#define CONFIG_RTO_MAX_MS 120000
+#define CONFIG_RTO_STEP_MS 250
+
+/*
+ * On-air budget of the messages sent to the mesh, see shaper.h. Tokens are
+ * added at SHAPER_RATE per second up to SHAPER_BURST. The background lane
+ * (provisioning and config) leaves the last SHAPER_RESERVE_INTERACTIVE tokens
+ * to the model sets, and the bulk lane (node reset) leaves another
+ * SHAPER_RESERVE_BACKGROUND to the background lane. Rate 0 disables shaping.
+ */
+#define SHAPER_RATE 25
+#define SHAPER_BURST 16
+#define SHAPER_RESERVE_INTERACTIVE 8
+#define SHAPER_RESERVE_BACKGROUND 2
+
 #define ADD_NO_RSP_TIMEOUT 90
 
+/*
+ * Seconds to wait for all the devices listed by the NCP target DDB, see
+ * ddb_cache.h. If not all are received, the nodes are looked up one by one.
+ */
+#define DDB_LIST_TIMEOUT 5
+
+/*
+ * Commands the CLI may queue to the manager, see cmd_ring.h. Must be a power
+ * of 2. The CLI waits if the manager falls this far behind.
+ */
+#define CMD_RING_SIZE 256
+
+/*
+ * JSON-RPC control socket, see rpc.h. Clients served at once, longest request
+ * line, and the replies and notifications the manager may have waiting for
+ * the server (must be a power of 2 and more than CMD_RING_SIZE). At most
+ * CMD_RING_SIZE requests are in flight, the ones beyond are refused as busy,
+ * and as many slots are kept for their replies, so only notifications are
+ * dropped when the server falls behind.
+ */
+#define RPC_MAX_CLIENTS 8
+#define RPC_LINE_MAX 4096
+#define RPC_OUT_SIZE 512
+
 /*
  * If OOM happens in attempt to provision a device, stop scanning and react to
  * unprovisioned beacon event for a while to let the device to recover.
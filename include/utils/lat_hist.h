@@ -0,0 +1,55 @@
+/*************************************************************************
+    > File Name: lat_hist.h
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description:
+ ************************************************************************/
+
+#ifndef LAT_HIST_H
+#define LAT_HIST_H
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+#include <stdint.h>
+
+/*
+ * Latency histogram in microseconds with log-linear buckets like HDR
+ * histogram, each power of 2 is split into 2^LAT_HIST_SUB_BITS buckets, so a
+ * percentile is within 1/16 of the real value. Latencies beyond UINT32_MAX us
+ * (71 minutes) fall into the last bucket, max is always exact.
+ */
+#define LAT_HIST_SUB_BITS 4
+#define LAT_HIST_BUCKETS ((32 - LAT_HIST_SUB_BITS + 1) << LAT_HIST_SUB_BITS)
+
+typedef struct {
+  uint32_t cnt;
+  uint64_t max;
+  uint64_t sum;
+  uint32_t buckets[LAT_HIST_BUCKETS];
+}lat_hist_t;
+
+/**
+ * @brief lat_now_us - monotonic time for measuring latencies
+ *
+ * @return time in microseconds
+ */
+uint64_t lat_now_us(void);
+
+void lat_hist_record(lat_hist_t *h, uint64_t us);
+
+/**
+ * @brief lat_hist_percentile - get the value at a percentile
+ *
+ * @param h - histogram
+ * @param p - percentile, 0 - 100
+ *
+ * @return the highest value of the bucket the percentile falls in, capped by
+ * the max, 0 if the histogram is empty
+ */
+uint64_t lat_hist_percentile(const lat_hist_t *h, double p);
+
+#ifdef __cplusplus
+}
+#endif
+#endif //LAT_HIST_H
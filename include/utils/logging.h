@@ -89,6 +89,39 @@ typedef enum {
   LVL_VER
 }log_lvl_t;
 
+/*
+ * Log calls above this level are removed at compile time, release builds set
+ * it to LVL_DBG
+ */
+#ifndef LOG_COMPILE_LVL
+#define LOG_COMPILE_LVL LVL_VER
+#endif
+
+/*
+ * Modules with their own runtime threshold. A source file selects its module
+ * by defining LOG_MODULE before including any header, the others log as
+ * log_mod_default.
+ */
+typedef enum {
+  log_mod_default,
+  log_mod_mng,
+  log_mod_dev_config,
+  log_mod_json_parser,
+  log_mod_hal,
+  log_mod_max
+}log_mod_t;
+
+#ifndef LOG_MODULE
+#define LOG_MODULE log_mod_default
+#endif
+
+/* Read by the LOG macros, use set_logging_mod_lvl_threshold to change */
+extern int log_mod_lvls[log_mod_max];
+
+/* Checked before the arguments are evaluated */
+#define LOG_ON(lvl) \
+  ((int)(lvl) <= (int)LOG_COMPILE_LVL && (int)(lvl) <= log_mod_lvls[LOG_MODULE])
+
 /**
  * @brief logging_init - initialization of logging
  *
@@ -108,6 +141,19 @@ err_t logging_init(const char *path,
  */
 void logging_deinit(void);
 
+/**
+ * @brief logging_flush - wait until the records logged so far are written
+ */
+void logging_flush(void);
+
+/**
+ * @brief get_logging_dropped - get how many records are dropped because the
+ * log ring was full
+ *
+ * @return number of dropped records
+ */
+unsigned long get_logging_dropped(void);
+
 /**
  * @brief logging_demo - output the demonstration of logging to stdout
  */
@@ -120,7 +166,12 @@ err_t __log(const char *file_name,
             ...);
 
 void log_n(void);
-#define LOG(lvl, fmt, ...) __log(__FILE__, __LINE__, (lvl), (fmt), ##__VA_ARGS__)
+#define LOG(lvl, fmt, ...)                                               \
+  do {                                                                   \
+    if (LOG_ON(lvl)) {                                                   \
+      (void)__log(__FILE__, __LINE__, (lvl), (fmt), ##__VA_ARGS__);      \
+    }                                                                    \
+  } while (0)
 #define LOGN() log_n()
 
 /*
@@ -138,8 +189,23 @@ void log_n(void);
 
 void set_logging_tostdout(int enable);
 int get_logging_tostdout(void);
+/*
+ * Set the threshold of all the modules
+ */
 void set_logging_lvl_threshold(log_lvl_t lvl);
 int get_logging_lvl_threshold(void);
+void set_logging_mod_lvl_threshold(log_mod_t mod, log_lvl_t lvl);
+int get_logging_mod_lvl_threshold(log_mod_t mod);
+
+/**
+ * @brief get_logging_mod - get the module by name
+ *
+ * @param name - module name, e.g. "dev_config"
+ *
+ * @return the module, log_mod_max if not found
+ */
+log_mod_t get_logging_mod(const char *name);
+const char *get_logging_mod_name(log_mod_t mod);
 
 #ifdef __cplusplus
 }
@@ -55,6 +55,18 @@ typedef struct {
       char clt[FILE_PATH_MAX];
     }sock;
   };
+  /* Metrics endpoint, TCP port or Unix domain socket path, not cached */
+  char metrics[FILE_PATH_MAX];
+  /* BGAPI capture to write and to replay, not cached */
+  char capture[FILE_PATH_MAX];
+  char replay[FILE_PATH_MAX];
+  double replay_speed;
+  /* Attach to the running NCP target instead of resetting it, not cached */
+  bool warm;
+  /* Commands to run instead of the shell, "-" for stdin, not cached */
+  char script[FILE_PATH_MAX];
+  /* JSON-RPC control socket path, not cached */
+  char rpc[FILE_PATH_MAX];
 }proj_args_t;
 
 typedef err_t (*init_func_t)(void *p);
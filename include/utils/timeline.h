@@ -0,0 +1,89 @@
+/*************************************************************************
+    > File Name: timeline.h
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Timeline recorder in the Trace Event Format of Chrome
+ ************************************************************************/
+
+#ifndef TIMELINE_H
+#define TIMELINE_H
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+#include <stdint.h>
+#include "err.h"
+
+/* First lanes of the provisioning sessions and the key refresh */
+#define TL_LANE_PROV_BASE 16
+#define TL_LANE_KR_BASE   32
+
+/*
+ * A lane is a row in the viewer, it has at most one open slice. Starting a
+ * slice ends the open one of the lane, so the slices never overlap.
+ */
+enum {
+  /* + index of the config/rm slot */
+  tl_lane_config = 0,
+  /* + index of the provisioning session */
+  tl_lane_prov = TL_LANE_PROV_BASE,
+  tl_lane_kr = TL_LANE_KR_BASE,
+  tl_lane_max
+};
+
+/*
+ * The recorder is NOT thread safe, all the calls except timeline_on must be
+ * in the thread of the main loop, which is also where the CLI commands run.
+ */
+
+/**
+ * @brief timeline_start - start recording to a file in the JSON array format
+ * of the Trace Event Format, which loads in Perfetto or chrome://tracing. The
+ * closing bracket is optional for the format, so a file is still valid if
+ * the program exits without timeline_stop.
+ *
+ * @param path - file to write
+ *
+ * @return @ref{err_t}
+ */
+err_t timeline_start(const char *path);
+
+/**
+ * @brief timeline_stop - end the open slices, flush and close the file
+ */
+void timeline_stop(void);
+int timeline_on(void);
+
+void __timeline_slice(int lane, const char *name, const char *key, uint32_t val);
+void __timeline_end(int lane);
+void __timeline_instant(int lane, const char *name, const char *key, uint32_t val);
+
+/*
+ * Start a slice on the lane, the names must be string literals or static,
+ * key and val are the argument shown in the viewer, val is printed in hex
+ */
+#define TL_SLICE(lane, name, key, val)                  \
+  do {                                                  \
+    if (timeline_on()) {                                \
+      __timeline_slice((lane), (name), (key), (val));   \
+    }                                                   \
+  } while (0)
+
+#define TL_END(lane)              \
+  do {                            \
+    if (timeline_on()) {          \
+      __timeline_end((lane));     \
+    }                             \
+  } while (0)
+
+#define TL_INSTANT(lane, name, key, val)                \
+  do {                                                  \
+    if (timeline_on()) {                                \
+      __timeline_instant((lane), (name), (key), (val)); \
+    }                                                   \
+  } while (0)
+
+#ifdef __cplusplus
+}
+#endif
+#endif //TIMELINE_H
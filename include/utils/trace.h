@@ -0,0 +1,189 @@
+/*************************************************************************
+    > File Name: trace.h
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description:
+ ************************************************************************/
+
+#ifndef TRACE_H
+#define TRACE_H
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+#include <stdint.h>
+#include <stddef.h>
+#include "logging.h"
+
+#define TRACE_MAX_ARGS  6
+
+/*
+ * Trace points, X(id, level, format)
+ *
+ * A trace records only the id and the raw arguments, the message is formatted
+ * by the log writer, or offline by the decoder if binary tracing is on.
+ * Arguments are stored as uint32_t, so only integer conversions are allowed,
+ * except that the argument of %s is an index to the string table set by
+ * trace_set_strtab.
+ */
+#define TRACE_POINTS(X)                                                                     \
+  X(trc_acc_config_start, LVL_MSG, "Node[0x%04x]: Configuring Started\n")                   \
+  X(trc_acc_rm_start, LVL_MSG, "Node[0x%04x]: Removing Started\n")                          \
+  X(trc_acc_state_end, LVL_MSG, "Node[0x%04x]: End   - [%s]\n")                             \
+  X(trc_acc_state_try, LVL_VER, "Node[0x%04x]: Try to Enter %s State\n")                    \
+  X(trc_acc_state_start, LVL_MSG, "Node[0x%04x]: Start - [%s]\n")                           \
+  X(trc_acc_expired_retry_fail, LVL_ERR, "Retry on Expired Returns %d\n")                   \
+  X(trc_acc_oom_retry_fail, LVL_ERR, "Retry on OOM Returns %d\n")                           \
+  X(trc_acc_oom_recovery, LVL_DBG, "Node[0x%04x]: OOM Recovery Once.\n")                    \
+  X(trc_getdcd, LVL_VER, "Node[0x%04x]:  --- Get DCD\n")                                    \
+  X(trc_getdcd_suc, LVL_DBG, "Node[0x%04x]:  --- Get DCD SUCCESS\n")                        \
+  X(trc_getdcd_fail, LVL_ERR, "Node[0x%04x]:  --- Get DCD Failed, Err <0x%04x>\n")          \
+  X(trc_addappkey, LVL_VER, "Node[0x%04x]:  --- Add App Key[%d (Ref ID)]\n")                \
+  X(trc_addappkey_suc, LVL_DBG, "Node[0x%04x]:  --- Add App Key[%d (Ref ID)] SUCCESS \n")   \
+  X(trc_addappkey_fail, LVL_ERR,                                                            \
+    "Node[0x%04x]:  --- Add App Key[%d (Ref ID)] FAILED, Err <0x%04x>\n")                   \
+  X(trc_addsub, LVL_VER,                                                                    \
+    "Node[0x%04x]:  --- Sub [Element-Model(%d-%04x:%04x) <- 0x%04x]\n")                     \
+  X(trc_addsub_suc, LVL_DBG,                                                                \
+    "Node[0x%04x]:  --- Sub [Element-Model(%d-%04x:%04x) <- 0x%04x] SUCCESS\n")             \
+  X(trc_addsub_fail, LVL_ERR,                                                               \
+    "Node[0x%04x]:  --- Sub [Element-Model(%d-%04x:%04x) <- 0x%04x] FAILED, Err <0x%04x>\n") \
+  X(trc_rmappkey, LVL_VER, "Node[0x%04x]:  --- Remove App Key[%d (Ref ID)]\n")              \
+  X(trc_rmappkey_suc, LVL_DBG, "Node[0x%04x]:  --- Remove App Key[%d (Ref ID)] SUCCESS\n")  \
+  X(trc_rmappkey_fail, LVL_ERR,                                                             \
+    "Node[0x%04x]:  --- Remove App Key[%d (Ref ID)] FAILED, Err <0x%04x>\n")                \
+  X(trc_clrsub, LVL_VER, "Node[0x%04x]:  --- Clear Sub [Element-Model(%d-%04x:%04x)]\n")    \
+  X(trc_clrsub_suc, LVL_DBG,                                                                \
+    "Node[0x%04x]:  --- Clear Sub [Element-Model(%d-%04x:%04x)] SUCCESS\n")                 \
+  X(trc_clrsub_fail, LVL_ERR,                                                               \
+    "Node[0x%04x]:  --- Clear Sub [Element-Model(%d-%04x:%04x)] FAILED, Err <0x%04x>\n")    \
+  X(trc_setpub, LVL_VER,                                                                    \
+    "Node[0x%04x]:  --- Pub [Element-Model(%d-%04x:%04x) -> 0x%04x]\n")                     \
+  X(trc_setpub_suc, LVL_DBG,                                                                \
+    "Node[0x%04x]:  --- Pub [Element-Model(%d-%04x:%04x) -> 0x%04x] SUCCESS\n")             \
+  X(trc_setpub_fail, LVL_ERR,                                                               \
+    "Node[0x%04x]:  --- Pub [Element-Model(%d-%04x:%04x) -> 0x%04x] FAILED, Err <0x%04x>\n") \
+  X(trc_bindappkey, LVL_VER,                                                                \
+    "Node[0x%04x]:  --- Bind [refid(%d) <-> Model(%04x:%04x)]\n")                           \
+  X(trc_bindappkey_suc, LVL_DBG,                                                            \
+    "Node[0x%04x]:  --- Bind [refid(%d) <-> Model(%04x:%04x)] SUCCESS\n")                   \
+  X(trc_bindappkey_fail, LVL_ERR,                                                           \
+    "Node[0x%04x]:  --- Bind [refid(%d) <-> Model(%04x:%04x)] FAILED, Err <0x%04x>\n")      \
+  X(trc_setrelay, LVL_VER, "Node[0x%04x]:  --- Set [Relay(%d)]\n")                          \
+  X(trc_setrelay_suc, LVL_DBG, "Node[0x%04x]:  --- Set [Relay(%d)] SUCCESS\n")              \
+  X(trc_setrelay_fail, LVL_ERR,                                                             \
+    "Node[0x%04x]:  --- Set [Relay(%d)] FAILED, Err <0x%04x>\n")                            \
+  X(trc_setproxy, LVL_VER, "Node[0x%04x]:  --- Set [Proxy(%d)]\n")                          \
+  X(trc_setproxy_suc, LVL_DBG, "Node[0x%04x]:  --- Set [Proxy(%d)] SUCCESS\n")              \
+  X(trc_setproxy_fail, LVL_ERR,                                                             \
+    "Node[0x%04x]:  --- Set [Proxy(%d)] FAILED, Err <0x%04x>\n")                            \
+  X(trc_setfriend, LVL_VER, "Node[0x%04x]:  --- Set [Friend(%d)]\n")                        \
+  X(trc_setfriend_suc, LVL_DBG, "Node[0x%04x]:  --- Set [Friend(%d)] SUCCESS\n")            \
+  X(trc_setfriend_fail, LVL_ERR,                                                            \
+    "Node[0x%04x]:  --- Set [Friend(%d)] FAILED, Err <0x%04x>\n")                           \
+  X(trc_setsnb, LVL_VER, "Node[0x%04x]:  --- Set [SNB(%d)]\n")                              \
+  X(trc_setsnb_suc, LVL_DBG, "Node[0x%04x]:  --- Set [SNB(%d)] SUCCESS\n")                  \
+  X(trc_setsnb_fail, LVL_ERR,                                                               \
+    "Node[0x%04x]:  --- Set [SNB(%d)] FAILED, Err <0x%04x>\n")                              \
+  X(trc_setttl, LVL_VER, "Node[0x%04x]:  --- Set [TTL(%d)]\n")                              \
+  X(trc_setttl_suc, LVL_DBG, "Node[0x%04x]:  --- Set [TTL(%d)] SUCCESS\n")                  \
+  X(trc_setttl_fail, LVL_ERR,                                                               \
+    "Node[0x%04x]:  --- Set [TTL(%d)] FAILED, Err <0x%04x>\n")                              \
+  X(trc_setnettx, LVL_VER,                                                                  \
+    "Node[0x%04x]:  --- Set [nettx:count-interval(%d-%dms)]\n")                             \
+  X(trc_setnettx_suc, LVL_DBG,                                                              \
+    "Node[0x%04x]:  --- Set [nettx:count-interval(%d-%dms)] SUCCESS\n")                     \
+  X(trc_setnettx_fail, LVL_ERR,                                                             \
+    "Node[0x%04x]:  --- Set [nettx:count-interval(%d-%dms)] FAILED, Err <0x%04x>\n")        \
+  X(trc_rm, LVL_VER, "Node[0x%04x]:  --- RM\n")                                             \
+  X(trc_rm_suc, LVL_DBG, "Node[0x%04x]:  --- SUCCESS\n")                                    \
+  X(trc_rm_fail, LVL_ERR, "Node[0x%04x]:  --- RM FAILED, Err <0x%04x>\n")                   \
+  X(trc_bgevt, LVL_VER, "NCP Target Event [0x%08x]\n")                                      \
+  X(trc_bgevt_unhandled, LVL_WRN, "NCP Target Event [0x%08x] Not Handled\n")
+
+#define TRACE_ENUM(id, lvl, fmt) id,
+typedef enum {
+  TRACE_POINTS(TRACE_ENUM)
+  trc_max
+}trace_id_t;
+
+/* Levels as constants, so TRC can be compiled out like the LOG macros */
+#define TRACE_LVL_ENUM(id, lvl, fmt) id##_lvl = (lvl),
+enum {
+  TRACE_POINTS(TRACE_LVL_ENUM)
+};
+
+typedef struct {
+  const char *name;
+  int lvl;
+  const char *fmt;
+}trace_point_t;
+
+extern const trace_point_t trace_points[];
+
+/**
+ * @brief trace_set_strtab - set the strings the %s arguments refer to
+ *
+ * @param strtab - string table, must stay valid
+ * @param num - number of strings
+ */
+void trace_set_strtab(const char *const *strtab, int num);
+const char *const *trace_get_strtab(int *num);
+
+/**
+ * @brief trace_format - format a trace like snprintf
+ *
+ * @param buf - buffer to be filled
+ * @param size - size of the buffer
+ * @param fmt - format of the trace point
+ * @param args - raw arguments
+ * @param nargs - number of arguments
+ * @param strtab - string table for %s
+ * @param nstr - number of strings
+ *
+ * @return length of the formatted string, truncated to size - 1
+ */
+size_t trace_format(char *buf,
+                    size_t size,
+                    const char *fmt,
+                    const uint32_t *args,
+                    int nargs,
+                    const char *const *strtab,
+                    int nstr);
+
+err_t __trace(const char *file_name,
+              unsigned int line,
+              trace_id_t id,
+              int nargs,
+              const uint32_t *args);
+
+#define TRACE_NARGS(...) \
+  ((int)(sizeof((uint32_t[]){ __VA_ARGS__ }) / sizeof(uint32_t)))
+
+/*
+ * Record a trace point, at least one argument is needed
+ */
+#define TRC(id, ...)                                                    \
+  do {                                                                  \
+    if (LOG_ON(id##_lvl)) {                                             \
+      (void)__trace(__FILE__, __LINE__, (id), TRACE_NARGS(__VA_ARGS__), \
+                    (const uint32_t[]){ __VA_ARGS__ });                 \
+    }                                                                   \
+  } while (0)
+
+/**
+ * @brief logging_trace_start - write traces in binary to a file instead of
+ * formatting them to the log, use the decoder tool to read the file
+ *
+ * @param path - trace file
+ *
+ * @return @ref{err_t}
+ */
+err_t logging_trace_start(const char *path);
+void logging_trace_stop(void);
+int logging_trace_on(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif //TRACE_H
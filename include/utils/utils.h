@@ -243,6 +243,14 @@ int utils_clz(uint32_t u);
 int utils_ffs(uint32_t u);
 int utils_frz(uint32_t u);
 
+/* FNV-1a, start from UTILS_HASH_INIT */
+#define UTILS_HASH_INIT 2166136261u
+static inline uint32_t utils_hash_u16(uint32_t h, uint16_t v)
+{
+  h = (h ^ (v & 0xff)) * 16777619u;
+  return (h ^ (v >> 8)) * 16777619u;
+}
+
 static inline int fmt_uuid(char *buf, const uint8_t *uuid)
 {
   int inline_ofs = 0;
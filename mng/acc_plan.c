@@ -0,0 +1,297 @@
+/*************************************************************************
+    > File Name: acc_plan.c
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Configuration plans.
+    The models of a node are walked once when its DCD is got, the app keys to
+    add, the bindings, the publications and the subscriptions are laid out in
+    the order the states send them, so the states only step through an array.
+    A node configured before may have app keys and subscriptions which are no
+    longer in its configuration, the app keys of the provisioner not bound are
+    removed, which unbinds them too, and the subscriptions of the models are
+    cleared if there are none to set. These come last in their states and are
+    skipped by the nodes never configured.
+ ************************************************************************/
+
+/* Includes *********************************************************** */
+#define LOG_MODULE log_mod_dev_config
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+
+#include "projconfig.h"
+#include "acc_plan.h"
+#include "cfg_digest.h"
+#include "dev_config.h"
+#include "logging.h"
+#include "utils.h"
+
+/* Defines  *********************************************************** */
+
+/* Global Variables *************************************************** */
+
+/* Static Variables *************************************************** */
+/* Models which don't publish */
+static const uint16_t not_pub_models[] = {
+  0x1301,
+  0x1007,
+  0x1304,
+  0x1204
+};
+
+/* Part of the digest each plan state applies */
+static const uint8_t plan_parts[plan_state_max] = {
+  dg_appkey, dg_appkey, dg_pub, dg_sub
+};
+
+static GList *plans = NULL;
+static int plan_num = 0;
+
+/* Static Functions Declaractions ************************************* */
+static inline bool __pub_supported(uint16_t md)
+{
+  for (int i = 0; i < ARR_LEN(not_pub_models); i++) {
+    if (not_pub_models[i] == md) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool list_has(const uint16_t *list, uint8_t num, uint16_t v)
+{
+  for (int i = 0; i < num; i++) {
+    if (list[i] == v) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/* Adds v to the list if not in it yet */
+static uint8_t list_add(uint16_t *list, uint8_t num, uint16_t v)
+{
+  if (list_has(list, num, v)) {
+    return num;
+  }
+  list[num] = v;
+  return num + 1;
+}
+
+/* The guard of the Set Pub state */
+static bool pub_wanted(const node_t *node, const uint16_t *binds, uint8_t num)
+{
+  if (!node->config.pub) {
+    return false;
+  }
+  for (int i = 0; i < num; i++) {
+    if (binds[i] == node->config.pub->aki) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void plan_free(acc_plan_t *p)
+{
+  SAFE_FREE(p->binds);
+  SAFE_FREE(p->subs);
+  for (int s = 0; s < plan_state_max; s++) {
+    SAFE_FREE(p->st[s].ops);
+  }
+  free(p);
+}
+
+static acc_op_t *op_put(acc_plan_t *p, int s, int elem, int m)
+{
+  const elem_t *e = &p->dcd->elems[elem];
+  acc_op_t *op = &p->st[s].ops[p->st[s].num++];
+
+  op->elem = elem;
+  op->set = 0;
+  op->del = 0;
+  if (m < e->sigm_cnt) {
+    op->vd = SIG_VENDOR_ID;
+    op->md = e->sig_models[m];
+  } else {
+    op->vd = e->vm[m - e->sigm_cnt].vid;
+    op->md = e->vm[m - e->sigm_cnt].mid;
+  }
+  op->arg = 0;
+  return op;
+}
+
+static int plan_compile(acc_plan_t *p)
+{
+  const subnet_t *sn = &get_mng()->cfg->subnets[0];
+  int models = 0, keys = p->bind_num + sn->active_appkey_num;
+  acc_op_t *op;
+
+  for (int e = 0; e < p->dcd->element_cnt; e++) {
+    models += p->dcd->elems[e].sigm_cnt + p->dcd->elems[e].vm_cnt;
+  }
+  if ((p->bind_num > p->sub_num ? p->bind_num : p->sub_num) * models
+      > UINT16_MAX) {
+    LOGE("Too many models (%d) to plan\n", models);
+    return -1;
+  }
+  if (keys) {
+    p->st[plan_addappkey].ops = calloc(keys, sizeof(acc_op_t));
+  }
+  if (p->bind_num && models) {
+    p->st[plan_bindappkey].ops = calloc(p->bind_num * models,
+                                        sizeof(acc_op_t));
+  }
+  if (p->pub && models) {
+    p->st[plan_setpub].ops = calloc(models, sizeof(acc_op_t));
+  }
+  if (models) {
+    /* One clear per model if no subscription */
+    p->st[plan_addsub].ops = calloc(p->sub_num ? p->sub_num * models : models,
+                                    sizeof(acc_op_t));
+  }
+  if ((keys && !p->st[plan_addappkey].ops)
+      || (p->bind_num && models && !p->st[plan_bindappkey].ops)
+      || (p->pub && models && !p->st[plan_setpub].ops)
+      || (models && !p->st[plan_addsub].ops)) {
+    return -1;
+  }
+
+  for (int k = 0; k < p->bind_num; k++) {
+    op = &p->st[plan_addappkey].ops[p->st[plan_addappkey].num++];
+    op->arg = p->binds[k];
+  }
+  for (int i = 0; i < sn->active_appkey_num; i++) {
+    if (list_has(p->binds, p->bind_num, sn->appkey[i].refid)) {
+      continue;
+    }
+    op = &p->st[plan_addappkey].ops[p->st[plan_addappkey].num++];
+    op->arg = sn->appkey[i].refid;
+    op->del = 1;
+    p->st[plan_addappkey].del++;
+  }
+  for (int e = 0; e < p->dcd->element_cnt; e++) {
+    const elem_t *elem = &p->dcd->elems[e];
+    for (int m = 0; m < elem->sigm_cnt + elem->vm_cnt; m++) {
+      for (int k = 0; k < p->bind_num; k++) {
+        op_put(p, plan_bindappkey, e, m)->arg = p->binds[k];
+      }
+      if (p->pub) {
+        op = op_put(p, plan_setpub, e, m);
+        if (!__pub_supported(op->md)) {
+          p->st[plan_setpub].num--;
+        }
+      }
+      for (int k = 0; k < p->sub_num; k++) {
+        op = op_put(p, plan_addsub, e, m);
+        op->set = !k;
+        op->arg = p->subs[k];
+      }
+      if (!p->sub_num) {
+        op_put(p, plan_addsub, e, m)->del = 1;
+        p->st[plan_addsub].del++;
+      }
+    }
+  }
+  return 0;
+}
+
+static bool plan_match(const acc_plan_t *a, const acc_plan_t *b)
+{
+  return a->hash == b->hash && a->dcd == b->dcd && a->pub == b->pub
+         && a->bind_num == b->bind_num && a->sub_num == b->sub_num
+         && !memcmp(a->binds, b->binds, a->bind_num * sizeof(uint16_t))
+         && !memcmp(a->subs, b->subs, a->sub_num * sizeof(uint16_t));
+}
+
+const acc_plan_t *acc_plan_get(const node_t *node, const dcd_t *dcd)
+{
+  const uint16list_t *b = node->config.bindings, *s = node->config.sublist;
+  uint16_t binds[0xff], subs[0xff];
+  acc_plan_t key = { 0 }, *p;
+
+  key.dcd = dcd;
+  key.binds = binds;
+  key.subs = subs;
+  for (int i = 0; b && i < b->len && key.bind_num < ARR_LEN(binds); i++) {
+    if (asr_suc == appkey_by_refid(get_mng(), b->data[i], NULL)) {
+      key.bind_num = list_add(binds, key.bind_num, b->data[i]);
+    }
+  }
+  for (int i = 0; s && i < s->len && key.sub_num < ARR_LEN(subs); i++) {
+    key.sub_num = list_add(subs, key.sub_num, s->data[i]);
+  }
+  key.pub = pub_wanted(node, binds, key.bind_num);
+
+  key.hash = utils_hash_u16(utils_hash_u16(UTILS_HASH_INIT, key.pub),
+                            key.bind_num);
+  for (int i = 0; i < key.bind_num; i++) {
+    key.hash = utils_hash_u16(key.hash, binds[i]);
+  }
+  key.hash = utils_hash_u16(key.hash, key.sub_num);
+  for (int i = 0; i < key.sub_num; i++) {
+    key.hash = utils_hash_u16(key.hash, subs[i]);
+  }
+
+  for (GList *l = plans; l; l = l->next) {
+    if (plan_match(l->data, &key)) {
+      return l->data;
+    }
+  }
+
+  if (!(p = calloc(1, sizeof(acc_plan_t)))) {
+    return NULL;
+  }
+  *p = key;
+  p->binds = NULL;
+  p->subs = NULL;
+  memset(p->st, 0, sizeof(p->st));
+  alloc_copy((uint8_t **)&p->binds, binds, key.bind_num * sizeof(uint16_t));
+  alloc_copy((uint8_t **)&p->subs, subs, key.sub_num * sizeof(uint16_t));
+  if ((key.bind_num && !p->binds) || (key.sub_num && !p->subs)
+      || plan_compile(p)) {
+    plan_free(p);
+    return NULL;
+  }
+  plans = g_list_prepend(plans, p);
+  plan_num++;
+  LOGD("Plan %d compiled, %u/%u/%u/%u app keys/bindings/pubs/subs\n",
+       plan_num,
+       p->st[plan_addappkey].num,
+       p->st[plan_bindappkey].num,
+       p->st[plan_setpub].num,
+       p->st[plan_addsub].num);
+  return p;
+}
+
+int acc_plan_remaining(const config_cache_t *cache)
+{
+  int n, s;
+
+  if (!cache->plan || cache->state > setconfig_em) {
+    return cache->plan ? 0 : -1;
+  }
+  n = 0;
+  if (IS_BIT_SET(cache->redo, dg_config)) {
+    n = utils_popcount((cache->node->config.features.target
+                        ^ cache->node->config.features.current) & 0x0000FFFF);
+  }
+  s = cache->state - addappkey_em;
+  if (s < 0) {
+    s = 0;
+  } else if (s < plan_state_max) {
+    n += acc_plan_ops(cache, s) - cache->iterators[PLAN_OP_ITERATOR_INDEX];
+    s++;
+  }
+  for (; s < plan_state_max; s++) {
+    if (IS_BIT_SET(cache->redo, plan_parts[s])) {
+      n += acc_plan_ops(cache, s);
+    }
+  }
+  return n;
+}
+
+int acc_plan_num(void)
+{
+  return plan_num;
+}
@@ -0,0 +1,218 @@
+/*************************************************************************
+    > File Name: acc_rto.c
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Adaptive timeouts of the config client.
+    The response time of each request is fed to an SRTT/RTTVAR estimator of
+    the node and one of its lane, LPN or not, as TCP does (RFC 6298). The
+    config client timeouts of the NCP target are global, so they only follow
+    the estimators of the lanes and are set again when one moves by a step.
+    The timeout of each node, from its estimator or the one of its lane if it
+    never responded, is doubled with some jitter on each timeout of the node
+    in a row and guards the request on the host.
+ ************************************************************************/
+
+/* Includes *********************************************************** */
+#define LOG_MODULE log_mod_dev_config
+#include <stdlib.h>
+#include <glib.h>
+
+#include "projconfig.h"
+#include "acc_rto.h"
+#include "dcd_cache.h"
+#include "dev_config.h"
+#include "lat_hist.h"
+#include "logging.h"
+#include "utils.h"
+
+/* Defines  *********************************************************** */
+/* Timeouts in a row to double the timeout for */
+#define BACKOFF_MAX 6
+
+typedef struct {
+  /* Key of the tree */
+  uint16_t addr;
+  rtt_est_t est;
+}node_est_t;
+
+/* Global Variables *************************************************** */
+
+/* Static Variables *************************************************** */
+static rtt_est_t lanes[rto_lane_max];
+/* Per node, keyed by the address */
+static GTree *nodes = NULL;
+/* The defaults of the NCP target */
+static uint32_t defaults[rto_lane_max] = { 5000, 120000 };
+/* What the NCP target is set to */
+static uint32_t applied[rto_lane_max] = { 5000, 120000 };
+
+/* Static Functions Declaractions ************************************* */
+static void est_update(rtt_est_t *e, int32_t r)
+{
+  int32_t delta;
+
+  if (!e->samples) {
+    e->srtt = r;
+    e->rttvar = r / 2;
+  } else {
+    delta = r - e->srtt;
+    e->srtt += delta / 8;
+    e->rttvar += ((delta < 0 ? -delta : delta) - e->rttvar) / 4;
+  }
+  e->samples++;
+}
+
+uint32_t acc_rto_of(const rtt_est_t *est)
+{
+  int32_t rto = est->srtt + 4 * est->rttvar;
+
+  if (rto < CONFIG_RTO_MIN_MS) {
+    return CONFIG_RTO_MIN_MS;
+  }
+  return rto > CONFIG_RTO_MAX_MS ? CONFIG_RTO_MAX_MS : rto;
+}
+
+static int lane_of(const config_cache_t *cache)
+{
+  const dcd_t *dcd = cache->dcd;
+
+  if (IS_BIT_SET(cache->node->config.features.target, LPN_BITOFS)) {
+    return rto_lpn;
+  }
+  if (!dcd && cache->node->tmpl) {
+    dcd = dcd_cache_tmpl(*cache->node->tmpl, NULL);
+  }
+  /* The NCP target takes a node as a normal one until told */
+  return (dcd && IS_BIT_SET(dcd->feature, LPN_BITOFS)) ? rto_lpn : rto_normal;
+}
+
+static gint u16_comp(gconstpointer a, gconstpointer b, gpointer user_data)
+{
+  return (*(uint16_t *)a == *(uint16_t *)b ? 0
+          : *(uint16_t *)a > *(uint16_t *)b ? 1 : -1);
+}
+
+static rtt_est_t *node_est(uint16_t addr, bool create)
+{
+  node_est_t *e;
+
+  if (!nodes) {
+    nodes = g_tree_new_full(u16_comp, NULL, NULL, free);
+  }
+  e = g_tree_lookup(nodes, &addr);
+  if (!e && create && NULL != (e = calloc(1, sizeof(node_est_t)))) {
+    e->addr = addr;
+    g_tree_insert(nodes, &e->addr, e);
+  }
+  return e ? &e->est : NULL;
+}
+
+static uint32_t round_step(uint32_t ms)
+{
+  return (ms + CONFIG_RTO_STEP_MS - 1) / CONFIG_RTO_STEP_MS * CONFIG_RTO_STEP_MS;
+}
+
+static uint32_t lane_rto(int lane)
+{
+  return lanes[lane].samples ? round_step(acc_rto_of(&lanes[lane]))
+         : defaults[lane];
+}
+
+static uint32_t node_rto(const config_cache_t *cache, int lane)
+{
+  const rtt_est_t *e = node_est(cache->node->addr, false);
+  uint32_t rto, max;
+
+  if (e && e->samples) {
+    rto = acc_rto_of(e);
+  } else if (lanes[lane].samples) {
+    rto = acc_rto_of(&lanes[lane]);
+  } else {
+    rto = defaults[lane];
+  }
+  if (cache->backoff) {
+    max = CONFIG_RTO_MAX_MS > defaults[lane] ? CONFIG_RTO_MAX_MS : defaults[lane];
+    rto <<= cache->backoff;
+    /* So that the nodes timed out together don't retry together */
+    rto += rand() % (rto / 8 + 1);
+    rto = rto > max ? max : rto;
+  }
+  return round_step(rto);
+}
+
+void acc_rto_init(uint32_t normal, uint32_t lpn)
+{
+  defaults[rto_normal] = applied[rto_normal] = normal;
+  defaults[rto_lpn] = applied[rto_lpn] = lpn;
+}
+
+void acc_rto_arm(config_cache_t *cache)
+{
+  uint32_t want[rto_lane_max];
+  uint16_t ret;
+  int lane = lane_of(cache);
+
+  cache->rto_ms = node_rto(cache, lane);
+  cache->req_us = lat_now_us();
+  want[rto_normal] = applied[rto_normal];
+  want[rto_lpn] = applied[rto_lpn];
+  want[lane] = lane_rto(lane);
+  /* It's global and moves the requests in flight too, so only for a step */
+  if (want[lane] < applied[lane] + CONFIG_RTO_STEP_MS
+      && applied[lane] < want[lane] + CONFIG_RTO_STEP_MS) {
+    return;
+  }
+  ret = gecko_cmd_mesh_config_client_set_default_timeout(want[rto_normal],
+                                                         want[rto_lpn])->result;
+  if (ret != bg_err_success) {
+    LOGBGE("Set config client timeout", ret);
+    return;
+  }
+  LOGV("Config Client Timeout of the %s lane %ums\n",
+       lane == rto_lpn ? "LPN" : "normal", want[lane]);
+  applied[lane] = want[lane];
+}
+
+void acc_rto_on_status(config_cache_t *cache, uint16_t result)
+{
+  rtt_est_t *e;
+  int32_t r;
+
+  if (!cache->req_us) {
+    /* Not the first event of the request */
+    return;
+  }
+  r = (int32_t)((lat_now_us() - cache->req_us) / 1000);
+  cache->req_us = 0;
+  if (result == bg_err_timeout) {
+    if (cache->backoff < BACKOFF_MAX) {
+      cache->backoff++;
+    }
+    return;
+  }
+  cache->backoff = 0;
+  est_update(&lanes[lane_of(cache)], r);
+  if (NULL != (e = node_est(cache->node->addr, true))) {
+    est_update(e, r);
+  }
+}
+
+uint32_t acc_rto_guard(const config_cache_t *cache)
+{
+  uint32_t ms = applied[lane_of(cache)];
+
+  /* The node may be given longer by its backoff */
+  if (cache->rto_ms > ms) {
+    ms = cache->rto_ms;
+  }
+  if (!cache->dcd && ms < applied[rto_lpn]) {
+    /* Might be an LPN, which the NCP target could know better */
+    ms = applied[rto_lpn];
+  }
+  return CONFIG_NO_RSP_TIMEOUT + (ms + 999) / 1000;
+}
+
+const rtt_est_t *acc_rto_lane(int lane)
+{
+  return lanes[lane].samples ? &lanes[lane] : NULL;
+}
@@ -0,0 +1,141 @@
+/*************************************************************************
+    > File Name: acc_sched.c
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Scheduler of the config slots.
+    A slow node holds a slot for up to the LPN timeout on every message, so the
+    nodes are split into the fast and the slow class, each with slots the other
+    can't take. Within a class, the node expected to send the fewest config
+    messages is loaded first.
+ ************************************************************************/
+
+/* Includes *********************************************************** */
+#define LOG_MODULE log_mod_dev_config
+#include <string.h>
+
+#include "projconfig.h"
+#include "acc_sched.h"
+#include "cfg_digest.h"
+#include "dcd_cache.h"
+#include "dev_config.h"
+#include "logging.h"
+#include "utils.h"
+
+/* Defines  *********************************************************** */
+#if (CONFIG_SLOTS_FAST_RESERVED + CONFIG_SLOTS_SLOW_RESERVED > MAX_CONCURRENT_CONFIG_NODES)
+#error "More config slots reserved than MAX_CONCURRENT_CONFIG_NODES"
+#endif
+
+/* Global Variables *************************************************** */
+
+/* Static Variables *************************************************** */
+/* Slots the class can use at most, the rest are reserved for the other */
+static const int class_max[sched_class_max] = {
+  MAX_CONCURRENT_CONFIG_NODES - CONFIG_SLOTS_SLOW_RESERVED,
+  MAX_CONCURRENT_CONFIG_NODES - CONFIG_SLOTS_FAST_RESERVED
+};
+
+/*
+ * The last pick which found nothing, the list isn't scanned again until it or
+ * the slots change, since the engine tries on every loop
+ */
+static struct {
+  const GList *list;
+  guint len;
+  int used[sched_class_max];
+}blocked;
+
+/* Static Functions Declaractions ************************************* */
+static const dcd_t *tmpl_dcd(const node_t *node)
+{
+  return node->tmpl ? dcd_cache_tmpl(*node->tmpl, NULL) : NULL;
+}
+
+int acc_sched_class(const node_t *node, const dcd_t *dcd)
+{
+  if (IS_BIT_SET(node->config.features.target, LPN_BITOFS)) {
+    return sched_slow;
+  }
+  if (!dcd && !(dcd = tmpl_dcd(node))) {
+    return sched_slow;
+  }
+  return IS_BIT_SET(dcd->feature, LPN_BITOFS) ? sched_slow : sched_fast;
+}
+
+/*
+ * Config messages the node is expected to send, the exact count isn't needed,
+ * so each model is assumed to take all the bindings and subscriptions
+ */
+static int expected_msgs(const node_t *node, const dcd_t *dcd)
+{
+  const mesh_config_t *c = &node->config;
+  uint8_t redo = cfg_digest_redo(node);
+  int models = 1, n = 0;
+
+  if (dcd) {
+    models = 0;
+    for (int e = 0; e < dcd->element_cnt; e++) {
+      models += dcd->elems[e].sigm_cnt + dcd->elems[e].vm_cnt;
+    }
+  } else {
+    /* Get DCD */
+    n++;
+  }
+  if (IS_BIT_SET(redo, dg_appkey) && c->bindings) {
+    n += c->bindings->len * (1 + models);
+  }
+  if (IS_BIT_SET(redo, dg_pub) && c->pub) {
+    n += models;
+  }
+  if (IS_BIT_SET(redo, dg_sub) && c->sublist) {
+    n += c->sublist->len * models;
+  }
+  if (IS_BIT_SET(redo, dg_config)) {
+    n += utils_popcount((c->features.target ^ c->features.current) & 0xffff);
+  }
+  return n;
+}
+
+GList *acc_sched_pick(GList *list, const int used[sched_class_max])
+{
+  GList *best[sched_class_max] = { NULL };
+  int cost[sched_class_max];
+  int total = 0;
+  guint len = g_list_length(list);
+
+  for (int i = 0; i < sched_class_max; i++) {
+    total += used[i];
+  }
+  if (total >= MAX_CONCURRENT_CONFIG_NODES) {
+    return NULL;
+  }
+  if (blocked.list == list && blocked.len == len
+      && !memcmp(blocked.used, used, sizeof(blocked.used))) {
+    return NULL;
+  }
+
+  for (GList *l = list; l; l = l->next) {
+    const node_t *node = l->data;
+    const dcd_t *dcd = tmpl_dcd(node);
+    int c = acc_sched_class(node, dcd), n;
+
+    if (used[c] >= class_max[c]) {
+      continue;
+    }
+    n = expected_msgs(node, dcd);
+    /* The earlier in the list wins a tie, FIFO as before */
+    if (!best[c] || n < cost[c]) {
+      best[c] = l;
+      cost[c] = n;
+    }
+  }
+  if (!best[sched_fast] && !best[sched_slow]) {
+    blocked.list = list;
+    blocked.len = len;
+    memcpy(blocked.used, used, sizeof(blocked.used));
+    return NULL;
+  }
+  blocked.list = NULL;
+  /* The fast ones are shorter anyway, the reserved slots keep the slow going */
+  return best[sched_fast] ? best[sched_fast] : best[sched_slow];
+}
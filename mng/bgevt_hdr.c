@@ -6,29 +6,44 @@
  ************************************************************************/
 
 /* Includes *********************************************************** */
+#define LOG_MODULE log_mod_mng
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include <unistd.h>
 
 #include "projconfig.h"
 #include "bg_uart_cbs.h"
+#include "bgapi_stat.h"
 #include "uart.h"
 #include "bgevt_hdr.h"
 #include "socket_handler.h"
 #include "gecko_bglib.h"
 #include "logging.h"
+#include "trace.h"
 #include "mng.h"
 #include "nwk.h"
 #include "dev_config.h"
+#include "ddb_cache.h"
+#include "lat_hist.h"
 #include "startup.h"
 
 /* Defines  *********************************************************** */
 BGLIB_DEFINE();
 
+/* Events kept while waiting for another, as many as bglib queues */
+#define DEFERRED_LEN  BGLIB_QUEUE_LEN
+
 /* Global Variables *************************************************** */
 
 /* Static Variables *************************************************** */
 static volatile int ncp_sync = false;
+/* Synchronized without resetting the NCP target */
+static bool attached = false;
+
+/* Events received by bgevt_wait_keep, handled first by bgevt_dispenser */
+static struct gecko_cmd_packet deferred[DEFERRED_LEN];
+static int deferred_r = 0, deferred_w = 0;
 
 static bgevt_hdr hdrs[] = {
   dev_add_hdr,
@@ -48,7 +63,9 @@ void conn_ncptarget(void)
   proj_args_t *arg = (proj_args_t *)getprojargs();
 
   BGLIB_INITIALIZE_NONBLOCK(u->bglib_output, u->bglib_input, u->bglib_peek);
-  if (arg->enc) {
+  if (arg->replay[0]) {
+    return;
+  } else if (arg->enc) {
     if (connect_domain_socket_server(arg->sock.srv, arg->sock.clt, arg->sock.enc)) {
       LOGE("Connection to domain socket unsuccessful. Exiting..\n");
       exit(EXIT_FAILURE);
@@ -67,59 +84,152 @@ void conn_ncptarget(void)
   }
 }
 
-void sync_host_and_ncp_target(void)
+static void defer(const struct gecko_cmd_packet *evt)
 {
-  int timeout = 0;
-  ncp_sync = false;
-  LOGM("Syncing NCP Host and Target\n");
-  while (timeout < MAXSLEEP && !ncp_sync) {
-    if (getprojargs()->enc) {
-      poll_update(50);
-    }
-    struct gecko_cmd_packet *p = gecko_peek_event();
+  if ((deferred_w + 1) % DEFERRED_LEN == deferred_r) {
+    LOGW("Event[0x%08x] Dropped, Too Many Kept While Waiting\n",
+         BGLIB_MSG_ID(evt->header));
+    bgapi_stat_evt(evt->header, bgapi_evt_dropped);
+    return;
+  }
+  memcpy(&deferred[deferred_w], evt,
+         BGLIB_MSG_HEADER_LEN + BGLIB_MSG_LEN(evt->header));
+  deferred_w = (deferred_w + 1) % DEFERRED_LEN;
+}
+
+static struct gecko_cmd_packet *wait_evt(uint32_t id, uint32_t timeout_ms,
+                                         bool keep)
+{
+  const bguart_t *u = get_bguart_impl();
+  uint64_t now, end = lat_now_us() + (uint64_t)timeout_ms * 1000;
+  struct gecko_cmd_packet *evt;
 
-    if (p && BGLIB_MSG_ID(p->header) == gecko_evt_system_boot_id) {
-      LOGM("System Booted - Host and NCP Target Synchronized\n");
-      ncp_sync = true;
-      return;
+  while (1) {
+    while (NULL != (evt = gecko_peek_event())) {
+      if (BGLIB_MSG_ID(evt->header) == id) {
+        return evt;
+      }
+      if (keep) {
+        defer(evt);
+        continue;
+      }
+      LOGV("Event[0x%08x] Dropped While Waiting for [0x%08x]\n",
+           BGLIB_MSG_ID(evt->header), id);
     }
+    now = lat_now_us();
+    if (now >= end) {
+      return NULL;
+    }
+    u->bglib_wait((int32_t)((end - now + 999) / 1000));
+  }
+}
+
+struct gecko_cmd_packet *bgevt_wait(uint32_t id, uint32_t timeout_ms)
+{
+  return wait_evt(id, timeout_ms, false);
+}
+
+struct gecko_cmd_packet *bgevt_wait_keep(uint32_t id, uint32_t timeout_ms)
+{
+  return wait_evt(id, timeout_ms, true);
+}
 
+void sync_host_and_ncp_target(void)
+{
+  uint64_t start = lat_now_us(), end = start + (uint64_t)MAXSLEEP * 1000000;
+  uint32_t backoff = NCP_RESET_BACKOFF_MIN_MS;
+
+  ncp_sync = false;
+  attached = false;
+  /* The DDB is read again after the NCP target resets */
+  ddb_cache_invalidate();
+  LOGM("Syncing NCP Host and Target\n");
+  /* The NCP target may have booted before the host is up */
+  ncp_sync = (NULL != bgevt_wait(gecko_evt_system_boot_id, 0));
+  while (!ncp_sync && lat_now_us() < end) {
     gecko_cmd_system_reset(0);
     LOGM("Sent reset signal to NCP target\n");
-    sleep(1);
-    timeout++;
+    ncp_sync = (NULL != bgevt_wait(gecko_evt_system_boot_id, backoff));
+    backoff = backoff * 2 > NCP_RESET_BACKOFF_MAX_MS
+              ? NCP_RESET_BACKOFF_MAX_MS : backoff * 2;
   }
 
   if (!ncp_sync) {
     LOGE("Failed to Synchronize NCP Target\n");
     exit(EXIT_FAILURE);
   }
+  LOGM("System Booted - Host and NCP Target Synchronized in %ums\n",
+       (unsigned)((lat_now_us() - start) / 1000));
+}
+
+bool attach_ncp_target(void)
+{
+  uint16_t ret;
+
+  ncp_sync = false;
+  attached = false;
+  /* The DDB may have changed while the host was away */
+  ddb_cache_invalidate();
+  if (NULL != bgevt_wait(gecko_evt_system_boot_id, 0)) {
+    /* The NCP target restarted anyway, nothing to keep */
+    LOGM("NCP Target Booted - Host and NCP Target Synchronized\n");
+    ncp_sync = true;
+    return true;
+  }
+  ret = gecko_cmd_system_hello()->result;
+  if (ret != bg_err_success) {
+    LOGBGE("system hello", ret);
+    return false;
+  }
+  LOGM("NCP Target Running - Attached Without Reset\n");
+  ncp_sync = true;
+  attached = true;
+  return true;
+}
+
+bool ncp_target_attached(void)
+{
+  return attached;
+}
+
+static void bgevt_dispatch(const struct gecko_cmd_packet *evt)
+{
+  bool handled = false;
+  bgevt_hdr *h = hdrs;
+
+  TRC(trc_bgevt, BGLIB_MSG_ID(evt->header));
+  while (*h && !handled) {
+    handled = (*h)(evt);
+    h++;
+  }
+  if (!handled) {
+    bgapi_stat_evt(evt->header, bgapi_evt_unhandled);
+    TRC(trc_bgevt_unhandled, BGLIB_MSG_ID(evt->header));
+  }
 }
 
 void bgevt_dispenser(void)
 {
-  bool handled;
   struct gecko_cmd_packet *evt = NULL;
   if (!ncp_sync) {
     sync_host_and_ncp_target();
     return;
   }
 
+  /* Kept by a wait in the order received, before the newer ones */
+  while (deferred_r != deferred_w) {
+    evt = &deferred[deferred_r];
+    deferred_r = (deferred_r + 1) % DEFERRED_LEN;
+    bgevt_dispatch(evt);
+  }
+
   do {
-    handled = false;
     if (getprojargs()->enc) {
       poll_update(50);
     }
     evt = gecko_peek_event();
     if (evt) {
-      bgevt_hdr *h = hdrs;
-      while (*h && !handled) {
-        handled = (*h)(evt);
-        h++;
-      }
-      if (!handled) {
-        LOGW("NCP Target Event [0x%08x] Not Handled\n", BGLIB_MSG_ID(evt->header));
-      }
+      bgevt_dispatch(evt);
     }
   } while (evt);
 }
@@ -0,0 +1,156 @@
+/*************************************************************************
+    > File Name: cfg_digest.c
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Digest of the configuration applied to a node.
+    The digest is stored with Done in the nodes config file when the node is
+    configured successfully, a part of it per group of config states. When the
+    lists are loaded, a done node is configured again only if the digest of its
+    current template and overrides differs, and only the states of the parts
+    which differ are run.
+ ************************************************************************/
+
+/* Includes *********************************************************** */
+#define LOG_MODULE log_mod_dev_config
+#include <stdio.h>
+#include <string.h>
+
+#include "projconfig.h"
+#include "cfg_digest.h"
+#include "dev_config.h"
+#include "generic_parser.h"
+#include "logging.h"
+#include "utils.h"
+
+/* Defines  *********************************************************** */
+
+/* Global Variables *************************************************** */
+
+/* Static Variables *************************************************** */
+static const char *part_names[] = { "appkey", "pub", "sub", "config" };
+
+/* Static Functions Declaractions ************************************* */
+static uint32_t hash_list(uint32_t h, const uint16list_t *l)
+{
+  if (!l) {
+    return utils_hash_u16(h, 0xffff);
+  }
+  h = utils_hash_u16(h, l->len);
+  for (int i = 0; i < l->len; i++) {
+    h = utils_hash_u16(h, l->data[i]);
+  }
+  return h;
+}
+
+static uint32_t hash_txp(uint32_t h, const txparam_t *txp)
+{
+  if (!txp) {
+    return utils_hash_u16(h, 0xffff);
+  }
+  return utils_hash_u16(utils_hash_u16(h, txp->cnt), txp->intv);
+}
+
+static uint32_t hash_u8p(uint32_t h, const uint8_t *v)
+{
+  return utils_hash_u16(h, v ? *v : 0xffff);
+}
+
+static void calc(const node_t *node, uint32_t dg[dg_max])
+{
+  const mesh_config_t *c = &node->config;
+  uint32_t h;
+
+  /* Only the app keys the provisioner has are added and bound */
+  h = UTILS_HASH_INIT;
+  for (int i = 0; c->bindings && i < c->bindings->len; i++) {
+    if (asr_suc == appkey_by_refid(get_mng(), c->bindings->data[i], NULL)) {
+      h = utils_hash_u16(h, c->bindings->data[i]);
+    }
+  }
+  dg[dg_appkey] = h;
+
+  h = UTILS_HASH_INIT;
+  if (c->pub) {
+    h = utils_hash_u16(h, c->pub->addr);
+    h = utils_hash_u16(h, c->pub->aki);
+    h = utils_hash_u16(h, c->pub->period);
+    h = utils_hash_u16(h, c->pub->period >> 16);
+    h = utils_hash_u16(h, c->pub->ttl);
+    h = hash_txp(h, &c->pub->txp);
+  }
+  dg[dg_pub] = h;
+
+  dg[dg_sub] = hash_list(UTILS_HASH_INIT, c->sublist);
+
+  h = utils_hash_u16(UTILS_HASH_INIT, c->features.target & 0xffff);
+  h = hash_u8p(h, c->ttl);
+  h = hash_u8p(h, c->snb);
+  h = hash_txp(h, c->net_txp);
+  h = hash_txp(h, c->features.relay_txp);
+  dg[dg_config] = h;
+
+  /* All 0 means unknown */
+  for (int i = 0; i < dg_max; i++) {
+    if (!dg[i]) {
+      dg[i] = 1;
+    }
+  }
+}
+
+/* NODE_DIGEST_LEN holds a 32-bit hash per part */
+static void to_bytes(const uint32_t dg[dg_max], uint8_t *buf)
+{
+  for (int i = 0; i < dg_max; i++) {
+    buf[i * 4] = dg[i] >> 24;
+    buf[i * 4 + 1] = dg[i] >> 16;
+    buf[i * 4 + 2] = dg[i] >> 8;
+    buf[i * 4 + 3] = dg[i];
+  }
+}
+
+uint8_t cfg_digest_redo(const node_t *node)
+{
+  static const uint8_t zero[NODE_DIGEST_LEN] = { 0 };
+  uint8_t cur[NODE_DIGEST_LEN];
+  uint32_t dg[dg_max];
+  uint8_t redo = 0;
+
+  if (!node->done) {
+    return DG_ALL;
+  }
+  if (!memcmp(node->digest, zero, NODE_DIGEST_LEN)) {
+    /* Configured before the digest is stored, trust Done */
+    return 0;
+  }
+  calc(node, dg);
+  to_bytes(dg, cur);
+  for (int i = 0; i < dg_max; i++) {
+    if (memcmp(&cur[i * 4], &node->digest[i * 4], 4)) {
+      BIT_SET(redo, i);
+    }
+  }
+  return redo;
+}
+
+err_t cfg_digest_applied(const node_t *node)
+{
+  uint8_t buf[NODE_DIGEST_LEN];
+  uint32_t dg[dg_max];
+
+  calc(node, dg);
+  to_bytes(dg, buf);
+  return nodeset_digest(node->addr, buf);
+}
+
+const char *cfg_digest_str(uint8_t redo, char *buf)
+{
+  int n = 0;
+
+  buf[0] = 0;
+  for (int i = 0; i < dg_max; i++) {
+    if (IS_BIT_SET(redo, i)) {
+      n += sprintf(buf + n, "%s%s", n ? "|" : "", part_names[i]);
+    }
+  }
+  return buf;
+}
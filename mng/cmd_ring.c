@@ -0,0 +1,199 @@
+/*************************************************************************
+    > File Name: cmd_ring.c
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Command rings between the command sources and the manager
+    thread, one ring per source thread. The source thread is the only one to
+    move the tail of its ring and the manager thread the only one to move the
+    heads, so no lock is needed. The slots are allocated up front, the
+    commands are parsed by the source thread and copied into them, only the
+    words wordexp allocates go along, which the manager frees after running
+    the command. The manager sleeps on an eventfd (a pipe where there's none)
+    when idle, so a command is taken at once instead of after the idle sleep.
+ ************************************************************************/
+
+/* Includes *********************************************************** */
+#define LOG_MODULE log_mod_mng
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#endif
+
+#include "projconfig.h"
+#include "cmd_ring.h"
+#include "logging.h"
+
+/* Defines  *********************************************************** */
+#if (CMD_RING_SIZE & (CMD_RING_SIZE - 1))
+#error "CMD_RING_SIZE must be a power of 2"
+#endif
+
+#define RING_MASK (CMD_RING_SIZE - 1)
+/* us, the source waits in steps for a full ring */
+#define FULL_WAIT_US 1000
+
+typedef struct {
+  cmd_t slots[CMD_RING_SIZE];
+  /* Free running, moved by the manager thread */
+  uint32_t head;
+  /* Free running, moved by the source thread */
+  uint32_t tail;
+  /* Commands run and failed, counted by the manager thread */
+  uint32_t done;
+  uint32_t failed;
+}ring_t;
+
+/* Global Variables *************************************************** */
+
+/* Static Variables *************************************************** */
+static ring_t rings[cmd_src_max];
+/* The ring to take the next command from first, so no source starves */
+static int next_src = 0;
+/* [0] is waited on, [1] is written, the same for an eventfd */
+static int wakefd[2] = { -1, -1 };
+
+/* Static Functions Declaractions ************************************* */
+err_t cmd_ring_init(void)
+{
+  if (wakefd[0] >= 0) {
+    return ec_success;
+  }
+#if defined(__linux__)
+  if (0 > (wakefd[0] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))) {
+    LOGE("eventfd error[%s]\n", strerror(errno));
+    return err(ec_errno);
+  }
+  wakefd[1] = wakefd[0];
+#else
+  if (pipe(wakefd)) {
+    LOGE("pipe error[%s]\n", strerror(errno));
+    return err(ec_errno);
+  }
+  fcntl(wakefd[0], F_SETFL, fcntl(wakefd[0], F_GETFL) | O_NONBLOCK);
+  fcntl(wakefd[1], F_SETFL, fcntl(wakefd[1], F_GETFL) | O_NONBLOCK);
+#endif
+  return ec_success;
+}
+
+static void wake(void)
+{
+#if defined(__linux__)
+  uint64_t one = 1;
+#else
+  uint8_t one = 1;
+#endif
+
+  if (wakefd[1] < 0) {
+    return;
+  }
+  /* A full pipe or counter already wakes the manager */
+  if (write(wakefd[1], &one, sizeof(one)) < 0 && errno != EAGAIN) {
+    LOGW("Wake manager error[%s]\n", strerror(errno));
+  }
+}
+
+bool cmd_try_enq(int src, const command_t *cmd, const wordexp_t *w, uint32_t tag)
+{
+  ring_t *r = &rings[src];
+  uint32_t t = r->tail;
+  cmd_t *c;
+
+  if (t - __atomic_load_n(&r->head, __ATOMIC_ACQUIRE) >= CMD_RING_SIZE) {
+    return false;
+  }
+  c = &r->slots[t & RING_MASK];
+  c->cmd = cmd;
+  c->w = *w;
+  c->src = src;
+  c->tag = tag;
+  /* The slot is written before the manager can see it */
+  __atomic_store_n(&r->tail, t + 1, __ATOMIC_RELEASE);
+  wake();
+  return true;
+}
+
+void cmd_enq(int src, const command_t *cmd, const wordexp_t *w, uint32_t tag)
+{
+  bool waited = false;
+
+  while (!cmd_try_enq(src, cmd, w, tag)) {
+    if (!waited) {
+      LOGW("Command Ring[%d] Full, Waiting for the Manager\n", src);
+      waited = true;
+    }
+    wake();
+    usleep(FULL_WAIT_US);
+  }
+}
+
+static inline bool ring_empty(const ring_t *r)
+{
+  return r->head == __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE);
+}
+
+bool cmd_deq(cmd_t *c)
+{
+  ring_t *r;
+  uint32_t h;
+
+  for (int i = 0; i < cmd_src_max; i++) {
+    r = &rings[(next_src + i) % cmd_src_max];
+    if (ring_empty(r)) {
+      continue;
+    }
+    h = r->head;
+    *c = r->slots[h & RING_MASK];
+    /* The slot is read before the source can reuse it */
+    __atomic_store_n(&r->head, h + 1, __ATOMIC_RELEASE);
+    next_src = (c->src + 1) % cmd_src_max;
+    return true;
+  }
+  return false;
+}
+
+void cmd_done(const cmd_t *c, err_t e)
+{
+  ring_t *r = &rings[c->src];
+
+  if (e != ec_success) {
+    __atomic_add_fetch(&r->failed, 1, __ATOMIC_RELAXED);
+  }
+  __atomic_add_fetch(&r->done, 1, __ATOMIC_RELEASE);
+}
+
+uint32_t cmd_ring_pending(int src)
+{
+  return rings[src].tail - __atomic_load_n(&rings[src].done, __ATOMIC_ACQUIRE);
+}
+
+uint32_t cmd_ring_failed(int src)
+{
+  return __atomic_load_n(&rings[src].failed, __ATOMIC_RELAXED);
+}
+
+void cmd_ring_wait(int timeout_ms)
+{
+  struct pollfd pfd = { .fd = wakefd[0], .events = POLLIN };
+  uint8_t buf[64];
+
+  if (wakefd[0] < 0) {
+    usleep(timeout_ms * 1000);
+    return;
+  }
+  for (int i = 0; i < cmd_src_max; i++) {
+    if (!ring_empty(&rings[i])) {
+      timeout_ms = 0;
+    }
+  }
+  if (timeout_ms) {
+    poll(&pfd, 1, timeout_ms);
+  }
+  /* Cleared before the ring is drained, a later command wakes again */
+  while (read(wakefd[0], buf, sizeof(buf)) > 0) {
+  }
+}
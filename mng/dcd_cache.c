@@ -0,0 +1,394 @@
+/*************************************************************************
+    > File Name: dcd_cache.c
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Cache of the composition data page 0.
+    Each device type, told by CID/PID/VID/CRPL, is parsed once to a dcd_t
+    which is never changed or freed afterwards, all the config caches of the
+    type point to it. The device type of a node is not known before its DCD is
+    got, so it's learned from the templates, once DCD_CACHE_CONFIRM nodes of a
+    template returned the same DCD, the later nodes of the template skip the
+    Get DCD state. The mapping is only a guess, so it's checked again by the
+    first node of the template in each run, by one node in DCD_CACHE_RECHECK
+    after, and by the nodes failed before, and dropped if a node disagrees.
+ ************************************************************************/
+
+/* Includes *********************************************************** */
+#define LOG_MODULE log_mod_dev_config
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+
+#include "projconfig.h"
+#include "dcd_cache.h"
+#include "logging.h"
+#include "utils.h"
+
+/* Defines  *********************************************************** */
+#define GENERIC_ONOFF_SERVER_MDID       0x1000
+#define LIGHT_LIGHTNESS_SERVER_MDID     0x1300
+#define LIGHT_CTL_SERVER_MDID           0x1303
+#define SENSOR_SERVER_MDID              0x1100
+
+#define CONFIGURATION_SERVER_MDID       0x0000
+#define CONFIGURATION_CLIENT_MDID       0x0001
+
+/* CID, PID, VID, CRPL and Features */
+#define PAGE0_HDR_LEN 10
+/* Loc, NumS and NumV */
+#define ELEM_HDR_LEN  4
+
+#define TMPL_NUM  256
+/* A page is 255 bytes at most */
+#define LINE_MAX_LEN  600
+
+/* Global Variables *************************************************** */
+
+/* Static Variables *************************************************** */
+/* All the device types, the newest first */
+static GList *dcds = NULL;
+/* Device types replaced by a different page of the same identity, kept since
+ * the config caches may still point to them */
+static GList *retired = NULL;
+
+static struct {
+  const dcd_t *dcd;
+  /* Nodes of which the DCD was fetched in this run */
+  uint8_t hits;
+  uint8_t confirmed;
+  uint8_t conflict;
+  /* Nodes which skipped getting the DCD since the last one got it */
+  uint8_t skipped;
+}tmpls[TMPL_NUM];
+
+static dcd_cache_stat_t counters = { 0 };
+static char file_path[FILE_PATH_MAX] = { 0 };
+
+/* Static Functions Declaractions ************************************* */
+static err_t dcd_cache_save(void);
+
+static bool same_type(const dcd_t *a, const dcd_t *b)
+{
+  return a->cid == b->cid && a->pid == b->pid
+         && a->vid == b->vid && a->crpl == b->crpl;
+}
+
+static void dcd_free(dcd_t *dcd)
+{
+  for (int e = 0; e < dcd->element_cnt; e++) {
+    SAFE_FREE(dcd->elems[e].sig_models);
+    SAFE_FREE(dcd->elems[e].vm);
+  }
+  SAFE_FREE(dcd->elems);
+  SAFE_FREE(dcd->raw);
+  free(dcd);
+}
+
+static int elems_count(const uint8_t *data, uint8_t len)
+{
+  int i = PAGE0_HDR_LEN, n = 0;
+
+  while (i + ELEM_HDR_LEN <= len) {
+    i += ELEM_HDR_LEN + sizeof(uint16_t) * data[i + 2]
+         + sizeof(uint16_t) * 2 * data[i + 3];
+    n++;
+  }
+  return (i == len && n <= 0xff) ? n : -1;
+}
+
+/*
+ * The configuration models are left out since they need no binding,
+ * publication or subscription
+ */
+static dcd_t *dcd_parse(const uint8_t *data, uint8_t len)
+{
+  int i, n;
+  dcd_t *dcd;
+
+  if (len < PAGE0_HDR_LEN || (n = elems_count(data, len)) < 0) {
+    return NULL;
+  }
+  dcd = (dcd_t *)calloc(1, sizeof(dcd_t));
+  if (!dcd) {
+    return NULL;
+  }
+  dcd->cid = BUILD_UINT16(data[0], data[1]);
+  dcd->pid = BUILD_UINT16(data[2], data[3]);
+  dcd->vid = BUILD_UINT16(data[4], data[5]);
+  dcd->crpl = BUILD_UINT16(data[6], data[7]);
+  dcd->feature = BUILD_UINT16(data[8], data[9]);
+  dcd->len = len;
+  alloc_copy(&dcd->raw, data, len);
+  dcd->elems = (elem_t *)calloc(n ? n : 1, sizeof(elem_t));
+  if (!dcd->raw || !dcd->elems) {
+    dcd_free(dcd);
+    return NULL;
+  }
+  /* Only once there are elements for dcd_free to walk */
+  dcd->element_cnt = n;
+
+  i = PAGE0_HDR_LEN;
+  for (int e = 0; e < n; e++) {
+    elem_t *elem = &dcd->elems[e];
+    uint8_t sigm_cnt = data[i + 2];
+
+    elem->vm_cnt = data[i + 3];
+    i += ELEM_HDR_LEN;
+    if (sigm_cnt) {
+      elem->sig_models = (uint16_t *)calloc(sigm_cnt, sizeof(uint16_t));
+    }
+    if (elem->vm_cnt) {
+      elem->vm = (vendor_model_t *)calloc(elem->vm_cnt,
+                                          sizeof(vendor_model_t));
+    }
+    if ((sigm_cnt && !elem->sig_models) || (elem->vm_cnt && !elem->vm)) {
+      dcd_free(dcd);
+      return NULL;
+    }
+    for (uint8_t ms = 0; ms < sigm_cnt; ms++) {
+      uint16_t mdid = BUILD_UINT16(data[i], data[i + 1]);
+      i += 2;
+      if (mdid == GENERIC_ONOFF_SERVER_MDID) {
+        dcd->func |= ONOFF_SV_BIT;
+      } else if (mdid == LIGHT_LIGHTNESS_SERVER_MDID) {
+        dcd->func |= LIGHTNESS_SV_BIT;
+      } else if (mdid == LIGHT_CTL_SERVER_MDID) {
+        dcd->func |= CTL_SV_BIT;
+      } else if (mdid == SENSOR_SERVER_MDID) {
+        dcd->func |= SENSOR_SV_BIT;
+      }
+      if (mdid == CONFIGURATION_CLIENT_MDID
+          || mdid == CONFIGURATION_SERVER_MDID) {
+        continue;
+      }
+      elem->sig_models[elem->sigm_cnt++] = mdid;
+    }
+    for (uint8_t ms = 0; ms < elem->vm_cnt; ms++) {
+      elem->vm[ms].vid = BUILD_UINT16(data[i], data[i + 1]);
+      elem->vm[ms].mid = BUILD_UINT16(data[i + 2], data[i + 3]);
+      i += 4;
+    }
+  }
+  return dcd;
+}
+
+static const dcd_t *dcd_find(uint16_t cid,
+                             uint16_t pid,
+                             uint16_t vid,
+                             uint16_t crpl)
+{
+  dcd_t key = { cid, pid, vid, crpl };
+
+  for (GList *p = dcds; p; p = p->next) {
+    if (same_type(p->data, &key)) {
+      return p->data;
+    }
+  }
+  return NULL;
+}
+
+static const dcd_t *dcd_intern(const uint8_t *data, uint8_t len, bool *added)
+{
+  dcd_t *dcd, *old;
+
+  *added = false;
+  if (!(dcd = dcd_parse(data, len))) {
+    return NULL;
+  }
+  old = (dcd_t *)dcd_find(dcd->cid, dcd->pid, dcd->vid, dcd->crpl);
+  if (old && old->len == len && !memcmp(old->raw, data, len)) {
+    dcd_free(dcd);
+    return old;
+  }
+  if (old) {
+    LOGW("DCD of CID/PID/VID 0x%04x/0x%04x/0x%04x changed\n",
+         dcd->cid, dcd->pid, dcd->vid);
+    dcds = g_list_remove(dcds, old);
+    retired = g_list_prepend(retired, old);
+    for (int t = 0; t < TMPL_NUM; t++) {
+      if (tmpls[t].dcd == old) {
+        memset(&tmpls[t], 0, sizeof(tmpls[t]));
+      }
+    }
+  }
+  dcds = g_list_prepend(dcds, dcd);
+  *added = true;
+  return dcd;
+}
+
+const dcd_t *dcd_cache_add(const uint8_t *data, uint8_t len)
+{
+  bool added;
+  const dcd_t *dcd = dcd_intern(data, len, &added);
+
+  if (!dcd) {
+    LOGE("Malformed DCD page 0, len %u\n", len);
+    return NULL;
+  }
+  counters.fetched++;
+  if (added) {
+    LOGM("New device type CID/PID/VID 0x%04x/0x%04x/0x%04x, %u elements\n",
+         dcd->cid, dcd->pid, dcd->vid, dcd->element_cnt);
+    dcd_cache_save();
+  }
+  return dcd;
+}
+
+void dcd_cache_learn(const node_t *node, const dcd_t *dcd)
+{
+  uint8_t t;
+
+  if (!node->tmpl || !dcd) {
+    return;
+  }
+  t = *node->tmpl;
+  if (tmpls[t].conflict) {
+    return;
+  }
+  if (!tmpls[t].dcd) {
+    tmpls[t].dcd = dcd;
+    tmpls[t].hits = 1;
+  } else if (tmpls[t].dcd == dcd) {
+    if (tmpls[t].hits < 0xff) {
+      tmpls[t].hits++;
+    }
+  } else {
+    LOGW("Template 0x%02x is used by different device types, always get the"
+         " DCD of its nodes\n", t);
+    tmpls[t].dcd = NULL;
+    tmpls[t].confirmed = 0;
+    tmpls[t].conflict = 1;
+    counters.conflicts++;
+    dcd_cache_save();
+    return;
+  }
+  if (!tmpls[t].confirmed && tmpls[t].hits >= DCD_CACHE_CONFIRM) {
+    tmpls[t].confirmed = 1;
+    dcd_cache_save();
+  }
+}
+
+const dcd_t *dcd_cache_lookup(const node_t *node)
+{
+  uint8_t t;
+
+  if (!node->tmpl) {
+    return NULL;
+  }
+  t = *node->tmpl;
+  /* A mapping loaded from the file isn't trusted before a node agrees */
+  if (!tmpls[t].confirmed || !tmpls[t].hits) {
+    return NULL;
+  }
+  /* The node may be another product than the template tells */
+  if (node->err || ++tmpls[t].skipped >= DCD_CACHE_RECHECK) {
+    tmpls[t].skipped = 0;
+    return NULL;
+  }
+  counters.shortcut++;
+  return tmpls[t].dcd;
+}
+
+const dcd_t *dcd_cache_tmpl(uint8_t refid, uint8_t *hits)
+{
+  if (hits) {
+    *hits = tmpls[refid].hits;
+  }
+  return tmpls[refid].confirmed ? tmpls[refid].dcd : NULL;
+}
+
+err_t dcd_cache_forget(void)
+{
+  memset(tmpls, 0, sizeof(tmpls));
+  memset(&counters, 0, sizeof(counters));
+  return dcd_cache_save();
+}
+
+const dcd_cache_stat_t *dcd_cache_stat(void)
+{
+  return &counters;
+}
+
+/*
+ * One device type or template mapping per line,
+ *   dcd <page 0 in hex>
+ *   tmpl <refid> <cid> <pid> <vid> <crpl>
+ */
+static err_t dcd_cache_save(void)
+{
+  FILE *fp;
+  char tmp[FILE_PATH_MAX + 4];
+  char hex[LINE_MAX_LEN];
+
+  if (!file_path[0]) {
+    return ec_success;
+  }
+  snprintf(tmp, sizeof(tmp), "%s.tmp", file_path);
+  if (!(fp = fopen(tmp, "w"))) {
+    LOGE("Cannot write the DCD cache to %s\n", tmp);
+    return err(ec_file_ope);
+  }
+  fprintf(fp, "# Composition data page 0 of each device type and the"
+              " templates mapped to them\n");
+  /* Oldest first, so the loading keeps the order */
+  for (GList *p = g_list_last(dcds); p; p = p->prev) {
+    const dcd_t *dcd = p->data;
+    memset(hex, 0, sizeof(hex));
+    cbuf2str((const char *)dcd->raw, dcd->len, 0, hex, sizeof(hex));
+    fprintf(fp, "dcd %s\n", hex);
+  }
+  for (int t = 0; t < TMPL_NUM; t++) {
+    if (tmpls[t].confirmed) {
+      fprintf(fp, "tmpl %02x %04x %04x %04x %04x\n", t,
+              tmpls[t].dcd->cid, tmpls[t].dcd->pid,
+              tmpls[t].dcd->vid, tmpls[t].dcd->crpl);
+    }
+  }
+  fclose(fp);
+  if (rename(tmp, file_path)) {
+    LOGE("Cannot write the DCD cache to %s\n", file_path);
+    return err(ec_file_ope);
+  }
+  return ec_success;
+}
+
+void dcd_cache_init(const char *path)
+{
+  FILE *fp;
+  char line[LINE_MAX_LEN];
+  char hex[LINE_MAX_LEN];
+  uint8_t raw[0xff];
+  unsigned t, cid, pid, vid, crpl;
+  const dcd_t *dcd;
+  bool added;
+  int types = 0, mapped = 0;
+
+  file_path[0] = 0;
+  if (path) {
+    snprintf(file_path, FILE_PATH_MAX, "%s", path);
+  }
+  if (!path || !(fp = fopen(path, "r"))) {
+    return;
+  }
+  while (fgets(line, sizeof(line), fp)) {
+    if (1 == sscanf(line, "dcd %599s", hex)) {
+      if (strlen(hex) > 2 * sizeof(raw)
+          || ec_success != str2cbuf(hex, 0, (char *)raw, sizeof(raw))
+          || !dcd_intern(raw, strlen(hex) / 2, &added)) {
+        LOGW("Bad DCD in %s: %s", path, line);
+        continue;
+      }
+      types++;
+    } else if (5 == sscanf(line, "tmpl %x %x %x %x %x",
+                           &t, &cid, &pid, &vid, &crpl)) {
+      if (t < TMPL_NUM && (dcd = dcd_find(cid, pid, vid, crpl))) {
+        tmpls[t].dcd = dcd;
+        tmpls[t].confirmed = 1;
+        mapped++;
+      }
+    }
+  }
+  fclose(fp);
+  LOGM("DCD cache loaded, %d device types, %d templates\n", types, mapped);
+}
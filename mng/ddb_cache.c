@@ -0,0 +1,191 @@
+/*************************************************************************
+    > File Name: ddb_cache.c
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Copy of the device database of the NCP target.
+    Loading the lists needs to know which nodes are in the DDB. Rather than a
+    DDB get per node on every sync, the DDB is listed once and the devices are
+    kept in a tree by UUID. The tree is kept in step with the devices
+    provisioned and deleted by the manager, and dropped when the NCP target
+    resets or is erased, so it's listed again on the next sync.
+ ************************************************************************/
+
+/* Includes *********************************************************** */
+#define LOG_MODULE log_mod_mng
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+
+#include "projconfig.h"
+#include "ddb_cache.h"
+#include "bgevt_hdr.h"
+#include "gecko_bglib.h"
+#include "lat_hist.h"
+#include "logging.h"
+#include "utils.h"
+
+/* Defines  *********************************************************** */
+typedef struct {
+  /* Key of the tree */
+  uint8_t uuid[16];
+  uint16_t addr;
+  uint8_t elements;
+}ddb_dev_t;
+
+/* Global Variables *************************************************** */
+
+/* Static Variables *************************************************** */
+static GTree *devs = NULL;
+static bool valid = false;
+
+/* Static Functions Declaractions ************************************* */
+static gint uuid_comp(gconstpointer a, gconstpointer b, gpointer user_data)
+{
+  return memcmp(a, b, 16);
+}
+
+static void put(const uint8_t *uuid, uint16_t addr, uint8_t elements)
+{
+  ddb_dev_t *d = g_tree_lookup(devs, uuid);
+
+  if (!d) {
+    if (NULL == (d = calloc(1, sizeof(ddb_dev_t)))) {
+      /* Can't tell the device is in the DDB */
+      valid = false;
+      return;
+    }
+    memcpy(d->uuid, uuid, 16);
+    g_tree_insert(devs, d->uuid, d);
+  }
+  d->addr = addr;
+  d->elements = elements;
+}
+
+static void clear(void)
+{
+  if (devs) {
+    g_tree_destroy(devs);
+  }
+  devs = g_tree_new_full(uuid_comp, NULL, NULL, free);
+}
+
+err_t ddb_cache_sync(void)
+{
+  struct gecko_msg_mesh_prov_ddb_list_devices_rsp_t *rsp;
+  struct gecko_cmd_packet *evt;
+  uint16_t cnt;
+  uint64_t now, end;
+
+  if (valid) {
+    return ec_success;
+  }
+  clear();
+  rsp = gecko_cmd_mesh_prov_ddb_list_devices();
+  if (rsp->result != bg_err_success) {
+    LOGBGE("ddb list devices", rsp->result);
+    return err(ec_bgrsp);
+  }
+
+  cnt = rsp->count;
+  end = lat_now_us() + (uint64_t)DDB_LIST_TIMEOUT * 1000000;
+  /* Valid until a put fails */
+  valid = true;
+  while (cnt) {
+    now = lat_now_us();
+    /* The other events are handled by the main loop after the listing */
+    evt = now < end
+          ? bgevt_wait_keep(gecko_evt_mesh_prov_ddb_list_id,
+                            (uint32_t)((end - now + 999) / 1000))
+          : NULL;
+    if (!evt) {
+      LOGE("%d Devices in NCP Target DDB Not Listed\n", cnt);
+      valid = false;
+      return err(ec_timeout);
+    }
+    put(evt->data.evt_mesh_prov_ddb_list.uuid.data,
+        evt->data.evt_mesh_prov_ddb_list.address,
+        evt->data.evt_mesh_prov_ddb_list.elements);
+    cnt--;
+  }
+  LOGM("%d Devices in NCP Target DDB\n", g_tree_nnodes(devs));
+  return valid ? ec_success : err(ec_not_exist);
+}
+
+bool ddb_cache_valid(void)
+{
+  return valid;
+}
+
+bool ddb_cache_has(const uint8_t *uuid)
+{
+  return valid && g_tree_lookup(devs, uuid);
+}
+
+void ddb_cache_add(const uint8_t *uuid, uint16_t addr)
+{
+  if (valid) {
+    put(uuid, addr, 0);
+  }
+}
+
+void ddb_cache_del(const uint8_t *uuid)
+{
+  if (valid) {
+    g_tree_remove(devs, uuid);
+  }
+}
+
+void ddb_cache_invalidate(void)
+{
+  valid = false;
+}
+
+uint32_t ddb_cache_dev_hash(const uint8_t *uuid, uint16_t addr)
+{
+  uint32_t h = UTILS_HASH_INIT;
+
+  for (int i = 0; i < 16; i += 2) {
+    h = utils_hash_u16(h, uuid[i] | (uuid[i + 1] << 8));
+  }
+  return utils_hash_u16(h, addr);
+}
+
+static gboolean digest_one(gpointer key, gpointer value, gpointer data)
+{
+  const ddb_dev_t *d = value;
+
+  *(uint32_t *)data += ddb_cache_dev_hash(d->uuid, d->addr);
+  return FALSE;
+}
+
+uint32_t ddb_cache_digest(int *count)
+{
+  uint32_t sum = 0;
+
+  if (!valid) {
+    *count = -1;
+    return 0;
+  }
+  *count = g_tree_nnodes(devs);
+  g_tree_foreach(devs, digest_one, &sum);
+  return sum;
+}
+
+static gboolean dump_one(gpointer key, gpointer value, gpointer data)
+{
+  const ddb_dev_t *d = value;
+
+  LOGD("dev - [%x:%x:%x] 0x%04x\n",
+       d->uuid[12], d->uuid[11], d->uuid[10], d->addr);
+  return FALSE;
+}
+
+void ddb_cache_dump(void)
+{
+  if (!valid) {
+    LOGM("NCP Target DDB Not Listed\n");
+    return;
+  }
+  LOGM("%d Devices in NCP Target DDB\n", g_tree_nnodes(devs));
+  g_tree_foreach(devs, dump_one, NULL);
+}
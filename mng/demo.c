@@ -6,6 +6,7 @@
  ************************************************************************/
 
 /* Includes *********************************************************** */
+#define LOG_MODULE log_mod_mng
 #include "mng.h"
 /* Defines  *********************************************************** */
 
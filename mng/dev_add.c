@@ -6,6 +6,7 @@
  ************************************************************************/
 
 /* Includes *********************************************************** */
+#define LOG_MODULE log_mod_mng
 /* #include "dev_add.h" */
 #include <glib.h>
 
@@ -19,8 +20,15 @@
 #include "cli.h"
 #include "generic_parser.h"
 #include "stat.h"
+#include "timeline.h"
+#include "shaper.h"
+#include "ddb_cache.h"
+#include "rpc.h"
 
 /* Defines  *********************************************************** */
+/* Last 4 bytes of the UUID, shown in the timeline */
+#define UUID_TAIL(uuid) \
+  (((uint32_t)(uuid)[12] << 24) | ((uuid)[13] << 16) | ((uuid)[14] << 8) | (uuid)[15])
 
 /* Global Variables *************************************************** */
 
@@ -75,6 +83,7 @@ static inline void rmcached(mng_t *mng,
         || memcmp(mng->cache.add[i].uuid, uuid, 16)) {
       continue;
     }
+    TL_END(tl_lane_prov + i);
     memset(&mng->cache.add[i], 0, sizeof(add_cache_t));
   }
 }
@@ -123,6 +132,7 @@ static void on_beacon_recv(const struct gecko_msg_mesh_prov_unprov_beacon_evt_t
   uint16_t ret;
   mng_t *mng = get_mng();
   node_t *n;
+  uint64_t beacon_us = lat_now_us();
 
   ASSERT(evt);
 
@@ -157,12 +167,18 @@ static void on_beacon_recv(const struct gecko_msg_mesh_prov_unprov_beacon_evt_t
     return;
   }
 
+  if (!shaper_take(shp_background)) {
+    /* The device keeps sending the beacon */
+    return;
+  }
   LOGM("Unprovisioned beacon match. Start provisioning it\n");
   ret = gecko_cmd_mesh_prov_provision_device(mng->cfg->subnets[0].netkey.id,
                                              16,
                                              evt->uuid.data)->result;
   if (bg_err_out_of_memory == ret) {
     LOGW("Provision Device OOM\n");
+    stat_oom(oom_prov);
+    TL_INSTANT(tl_lane_prov + freeid, "oom", "dev", UUID_TAIL(evt->uuid.data));
     mng->status.oom = 1;
     mng->status.oom_expired = time(NULL) + OOM_DELAY_TIMEOUT;
     if (!scan_need_recover) {
@@ -180,7 +196,9 @@ static void on_beacon_recv(const struct gecko_msg_mesh_prov_unprov_beacon_evt_t
 
   mng->cache.add[freeid].busy = 1;
   mng->cache.add[freeid].expired = time(NULL) + ADD_NO_RSP_TIMEOUT;
+  mng->cache.add[freeid].beacon_us = beacon_us;
   memcpy(mng->cache.add[freeid].uuid, evt->uuid.data, 16);
+  TL_SLICE(tl_lane_prov + freeid, "provisioning", "dev", UUID_TAIL(evt->uuid.data));
 
   if (is_cache_full(mng)) {
     scan_need_recover = true;
@@ -194,6 +212,7 @@ static void on_beacon_recv(const struct gecko_msg_mesh_prov_unprov_beacon_evt_t
 static void on_prov_success(const struct gecko_msg_mesh_prov_device_provisioned_evt_t *evt)
 {
   err_t e;
+  int i;
   mng_t *mng = get_mng();
   node_t *n;
   char uuid_str[33] = { 0 };
@@ -205,6 +224,7 @@ static void on_prov_success(const struct gecko_msg_mesh_prov_device_provisioned_
    * meanwhile, set the address */
   e = upl_nodeset_addr(evt->uuid.data, evt->address);
   elog(e);
+  ddb_cache_add(evt->uuid.data, evt->address);
 
   /* move the node from add list to config list */
   n = cfgdb_node_get(evt->address);
@@ -213,6 +233,11 @@ static void on_prov_success(const struct gecko_msg_mesh_prov_device_provisioned_
   mng->lists.config = g_list_append(mng->lists.config, n);
 
   stat_add_one_dev();
+  rpc_notify_node(rpc_evt_provisioned, evt->uuid.data, evt->address, 0);
+  i = iscached(mng, evt->uuid.data, NULL);
+  if (i != -1) {
+    stat_prov_lat(mng->cache.add[i].beacon_us);
+  }
   /* Remove from cache. */
   rmcached(mng, evt->uuid.data);
   if (scan_need_recover) {
@@ -295,6 +320,9 @@ static int prov_failed_wa(const struct gecko_msg_mesh_prov_provisioning_failed_e
   ret  = gecko_cmd_mesh_prov_ddb_delete(*(uuid_128 *)evt->uuid.data)->result;
   if (bg_err_success != ret) {
     LOGBGE("gecko_cmd_mesh_prov_ddb_delete", ret);
+    ddb_cache_invalidate();
+  } else {
+    ddb_cache_del(evt->uuid.data);
   }
 
   LOGE("%s Provisioned FAIL, reason[7], workaround applied\n"
@@ -309,6 +337,7 @@ static int prov_failed_wa(const struct gecko_msg_mesh_prov_provisioning_failed_e
 
 static void on_prov_failed(const struct gecko_msg_mesh_prov_provisioning_failed_evt_t *evt)
 {
+  int i;
   char uuid_str[33] = { 0 };
   cbuf2str((char *)evt->uuid.data, 16, 0, uuid_str, 33);
 
@@ -330,6 +359,11 @@ static void on_prov_failed(const struct gecko_msg_mesh_prov_provisioning_failed_
   bt_shell_printf("%s Provisioned FAIL, reason[%u]\n", uuid_str, evt->reason);
 
   stat_add_failed();
+  rpc_notify_node(rpc_evt_prov_failed, evt->uuid.data, 0, evt->reason);
+  i = iscached(get_mng(), evt->uuid.data, NULL);
+  if (i != -1) {
+    TL_INSTANT(tl_lane_prov + i, "prov failed", "reason", evt->reason);
+  }
   /* Remove from cache. */
   rmcached(get_mng(), evt->uuid.data);
   if (scan_need_recover) {
@@ -360,6 +394,8 @@ bool add_loop(void *p)
     }
     /* Remove from cache. */
     LOGE("Adding expired, clear cache.\n");
+    TL_INSTANT(tl_lane_prov + i, "prov expired", "dev", UUID_TAIL(mng->cache.add[i].uuid));
+    TL_END(tl_lane_prov + i);
     memset(&mng->cache.add[i], 0, sizeof(add_cache_t));
   }
   return false;
@@ -6,6 +6,7 @@
  ************************************************************************/
 
 /* Includes *********************************************************** */
+#define LOG_MODULE log_mod_mng
 #include "mng.h"
 #include "logging.h"
 #include "utils.h"
@@ -13,6 +14,7 @@
 #include "cli.h"
 #include "cfg.h"
 #include "stat.h"
+#include "timeline.h"
 
 /* Defines  *********************************************************** */
 
@@ -76,6 +78,7 @@ static err_t kr_start(mng_t *mng)
     return err(ec_bgrsp);
   } else {
     LOGM("Key Refresh Started\n");
+    TL_SLICE(tl_lane_kr, "kr started", "netkey", mng->cfg->subnets[0].netkey.id);
   }
   return ec_success;
 }
@@ -207,9 +210,13 @@ static void kr_node_update(const struct gecko_msg_mesh_prov_key_refresh_node_upd
 
 static void kr_nwk_update(const struct gecko_msg_mesh_prov_key_refresh_phase_update_evt_t *e)
 {
+  static const char *phases[] = {
+    "kr phase 0", "kr phase 1", "kr phase 2", "kr phase 3"
+  };
   LOGM("Network moved to [%u] phase - Netkey ID [%d]\n",
        e->phase,
        e->key);
+  TL_SLICE(tl_lane_kr, phases[e->phase & 3], "netkey", e->key);
 }
 
 static void kr_finish(const struct gecko_msg_mesh_prov_key_refresh_complete_evt_t *e)
@@ -218,6 +225,8 @@ static void kr_finish(const struct gecko_msg_mesh_prov_key_refresh_complete_evt_
   mng_t *mng = get_mng();
 
   mng->cache.bl.state = bl_done;
+  TL_END(tl_lane_kr);
+  TL_INSTANT(tl_lane_kr, "kr complete", "result", e->result);
 
   LOGM("Key Refresh Complete <<%s>>, err[0x%04x]\nNew Network Key Id is 0x%04x\n",
        e->result == 0 ? "YES" : "NO",
@@ -6,13 +6,22 @@
  ************************************************************************/
 
 /* Includes *********************************************************** */
+#define LOG_MODULE log_mod_dev_config
 #include "mng.h"
 
 #include "dev_config.h"
 #include "logging.h"
+#include "trace.h"
 #include "cli.h"
 #include "utils.h"
 #include "stat.h"
+#include "timeline.h"
+#include "dcd_cache.h"
+#include "cfg_digest.h"
+#include "acc_sched.h"
+#include "acc_rto.h"
+#include "shaper.h"
+#include "bgevt_hdr.h"
 /* Defines  *********************************************************** */
 enum {
   type_config,
@@ -149,6 +158,7 @@ static inline void __cache_reset(config_cache_t *c)
 
 static inline void __cache_reset_idx(int i)
 {
+  TL_END(tl_lane_config + i);
   BIT_CLR(get_mng()->cache.config.used, i);
   __cache_reset(&get_mng()->cache.config.cache[i]);
 }
@@ -210,6 +220,7 @@ static void __acc_reset(bool use_default)
   }
 
   for (int i = 0; i < MAX_CONCURRENT_CONFIG_NODES; i++) {
+    TL_END(tl_lane_config + i);
     __cache_reset(&mng->cache.config.cache[i]);
   }
   mng->cache.config.used = 0;
@@ -243,6 +254,8 @@ void acc_init(bool use_default)
     return;
   }
   __acc_reset(use_default);
+  dcd_cache_init(DCD_CACHE_FILE_PATH);
+  trace_set_strtab(state_names, ARR_LEN(state_names));
   acc.started = true;
 }
 
@@ -256,13 +269,17 @@ static inline void __cache_item_load(mng_t *mng,
   if (type == type_config) {
     cache->state = provisioned_em;
     cache->next_state = get_dcd_em;
+    cache->redo = cfg_digest_redo(node);
+    cache->cls = acc_sched_class(node, NULL);
   } else if (type == type_rm) {
     cache->state = end_em;
     cache->next_state = rm_em;
   }
-  LOGM("Node[0x%04x]: %s Started\n",
-       node->addr,
-       type == type_config ? "Configuring" : "Removing");
+  if (type == type_config) {
+    TRC(trc_acc_config_start, node->addr);
+  } else {
+    TRC(trc_acc_rm_start, node->addr);
+  }
   BIT_SET(mng->cache.config.used, ofs);
 }
 
@@ -278,7 +295,18 @@ static int __caches_load(mng_t *mng, int type)
   }
 
   while ((ofs = utils_frz(mng->cache.config.used)) < MAX_CONCURRENT_CONFIG_NODES) {
-    GList *item = g_list_first((type == type_config) ? mng->lists.config : mng->lists.rm);
+    GList *item;
+    if (type == type_config) {
+      int used[sched_class_max] = { 0 };
+      for (int i = 0; i < MAX_CONCURRENT_CONFIG_NODES; i++) {
+        if (IS_BIT_SET(mng->cache.config.used, i)) {
+          used[mng->cache.config.cache[i].cls]++;
+        }
+      }
+      item = acc_sched_pick(mng->lists.config, used);
+    } else {
+      item = g_list_first(mng->lists.rm);
+    }
     if (!item) {
       break;
     }
@@ -350,25 +378,26 @@ static bool to_next_state(config_cache_t *cache)
   }
 
   /* If current state exit callback exist, exist first */
-  LOGM("Node[0x%04x]: End   - [%s]\n",
-       cache->node->addr,
-       state_names[cache->state]);
+  TRC(trc_acc_state_end, cache->node->addr, cache->state);
+  if (cache->state_start) {
+    stat_state_lat(cache->state, cache->state_start);
+  }
   if (as && as->exit) {
     as->exit(cache);
   }
 
   while (nas) {
-    LOGV("Node[0x%04x]: Try to Enter %s State\n",
-         cache->node->addr,
-         state_names[nas->state]);
+    TRC(trc_acc_state_try, cache->node->addr, nas->state);
     switch (nas->entry(cache, nas->guard)) {
       case asr_suc:
       case asr_oom:
+      case asr_throttled:
         cache->state = nas->state;
         cache->next_state = nas->state;
-        LOGM("Node[0x%04x]: Start - [%s]\n",
-             cache->node->addr,
-             state_names[nas->state]);
+        cache->state_start = lat_now_us();
+        TRC(trc_acc_state_start, cache->node->addr, nas->state);
+        TL_SLICE(tl_lane_config + cache_slot(cache), state_names[nas->state],
+                 "node", cache->node->addr);
         return true;
       /* Implementation of the callback should make sure that won't return this
        * if not more states to load */
@@ -384,6 +413,30 @@ static bool to_next_state(config_cache_t *cache)
   return false;
 }
 
+static int lane_of(const config_cache_t *cache)
+{
+  return cache->state >= rm_em ? shp_bulk : shp_background;
+}
+
+bool acc_shape(config_cache_t *cache)
+{
+  if (shaper_take(lane_of(cache))) {
+    return true;
+  }
+  THROTTLED_SET(cache);
+  /* Sent first if not from a retry, see deferred_on */
+  cache->deferred = on_throttled_em;
+  return false;
+}
+
+/* The retry held back is done once the lane has a token */
+static inline void deferred_on(config_cache_t *cache, int ret, int reason)
+{
+  if (ret == asr_throttled) {
+    cache->deferred = reason;
+  }
+}
+
 static int config_engine(mng_t *mng)
 {
   int i, busy = 0;
@@ -403,19 +456,29 @@ static int config_engine(mng_t *mng)
     /*
      * Check if any **Exception** (OOM | Guard timer expired) happened in last round
      */
-    if (cache->expired && (time(NULL) > cache->expired) && as->retry) {
+    if (THROTTLED(cache)) {
+      /* The exception the request is held back on waits with it */
+      if (as->retry && shaper_ready(lane_of(cache))) {
+        THROTTLED_CLEAR(cache);
+        as->retry(cache, cache->deferred);
+      }
+    } else if (cache->expired && (time(NULL) > cache->expired) && as->retry) {
+      TL_INSTANT(tl_lane_config + i, "retry on guard timer", "node", cache->node->addr);
       ret = as->retry(cache, on_guard_timer_expired_em);
+      deferred_on(cache, ret, on_guard_timer_expired_em);
       if (mng->state == removing_devices_em) {
         stat_rm_retry();
       } else {
         stat_config_retry();
       }
-      if (ret != asr_suc) {
-        LOGE("Retry on Expired Returns %d\n", ret);
+      if (ret != asr_suc && ret != asr_throttled) {
+        TRC(trc_acc_expired_retry_fail, ret);
       }
     } else if (OOM(cache) && as->retry) {
       ASSERT(!WAIT_RESPONSE(cache));
+      TL_INSTANT(tl_lane_config + i, "retry on oom", "node", cache->node->addr);
       ret = as->retry(cache, on_oom_em);
+      deferred_on(cache, ret, on_oom_em);
       if (mng->state == removing_devices_em) {
         stat_rm_retry();
       } else {
@@ -423,10 +486,10 @@ static int config_engine(mng_t *mng)
       }
       if (ret == asr_oom) {
         LOGE("OOM Once Again, **NEED BACKOFF MECHANISM**\n");
-      } else if (ret != asr_suc) {
-        LOGE("Retry on OOM Returns %d\n", ret);
-      } else {
-        LOGD("Node[0x%04x]: OOM Recovery Once.\n", cache->node->addr);
+      } else if (ret == asr_suc) {
+        TRC(trc_acc_oom_recovery, cache->node->addr);
+      } else if (ret != asr_throttled) {
+        TRC(trc_acc_oom_retry_fail, ret);
       }
     }
 
@@ -457,52 +520,68 @@ static inline bool is_config_device_events(const struct gecko_cmd_packet *e)
           && (evt_id & 0x00ff0000) == 0x00270000);
 }
 
-static config_cache_t *cache_from_cchandle(const struct gecko_cmd_packet *e)
+static config_cache_t *cache_from_cchandle(const struct gecko_cmd_packet *e,
+                                           uint16_t *result)
 {
   int i;
   uint32_t handle;
   lbitmap_t usedmap;
   mng_t *mng = get_mng();
 
+  /* The DCD data event has no result */
+  *result = bg_err_success;
+
   switch (BGLIB_MSG_ID(e->header)) {
     case gecko_evt_mesh_config_client_dcd_data_id:
       handle = e->data.evt_mesh_config_client_dcd_data.handle;
       break;
     case gecko_evt_mesh_config_client_dcd_data_end_id:
       handle = e->data.evt_mesh_config_client_dcd_data_end.handle;
+      *result = e->data.evt_mesh_config_client_dcd_data_end.result;
       break;
     case gecko_evt_mesh_config_client_appkey_status_id:
       handle = e->data.evt_mesh_config_client_appkey_status.handle;
+      *result = e->data.evt_mesh_config_client_appkey_status.result;
       break;
     case gecko_evt_mesh_config_client_binding_status_id:
       handle = e->data.evt_mesh_config_client_binding_status.handle;
+      *result = e->data.evt_mesh_config_client_binding_status.result;
       break;
     case gecko_evt_mesh_config_client_model_pub_status_id:
       handle = e->data.evt_mesh_config_client_model_pub_status.handle;
+      *result = e->data.evt_mesh_config_client_model_pub_status.result;
       break;
     case gecko_evt_mesh_config_client_model_sub_status_id:
       handle = e->data.evt_mesh_config_client_model_sub_status.handle;
+      *result = e->data.evt_mesh_config_client_model_sub_status.result;
       break;
     case gecko_evt_mesh_config_client_relay_status_id:
       handle = e->data.evt_mesh_config_client_relay_status.handle;
+      *result = e->data.evt_mesh_config_client_relay_status.result;
       break;
     case gecko_evt_mesh_config_client_friend_status_id:
       handle = e->data.evt_mesh_config_client_friend_status.handle;
+      *result = e->data.evt_mesh_config_client_friend_status.result;
       break;
     case gecko_evt_mesh_config_client_gatt_proxy_status_id:
       handle = e->data.evt_mesh_config_client_gatt_proxy_status.handle;
+      *result = e->data.evt_mesh_config_client_gatt_proxy_status.result;
       break;
     case gecko_evt_mesh_config_client_default_ttl_status_id:
       handle = e->data.evt_mesh_config_client_default_ttl_status.handle;
+      *result = e->data.evt_mesh_config_client_default_ttl_status.result;
       break;
     case gecko_evt_mesh_config_client_network_transmit_status_id:
       handle = e->data.evt_mesh_config_client_network_transmit_status.handle;
+      *result = e->data.evt_mesh_config_client_network_transmit_status.result;
       break;
     case gecko_evt_mesh_config_client_reset_status_id:
       handle = e->data.evt_mesh_config_client_reset_status.handle;
+      *result = e->data.evt_mesh_config_client_reset_status.result;
       break;
     case gecko_evt_mesh_config_client_beacon_status_id:
       handle = e->data.evt_mesh_config_client_beacon_status.handle;
+      *result = e->data.evt_mesh_config_client_beacon_status.result;
       break;
 
     default:
@@ -522,6 +601,12 @@ static config_cache_t *cache_from_cchandle(const struct gecko_cmd_packet *e)
     }
   }
 
+  if (ncp_target_attached()) {
+    /* Answer to a request sent before the host restarted */
+    LOGW("Event[0x%08x] of Handle[0x%08x] Not Requested by This Run\n",
+         BGLIB_MSG_ID(e->header), handle);
+    return NULL;
+  }
   LOGA("No Cache Found by handle\n");
   return NULL;
 }
@@ -529,6 +614,7 @@ static config_cache_t *cache_from_cchandle(const struct gecko_cmd_packet *e)
 int dev_config_hdr(const struct gecko_cmd_packet *e)
 {
   int ret = 0;
+  uint16_t result;
   ASSERT(e);
   config_cache_t *cache;
   acc_state_t *state;
@@ -537,17 +623,25 @@ int dev_config_hdr(const struct gecko_cmd_packet *e)
     return 0;
   }
 
-  cache = cache_from_cchandle(e);
+  if (NULL == (cache = cache_from_cchandle(e, &result))) {
+    return 1;
+  }
   state = as_get(cache->state);
   ASSERT(state);
 
+  if (WAIT_RESPONSE(cache)) {
+    acc_rto_on_status(cache, result);
+  }
   if (WAIT_RESPONSE(cache) && state->inpg) {
     ret = state->inpg(e, cache);
   }
 
   /* Drived by timeout event */
   if (!ret && !WAIT_RESPONSE(cache) && EVER_RETRIED(cache) && state->retry) {
+    TL_INSTANT(tl_lane_config + cache_slot(cache), "retry on timeout", "node",
+               cache->node->addr);
     ret |= state->retry(cache, on_timeout_em);
+    deferred_on(cache, ret, on_timeout_em);
     if (get_mng()->state == removing_devices_em) {
       stat_rm_retry();
     } else {
@@ -561,19 +655,10 @@ int dev_config_hdr(const struct gecko_cmd_packet *e)
 
 void timer_set(config_cache_t *cache, bool enable)
 {
-  mng_t *mng = get_mng();
   if (!enable) {
     cache->expired = 0;
     return;
   }
-  cache->expired = time(NULL) + CONFIG_NO_RSP_TIMEOUT;
-  if (!cache->dcd.elems || cache->dcd.feature & LPN_BITOFS) {
-    /* Not able to figure out if the node is a LPN or normal node, always add
-     * longest possible value to it, this also applies if the node is LPN */
-    cache->expired += mng->cfg->timeout
-                      ? (get_mng()->cfg->timeout->lpn + 999) / 1000 : 120;
-  } else {
-    cache->expired += mng->cfg->timeout
-                      ? (get_mng()->cfg->timeout->normal + 999) / 1000 : 5;
-  }
+  /* The NCP target raises the event after the timeout it's set to */
+  cache->expired = time(NULL) + acc_rto_guard(cache);
 }
@@ -0,0 +1,569 @@
+/*************************************************************************
+    > File Name: metrics.c
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Metrics endpoint in the Prometheus text format
+ ************************************************************************/
+
+/* Includes *********************************************************** */
+#define LOG_MODULE log_mod_mng
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include <glib.h>
+
+#include "metrics.h"
+#include "stat.h"
+#include "acc_plan.h"
+#include "acc_rto.h"
+#include "shaper.h"
+#include "logging.h"
+#include "utils.h"
+#include "gecko_bglib.h"
+#include "hal/bgapi_stat.h"
+
+/* Defines  *********************************************************** */
+#define METRICS_BGAPI_MAX 64
+#define METRICS_BACKLOG   4
+#define METRICS_BUF_INIT  8192
+
+#define HTTP_HEADER                                 \
+  "HTTP/1.0 200 OK\r\n"                             \
+  "Content-Type: text/plain; version=0.0.4\r\n"     \
+  "Connection: close\r\n"                           \
+  "\r\n"
+
+enum {
+  ml_add,
+  ml_config,
+  ml_rm,
+  ml_bl,
+  ml_fail,
+  ml_max
+};
+
+typedef struct {
+  uint32_t cnt;
+  /* In seconds */
+  double sum;
+  double p50;
+  double p90;
+  double p99;
+}summary_t;
+
+/* Everything the endpoint serves, aggregated by the main loop */
+typedef struct {
+  int state;
+  int free_mode;
+  unsigned lists[ml_max];
+  unsigned slots_used;
+  unsigned prov_used;
+  unsigned model_set_pending;
+  unsigned config_ops;
+  int plans;
+  struct {
+    int32_t srtt;
+    uint32_t rto;
+  }rto[rto_lane_max];
+  unsigned shaper_tokens;
+  shaper_stat_t shaper;
+  struct __total total;
+  summary_t prov;
+  summary_t rm;
+  summary_t config[config_lat_max];
+  summary_t model_set[model_set_lat_max];
+  int ncmds;
+  struct {
+    const char *name;
+    uint32_t calls;
+    uint32_t errs;
+    uint64_t tx_bytes;
+    uint64_t rx_bytes;
+    summary_t rtt;
+  }cmds[METRICS_BGAPI_MAX];
+  int nevts;
+  struct {
+    const char *name;
+    uint32_t recv;
+    uint32_t dropped;
+    uint32_t unhandled;
+  }evts[METRICS_BGAPI_MAX];
+  int evt_queue_len;
+  int evt_queue_hwm;
+}snapshot_t;
+
+typedef struct {
+  char *p;
+  size_t len;
+  size_t cap;
+}buf_t;
+
+/* Global Variables *************************************************** */
+
+/* Static Variables *************************************************** */
+static const char *state_labels[] = {
+  "nil",
+  "initialized",
+  "configured",
+  "starting",
+  "adding_devices",
+  "configuring_devices",
+  "removing_devices",
+  "blacklisting_devices",
+  "stopping",
+  "state_reload"
+};
+
+static const char *list_labels[ml_max] = {
+  "add", "config", "rm", "bl", "fail"
+};
+
+static const char *config_labels[config_lat_max] = {
+  "get_dcd", "add_appkey", "bind_appkey", "set_pub", "add_sub", "set_config"
+};
+
+static const char *model_set_labels[model_set_lat_max] = {
+  "onoff", "lightness", "ctl"
+};
+
+static const char *shaper_labels[shp_lane_max] = {
+  "interactive", "background", "bulk"
+};
+
+static struct {
+  bool started;
+  int fd;
+  pthread_t tid;
+  pthread_mutex_t lock;
+  /* Written by the main loop, copied out by the server under the lock */
+  snapshot_t shared;
+  /* Only used by the main loop */
+  snapshot_t work;
+  uint64_t last_us;
+} metrics = {
+  .fd = -1,
+  .lock = PTHREAD_MUTEX_INITIALIZER
+};
+
+/* Static Functions Declaractions ************************************* */
+static void summarize(summary_t *s, const lat_hist_t *h)
+{
+  s->cnt = h->cnt;
+  s->sum = h->sum / 1e6;
+  s->p50 = lat_hist_percentile(h, 50) / 1e6;
+  s->p90 = lat_hist_percentile(h, 90) / 1e6;
+  s->p99 = lat_hist_percentile(h, 99) / 1e6;
+}
+
+void metrics_publish(const mng_t *mng)
+{
+  snapshot_t *w = &metrics.work;
+  const stat_t *s = get_stat();
+  const bgapi_cmd_stat_t *cmds[BGAPI_STAT_CMD_SLOTS];
+  const bgapi_evt_stat_t *evts[BGAPI_STAT_EVT_SLOTS];
+  uint64_t now;
+  int n;
+
+  if (!metrics.started) {
+    return;
+  }
+  now = lat_now_us();
+  if (now - metrics.last_us < METRICS_PUBLISH_MS * 1000ULL) {
+    return;
+  }
+  metrics.last_us = now;
+
+  w->state = mng->state;
+  w->free_mode = mng->status.free_mode;
+  w->lists[ml_add] = g_list_length(mng->lists.add);
+  w->lists[ml_config] = g_list_length(mng->lists.config);
+  w->lists[ml_rm] = g_list_length(mng->lists.rm);
+  w->lists[ml_bl] = g_list_length(mng->lists.bl);
+  w->lists[ml_fail] = g_list_length(mng->lists.fail);
+  w->slots_used = utils_popcount(mng->cache.config.used);
+  w->prov_used = 0;
+  for (int i = 0; i < MAX_PROV_SESSIONS; i++) {
+    w->prov_used += mng->cache.add[i].busy;
+  }
+  w->model_set_pending = g_list_length(mng->cache.model_set.nodes);
+  w->config_ops = 0;
+  for (int i = 0; i < MAX_CONCURRENT_CONFIG_NODES; i++) {
+    if (IS_BIT_SET(mng->cache.config.used, i)
+        && (n = acc_plan_remaining(&mng->cache.config.cache[i])) > 0) {
+      w->config_ops += n;
+    }
+  }
+  w->plans = acc_plan_num();
+  for (int i = 0; i < rto_lane_max; i++) {
+    const rtt_est_t *e = acc_rto_lane(i);
+    w->rto[i].srtt = e ? e->srtt : 0;
+    w->rto[i].rto = e ? acc_rto_of(e) : 0;
+  }
+  w->shaper_tokens = shaper_tokens();
+  memcpy(&w->shaper, shaper_stat(), sizeof(shaper_stat_t));
+
+  w->total = s->total;
+  summarize(&w->prov, &s->add.prov_lat);
+  summarize(&w->rm, &s->rm.rm_lat);
+  for (int i = 0; i < config_lat_max; i++) {
+    summarize(&w->config[i], &s->config.state_lat[i]);
+  }
+  for (int i = 0; i < model_set_lat_max; i++) {
+    summarize(&w->model_set[i], &s->model_set.lat[i]);
+  }
+
+  n = bgapi_stat_cmds(cmds);
+  w->ncmds = n > METRICS_BGAPI_MAX ? METRICS_BGAPI_MAX : n;
+  for (int i = 0; i < w->ncmds; i++) {
+    w->cmds[i].name = cmds[i]->name;
+    w->cmds[i].calls = cmds[i]->calls;
+    w->cmds[i].errs = cmds[i]->errs;
+    w->cmds[i].tx_bytes = cmds[i]->tx_bytes;
+    w->cmds[i].rx_bytes = cmds[i]->rx_bytes;
+    summarize(&w->cmds[i].rtt, &cmds[i]->rtt);
+  }
+  n = bgapi_stat_evts(evts);
+  w->nevts = n > METRICS_BGAPI_MAX ? METRICS_BGAPI_MAX : n;
+  for (int i = 0; i < w->nevts; i++) {
+    w->evts[i].name = evts[i]->name;
+    w->evts[i].recv = evts[i]->recv;
+    w->evts[i].dropped = evts[i]->dropped;
+    w->evts[i].unhandled = evts[i]->unhandled;
+  }
+  w->evt_queue_len = (gecko_queue_w + BGLIB_QUEUE_LEN - gecko_queue_r) % BGLIB_QUEUE_LEN;
+  w->evt_queue_hwm = bgapi_stat_evt_queue_hwm();
+
+  /* Only a copy is done under the lock, the rendering is in the server */
+  pthread_mutex_lock(&metrics.lock);
+  memcpy(&metrics.shared, w, sizeof(snapshot_t));
+  pthread_mutex_unlock(&metrics.lock);
+}
+
+static void bprintf(buf_t *b, const char *fmt, ...)
+{
+  va_list ap;
+  int n;
+  char *p;
+
+  while (1) {
+    va_start(ap, fmt);
+    n = vsnprintf(b->p + b->len, b->cap - b->len, fmt, ap);
+    va_end(ap);
+    if (n < 0) {
+      return;
+    }
+    if (b->len + n < b->cap) {
+      b->len += n;
+      return;
+    }
+    p = realloc(b->p, b->cap * 2);
+    if (!p) {
+      return;
+    }
+    b->p = p;
+    b->cap *= 2;
+  }
+}
+
+static void meta(buf_t *b, const char *name, const char *type, const char *help)
+{
+  bprintf(b, "# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+}
+
+static void summary(buf_t *b,
+                    const char *name,
+                    const char *label,
+                    const char *value,
+                    const summary_t *s)
+{
+  if (!s->cnt) {
+    return;
+  }
+  bprintf(b, "%s{%s=\"%s\",quantile=\"0.5\"} %g\n", name, label, value, s->p50);
+  bprintf(b, "%s{%s=\"%s\",quantile=\"0.9\"} %g\n", name, label, value, s->p90);
+  bprintf(b, "%s{%s=\"%s\",quantile=\"0.99\"} %g\n", name, label, value, s->p99);
+  bprintf(b, "%s_sum{%s=\"%s\"} %g\n", name, label, value, s->sum);
+  bprintf(b, "%s_count{%s=\"%s\"} %u\n", name, label, value, s->cnt);
+}
+
+static void render(buf_t *b, const snapshot_t *s)
+{
+  meta(b, "nwmng_state", "gauge", "State of the manager");
+  bprintf(b, "nwmng_state{state=\"%s\"} 1\n", state_labels[s->state]);
+  meta(b, "nwmng_free_mode", "gauge", "Free mode, 0 idle, 1 scanning, 2 on");
+  bprintf(b, "nwmng_free_mode %d\n", s->free_mode);
+
+  meta(b, "nwmng_list_length", "gauge", "Nodes waiting in each list");
+  for (int i = 0; i < ml_max; i++) {
+    bprintf(b, "nwmng_list_length{list=\"%s\"} %u\n", list_labels[i], s->lists[i]);
+  }
+  meta(b, "nwmng_config_slots_used", "gauge", "Config/rm slots in use");
+  bprintf(b, "nwmng_config_slots_used %u\n", s->slots_used);
+  meta(b, "nwmng_config_slots", "gauge", "Config/rm slots");
+  bprintf(b, "nwmng_config_slots %d\n", MAX_CONCURRENT_CONFIG_NODES);
+  meta(b, "nwmng_prov_sessions_used", "gauge", "Provisioning sessions in use");
+  bprintf(b, "nwmng_prov_sessions_used %u\n", s->prov_used);
+  meta(b, "nwmng_prov_sessions", "gauge", "Provisioning sessions");
+  bprintf(b, "nwmng_prov_sessions %d\n", MAX_PROV_SESSIONS);
+  meta(b, "nwmng_model_set_pending", "gauge", "Nodes waiting for a model set");
+  bprintf(b, "nwmng_model_set_pending %u\n", s->model_set_pending);
+  meta(b, "nwmng_config_ops_remaining", "gauge",
+       "Config messages the nodes in the slots still need to send");
+  bprintf(b, "nwmng_config_ops_remaining %u\n", s->config_ops);
+  meta(b, "nwmng_config_plans", "gauge", "Configuration plans compiled");
+  bprintf(b, "nwmng_config_plans %d\n", s->plans);
+  meta(b, "nwmng_config_srtt_ms", "gauge",
+       "Smoothed response time of the config client, 0 if none seen");
+  for (int i = 0; i < rto_lane_max; i++) {
+    bprintf(b, "nwmng_config_srtt_ms{lane=\"%s\"} %d\n",
+            i == rto_lpn ? "lpn" : "normal", s->rto[i].srtt);
+  }
+  meta(b, "nwmng_config_rto_ms", "gauge",
+       "Config client timeout estimated, 0 if none seen");
+  for (int i = 0; i < rto_lane_max; i++) {
+    bprintf(b, "nwmng_config_rto_ms{lane=\"%s\"} %u\n",
+            i == rto_lpn ? "lpn" : "normal", s->rto[i].rto);
+  }
+  meta(b, "nwmng_shaper_tokens", "gauge", "Messages the shaper allows at once");
+  bprintf(b, "nwmng_shaper_tokens %u\n", s->shaper_tokens);
+  meta(b, "nwmng_shaper_rate", "gauge", "Messages per second the shaper allows, 0 if off");
+  bprintf(b, "nwmng_shaper_rate %u\n", s->shaper.rate);
+  meta(b, "nwmng_shaper_sent_total", "counter", "Messages sent through the shaper");
+  for (int i = 0; i < shp_lane_max; i++) {
+    bprintf(b, "nwmng_shaper_sent_total{lane=\"%s\"} %u\n",
+            shaper_labels[i], s->shaper.lanes[i].sent);
+  }
+  meta(b, "nwmng_shaper_deferred_total", "counter",
+       "Times a lane of the shaper waited for a token");
+  for (int i = 0; i < shp_lane_max; i++) {
+    bprintf(b, "nwmng_shaper_deferred_total{lane=\"%s\"} %u\n",
+            shaper_labels[i], s->shaper.lanes[i].deferred);
+  }
+
+  meta(b, "nwmng_oom_total", "counter", "Out of memory returned by the NCP target");
+  bprintf(b, "nwmng_oom_total{source=\"prov\"} %lu\n", s->total.oom[oom_prov]);
+  bprintf(b, "nwmng_oom_total{source=\"config\"} %lu\n", s->total.oom[oom_config]);
+  meta(b, "nwmng_retries_total", "counter", "Retries of the config engine");
+  bprintf(b, "nwmng_retries_total{op=\"config\"} %lu\n", s->total.config_retries);
+  bprintf(b, "nwmng_retries_total{op=\"rm\"} %lu\n", s->total.rm_retries);
+  meta(b, "nwmng_prov_failures_total", "counter", "Failed provisioning");
+  bprintf(b, "nwmng_prov_failures_total %lu\n", s->total.prov_failures);
+
+  meta(b, "nwmng_prov_latency_seconds", "summary",
+       "From the unprovisioned beacon to provisioned, since the last sync");
+  summary(b, "nwmng_prov_latency_seconds", "op", "prov", &s->prov);
+  meta(b, "nwmng_state_latency_seconds", "summary",
+       "Time a node spends in a config state, since the last sync");
+  for (int i = 0; i < config_lat_max; i++) {
+    summary(b, "nwmng_state_latency_seconds", "state", config_labels[i], &s->config[i]);
+  }
+  summary(b, "nwmng_state_latency_seconds", "state", "rm", &s->rm);
+  meta(b, "nwmng_model_set_latency_seconds", "summary",
+       "From the set command to the message sent, since the last sync");
+  for (int i = 0; i < model_set_lat_max; i++) {
+    summary(b, "nwmng_model_set_latency_seconds", "type", model_set_labels[i],
+            &s->model_set[i]);
+  }
+
+  meta(b, "nwmng_bgapi_rtt_seconds", "summary", "Round-trip time of BGAPI commands");
+  for (int i = 0; i < s->ncmds; i++) {
+    summary(b, "nwmng_bgapi_rtt_seconds", "cmd", s->cmds[i].name, &s->cmds[i].rtt);
+  }
+  meta(b, "nwmng_bgapi_calls_total", "counter", "BGAPI commands sent");
+  for (int i = 0; i < s->ncmds; i++) {
+    bprintf(b, "nwmng_bgapi_calls_total{cmd=\"%s\"} %u\n", s->cmds[i].name, s->cmds[i].calls);
+  }
+  meta(b, "nwmng_bgapi_errors_total", "counter", "BGAPI responses with a non-zero result");
+  for (int i = 0; i < s->ncmds; i++) {
+    bprintf(b, "nwmng_bgapi_errors_total{cmd=\"%s\"} %u\n", s->cmds[i].name, s->cmds[i].errs);
+  }
+  meta(b, "nwmng_bgapi_tx_bytes_total", "counter", "Bytes of BGAPI commands");
+  for (int i = 0; i < s->ncmds; i++) {
+    bprintf(b, "nwmng_bgapi_tx_bytes_total{cmd=\"%s\"} %llu\n", s->cmds[i].name,
+            (unsigned long long)s->cmds[i].tx_bytes);
+  }
+  meta(b, "nwmng_bgapi_rx_bytes_total", "counter", "Bytes of BGAPI responses");
+  for (int i = 0; i < s->ncmds; i++) {
+    bprintf(b, "nwmng_bgapi_rx_bytes_total{cmd=\"%s\"} %llu\n", s->cmds[i].name,
+            (unsigned long long)s->cmds[i].rx_bytes);
+  }
+  meta(b, "nwmng_bgapi_events_total", "counter", "BGAPI events received");
+  for (int i = 0; i < s->nevts; i++) {
+    bprintf(b, "nwmng_bgapi_events_total{evt=\"%s\"} %u\n", s->evts[i].name, s->evts[i].recv);
+  }
+  meta(b, "nwmng_bgapi_events_dropped_total", "counter",
+       "BGAPI events dropped since the event queue is full");
+  for (int i = 0; i < s->nevts; i++) {
+    bprintf(b, "nwmng_bgapi_events_dropped_total{evt=\"%s\"} %u\n", s->evts[i].name,
+            s->evts[i].dropped);
+  }
+  meta(b, "nwmng_bgapi_events_unhandled_total", "counter", "BGAPI events not handled");
+  for (int i = 0; i < s->nevts; i++) {
+    bprintf(b, "nwmng_bgapi_events_unhandled_total{evt=\"%s\"} %u\n", s->evts[i].name,
+            s->evts[i].unhandled);
+  }
+  meta(b, "nwmng_bgapi_event_queue_length", "gauge", "Events in the queue of bglib");
+  bprintf(b, "nwmng_bgapi_event_queue_length %d\n", s->evt_queue_len);
+  meta(b, "nwmng_bgapi_event_queue_hwm", "gauge",
+       "High-water mark of the event queue of bglib");
+  bprintf(b, "nwmng_bgapi_event_queue_hwm %d\n", s->evt_queue_hwm);
+}
+
+static void serve(int fd, buf_t *b, snapshot_t *s)
+{
+  char req[512];
+  struct timeval tv = { 1, 0 };
+  ssize_t n, off;
+
+  /* The request is not parsed, any request gets the metrics */
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+  if (read(fd, req, sizeof(req)) < 0) {
+    return;
+  }
+
+  pthread_mutex_lock(&metrics.lock);
+  memcpy(s, &metrics.shared, sizeof(snapshot_t));
+  pthread_mutex_unlock(&metrics.lock);
+
+  b->len = 0;
+  bprintf(b, "%s", HTTP_HEADER);
+  render(b, s);
+  for (off = 0; off < b->len; off += n) {
+    n = write(fd, b->p + off, b->len - off);
+    if (n <= 0) {
+      return;
+    }
+  }
+}
+
+static void *metrics_server(void *p)
+{
+  int fd;
+  buf_t b;
+  snapshot_t *s;
+
+  b.cap = METRICS_BUF_INIT;
+  b.len = 0;
+  b.p = malloc(b.cap);
+  s = malloc(sizeof(snapshot_t));
+  if (!b.p || !s) {
+    LOGE("Metrics server out of memory\n");
+    free(b.p);
+    free(s);
+    return NULL;
+  }
+
+  while (1) {
+    fd = accept(metrics.fd, NULL, NULL);
+    if (fd < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      LOGE("Metrics accept error[%d:%s]\n", errno, strerror(errno));
+      break;
+    }
+    serve(fd, &b, s);
+    close(fd);
+  }
+  free(b.p);
+  free(s);
+  return NULL;
+}
+
+static int listen_tcp(uint16_t port)
+{
+  int fd, on = 1;
+  struct sockaddr_in addr;
+
+  fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) {
+    return -1;
+  }
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+static int listen_unix(const char *path)
+{
+  int fd;
+  struct sockaddr_un addr;
+
+  if (strlen(path) >= sizeof(addr.sun_path)) {
+    return -1;
+  }
+  fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {
+    return -1;
+  }
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, path);
+  unlink(path);
+  if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+err_t metrics_start(const char *endpoint)
+{
+  int ret;
+  char *end;
+  long port;
+
+  if (!endpoint || !endpoint[0]) {
+    return err(ec_param_null);
+  }
+  if (metrics.started) {
+    return ec_success;
+  }
+
+  port = strtol(endpoint, &end, 10);
+  if (*end == '\0') {
+    if (port <= 0 || port > 0xffff) {
+      return err(ec_param_invalid);
+    }
+    metrics.fd = listen_tcp(port);
+  } else {
+    metrics.fd = listen_unix(endpoint);
+  }
+  if (metrics.fd < 0 || listen(metrics.fd, METRICS_BACKLOG) < 0) {
+    LOGE("Metrics endpoint [%s] error[%d:%s]\n", endpoint, errno, strerror(errno));
+    if (metrics.fd >= 0) {
+      close(metrics.fd);
+      metrics.fd = -1;
+    }
+    return err(ec_file_ope);
+  }
+
+  if (0 != (ret = pthread_create(&metrics.tid, NULL, metrics_server, NULL))) {
+    LOGE("Create metrics server error[%d]\n", ret);
+    close(metrics.fd);
+    metrics.fd = -1;
+    return err(ec_file_ope);
+  }
+  pthread_detach(metrics.tid);
+  metrics.started = true;
+  LOGM("Metrics served on [%s]\n", endpoint);
+  return ec_success;
+}
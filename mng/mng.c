@@ -6,6 +6,7 @@
  ************************************************************************/
 
 /* Includes *********************************************************** */
+#define LOG_MODULE log_mod_mng
 #include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -13,10 +14,14 @@
 /* #include <sys/prctl.h> */
 
 #include "hal/bg_uart_cbs.h"
+#include "hal/bgapi_stat.h"
+#include "hal/bgapi_cap.h"
 #include "host_gecko.h"
 
 #include "projconfig.h"
 #include "logging.h"
+#include "trace.h"
+#include "timeline.h"
 #include "utils.h"
 #include "generic_parser.h"
 #include "gecko_bglib.h"
@@ -31,6 +36,13 @@
 #include "gecko_bglib.h"
 #include "dev_config.h"
 #include "stat.h"
+#include "metrics.h"
+#include "dcd_cache.h"
+#include "cfg_digest.h"
+#include "shaper.h"
+#include "ddb_cache.h"
+#include "cmd_ring.h"
+#include "rpc.h"
 /* Defines  *********************************************************** */
 /*
  * Default priority for taking actions: Adding > Removing > Blacklisting
@@ -42,88 +54,25 @@
 #define BL_BITMASK  0x01
 #define RM_BITMASK  0x10
 
-typedef struct qitem{
-  int offs;
-  wordexp_t *cmd;
-  struct qitem *next;
-}qitem_t;
-
-typedef struct {
-  qitem_t *head;
-  qitem_t *tail;
-}cmdq_t;
-
 typedef struct {
   char state;
   bool (*loader)(void);
 }seq_loader_t;
 
 /* Global Variables *************************************************** */
-extern const command_t commands[];
-extern pthread_mutex_t qlock;
 err_t cmd_ret = ec_success;
-cmdq_t cmdq = { 0 };
 
 /* Static Variables *************************************************** */
 static mng_t mng = {
   .conn = 0xff
 };
+/* Set by another thread to end the main loop */
+static bool stop_req = false;
 
 /* Static Functions Declaractions ************************************* */
 static err_t clm_set_scan(int status);
 static void poll_cmd(void);
 static gboolean load_lists(gpointer key, gpointer value, gpointer data);
-/******************************************************************
- * Command queue
- * ***************************************************************/
-void cmd_enq(const char *str, int offs)
-{
-  wordexp_t *w = NULL;
-  if (!str) {
-    return;
-  }
-  w = malloc(sizeof(wordexp_t));
-  if (wordexp(str, w, WRDE_NOCMD)) {
-    free(w);
-    return;
-  }
-  qitem_t *qi = malloc(sizeof(qitem_t));
-  qi->cmd = w;
-  qi->offs = offs;
-  qi->next = NULL;
-  PTMTX_LOCK(&qlock);
-  if (cmdq.tail) {
-    cmdq.tail->next = qi;
-    cmdq.tail = qi;
-  } else {
-    cmdq.tail = cmdq.head = qi;
-  }
-  PTMTX_UNLOCK(&qlock);
-}
-
-wordexp_t *cmd_deq(int *offs)
-{
-  wordexp_t *w = NULL;
-  qitem_t *qi;
-
-  PTMTX_LOCK(&qlock);
-  if (!cmdq.head) {
-    goto out;
-  }
-
-  w = cmdq.head->cmd;
-  *offs = cmdq.head->offs;
-  qi = cmdq.head;
-  cmdq.head = cmdq.head->next;
-  if (!cmdq.head) {
-    cmdq.tail = NULL;
-  }
-  free(qi);
-
-  out:
-  PTMTX_UNLOCK(&qlock);
-  return w;
-}
 
 mng_t *get_mng(void)
 {
@@ -132,6 +81,11 @@ mng_t *get_mng(void)
 
 void __ncp_exit(void)
 {
+  if (getprojargs()->warm) {
+    /* Left running for the next start to attach to */
+    LOGM("MNG Exit, NCP Target Kept Running\n");
+    return;
+  }
   gecko_cmd_system_reset(0);
   LOGM("MNG Exit\n");
 }
@@ -155,12 +109,14 @@ err_t clr_all(void *p)
     LOGBGE("Erase all", ret);
     return err(ec_bgrsp);
   }
-  usleep(300 * 1000);
+  ddb_cache_invalidate();
+  /* The erase is done once responded, init_ncp then waits for the boot */
   return ec_success;
 }
 
 err_t init_ncp(void *p)
 {
+  static bool warm_tried = false;
   const proj_args_t *pg = getprojargs();
   if (!pg->initialized) {
     return err(ec_state);
@@ -168,7 +124,11 @@ err_t init_ncp(void *p)
 
   bguart_init();
   conn_ncptarget();
-  sync_host_and_ncp_target();
+  /* Only the start attaches, the NCP target is reset on the later inits */
+  if (!pg->warm || warm_tried || !attach_ncp_target()) {
+    sync_host_and_ncp_target();
+  }
+  warm_tried = true;
   atexit(__ncp_exit);
   /* LOGD("ncp init done\n"); */
   return ec_success;
@@ -258,13 +218,14 @@ static void set_mng_state(void)
     LOGM("Sync[%s] Done\n", mng.status.seq.prios);
     bt_shell_printf("Sync[%s] Done\n", mng.status.seq.prios);
     cli_print_stat(get_stat());
+    rpc_notify_sync_done();
   }
 }
 
 void *mng_mainloop(void *p)
 {
   bool busy;
-  while (1) {
+  while (!__atomic_load_n(&stop_req, __ATOMIC_ACQUIRE)) {
     busy = false;
     poll_cmd();
     bgevt_dispenser();
@@ -293,25 +254,37 @@ void *mng_mainloop(void *p)
     set_mng_state();
     busy |= models_loop(&mng);
     demo_run();
+    metrics_publish(&mng);
     if (!busy) {
-      usleep(10 * 1000);
+      cmd_ring_wait(10);
     }
   }
   return NULL;
 }
 
+void mng_stop(void)
+{
+  __atomic_store_n(&stop_req, true, __ATOMIC_RELEASE);
+}
+
 static void poll_cmd(void)
 {
-  int i;
-  wordexp_t *w = cmd_deq(&i);
-  if (w) {
-    /* DUMP_PARAMS(w->we_wordc, w->we_wordv); */
-    if (ec_param_invalid == errof(commands[i].fn(w->we_wordc, w->we_wordv))) {
+  err_t e;
+  cmd_t c;
+
+  /* All queued, bounded so that a flood can't starve the events */
+  for (int n = 0; n < CMD_RING_SIZE && cmd_deq(&c); n++) {
+    /* DUMP_PARAMS(c.w.we_wordc, c.w.we_wordv); */
+    e = c.cmd->fn(c.w.we_wordc, c.w.we_wordv);
+    if (ec_param_invalid == errof(e) && c.src == cmd_src_cli) {
       printf(COLOR_HIGHLIGHT "Invalid Parameter(s)\nUsage: " COLOR_OFF);
-      print_cmd_usage(&commands[i]);
+      print_cmd_usage(c.cmd);
     }
-    wordfree(w);
-    free(w);
+    if (c.src == cmd_src_rpc) {
+      rpc_on_done(&c, e);
+    }
+    wordfree(&c.w);
+    cmd_done(&c, e);
   }
 }
 
@@ -355,7 +328,7 @@ err_t mng_init(void *p)
   memcpy(mng.status.seq.prios, DEFAULT_SEQ_PRIO, 3);
   mng.cfg = get_provcfg();
   acc_init(true);
-  return ec_success;
+  return cmd_ring_init();
 }
 
 void mng_load_lists(void)
@@ -363,6 +336,8 @@ void mng_load_lists(void)
   if (mng.state < configured) {
     return;
   }
+  /* One list query instead of a DDB get per node */
+  elog(ddb_cache_sync());
   __lists_clr();
   cfg_load_mnglists(load_lists);
   LOGM("[%d-%d-%d-%d] loaded to be [added-configured-removed-blacklisted]\n",
@@ -374,34 +349,9 @@ void mng_load_lists(void)
 
 void list_nodes(void)
 {
-  struct gecko_msg_mesh_prov_ddb_list_devices_rsp_t *rsp;
-  uint16_t cnt;
-
-  rsp = gecko_cmd_mesh_prov_ddb_list_devices();
-
-  if (rsp->result != bg_err_success) {
-    LOGBGE("ddb list devices", rsp->result);
-    return;
-  }
-
-  cnt = rsp->count;
-
-  LOGM("%d Nodes in NCP Target DDB\n", cnt);
-  while (cnt) {
-    if (getprojargs()->enc) {
-      poll_update(50);
-    }
-    struct gecko_cmd_packet *evt = gecko_peek_event();
-    if (NULL == evt
-        || BGLIB_MSG_ID(evt->header) != gecko_evt_mesh_prov_ddb_list_id) {
-      usleep(500);
-      continue;
-    }
-    LOGD("dev - [%x:%x:%x]\n",
-         evt->data.evt_mesh_prov_ddb_list.uuid.data[12],
-         evt->data.evt_mesh_prov_ddb_list.uuid.data[11],
-         evt->data.evt_mesh_prov_ddb_list.uuid.data[10]);
-    cnt--;
+  ddb_cache_invalidate();
+  if (ec_success == ddb_cache_sync()) {
+    ddb_cache_dump();
   }
 }
 
@@ -414,8 +364,18 @@ err_t clicb_list(int argc, char *argv[])
 static gboolean load_lists(gpointer key, gpointer value, gpointer data)
 {
   node_t *n = (node_t *)value;
-  uint16_t ret = gecko_cmd_mesh_prov_ddb_get(16, n->uuid)->result;
-  int in = (ret == bg_err_success);
+  uint8_t redo;
+  char buf[32];
+  uint16_t ret = bg_err_success;
+  int in;
+
+  if (ddb_cache_valid()) {
+    in = ddb_cache_has(n->uuid);
+  } else {
+    /* Not listed, look up the node itself */
+    ret = gecko_cmd_mesh_prov_ddb_get(16, n->uuid)->result;
+    in = (ret == bg_err_success);
+  }
 
   if (mng.state < initialized) {
     ASSERT_MSG(0, "Load list before ncp target is initialized\n");
@@ -424,6 +384,7 @@ static gboolean load_lists(gpointer key, gpointer value, gpointer data)
   if (!n->addr) {
     if (in) {
       gecko_cmd_mesh_prov_ddb_delete(*(uuid_128 *)n->uuid);
+      ddb_cache_del(n->uuid);
     }
     if (!n->rmorbl) {
       mng.lists.add = g_list_append(mng.lists.add, n);
@@ -433,8 +394,8 @@ static gboolean load_lists(gpointer key, gpointer value, gpointer data)
     /* Priority: Blacklist > remove > config */
     if (!in) {
       LOGE("CFG and DDB in NCP are Out Of Sync - **Factory Reset Required?**\n");
-      LOGE("gecko_cmd_mesh_prov_ddb_get returns %x, Node Dump:\n", ret);
-      list_nodes();
+      LOGE("Node[0x%04x] Not in DDB (0x%04x), Node Dump:\n", n->addr, ret);
+      ddb_cache_dump();
       return TRUE;
     }
     if (n->rmorbl & BL_BITMASK) {
@@ -445,7 +406,12 @@ static gboolean load_lists(gpointer key, gpointer value, gpointer data)
       } else {
         mng.lists.rm = g_list_append(mng.lists.rm, n);
       }
-    } else if (!n->done) {
+    } else if (0 != (redo = cfg_digest_redo(n))) {
+      if (n->done) {
+        LOGM("Node[0x%04x]: Config Changed <<%s>>\n",
+             n->addr,
+             cfg_digest_str(redo, buf));
+      }
       mng.lists.config = g_list_append(mng.lists.config, n);
     }
   }
@@ -540,22 +506,31 @@ err_t clicb_rmblclr(int argc, char *argv[])
   return e;
 }
 
+static int lvl_parse(const char *s)
+{
+  switch (s[0]) {
+    case 'e':
+      return LVL_ERR;
+    case 'w':
+      return LVL_WRN;
+    case 'm':
+      return LVL_MSG;
+    case 'd':
+      return LVL_DBG;
+    case 'v':
+      return LVL_VER;
+    default:
+      return -1;
+  }
+}
+
 err_t clicb_loglvlset(int argc, char *argv[])
 {
-  unsigned lvl = LVL_VER;
+  int lvl;
 
   if (argc > 1) {
-    if (argv[1][0] == 'e') {
-      lvl = LVL_ERR;
-    } else if (argv[1][0] == 'w') {
-      lvl = LVL_WRN;
-    } else if (argv[1][0] == 'm') {
-      lvl = LVL_MSG;
-    } else if (argv[1][0] == 'd') {
-      lvl = LVL_DBG;
-    } else if (argv[1][0] == 'v') {
-      lvl = LVL_VER;
-    } else {
+    lvl = lvl_parse(argv[1]);
+    if (lvl < 0) {
       return err(ec_param_invalid);
     }
     set_logging_lvl_threshold(lvl);
@@ -568,6 +543,114 @@ err_t clicb_loglvlset(int argc, char *argv[])
   return ec_success;
 }
 
+err_t clicb_modlvlset(int argc, char *argv[])
+{
+  log_mod_t mod;
+  int lvl;
+
+  if (argc < 3) {
+    return err(ec_param_invalid);
+  }
+  mod = get_logging_mod(argv[1]);
+  lvl = lvl_parse(argv[2]);
+  if (mod == log_mod_max || lvl < 0) {
+    return err(ec_param_invalid);
+  }
+  set_logging_mod_lvl_threshold(mod, lvl);
+  return ec_success;
+}
+
+err_t clicb_trace(int argc, char *argv[])
+{
+  if (argc < 2) {
+    return err(ec_param_invalid);
+  }
+  if (!strcmp(argv[1], "on")) {
+    return logging_trace_start(CLI_TRACE_FILE_PATH);
+  } else if (!strcmp(argv[1], "off")) {
+    logging_trace_stop();
+    return ec_success;
+  }
+  return err(ec_param_invalid);
+}
+
+err_t clicb_timeline(int argc, char *argv[])
+{
+  if (argc < 2) {
+    return err(ec_param_invalid);
+  }
+  if (!strcmp(argv[1], "on")) {
+    return timeline_start(CLI_TIMELINE_FILE_PATH);
+  } else if (!strcmp(argv[1], "off")) {
+    timeline_stop();
+    return ec_success;
+  }
+  return err(ec_param_invalid);
+}
+
+err_t clicb_capture(int argc, char *argv[])
+{
+  if (argc < 2) {
+    return err(ec_param_invalid);
+  }
+  if (getprojargs()->replay[0]) {
+    return err(ec_state);
+  }
+  if (!strcmp(argv[1], "on")) {
+    return bgapi_cap_start(BGAPI_CAPTURE_FILE_PATH);
+  } else if (!strcmp(argv[1], "off")) {
+    bgapi_cap_stop();
+    return ec_success;
+  }
+  return err(ec_param_invalid);
+}
+
+err_t clicb_bgstat(int argc, char *argv[])
+{
+  if (argc < 2) {
+    cli_print_bgapi_stat();
+    return ec_success;
+  }
+  if (!strcmp(argv[1], "reset")) {
+    bgapi_stat_reset();
+    return ec_success;
+  } else if (!strcmp(argv[1], "export")) {
+    return bgapi_stat_export(BGAPI_STAT_FILE_PATH);
+  }
+  return err(ec_param_invalid);
+}
+
+err_t clicb_dcdcache(int argc, char *argv[])
+{
+  if (argc < 2) {
+    cli_print_dcd_cache();
+    return ec_success;
+  }
+  if (!strcmp(argv[1], "clear")) {
+    return dcd_cache_forget();
+  }
+  return err(ec_param_invalid);
+}
+
+err_t clicb_shaper(int argc, char *argv[])
+{
+  uint32_t rate, burst;
+  err_t e;
+
+  if (argc < 2) {
+    cli_print_shaper();
+    return ec_success;
+  }
+  if (argc != 3) {
+    return err(ec_param_invalid);
+  }
+  if (ec_success != (e = str2uint(argv[1], strlen(argv[1]), &rate, sizeof(uint32_t)))
+      || ec_success != (e = str2uint(argv[2], strlen(argv[2]), &burst, sizeof(uint32_t)))) {
+    return e;
+  }
+  return shaper_set(rate, burst);
+}
+
 static inline bool seq_valid(const char *seq)
 {
   for (int i = 0; i < 3; i++) {
@@ -602,6 +685,7 @@ err_t clicb_seqset(int argc, char *argv[])
 err_t clicb_status(int argc, char *argv[])
 {
   cli_status(&mng);
+  cli_print_stat(get_stat());
   return ec_success;
 }
 
@@ -6,12 +6,16 @@
  ************************************************************************/
 
 /* Includes *********************************************************** */
+#define LOG_MODULE log_mod_mng
 #include "projconfig.h"
 #include "host_gecko.h"
 #include "mng.h"
 #include "cli.h"
 #include "logging.h"
+#include "stat.h"
 #include "utils.h"
+#include "shaper.h"
+#include "rpc.h"
 
 /* Defines  *********************************************************** */
 #ifdef DEMO_EN
@@ -228,6 +232,7 @@ err_t clicb_onoff(int argc, char *argv[])
 
   if (mng->cache.model_set.nodes) {
     mng->cache.model_set.type = ONOFF_SV_BIT;
+    mng->cache.model_set.start = lat_now_us();
   }
   return e;
 }
@@ -287,6 +292,7 @@ static err_t clicb_perc_set(int argc, char *argv[], uint8_t type)
   }
   if (mng->cache.model_set.nodes) {
     mng->cache.model_set.type = type;
+    mng->cache.model_set.start = lat_now_us();
   }
   return e;
 }
@@ -359,6 +365,10 @@ bool models_loop(mng_t *mng)
   if (!item) {
     ASSERT(0);
   }
+  if (!shaper_take(shp_interactive)) {
+    /* Sleep till the next token */
+    return false;
+  }
 
   if (mng->cache.model_set.type == ONOFF_SV_BIT) {
     ret = send_onoff(*(uint16_t *)item->data, mng->cache.model_set.value);
@@ -374,6 +384,7 @@ bool models_loop(mng_t *mng)
     }
     LOGE("Model Set to Node[0x%04x] Error[0x%04x].\n", *(uint16_t *)item->data, ret);
   } else {
+    stat_model_set_lat(mng->cache.model_set.type, mng->cache.model_set.start);
 #if 0
     cli_print_modelset_done(*(uint16_t *)item->data,
                             mng->cache.model_set.type,
@@ -382,6 +393,9 @@ bool models_loop(mng_t *mng)
   }
 
   mng->cache.model_set.nodes = g_list_remove_link(mng->cache.model_set.nodes, item);
+  rpc_notify_model_set(*(uint16_t *)item->data, mng->cache.model_set.type,
+                       mng->cache.model_set.value, ret,
+                       !mng->cache.model_set.nodes);
   free(item->data);
   g_list_free(item);
   if (!g_list_length(mng->cache.model_set.nodes)) {
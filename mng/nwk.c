@@ -6,9 +6,11 @@
  ************************************************************************/
 
 /* Includes *********************************************************** */
+#define LOG_MODULE log_mod_mng
 #include <stdio.h>
 #include <unistd.h>
 
+#include "projconfig.h"
 #include "cli.h"
 #include "host_gecko.h"
 #include "nwk.h"
@@ -19,6 +21,9 @@
 #include "socket_handler.h"
 #include "generic_parser.h"
 #include "startup.h"
+#include "acc_rto.h"
+#include "bgevt_hdr.h"
+#include "warm.h"
 
 /* Defines  *********************************************************** */
 
@@ -28,6 +33,96 @@
 
 /* Static Functions Declaractions ************************************* */
 static err_t on_initialized_config(struct gecko_msg_mesh_prov_initialized_evt_t *ein);
+static void self_config(const mng_t *mng);
+
+/* The models of the attached NCP target are initialized already */
+static inline bool client_init_ok(uint16_t ret)
+{
+  return ret == bg_err_success
+         || (ncp_target_attached()
+             && (ret == bg_err_wrong_state
+                 || ret == bg_err_mesh_already_initialized));
+}
+
+/* Model clients the manager uses */
+static const struct {
+  uint32_t id;
+  /* Element index, -1 for the clients which take none */
+  int elem;
+  const char *name;
+} client_inits[] = {
+  { gecko_cmd_mesh_generic_client_init_id, -1, "gecko_cmd_mesh_generic_client_init" },
+  { gecko_cmd_mesh_sensor_client_init_id, -1, "gecko_cmd_mesh_sensor_client_init" },
+#if (LC_CLIENT_PRESENT == 1)
+  { gecko_cmd_mesh_lc_client_init_id, LC_ELEM_INDEX, "gecko_cmd_mesh_lc_client_init" },
+#endif
+#if (SCENE_CLIENT_PRESENT == 1)
+  { gecko_cmd_mesh_scene_client_init_id, SCENE_ELEM_INDEX, "gecko_cmd_mesh_scene_client_init" },
+#endif
+};
+
+/*
+ * The model clients don't depend on each other, so all the init commands are
+ * sent before the first response is waited for, which costs one round trip to
+ * the NCP target instead of one per client.
+ */
+static err_t clients_init(void)
+{
+  uint32_t hdrs[ARR_LEN(client_inits)];
+  uint64_t start = lat_now_us();
+  struct gecko_cmd_packet *rsp;
+  err_t e = ec_success;
+  uint16_t ret;
+  uint8_t len;
+
+  for (int i = 0; i < ARR_LEN(client_inits); i++) {
+    len = client_inits[i].elem < 0 ? 0 : sizeof(uint16_t);
+    if (len) {
+      /* The LC and scene client init take the same element index */
+      gecko_cmd_msg->data.cmd_mesh_lc_client_init.elem_index = client_inits[i].elem;
+    }
+    hdrs[i] = client_inits[i].id + ((len & 0xff) << 8) + ((len & 0x700) >> 8);
+    gecko_cmd_msg->header = hdrs[i];
+    gecko_send_command();
+  }
+  /* Every response is read even after a failure, the later ones would be
+   * taken as the responses of the next commands otherwise */
+  for (int i = 0; i < ARR_LEN(client_inits); i++) {
+    rsp = gecko_recv_response(hdrs[i], start);
+    if (BGLIB_MSG_ID(rsp->header) != BGLIB_MSG_ID(hdrs[i])) {
+      LOGE("Response 0x%08x to %s\n", rsp->header, client_inits[i].name);
+      e = err(ec_bgrsp);
+      continue;
+    }
+    /* The responses of the client init are all the result only */
+    ret = rsp->data.rsp_mesh_generic_client_init.result;
+    if (!client_init_ok(ret)) {
+      LOGE("%s returns Error[0x%04x]\n", client_inits[i].name, ret);
+      e = err(ec_bgrsp);
+    }
+  }
+  return e;
+}
+
+/*
+ * Take over the running NCP target if it agrees with the config, it's reset
+ * otherwise.
+ */
+static bool warm_attach(mng_t *mng)
+{
+  if (!ncp_target_attached()) {
+    return false;
+  }
+  if (ec_success != warm_validate(mng)) {
+    LOGW("NCP Target Doesn't Agree with Config, Reset It\n");
+    sync_host_and_ncp_target();
+    return false;
+  }
+  mng->state = initialized;
+  LOGM("NCP ---> NWK Attached\n");
+  self_config(mng);
+  return true;
+}
 
 err_t nwk_init(void *p)
 {
@@ -36,54 +131,31 @@ err_t nwk_init(void *p)
   err_t e = ec_success;
 
   mng_t *mng = get_mng();
-  if (bg_err_success != (ret = gecko_cmd_mesh_prov_init()->result)) {
-    LOGBGE("gecko_cmd_mesh_prov_init", ret);
-    return err(ec_bgrsp);
-  }
+  if (!warm_attach(mng)) {
+    if (bg_err_success != (ret = gecko_cmd_mesh_prov_init()->result)) {
+      LOGBGE("gecko_cmd_mesh_prov_init", ret);
+      return err(ec_bgrsp);
+    }
 
-  while (NULL == evt || BGLIB_MSG_ID(evt->header) != gecko_evt_mesh_prov_initialized_id) {
-    if (getprojargs()->enc) {
-      poll_update(50);
+    evt = bgevt_wait(gecko_evt_mesh_prov_initialized_id, NCP_PROV_INIT_TIMEOUT_MS);
+    if (!evt) {
+      LOGE("NCP Target Not Initialized in %dms\n", NCP_PROV_INIT_TIMEOUT_MS);
+      return err(ec_timeout);
     }
-    evt = gecko_peek_event();
-    /* Blocking wait for initialized event, timeout could be added to increase the robust */
-    usleep(500);
-  }
 
-  mng->state = initialized;
-  LOGM("NCP ---> NWK Initialized\n");
-  EC(ec_success, on_initialized_config(&evt->data.evt_mesh_prov_initialized));
+    mng->state = initialized;
+    LOGM("NCP ---> NWK Initialized\n");
+    EC(ec_success, on_initialized_config(&evt->data.evt_mesh_prov_initialized));
+  }
   mng->state = configured;
-  mng_load_lists();     /* do the initial loading */
+  /* do the initial loading, the DDB listed by the warm attach is reused */
+  mng_load_lists();
   LOGM("Network configured and nodes loaded\n");
 
   /*
    * Initialize all the required model classes
    */
-  /* Generic client model */
-  if (bg_err_success != (ret = gecko_cmd_mesh_generic_client_init()->result)) {
-    LOGBGE("gecko_cmd_mesh_generic_client_init", ret);
-    return err(ec_bgrsp);
-  }
-  /* Sensor client model */
-  if (bg_err_success != (ret = gecko_cmd_mesh_sensor_client_init()->result)) {
-    LOGBGE("gecko_cmd_mesh_sensor_client_init", ret);
-    return err(ec_bgrsp);
-  }
-#if (LC_CLIENT_PRESENT == 1)
-  /* LC client model */
-  if (bg_err_success != (ret = gecko_cmd_mesh_lc_client_init(LC_ELEM_INDEX)->result)) {
-    LOGBGE("gecko_cmd_mesh_lc_client_init", ret);
-    return err(ec_bgrsp);
-  }
-#endif
-#if (SCENE_CLIENT_PRESENT == 1)
-  /* Scene client model */
-  if (bg_err_success != (ret = gecko_cmd_mesh_scene_client_init(SCENE_ELEM_INDEX)->result)) {
-    LOGBGE("gecko_cmd_mesh_scene_client_init", ret);
-    return err(ec_bgrsp);
-  }
-#endif
+  EC(ec_success, clients_init());
 
   return e;
 }
@@ -179,6 +251,7 @@ static void self_config(const mng_t *mng)
     LOGM("Set config client timeout for normal node/LPN [%dms/%dms] Success\n",
          mng->cfg->timeout->normal,
          mng->cfg->timeout->lpn);
+    acc_rto_init(mng->cfg->timeout->normal, mng->cfg->timeout->lpn);
   }
 }
 
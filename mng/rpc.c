@@ -0,0 +1,786 @@
+/*************************************************************************
+    > File Name: rpc.c
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: JSON-RPC control socket.
+    The server thread reads the requests of all the clients, one JSON object
+    per line, turns each into a command of the command table or a query and
+    queues it to the manager in the command ring of the RPC source, tagged
+    with a request number. The manager runs it and hands the result back
+    through a ring the other way, together with the notifications of what it
+    does, and the server writes the replies and notifications to the clients.
+    Only the manager touches the config and the state, only the server
+    touches the sockets and the JSON of the requests.
+ ************************************************************************/
+
+/* Includes *********************************************************** */
+#define LOG_MODULE log_mod_mng
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <glib.h>
+#include <json.h>
+
+#include "projconfig.h"
+#include "rpc.h"
+#include "mng.h"
+#include "cfg.h"
+#include "stat.h"
+#include "logging.h"
+#include "utils.h"
+
+/* Defines  *********************************************************** */
+#if (RPC_OUT_SIZE & (RPC_OUT_SIZE - 1))
+#error "RPC_OUT_SIZE must be a power of 2"
+#endif
+
+#if (RPC_OUT_SIZE <= CMD_RING_SIZE)
+#error "RPC_OUT_SIZE must be more than CMD_RING_SIZE"
+#endif
+
+#define OUT_MASK (RPC_OUT_SIZE - 1)
+/* Requests in flight, each has a slot of the out ring kept for its reply */
+#define PENDING_MAX CMD_RING_SIZE
+
+#ifndef MSG_NOSIGNAL
+/* SO_NOSIGPIPE is set on the client sockets instead */
+#define MSG_NOSIGNAL 0
+#endif
+
+/* JSON-RPC 2.0 error codes */
+#define RPC_PARSE_ERROR       -32700
+#define RPC_INVALID_REQUEST   -32600
+#define RPC_METHOD_NOT_FOUND  -32601
+#define RPC_INVALID_PARAMS    -32602
+#define RPC_COMMAND_FAILED    -32000
+#define RPC_BUSY              -32001
+
+typedef struct {
+  /* 0 if the slot is free, never reused otherwise */
+  uint32_t uid;
+  int fd;
+  size_t len;
+  char buf[RPC_LINE_MAX];
+}client_t;
+
+/* A request the manager hasn't answered yet */
+typedef struct {
+  uint32_t client;
+  /* NULL if the client wants no reply */
+  json_object *id;
+}pending_t;
+
+/* From the manager to the server */
+typedef struct {
+  /* 0 for a notification */
+  uint32_t req;
+  err_t e;
+  /* The result of a query or the notification, owned by the server once
+   * queued */
+  json_object *obj;
+}out_t;
+
+/* Global Variables *************************************************** */
+
+/* Static Variables *************************************************** */
+static const char *evt_names[rpc_evt_max] = {
+  "provisioned", "prov_failed", "configured", "config_failed", "removed"
+};
+
+/* The CLI commands open to the clients, by the method names */
+static const struct {
+  const char *method;
+  const char *cmd;
+} cli_methods[] = {
+  { "sync", "sync" },
+  { "onoff", "onoff" },
+  { "lightness", "lightness" },
+  { "ct", "colortemp" },
+  { "rmall", "rmall" },
+  { "freemode", "freemode" },
+};
+
+static err_t rpcq_status(int argc, char *argv[]);
+static err_t rpcq_nodes(int argc, char *argv[]);
+
+static const command_t queries[] = {
+  { "status", NULL, rpcq_status,
+    "State of the manager and the statistics" },
+  { "nodes", "[addr...]", rpcq_nodes,
+    "The nodes in the database, all of them if no address is given" },
+};
+
+static struct {
+  bool started;
+  int fd;
+  /* [0] is waited on by the server, [1] is written by the manager */
+  int wakefd[2];
+  pthread_t tid;
+  client_t clients[RPC_MAX_CLIENTS];
+  /* Read by the manager, nothing is notified if no one listens */
+  int nclients;
+  uint32_t next_uid;
+  uint32_t next_req;
+  /* Request number to pending_t */
+  GHashTable *pending;
+  out_t outs[RPC_OUT_SIZE];
+  /* Free running, moved by the server */
+  uint32_t out_head;
+  /* Free running, moved by the manager */
+  uint32_t out_tail;
+  /* Below only used by the manager thread */
+  uint32_t out_dropped;
+  /* Set by a query for its reply */
+  json_object *result;
+  /* The requests which started the sync and the model set, 0 if none */
+  uint32_t sync_req;
+  uint32_t model_set_req;
+} rpc = {
+  .fd = -1,
+  .wakefd = { -1, -1 }
+};
+
+/* Static Functions Declaractions ************************************* */
+/******************************************************************
+ * Manager side
+ * ***************************************************************/
+static void out_put(uint32_t req, err_t e, json_object *obj)
+{
+  uint32_t t = rpc.out_tail;
+  uint8_t one = 1;
+  /*
+   * The replies in the ring are at most the requests in flight, so with
+   * PENDING_MAX slots kept for them a reply always finds one.
+   */
+  uint32_t limit = req ? RPC_OUT_SIZE : RPC_OUT_SIZE - PENDING_MAX;
+
+  if (t - __atomic_load_n(&rpc.out_head, __ATOMIC_ACQUIRE) >= limit) {
+    /* The manager never waits for the clients */
+    if (!rpc.out_dropped++) {
+      LOGW("RPC Server Behind, Notifications Dropped\n");
+    }
+    ASSERT(!req);
+    if (obj) {
+      json_object_put(obj);
+    }
+    return;
+  }
+  rpc.outs[t & OUT_MASK].req = req;
+  rpc.outs[t & OUT_MASK].e = e;
+  rpc.outs[t & OUT_MASK].obj = obj;
+  __atomic_store_n(&rpc.out_tail, t + 1, __ATOMIC_RELEASE);
+  if (write(rpc.wakefd[1], &one, 1) < 0 && errno != EAGAIN) {
+    LOGW("Wake RPC server error[%s]\n", strerror(errno));
+  }
+}
+
+static inline bool listened(void)
+{
+  return rpc.started && __atomic_load_n(&rpc.nclients, __ATOMIC_RELAXED);
+}
+
+static void notify(const char *method, json_object *params)
+{
+  json_object *o = json_object_new_object();
+
+  json_object_object_add(o, "jsonrpc", json_object_new_string("2.0"));
+  json_object_object_add(o, "method", json_object_new_string(method));
+  json_object_object_add(o, "params", params);
+  out_put(0, ec_success, o);
+}
+
+static inline json_object *req_json(uint32_t req)
+{
+  return req ? json_object_new_int64(req) : NULL;
+}
+
+void rpc_on_done(const cmd_t *c, err_t e)
+{
+  json_object *result = rpc.result;
+
+  rpc.result = NULL;
+  if (e == ec_success) {
+    if (c->cmd->fn == clicb_sync
+        && (c->w.we_wordc < 2 || atoi(c->w.we_wordv[1]))) {
+      rpc.sync_req = c->tag;
+    } else if (c->cmd->fn == clicb_onoff
+               || c->cmd->fn == clicb_lightness
+               || c->cmd->fn == clicb_ct) {
+      rpc.model_set_req = c->tag;
+    }
+  }
+  out_put(c->tag, e, result);
+}
+
+void rpc_notify_node(int evt, const uint8_t *uuid, uint16_t addr,
+                     uint32_t result)
+{
+  json_object *p;
+  char uuid_str[33] = { 0 };
+
+  if (!listened()) {
+    return;
+  }
+  p = json_object_new_object();
+  json_object_object_add(p, "event", json_object_new_string(evt_names[evt]));
+  if (uuid) {
+    cbuf2str((const char *)uuid, 16, 0, uuid_str, 33);
+    json_object_object_add(p, "uuid", json_object_new_string(uuid_str));
+  }
+  if (addr) {
+    json_object_object_add(p, "addr", json_object_new_int(addr));
+  }
+  if (result) {
+    json_object_object_add(p, "result", json_object_new_int64(result));
+  }
+  notify("node", p);
+}
+
+void rpc_notify_model_set(uint16_t addr, uint8_t type, uint8_t value,
+                          uint16_t result, bool last)
+{
+  json_object *p;
+  uint32_t req = rpc.model_set_req;
+
+  if (last) {
+    rpc.model_set_req = 0;
+  }
+  if (!listened()) {
+    return;
+  }
+  p = json_object_new_object();
+  json_object_object_add(p, "req", req_json(req));
+  json_object_object_add(p, "model", json_object_new_string(
+                           type == ONOFF_SV_BIT ? "onoff"
+                           : type == LIGHTNESS_SV_BIT ? "lightness" : "ct"));
+  json_object_object_add(p, "addr", json_object_new_int(addr));
+  json_object_object_add(p, "value", json_object_new_int(value));
+  json_object_object_add(p, "result", json_object_new_int(result));
+  json_object_object_add(p, "last", json_object_new_boolean(last));
+  notify("model_set", p);
+}
+
+void rpc_notify_sync_done(void)
+{
+  const stat_t *s = get_stat();
+  json_object *p;
+  uint32_t req = rpc.sync_req;
+
+  rpc.sync_req = 0;
+  if (!listened()) {
+    return;
+  }
+  p = json_object_new_object();
+  json_object_object_add(p, "req", req_json(req));
+  json_object_object_add(p, "added", json_object_new_int(s->add.dev_cnt));
+  json_object_object_add(p, "configured", json_object_new_int(s->config.dev_cnt));
+  json_object_object_add(p, "removed", json_object_new_int(s->rm.dev_cnt));
+  json_object_object_add(p, "fail", json_object_new_int(
+                           g_list_length(get_mng()->lists.fail)));
+  notify("sync_done", p);
+}
+
+static json_object *node_json(const node_t *n)
+{
+  json_object *o = json_object_new_object();
+  char uuid_str[33] = { 0 };
+
+  cbuf2str((const char *)n->uuid, 16, 0, uuid_str, 33);
+  json_object_object_add(o, "addr", json_object_new_int(n->addr));
+  json_object_object_add(o, "uuid", json_object_new_string(uuid_str));
+  json_object_object_add(o, "done", json_object_new_boolean(n->done));
+  json_object_object_add(o, "rmorbl", json_object_new_int(n->rmorbl));
+  json_object_object_add(o, "err", json_object_new_int64(n->err));
+  json_object_object_add(o, "func", json_object_new_int(n->models.func));
+  return o;
+}
+
+static err_t rpcq_status(int argc, char *argv[])
+{
+  const mng_t *mng = get_mng();
+  const stat_t *s = get_stat();
+  json_object *o = json_object_new_object(), *l = json_object_new_object();
+
+  json_object_object_add(o, "state", json_object_new_int(mng->state));
+  json_object_object_add(o, "busy", json_object_new_boolean(mng->state > configured));
+  json_object_object_add(o, "freemode", json_object_new_boolean(mng->status.free_mode));
+  json_object_object_add(o, "seq", json_object_new_string(mng->status.seq.prios));
+  json_object_object_add(l, "add", json_object_new_int(g_list_length(mng->lists.add)));
+  json_object_object_add(l, "config", json_object_new_int(g_list_length(mng->lists.config)));
+  json_object_object_add(l, "rm", json_object_new_int(g_list_length(mng->lists.rm)));
+  json_object_object_add(l, "bl", json_object_new_int(g_list_length(mng->lists.bl)));
+  json_object_object_add(l, "fail", json_object_new_int(g_list_length(mng->lists.fail)));
+  json_object_object_add(o, "lists", l);
+  json_object_object_add(o, "model_set_pending",
+                         json_object_new_int(g_list_length(mng->cache.model_set.nodes)));
+  json_object_object_add(o, "added", json_object_new_int(s->add.dev_cnt));
+  json_object_object_add(o, "configured", json_object_new_int(s->config.dev_cnt));
+  json_object_object_add(o, "removed", json_object_new_int(s->rm.dev_cnt));
+  json_object_object_add(o, "prov_failures", json_object_new_int64(s->total.prov_failures));
+  rpc.result = o;
+  return ec_success;
+}
+
+static err_t rpcq_nodes(int argc, char *argv[])
+{
+  json_object *a = json_object_new_array();
+  uint16list_t *addrs;
+  node_t *n;
+  uint16_t addr;
+
+  if (argc < 2) {
+    if (NULL != (addrs = get_node_addrs())) {
+      for (int i = 0; i < addrs->len; i++) {
+        if (NULL != (n = cfgdb_node_get(addrs->data[i]))) {
+          json_object_array_add(a, node_json(n));
+        }
+      }
+      free(addrs->data);
+      free(addrs);
+    }
+  }
+  for (int i = 1; i < argc; i++) {
+    if (ec_success != str2uint(argv[i], strlen(argv[i]), &addr, sizeof(uint16_t))) {
+      json_object_put(a);
+      return err(ec_param_invalid);
+    }
+    if (NULL == (n = cfgdb_node_get(addr))) {
+      json_object_put(a);
+      return err(ec_not_exist);
+    }
+    json_object_array_add(a, node_json(n));
+  }
+  rpc.result = a;
+  return ec_success;
+}
+
+/******************************************************************
+ * Server side
+ * ***************************************************************/
+static void client_drop(client_t *c)
+{
+  close(c->fd);
+  c->uid = 0;
+  c->len = 0;
+  __atomic_sub_fetch(&rpc.nclients, 1, __ATOMIC_RELAXED);
+}
+
+static void send_line(client_t *c, json_object *o)
+{
+  const char *s = json_object_to_json_string_ext(o, JSON_C_TO_STRING_PLAIN);
+  size_t len = strlen(s), off = 0;
+  ssize_t n;
+
+  while (off <= len) {
+    /* The line ends with a newline */
+    /* A client gone away mustn't kill the process with SIGPIPE */
+    n = off < len ? send(c->fd, s + off, len - off, MSG_NOSIGNAL)
+        : send(c->fd, "\n", 1, MSG_NOSIGNAL);
+    if (n <= 0) {
+      /* A client too slow to read is dropped rather than waited for */
+      LOGW("RPC Client[%u] Dropped on Write[%s]\n", c->uid,
+           n < 0 ? strerror(errno) : "closed");
+      client_drop(c);
+      return;
+    }
+    off += n;
+  }
+}
+
+static client_t *client_of(uint32_t uid)
+{
+  for (int i = 0; i < RPC_MAX_CLIENTS; i++) {
+    if (rpc.clients[i].uid == uid) {
+      return &rpc.clients[i];
+    }
+  }
+  return NULL;
+}
+
+static json_object *msg_new(json_object *id)
+{
+  json_object *o = json_object_new_object();
+
+  json_object_object_add(o, "jsonrpc", json_object_new_string("2.0"));
+  json_object_object_add(o, "id", id ? json_object_get(id) : NULL);
+  return o;
+}
+
+static void reply_error(client_t *c, json_object *id, int code,
+                        const char *msg, json_object *data)
+{
+  json_object *o = msg_new(id), *e = json_object_new_object();
+
+  json_object_object_add(e, "code", json_object_new_int(code));
+  json_object_object_add(e, "message", json_object_new_string(msg));
+  if (data) {
+    json_object_object_add(e, "data", data);
+  }
+  json_object_object_add(o, "error", e);
+  send_line(c, o);
+  json_object_put(o);
+}
+
+static void reply(const out_t *out)
+{
+  pending_t *p = g_hash_table_lookup(rpc.pending, GUINT_TO_POINTER(out->req));
+  client_t *c;
+  json_object *o, *d;
+
+  if (!p) {
+    return;
+  }
+  if (p->id && NULL != (c = client_of(p->client))) {
+    if (out->e == ec_success) {
+      o = msg_new(p->id);
+      d = json_object_new_object();
+      json_object_object_add(d, "req", json_object_new_int64(out->req));
+      if (out->obj) {
+        json_object_object_add(d, "data", json_object_get(out->obj));
+      }
+      json_object_object_add(o, "result", d);
+      send_line(c, o);
+      json_object_put(o);
+    } else {
+      d = json_object_new_object();
+      json_object_object_add(d, "req", json_object_new_int64(out->req));
+      json_object_object_add(d, "ec", json_object_new_int(errof(out->e)));
+      json_object_object_add(d, "err", json_object_new_int64(out->e));
+      reply_error(c, p->id,
+                  errof(out->e) == ec_param_invalid ? RPC_INVALID_PARAMS
+                  : RPC_COMMAND_FAILED,
+                  errof(out->e) == ec_param_invalid ? "Invalid params"
+                  : "Command failed",
+                  d);
+    }
+  }
+  g_hash_table_remove(rpc.pending, GUINT_TO_POINTER(out->req));
+}
+
+static void flush_outs(void)
+{
+  uint32_t h = rpc.out_head;
+  out_t *out;
+
+  while (h != __atomic_load_n(&rpc.out_tail, __ATOMIC_ACQUIRE)) {
+    out = &rpc.outs[h & OUT_MASK];
+    if (out->req) {
+      reply(out);
+    } else {
+      for (int i = 0; i < RPC_MAX_CLIENTS; i++) {
+        if (rpc.clients[i].uid) {
+          send_line(&rpc.clients[i], out->obj);
+        }
+      }
+    }
+    if (out->obj) {
+      json_object_put(out->obj);
+    }
+    /* The slot is read before the manager can reuse it */
+    __atomic_store_n(&rpc.out_head, ++h, __ATOMIC_RELEASE);
+  }
+}
+
+static const command_t *method_cmd(const char *method)
+{
+  for (int i = 0; i < ARR_LEN(cli_methods); i++) {
+    if (!strcmp(method, cli_methods[i].method)) {
+      return cli_cmd_get(cli_methods[i].cmd);
+    }
+  }
+  for (int i = 0; i < ARR_LEN(queries); i++) {
+    if (!strcmp(method, queries[i].name)) {
+      return &queries[i];
+    }
+  }
+  return NULL;
+}
+
+/* In single quotes, nothing in it is expanded by wordexp */
+static void append_quoted(GString *s, const char *arg)
+{
+  g_string_append(s, " '");
+  for (; *arg; arg++) {
+    if (*arg == '\'') {
+      g_string_append(s, "'\\''");
+    } else {
+      g_string_append_c(s, *arg);
+    }
+  }
+  g_string_append_c(s, '\'');
+}
+
+static bool parse_params(const command_t *cmd, json_object *params, wordexp_t *w)
+{
+  GString *s = g_string_new(cmd->name);
+  json_object *v;
+  bool ok = true;
+  size_t n = params ? json_object_array_length(params) : 0;
+
+  for (size_t i = 0; ok && i < n; i++) {
+    v = json_object_array_get_idx(params, i);
+    switch (json_object_get_type(v)) {
+      case json_type_string:
+      case json_type_int:
+        append_quoted(s, json_object_get_string(v));
+        break;
+      default:
+        ok = false;
+        break;
+    }
+  }
+  ok = ok && !wordexp(s->str, w, WRDE_NOCMD);
+  g_string_free(s, TRUE);
+  return ok;
+}
+
+static void handle_line(client_t *c, const char *line)
+{
+  json_object *req, *id = NULL, *m, *params = NULL;
+  const command_t *cmd;
+  pending_t *p;
+  wordexp_t w;
+
+  req = json_tokener_parse(line);
+  if (!req || json_object_get_type(req) != json_type_object) {
+    reply_error(c, NULL, RPC_PARSE_ERROR, "Parse error", NULL);
+    if (req) {
+      json_object_put(req);
+    }
+    return;
+  }
+  json_object_object_get_ex(req, "id", &id);
+  if (!json_object_object_get_ex(req, "method", &m)
+      || json_object_get_type(m) != json_type_string) {
+    reply_error(c, id, RPC_INVALID_REQUEST, "Invalid Request", NULL);
+    goto out;
+  }
+  if (NULL == (cmd = method_cmd(json_object_get_string(m)))) {
+    reply_error(c, id, RPC_METHOD_NOT_FOUND, "Method not found", NULL);
+    goto out;
+  }
+  if (json_object_object_get_ex(req, "params", &params)
+      && params && json_object_get_type(params) != json_type_array) {
+    reply_error(c, id, RPC_INVALID_PARAMS, "Invalid params", NULL);
+    goto out;
+  }
+  if (!parse_params(cmd, params, &w)) {
+    reply_error(c, id, RPC_INVALID_PARAMS, "Invalid params", NULL);
+    goto out;
+  }
+
+  if (g_hash_table_size(rpc.pending) >= PENDING_MAX) {
+    wordfree(&w);
+    reply_error(c, id, RPC_BUSY, "Busy", NULL);
+    goto out;
+  }
+  if (NULL == (p = malloc(sizeof(pending_t)))) {
+    wordfree(&w);
+    reply_error(c, id, RPC_COMMAND_FAILED, "Out of memory", NULL);
+    goto out;
+  }
+  if (!++rpc.next_req) {
+    /* 0 is for the notifications */
+    rpc.next_req++;
+  }
+  /*
+   * Never waits for the manager, the other clients would wait as well. The
+   * reply is handled by this thread, so the request is recorded after.
+   */
+  if (!cmd_try_enq(cmd_src_rpc, cmd, &w, rpc.next_req)) {
+    free(p);
+    wordfree(&w);
+    reply_error(c, id, RPC_BUSY, "Busy", NULL);
+    goto out;
+  }
+  p->client = c->uid;
+  p->id = id ? json_object_get(id) : NULL;
+  g_hash_table_insert(rpc.pending, GUINT_TO_POINTER(rpc.next_req), p);
+
+  out:
+  json_object_put(req);
+}
+
+static void client_read(client_t *c)
+{
+  ssize_t n;
+  char *nl, *line;
+
+  n = read(c->fd, c->buf + c->len, sizeof(c->buf) - 1 - c->len);
+  if (n <= 0) {
+    if (n < 0 && (errno == EAGAIN || errno == EINTR)) {
+      return;
+    }
+    LOGM("RPC Client[%u] Disconnected\n", c->uid);
+    client_drop(c);
+    return;
+  }
+  c->len += n;
+  c->buf[c->len] = '\0';
+  line = c->buf;
+  while (c->uid && NULL != (nl = strchr(line, '\n'))) {
+    *nl = '\0';
+    if (line[strspn(line, " \t\r")]) {
+      handle_line(c, line);
+    }
+    line = nl + 1;
+  }
+  if (!c->uid) {
+    return;
+  }
+  c->len -= line - c->buf;
+  memmove(c->buf, line, c->len);
+  if (c->len == sizeof(c->buf) - 1) {
+    reply_error(c, NULL, RPC_INVALID_REQUEST, "Request too long", NULL);
+    if (c->uid) {
+      client_drop(c);
+    }
+  }
+}
+
+static void client_accept(void)
+{
+  int fd;
+  client_t *c = client_of(0);
+
+  if (0 > (fd = accept(rpc.fd, NULL, NULL))) {
+    if (errno != EINTR && errno != EAGAIN) {
+      LOGE("RPC accept error[%d:%s]\n", errno, strerror(errno));
+    }
+    return;
+  }
+  if (!c) {
+    LOGW("RPC Clients Full, Connection Refused\n");
+    close(fd);
+    return;
+  }
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+#ifdef SO_NOSIGPIPE
+  setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &(int){ 1 }, sizeof(int));
+#endif
+  if (!++rpc.next_uid) {
+    rpc.next_uid++;
+  }
+  c->uid = rpc.next_uid;
+  c->fd = fd;
+  c->len = 0;
+  __atomic_add_fetch(&rpc.nclients, 1, __ATOMIC_RELAXED);
+  LOGM("RPC Client[%u] Connected\n", c->uid);
+}
+
+static void *rpc_server(void *p)
+{
+  struct pollfd pfds[RPC_MAX_CLIENTS + 2];
+  client_t *polled[RPC_MAX_CLIENTS + 2];
+  uint8_t buf[64];
+  int n;
+
+  while (1) {
+    pfds[0].fd = rpc.fd;
+    pfds[1].fd = rpc.wakefd[0];
+    n = 2;
+    for (int i = 0; i < RPC_MAX_CLIENTS; i++) {
+      if (rpc.clients[i].uid) {
+        polled[n] = &rpc.clients[i];
+        pfds[n++].fd = rpc.clients[i].fd;
+      }
+    }
+    for (int i = 0; i < n; i++) {
+      pfds[i].events = POLLIN;
+      pfds[i].revents = 0;
+    }
+    if (poll(pfds, n, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      LOGE("RPC poll error[%d:%s]\n", errno, strerror(errno));
+      break;
+    }
+    if (pfds[1].revents) {
+      while (read(rpc.wakefd[0], buf, sizeof(buf)) > 0) {
+      }
+    }
+    for (int i = 2; i < n; i++) {
+      if (pfds[i].revents && polled[i]->uid) {
+        client_read(polled[i]);
+      }
+    }
+    if (pfds[0].revents & POLLIN) {
+      client_accept();
+    }
+    flush_outs();
+  }
+  return NULL;
+}
+
+static void pending_free(gpointer data)
+{
+  pending_t *p = data;
+
+  if (p->id) {
+    json_object_put(p->id);
+  }
+  free(p);
+}
+
+err_t rpc_start(const char *path)
+{
+  int ret;
+  struct sockaddr_un addr;
+
+  if (!path || !path[0]) {
+    return err(ec_param_null);
+  }
+  if (rpc.started) {
+    return ec_success;
+  }
+  if (strlen(path) >= sizeof(addr.sun_path)) {
+    return err(ec_param_invalid);
+  }
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, path);
+  unlink(path);
+  if (0 > (rpc.fd = socket(AF_UNIX, SOCK_STREAM, 0))
+      || bind(rpc.fd, (struct sockaddr *)&addr, sizeof(addr)) < 0
+      || listen(rpc.fd, RPC_MAX_CLIENTS) < 0
+      || pipe(rpc.wakefd) < 0) {
+    LOGE("RPC socket [%s] error[%d:%s]\n", path, errno, strerror(errno));
+    goto fail;
+  }
+  fcntl(rpc.wakefd[0], F_SETFL, fcntl(rpc.wakefd[0], F_GETFL) | O_NONBLOCK);
+  fcntl(rpc.wakefd[1], F_SETFL, fcntl(rpc.wakefd[1], F_GETFL) | O_NONBLOCK);
+  rpc.pending = g_hash_table_new_full(g_direct_hash, g_direct_equal,
+                                      NULL, pending_free);
+
+  if (0 != (ret = pthread_create(&rpc.tid, NULL, rpc_server, NULL))) {
+    LOGE("Create RPC server error[%d]\n", ret);
+    g_hash_table_destroy(rpc.pending);
+    goto fail;
+  }
+  pthread_detach(rpc.tid);
+  rpc.started = true;
+  LOGM("RPC served on [%s]\n", path);
+  return ec_success;
+
+  fail:
+  for (int i = 0; i < 2; i++) {
+    if (rpc.wakefd[i] >= 0) {
+      close(rpc.wakefd[i]);
+      rpc.wakefd[i] = -1;
+    }
+  }
+  if (rpc.fd >= 0) {
+    close(rpc.fd);
+    rpc.fd = -1;
+  }
+  return err(ec_file_ope);
+}
@@ -0,0 +1,121 @@
+/*************************************************************************
+    > File Name: shaper.c
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Traffic shaper of the messages sent to the mesh.
+    All the lanes draw from one token bucket, so the on-air rate is bounded no
+    matter who sends. A lane only takes a token while the bucket holds more
+    than the tokens reserved for the lanes above it, so a model set finds
+    tokens at once even in a large sync, and takes them all until it's done.
+ ************************************************************************/
+
+/* Includes *********************************************************** */
+#define LOG_MODULE log_mod_mng
+#include "projconfig.h"
+#include "shaper.h"
+#include "lat_hist.h"
+#include "logging.h"
+
+/* Defines  *********************************************************** */
+#if (SHAPER_RESERVE_INTERACTIVE + SHAPER_RESERVE_BACKGROUND >= SHAPER_BURST)
+#error "SHAPER_BURST leaves no token to the bulk lane"
+#endif
+
+/* Tokens are kept in milli-tokens so the slow rates don't lose the fractions */
+#define MILLI 1000
+
+/* Global Variables *************************************************** */
+
+/* Static Variables *************************************************** */
+/* Tokens the lanes above each lane have to itself */
+static const uint32_t reserved[shp_lane_max] = {
+  0,
+  SHAPER_RESERVE_INTERACTIVE,
+  SHAPER_RESERVE_INTERACTIVE + SHAPER_RESERVE_BACKGROUND
+};
+
+static shaper_stat_t stat = {
+  .rate = SHAPER_RATE,
+  .burst = SHAPER_BURST
+};
+static uint64_t mtokens = (uint64_t)SHAPER_BURST * MILLI;
+/* us, up to when the tokens are added */
+static uint64_t last_us = 0;
+static bool waiting[shp_lane_max];
+
+/* Static Functions Declaractions ************************************* */
+static void refill(void)
+{
+  uint64_t now = lat_now_us(), add;
+  uint64_t full = (uint64_t)stat.burst * MILLI;
+
+  if (!last_us || mtokens >= full) {
+    last_us = now;
+    return;
+  }
+  add = (now - last_us) * stat.rate / 1000;
+  if (!add) {
+    return;
+  }
+  if (mtokens + add >= full) {
+    mtokens = full;
+    last_us = now;
+    return;
+  }
+  mtokens += add;
+  /* Only the time the tokens are added for is consumed */
+  last_us += add * 1000 / stat.rate;
+}
+
+err_t shaper_set(uint32_t rate, uint32_t burst)
+{
+  if (burst <= reserved[shp_bulk]) {
+    return err(ec_param_invalid);
+  }
+  stat.rate = rate;
+  stat.burst = burst;
+  mtokens = (uint64_t)burst * MILLI;
+  last_us = 0;
+  LOGM("Shaper: %u Messages/s, Burst %u\n", rate, burst);
+  return ec_success;
+}
+
+bool shaper_ready(int lane)
+{
+  if (!stat.rate) {
+    return true;
+  }
+  refill();
+  return mtokens >= (uint64_t)(reserved[lane] + 1) * MILLI;
+}
+
+bool shaper_take(int lane)
+{
+  if (!shaper_ready(lane)) {
+    if (!waiting[lane]) {
+      waiting[lane] = true;
+      stat.lanes[lane].deferred++;
+    }
+    return false;
+  }
+  if (stat.rate) {
+    mtokens -= MILLI;
+  }
+  waiting[lane] = false;
+  stat.lanes[lane].sent++;
+  return true;
+}
+
+uint32_t shaper_tokens(void)
+{
+  if (!stat.rate) {
+    return stat.burst;
+  }
+  refill();
+  return (uint32_t)(mtokens / MILLI);
+}
+
+const shaper_stat_t *shaper_stat(void)
+{
+  return &stat;
+}
@@ -6,10 +6,13 @@
  ************************************************************************/
 
 /* Includes *********************************************************** */
+#define LOG_MODULE log_mod_mng
 #include <stddef.h>
 #include <string.h>
 #include "stat.h"
+#include "dev_config.h"
 #include "logging.h"
+#include "utils.h"
 
 /* Defines  *********************************************************** */
 
@@ -26,7 +29,7 @@ const stat_t *get_stat(void)
 
 void stat_reset(void)
 {
-  memset(&stat, 0, sizeof(stat_t));
+  memset(&stat, 0, offsetof(stat_t, total));
 }
 
 void stat_add_start(void)
@@ -56,6 +59,12 @@ void stat_add_one_dev(void)
 void stat_add_failed(void)
 {
   stat.add.fail_times++;
+  stat.total.prov_failures++;
+}
+
+void stat_prov_lat(uint64_t start_us)
+{
+  lat_hist_record(&stat.add.prov_lat, lat_now_us() - start_us);
 }
 
 void stat_config_start(void)
@@ -85,6 +94,7 @@ void stat_config_one_dev(void)
 void stat_config_retry(void)
 {
   stat.config.retry_times++;
+  stat.total.config_retries++;
 }
 
 void stat_config_loading_record(const mng_t *mng)
@@ -104,6 +114,17 @@ void stat_config_loading_record(const mng_t *mng)
   }
 }
 
+void stat_state_lat(int state, uint64_t start_us)
+{
+  uint64_t us = lat_now_us() - start_us;
+
+  if (state >= get_dcd_em && state <= setconfig_em) {
+    lat_hist_record(&stat.config.state_lat[state - get_dcd_em], us);
+  } else if (state == rm_em) {
+    lat_hist_record(&stat.rm.rm_lat, us);
+  }
+}
+
 void stat_bl_start(void)
 {
   if (stat.bl.time.state != rc_idle) {
@@ -150,6 +171,28 @@ void stat_rm_one_dev(void)
 void stat_rm_retry(void)
 {
   stat.rm.retry_times++;
+  stat.total.rm_retries++;
+}
+
+void stat_oom(int src)
+{
+  stat.total.oom[src]++;
+}
+
+void stat_model_set_lat(uint8_t type, uint64_t start_us)
+{
+  int i;
+
+  if (type == ONOFF_SV_BIT) {
+    i = lat_set_onoff;
+  } else if (type == LIGHTNESS_SV_BIT) {
+    i = lat_set_lightness;
+  } else if (type == CTL_SV_BIT) {
+    i = lat_set_ctl;
+  } else {
+    return;
+  }
+  lat_hist_record(&stat.model_set.lat[i], lat_now_us() - start_us);
 }
 void stat_print(void)
 {
@@ -6,34 +6,58 @@
  ************************************************************************/
 
 /* Includes *********************************************************** */
+#define LOG_MODULE log_mod_dev_config
 #include "projconfig.h"
 #include "dev_config.h"
 #include "utils.h"
 #include "logging.h"
+#include "trace.h"
+#include "acc_plan.h"
+#include "cfg_digest.h"
+#include "acc_rto.h"
 
 /* Defines  *********************************************************** */
-#define APP_KEY_ITERATOR_INDEX  0
+#define CUR_OP(cache) acc_plan_op((cache), plan_addappkey)
 
-#define ONCE_P(cache)                                                                     \
-  do {                                                                                    \
-    LOGV("Node[0x%04x]:  --- Add App Key[%d (Ref ID)]\n",                                 \
-         cache->node->addr,                                                               \
-         get_mng()->cfg->subnets[0].appkey[cache->iterators[APP_KEY_ITERATOR_INDEX]].id); \
+#define ONCE_P(cache)              \
+  do {                             \
+    if (CUR_OP(cache)->del) {      \
+      TRC(trc_rmappkey,            \
+          cache->node->addr,       \
+          CUR_OP(cache)->arg);     \
+    } else {                       \
+      TRC(trc_addappkey,           \
+          cache->node->addr,       \
+          CUR_OP(cache)->arg);     \
+    }                              \
   } while (0)
 
-#define SUC_P(cache)                                                                      \
-  do {                                                                                    \
-    LOGD("Node[0x%04x]:  --- Add App Key[%d (Ref ID)] SUCCESS \n",                        \
-         cache->node->addr,                                                               \
-         get_mng()->cfg->subnets[0].appkey[cache->iterators[APP_KEY_ITERATOR_INDEX]].id); \
+#define SUC_P(cache)               \
+  do {                             \
+    if (CUR_OP(cache)->del) {      \
+      TRC(trc_rmappkey_suc,        \
+          cache->node->addr,       \
+          CUR_OP(cache)->arg);     \
+    } else {                       \
+      TRC(trc_addappkey_suc,       \
+          cache->node->addr,       \
+          CUR_OP(cache)->arg);     \
+    }                              \
   } while (0)
 
-#define FAIL_P(cache, err)                                                               \
-  do {                                                                                   \
-    LOGE("Node[0x%04x]:  --- Add App Key[%d (Ref ID)] FAILED, Err <0x%04x>\n",           \
-         cache->node->addr,                                                              \
-         get_mng()->cfg->subnets[0].appkey[cache->iterators[APP_KEY_ITERATOR_INDEX]].id, \
-         err);                                                                           \
+#define FAIL_P(cache, err)         \
+  do {                             \
+    if (CUR_OP(cache)->del) {      \
+      TRC(trc_rmappkey_fail,       \
+          cache->node->addr,       \
+          CUR_OP(cache)->arg,      \
+          err);                    \
+    } else {                       \
+      TRC(trc_addappkey_fail,      \
+          cache->node->addr,       \
+          CUR_OP(cache)->arg,      \
+          err);                    \
+    }                              \
   } while (0)
 
 /* Global Variables *************************************************** */
@@ -46,38 +70,52 @@ static const uint32_t events[] = {
 #define RELATE_EVENTS_NUM() (sizeof(events) / sizeof(uint32_t))
 
 /* Static Functions Declaractions ************************************* */
-static int iter_appkey(config_cache_t *cache);
-
 static int __add_appkey(config_cache_t *cache, mng_t *mng)
 {
   int ret;
-  uint16_t key_id = 0;
-  struct gecko_msg_mesh_config_client_add_appkey_rsp_t *rsp;
+  uint16_t key_id = 0, retval;
+  uint32_t handle;
+  struct gecko_msg_mesh_config_client_add_appkey_rsp_t *arsp;
+  struct gecko_msg_mesh_config_client_remove_appkey_rsp_t *rrsp;
 
-  ret = appkey_by_refid(
-    mng,
-    cache->node->config.bindings->data[cache->iterators[APP_KEY_ITERATOR_INDEX]],
-    &key_id);
+  ret = appkey_by_refid(mng, CUR_OP(cache)->arg, &key_id);
   ASSERT(ret == asr_suc);
 
-  rsp = gecko_cmd_mesh_config_client_add_appkey(
-    mng->cfg->subnets[0].netkey.id,
-    cache->node->addr,
-    key_id,
-    mng->cfg->subnets[0].netkey.id);
+  if (!acc_shape(cache)) {
+    return asr_throttled;
+  }
+  acc_rto_arm(cache);
+  if (CUR_OP(cache)->del) {
+    /* Unbinds it from all the models too */
+    rrsp = gecko_cmd_mesh_config_client_remove_appkey(
+      mng->cfg->subnets[0].netkey.id,
+      cache->node->addr,
+      key_id,
+      mng->cfg->subnets[0].netkey.id);
+    retval = rrsp->result;
+    handle = rrsp->handle;
+  } else {
+    arsp = gecko_cmd_mesh_config_client_add_appkey(
+      mng->cfg->subnets[0].netkey.id,
+      cache->node->addr,
+      key_id,
+      mng->cfg->subnets[0].netkey.id);
+    retval = arsp->result;
+    handle = arsp->handle;
+  }
 
-  if (rsp->result != bg_err_success) {
-    if (rsp->result == bg_err_out_of_memory) {
+  if (retval != bg_err_success) {
+    if (retval == bg_err_out_of_memory) {
       oom_set(cache);
       return asr_oom;
     }
-    FAIL_P(cache, rsp->result);
-    err_set_to_end(cache, rsp->result, bgapi_em);
+    FAIL_P(cache, retval);
+    err_set_to_end(cache, retval, bgapi_em);
     return asr_bgapi;
   } else {
     ONCE_P(cache);
     WAIT_RESPONSE_SET(cache);
-    cache->cc_handle = rsp->handle;
+    cache->cc_handle = handle;
     timer_set(cache, 1);
   }
   return asr_suc;
@@ -85,7 +123,8 @@ static int __add_appkey(config_cache_t *cache, mng_t *mng)
 
 bool addappkey_guard(const config_cache_t *cache)
 {
-  return (cache->node->config.bindings && (cache->node->config.bindings->len != 0));
+  /* With no binding, the app keys might still be removed */
+  return IS_BIT_SET(cache->redo, dg_appkey);
 }
 
 int addappkey_entry(config_cache_t *cache, func_guard guard)
@@ -94,6 +133,11 @@ int addappkey_entry(config_cache_t *cache, func_guard guard)
     LOGW("State[%s] Guard Not Passed\n", state_names[cache->state]);
     return asr_tonext;
   }
+  cache->iterators[PLAN_OP_ITERATOR_INDEX] = 0;
+  if (!CUR_OP(cache)) {
+    /* None of the app keys is in the provisioner config, or to remove */
+    return asr_tonext;
+  }
   return __add_appkey(cache, get_mng());
 }
 
@@ -133,7 +177,7 @@ int addappkey_inprg(const struct gecko_cmd_packet *evt, config_cache_t *cache)
           return asr_suc;
       }
 
-      if (iter_appkey(cache) == 1) {
+      if (acc_plan_next(cache, plan_addappkey) == 1) {
         cache->next_state = -1;
         return asr_suc;
       }
@@ -198,23 +242,6 @@ bool is_addappkey_pkts(uint32_t evtid)
   return 0;
 }
 
-static int iter_appkey(config_cache_t *cache)
-{
-  while (++cache->iterators[APP_KEY_ITERATOR_INDEX] != cache->node->config.bindings->len) {
-    if (asr_suc == appkey_by_refid(
-          get_mng(),
-          cache->node->config.bindings->data[cache->iterators[APP_KEY_ITERATOR_INDEX]],
-          NULL)) {
-      break;
-    }
-  }
-  if (cache->iterators[APP_KEY_ITERATOR_INDEX] == cache->node->config.bindings->len) {
-    cache->iterators[APP_KEY_ITERATOR_INDEX] = 0;
-    return 1;
-  }
-  return 0;
-}
-
 int appkey_by_refid(mng_t *mng,
                     uint16_t refid,
                     uint16_t *id)
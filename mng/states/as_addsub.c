@@ -6,48 +6,73 @@
  ************************************************************************/
 
 /* Includes *********************************************************** */
+#define LOG_MODULE log_mod_dev_config
 #include "projconfig.h"
 #include "dev_config.h"
 #include "utils.h"
 #include "logging.h"
+#include "trace.h"
+#include "acc_plan.h"
+#include "cfg_digest.h"
+#include "acc_rto.h"
 
 /* Defines  *********************************************************** */
-#define ELEMENT_ITERATOR_INDEX  0
-#define MODEL_ITERATOR_INDEX  1
-#define SUB_ADDR_ITERATOR_INDEX  2
+#define CUR_OP(cache) acc_plan_op((cache), plan_addsub)
 
-#define ONCE_P(cache)                                                                \
-  do {                                                                               \
-    LOGV(                                                                            \
-      "Node[0x%04x]:  --- Sub [Element-Model(%d-%04x:%04x) <- 0x%04x]\n",            \
-      cache->node->addr,                                                             \
-      cache->iterators[ELEMENT_ITERATOR_INDEX],                                      \
-      cache->vnm.vd,                                                                 \
-      cache->vnm.md,                                                                 \
-      cache->node->config.sublist->data[cache->iterators[SUB_ADDR_ITERATOR_INDEX]]); \
+#define ONCE_P(cache)              \
+  do {                             \
+    if (CUR_OP(cache)->del) {      \
+      TRC(trc_clrsub,              \
+          cache->node->addr,       \
+          CUR_OP(cache)->elem,     \
+          cache->vnm.vd,           \
+          cache->vnm.md);          \
+    } else {                       \
+      TRC(trc_addsub,              \
+          cache->node->addr,       \
+          CUR_OP(cache)->elem,     \
+          cache->vnm.vd,           \
+          cache->vnm.md,           \
+          CUR_OP(cache)->arg);     \
+    }                              \
   } while (0)
 
-#define SUC_P(cache)                                                                 \
-  do {                                                                               \
-    LOGD(                                                                            \
-      "Node[0x%04x]:  --- Sub [Element-Model(%d-%04x:%04x) <- 0x%04x] SUCCESS\n",    \
-      cache->node->addr,                                                             \
-      cache->iterators[ELEMENT_ITERATOR_INDEX],                                      \
-      cache->vnm.vd,                                                                 \
-      cache->vnm.md,                                                                 \
-      cache->node->config.sublist->data[cache->iterators[SUB_ADDR_ITERATOR_INDEX]]); \
+#define SUC_P(cache)               \
+  do {                             \
+    if (CUR_OP(cache)->del) {      \
+      TRC(trc_clrsub_suc,          \
+          cache->node->addr,       \
+          CUR_OP(cache)->elem,     \
+          cache->vnm.vd,           \
+          cache->vnm.md);          \
+    } else {                       \
+      TRC(trc_addsub_suc,          \
+          cache->node->addr,       \
+          CUR_OP(cache)->elem,     \
+          cache->vnm.vd,           \
+          cache->vnm.md,           \
+          CUR_OP(cache)->arg);     \
+    }                              \
   } while (0)
 
-#define FAIL_P(cache, err)                                                                     \
-  do {                                                                                         \
-    LOGE(                                                                                      \
-      "Node[0x%04x]:  --- Sub [Element-Model(%d-%04x:%04x) <- 0x%04x] FAILED, Err <0x%04x>\n", \
-      cache->node->addr,                                                                       \
-      cache->iterators[ELEMENT_ITERATOR_INDEX],                                                \
-      cache->vnm.vd,                                                                           \
-      cache->vnm.md,                                                                           \
-      cache->node->config.sublist->data[cache->iterators[SUB_ADDR_ITERATOR_INDEX]],            \
-      err);                                                                                    \
+#define FAIL_P(cache, err)         \
+  do {                             \
+    if (CUR_OP(cache)->del) {      \
+      TRC(trc_clrsub_fail,         \
+          cache->node->addr,       \
+          CUR_OP(cache)->elem,     \
+          cache->vnm.vd,           \
+          cache->vnm.md,           \
+          err);                    \
+    } else {                       \
+      TRC(trc_addsub_fail,         \
+          cache->node->addr,       \
+          CUR_OP(cache)->elem,     \
+          cache->vnm.vd,           \
+          cache->vnm.md,           \
+          CUR_OP(cache)->arg,      \
+          err);                    \
+    }                              \
   } while (0)
 
 /* Global Variables *************************************************** */
@@ -60,50 +85,51 @@ static const uint32_t events[] = {
 #define RELATE_EVENTS_NUM() (sizeof(events) / sizeof(uint32_t))
 
 /* Static Functions Declaractions ************************************* */
-static int iter_addsub(config_cache_t *cache);
+static int iter_addsub(config_cache_t *cache, bool model_done);
 
 static int __addsub(config_cache_t *cache, mng_t *mng)
 {
   struct gecko_msg_mesh_config_client_add_model_sub_rsp_t *arsp;
   struct gecko_msg_mesh_config_client_set_model_sub_rsp_t *srsp;
+  struct gecko_msg_mesh_config_client_clear_model_sub_rsp_t *crsp;
+  const acc_op_t *op = CUR_OP(cache);
   uint16_t retval;
   uint32_t handle;
 
-  if (cache->iterators[SUB_ADDR_ITERATOR_INDEX] == 0) {
-    cache->vnm.vd =
-      cache->iterators[MODEL_ITERATOR_INDEX] >= cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].sigm_cnt
-      ? cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].vm[cache->iterators[MODEL_ITERATOR_INDEX] - cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].sigm_cnt].vid
-      : 0xFFFF;
-    cache->vnm.md =
-      cache->iterators[MODEL_ITERATOR_INDEX] >= cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].sigm_cnt
-      ? cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].vm[cache->iterators[MODEL_ITERATOR_INDEX] - cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].sigm_cnt].mid
-      : cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].sig_models[cache->iterators[MODEL_ITERATOR_INDEX]];
-
+  cache->vnm.vd = op->vd;
+  cache->vnm.md = op->md;
+  if (!acc_shape(cache)) {
+    return asr_throttled;
+  }
+  acc_rto_arm(cache);
+  if (op->del) {
+    /* The list is empty now, drop what the last configuration left */
+    crsp = gecko_cmd_mesh_config_client_clear_model_sub(
+      mng->cfg->subnets[0].netkey.id,
+      cache->node->addr,
+      op->elem,
+      cache->vnm.vd,
+      cache->vnm.md);
+    retval = crsp->result;
+    handle = crsp->handle;
+  } else if (op->set) {
     srsp = gecko_cmd_mesh_config_client_set_model_sub(
       mng->cfg->subnets[0].netkey.id,
       cache->node->addr,
-      cache->iterators[ELEMENT_ITERATOR_INDEX],
+      op->elem,
       cache->vnm.vd,
       cache->vnm.md,
-      cache->node->config.sublist->data[cache->iterators[SUB_ADDR_ITERATOR_INDEX]]);
+      op->arg);
     retval = srsp->result;
     handle = srsp->handle;
   } else {
-    cache->vnm.vd =
-      cache->iterators[MODEL_ITERATOR_INDEX] >= cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].sigm_cnt
-      ? cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].vm[cache->iterators[MODEL_ITERATOR_INDEX] - cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].sigm_cnt].vid
-      : 0xFFFF;
-    cache->vnm.md =
-      cache->iterators[MODEL_ITERATOR_INDEX] >= cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].sigm_cnt
-      ? cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].vm[cache->iterators[MODEL_ITERATOR_INDEX] - cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].sigm_cnt].mid
-      : cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].sig_models[cache->iterators[MODEL_ITERATOR_INDEX]];
     arsp = gecko_cmd_mesh_config_client_add_model_sub(
       mng->cfg->subnets[0].netkey.id,
       cache->node->addr,
-      cache->iterators[ELEMENT_ITERATOR_INDEX],
+      op->elem,
       cache->vnm.vd,
       cache->vnm.md,
-      cache->node->config.sublist->data[cache->iterators[SUB_ADDR_ITERATOR_INDEX]]);
+      op->arg);
     retval = arsp->result;
     handle = arsp->handle;
   }
@@ -128,7 +154,8 @@ static int __addsub(config_cache_t *cache, mng_t *mng)
 
 bool addsub_guard(const config_cache_t *cache)
 {
-  return (cache->node->config.sublist && cache->node->config.sublist->len);
+  /* With an empty list, the subscriptions might still be cleared */
+  return IS_BIT_SET(cache->redo, dg_sub);
 }
 
 int addsub_entry(config_cache_t *cache, func_guard guard)
@@ -137,7 +164,10 @@ int addsub_entry(config_cache_t *cache, func_guard guard)
     LOGW("State[%s] Guard Not Passed\n", state_names[cache->state]);
     return asr_tonext;
   }
-
+  cache->iterators[PLAN_OP_ITERATOR_INDEX] = 0;
+  if (!CUR_OP(cache)) {
+    return asr_tonext;
+  }
   return __addsub(cache, get_mng());
 }
 
@@ -178,8 +208,18 @@ int addsub_inprg(const struct gecko_cmd_packet *evt, config_cache_t *cache)
           break;
         case bg_err_mesh_foundation_insufficient_resources:
           LOGW("Node[0x%04x]: Cannot Sub More Address, Passing\n", cache->node->addr);
-          cache->iterators[SUB_ADDR_ITERATOR_INDEX] = cache->node->config.sublist->len - 1;
-          break;
+          if (iter_addsub(cache, true) == 1) {
+            cache->next_state = -1;
+            return asr_suc;
+          }
+          return __addsub(cache, get_mng());
+        case bg_err_mesh_foundation_not_subscribe_model:
+          if (CUR_OP(cache)->del) {
+            /* Nothing to clear */
+            RETRY_CLEAR(cache);
+            break;
+          }
+          /* fall through */
         default:
           FAIL_P(cache,
                  evt->data.evt_mesh_config_client_model_sub_status.result);
@@ -187,7 +227,7 @@ int addsub_inprg(const struct gecko_cmd_packet *evt, config_cache_t *cache)
           return asr_suc;
       }
 
-      if (iter_addsub(cache) == 1) {
+      if (iter_addsub(cache, false) == 1) {
         cache->next_state = -1;
         return asr_suc;
       }
@@ -255,19 +295,16 @@ bool is_addsub_pkts(uint32_t evtid)
   return 0;
 }
 
-static int iter_addsub(config_cache_t *cache)
+/*
+ * Moves to the next subscription, or to the first one of the next model if
+ * the model takes no more
+ */
+static int iter_addsub(config_cache_t *cache, bool model_done)
 {
-  if (++cache->iterators[SUB_ADDR_ITERATOR_INDEX] == cache->node->config.sublist->len) {
-    cache->iterators[SUB_ADDR_ITERATOR_INDEX] = 0;
-    if (++cache->iterators[MODEL_ITERATOR_INDEX]
-        == cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].sigm_cnt
-        + cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].vm_cnt) {
-      cache->iterators[MODEL_ITERATOR_INDEX] = 0;
-      if (++cache->iterators[ELEMENT_ITERATOR_INDEX] == cache->dcd.element_cnt) {
-        cache->iterators[ELEMENT_ITERATOR_INDEX] = 0;
-        return 1;
-      }
+  while (!acc_plan_next(cache, plan_addsub)) {
+    if (!model_done || CUR_OP(cache)->set) {
+      return 0;
     }
   }
-  return 0;
+  return 1;
 }
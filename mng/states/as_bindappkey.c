@@ -6,45 +6,45 @@
  ************************************************************************/
 
 /* Includes *********************************************************** */
+#define LOG_MODULE log_mod_dev_config
 #include "projconfig.h"
 #include "dev_config.h"
 #include "utils.h"
 #include "logging.h"
+#include "trace.h"
+#include "acc_plan.h"
+#include "cfg_digest.h"
+#include "acc_rto.h"
 
 /* Defines  *********************************************************** */
-#define ELEMENT_ITERATOR_INDEX  0
-#define MODEL_ITERATOR_INDEX  1
-#define APP_KEY_ITERATOR_INDEX  2
-
-#define ONCE_P(cache)                                                                    \
-  do {                                                                                   \
-    LOGV("Node[0x%04x]:  --- Bind [refid(%d) <-> %s Model(%04x:%04x)]\n",                \
-         cache->node->addr,                                                              \
-         get_mng()->cfg->subnets[0].appkey[cache->iterators[APP_KEY_ITERATOR_INDEX]].id, \
-         cache->vnm.vd == SIG_VENDOR_ID ? "SIG" : "Vendor",                              \
-         cache->vnm.vd,                                                                  \
-         cache->vnm.md);                                                                 \
+#define CUR_OP(cache) acc_plan_op((cache), plan_bindappkey)
+
+#define ONCE_P(cache)              \
+  do {                             \
+    TRC(trc_bindappkey,            \
+        cache->node->addr,         \
+        CUR_OP(cache)->arg,        \
+        cache->vnm.vd,             \
+        cache->vnm.md);            \
   } while (0)
 
-#define SUC_P(cache, config)                                                             \
-  do {                                                                                   \
-    LOGD("Node[0x%04x]:  --- Bind [refid(%d) <-> %s Model(%04x:%04x)] SUCCESS\n",        \
-         cache->node->addr,                                                              \
-         get_mng()->cfg->subnets[0].appkey[cache->iterators[APP_KEY_ITERATOR_INDEX]].id, \
-         cache->vnm.vd == SIG_VENDOR_ID ? "SIG" : "Vendor",                              \
-         cache->vnm.vd,                                                                  \
-         cache->vnm.md);                                                                 \
+#define SUC_P(cache)               \
+  do {                             \
+    TRC(trc_bindappkey_suc,        \
+        cache->node->addr,         \
+        CUR_OP(cache)->arg,        \
+        cache->vnm.vd,             \
+        cache->vnm.md);            \
   } while (0)
 
-#define FAIL_P(cache, config, err)                                                             \
-  do {                                                                                         \
-    LOGE("Node[0x%04x]:  --- Bind [refid(%d) <-> %s Model(%04x:%04x)] FAILED, Err <0x%04x>\n", \
-         cache->node->addr,                                                                    \
-         get_mng()->cfg->subnets[0].appkey[cache->iterators[APP_KEY_ITERATOR_INDEX]].id,       \
-         cache->vnm.vd == SIG_VENDOR_ID ? "SIG" : "Vendor",                                    \
-         cache->vnm.vd,                                                                        \
-         cache->vnm.md,                                                                        \
-         err);                                                                                 \
+#define FAIL_P(cache, err)         \
+  do {                             \
+    TRC(trc_bindappkey_fail,       \
+        cache->node->addr,         \
+        CUR_OP(cache)->arg,        \
+        cache->vnm.vd,             \
+        cache->vnm.md,             \
+        (err));                    \
   } while (0)
 
 /* Global Variables *************************************************** */
@@ -57,33 +57,27 @@ static const uint32_t events[] = {
 #define RELATE_EVENTS_NUM() (sizeof(events) / sizeof(uint32_t))
 
 /* Static Functions Declaractions ************************************* */
-static int iter_bindings(config_cache_t *cache);
-
 static int __bind_appkey(config_cache_t *cache, mng_t *mng)
 {
   int ret;
   uint16_t key_id = 0;
   struct gecko_msg_mesh_config_client_bind_model_rsp_t *rsp;
+  const acc_op_t *op = CUR_OP(cache);
+
+  cache->vnm.vd = op->vd;
+  cache->vnm.md = op->md;
 
-  cache->vnm.vd =
-    (cache->iterators[MODEL_ITERATOR_INDEX] >= cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].sigm_cnt)
-    ? cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].vm[cache->iterators[MODEL_ITERATOR_INDEX] - cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].sigm_cnt].vid
-    : 0xFFFF;
-  cache->vnm.md =
-    (cache->iterators[MODEL_ITERATOR_INDEX] >= cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].sigm_cnt)
-    ? cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].vm[cache->iterators[MODEL_ITERATOR_INDEX] - cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].sigm_cnt].mid
-    : cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].sig_models[cache->iterators[MODEL_ITERATOR_INDEX]];
-
-  ret = appkey_by_refid(
-    mng,
-    cache->node->config.bindings->data[cache->iterators[APP_KEY_ITERATOR_INDEX]],
-    &key_id);
+  ret = appkey_by_refid(mng, op->arg, &key_id);
   ASSERT(asr_suc == ret);
 
+  if (!acc_shape(cache)) {
+    return asr_throttled;
+  }
+  acc_rto_arm(cache);
   rsp = gecko_cmd_mesh_config_client_bind_model(
     mng->cfg->subnets[0].netkey.id,
     cache->node->addr,
-    cache->iterators[ELEMENT_ITERATOR_INDEX],
+    op->elem,
     key_id,
     cache->vnm.vd,
     cache->vnm.md);
@@ -93,7 +87,7 @@ static int __bind_appkey(config_cache_t *cache, mng_t *mng)
       oom_set(cache);
       return asr_oom;
     }
-    FAIL_P(cache, pconfig, rsp->result);
+    FAIL_P(cache, rsp->result);
     err_set_to_end(cache, rsp->result, bgapi_em);
     return asr_bgapi;
   } else {
@@ -107,7 +101,9 @@ static int __bind_appkey(config_cache_t *cache, mng_t *mng)
 
 bool bindappkey_guard(const config_cache_t *cache)
 {
-  return (cache->node->config.bindings && (cache->node->config.bindings->len != 0));
+  return (IS_BIT_SET(cache->redo, dg_appkey)
+          && cache->node->config.bindings
+          && (cache->node->config.bindings->len != 0));
 }
 
 int bindappkey_entry(config_cache_t *cache, func_guard guard)
@@ -116,6 +112,10 @@ int bindappkey_entry(config_cache_t *cache, func_guard guard)
     LOGM("State[%s] Guard Not Passed\n", state_names[cache->state]);
     return asr_tonext;
   }
+  cache->iterators[PLAN_OP_ITERATOR_INDEX] = 0;
+  if (!CUR_OP(cache)) {
+    return asr_tonext;
+  }
   return __bind_appkey(cache, get_mng());
 }
 
@@ -135,7 +135,7 @@ int bindappkey_inprg(const struct gecko_cmd_packet *evt, config_cache_t *cache)
       switch (evt->data.evt_mesh_config_client_binding_status.result) {
         case bg_err_success:
           RETRY_CLEAR(cache);
-          SUC_P(cache, pconfig);
+          SUC_P(cache);
           break;
         case bg_err_timeout:
           /* bind any remaining_retry case here */
@@ -151,13 +151,12 @@ int bindappkey_inprg(const struct gecko_cmd_packet *evt, config_cache_t *cache)
           break;
         default:
           FAIL_P(cache,
-                 pconfig,
                  evt->data.evt_mesh_config_client_binding_status.result);
           err_set_to_end(cache, bg_err_timeout, bgevent_em);
           return asr_suc;
       }
 
-      if (iter_bindings(cache) == 1) {
+      if (acc_plan_next(cache, plan_bindappkey) == 1) {
         cache->next_state = -1;
         return asr_suc;
       }
@@ -222,30 +221,3 @@ bool is_bindappkey_pkts(uint32_t evtid)
   }
   return 0;
 }
-
-static int iter_bindings(config_cache_t *cache)
-{
-  while (++cache->iterators[APP_KEY_ITERATOR_INDEX] != cache->node->config.bindings->len) {
-    if (asr_suc == appkey_by_refid(
-          get_mng(),
-          cache->node->config.bindings->data[cache->iterators[APP_KEY_ITERATOR_INDEX]],
-          NULL)) {
-      break;
-    }
-  }
-
-  if (cache->iterators[APP_KEY_ITERATOR_INDEX] == cache->node->config.bindings->len) {
-    cache->iterators[APP_KEY_ITERATOR_INDEX] = 0;
-    if (++cache->iterators[MODEL_ITERATOR_INDEX]
-        == cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].sigm_cnt
-        + cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].vm_cnt) {
-      cache->iterators[MODEL_ITERATOR_INDEX] = 0;
-      if (++cache->iterators[ELEMENT_ITERATOR_INDEX] == cache->dcd.element_cnt) {
-        cache->iterators[ELEMENT_ITERATOR_INDEX] = 0;
-        /* All bind appkey is done */
-        return 1;
-      }
-    }
-  }
-  return 0;
-}
@@ -6,11 +6,14 @@
  ************************************************************************/
 
 /* Includes *********************************************************** */
+#define LOG_MODULE log_mod_dev_config
 #include "dev_config.h"
 #include "logging.h"
 #include "generic_parser.h"
 #include "cli.h"
 #include "stat.h"
+#include "cfg_digest.h"
+#include "rpc.h"
 
 #define ON_END_DEBUG
 #ifdef ON_END_DEBUG
@@ -45,6 +48,8 @@ static void __on_success(config_cache_t *cache)
   bt_shell_printf("Node[0x%04x] **Configured**\n", cache->node->addr);
   nodeset_errbits(cache->node->addr, 0);
   nodeset_done(cache->node->addr, 0x1);
+  cfg_digest_applied(cache->node);
+  rpc_notify_node(rpc_evt_configured, cache->node->uuid, cache->node->addr, 0);
 
 #ifdef ON_END_DEBUG
   send_onoff(0xc030, 1);
@@ -75,4 +80,6 @@ static void __on_failed(config_cache_t *cache)
   }
   err = (cache->err_cache.bgevt | cache->err_cache.bgcall) & 0x7FFFFFFF;
   nodeset_errbits(cache->node->addr, err);
+  rpc_notify_node(rpc_evt_config_failed, cache->node->uuid, cache->node->addr,
+                  err);
 }
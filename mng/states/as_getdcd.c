@@ -6,40 +6,34 @@
  ************************************************************************/
 
 /* Includes *********************************************************** */
+#define LOG_MODULE log_mod_dev_config
 #include "projconfig.h"
 #include "dev_config.h"
 #include "utils.h"
 #include "logging.h"
+#include "trace.h"
 #include "generic_parser.h"
+#include "dcd_cache.h"
+#include "acc_plan.h"
+#include "acc_sched.h"
+#include "acc_rto.h"
 
 /* Defines  *********************************************************** */
-#define GENERIC_ONOFF_SERVER_MDID       0x1000
-#define GENERIC_ONOFF_CLIENT_MDID       0x1001
-
-#define LIGHT_LIGHTNESS_SERVER_MDID     0x1300
-#define LIGHT_CTL_SERVER_MDID     0x1303
-#define SENSOR_SERVER_MDID  0x1100
-
-#define CONFIGURATION_SERVER_MDID       0x0000
-#define CONFIGURATION_CLIENT_MDID       0x0001
-#define HEALTH_SERVER_MDID              0x0002
-#define HEALTH_CLIENT_MDID              0x0003
-
-#define ONCE_P(cache)                                        \
-  do {                                                       \
-    LOGV("Node[0x%04x]:  --- Get DCD\n", cache->node->addr); \
+#define ONCE_P(cache)                       \
+  do {                                      \
+    TRC(trc_getdcd, cache->node->addr);     \
   } while (0)
 
-#define SUC_P(cache)                                                 \
-  do {                                                               \
-    LOGD("Node[0x%04x]:  --- Get DCD SUCCESS\n", cache->node->addr); \
+#define SUC_P(cache)                        \
+  do {                                      \
+    TRC(trc_getdcd_suc, cache->node->addr); \
   } while (0)
 
-#define FAIL_P(cache, err)                                    \
-  do {                                                        \
-    LOGE("Node[0x%04x]:  --- Get DCD Failed, Err <0x%04x>\n", \
-         cache->node->addr,                                   \
-         err);                                                \
+#define FAIL_P(cache, err) \
+  do {                     \
+    TRC(trc_getdcd_fail,   \
+        cache->node->addr, \
+        err);              \
   } while (0)
 
 /* Global Variables *************************************************** */
@@ -53,14 +47,26 @@ static const uint32_t events[] = {
 #define RELATE_EVENTS_NUM() (sizeof(events) / sizeof(uint32_t))
 
 /* Static Functions Declaractions ************************************* */
-static void __dcd_store(const uint8_t *data,
-                        uint8_t len,
-                        config_cache_t *cache);
+/* The plan of the node is compiled along, NULL if out of memory */
+static const acc_plan_t *__dcd_set(config_cache_t *cache, const dcd_t *dcd)
+{
+  cache->dcd = dcd;
+  cache->node->models.func |= dcd->func;
+  nodeset_func(cache->node->addr, cache->node->models.func);
+  /* The slot is counted as a fast one from now on if it's not an LPN */
+  cache->cls = acc_sched_class(cache->node, dcd);
+  cache->plan = acc_plan_get(cache->node, dcd);
+  return cache->plan;
+}
 
 static int __dcd_get(config_cache_t *cache, mng_t *mng)
 {
   struct gecko_msg_mesh_config_client_get_dcd_rsp_t *rsp;
 
+  if (!acc_shape(cache)) {
+    return asr_throttled;
+  }
+  acc_rto_arm(cache);
   rsp = gecko_cmd_mesh_config_client_get_dcd(mng->cfg->subnets[0].netkey.id,
                                              cache->node->addr,
                                              0);
@@ -90,11 +96,27 @@ bool getdcd_guard(const config_cache_t *cache)
 
 int getdcd_entry(config_cache_t *cache, func_guard guard)
 {
+  const dcd_t *dcd;
+
   /* Alarm SHOULD be set in the main engine */
   if (guard && !guard(cache)) {
     LOGW("State[%s] Guard Not Passed\n", state_names[cache->state]);
     return asr_tonext;
   }
+  /*
+   * The template is known to be used by one device type, skip asking the
+   * node. The states after are all loaded then, which is harmless even if the
+   * node failed in one of them last time.
+   */
+  if (NULL != (dcd = dcd_cache_lookup(cache->node))) {
+    LOGV("Node[0x%04x]: DCD Got from the Cache\n", cache->node->addr);
+    if (!__dcd_set(cache, dcd)) {
+      FAIL_P(cache, bg_err_out_of_memory);
+      err_set_to_end(cache, bg_err_out_of_memory, bgevent_em);
+      return asr_unspec;
+    }
+    return asr_tonext;
+  }
   return __dcd_get(cache, get_mng());
 }
 
@@ -108,10 +130,13 @@ int getdcd_inprg(const struct gecko_cmd_packet *evt, config_cache_t *cache)
     case gecko_evt_mesh_config_client_dcd_data_id:
       /* Ignore pages other than 0 for now */
       if (evt->data.evt_mesh_config_client_dcd_data.page == 0) {
+        const dcd_t *dcd;
         LOGV("Node[0x%04x]: DCD Page 0 Received\n", cache->node->addr);
-        __dcd_store(evt->data.evt_mesh_config_client_dcd_data.data.data,
-                    evt->data.evt_mesh_config_client_dcd_data.data.len,
-                    cache);
+        dcd = dcd_cache_add(evt->data.evt_mesh_config_client_dcd_data.data.data,
+                            evt->data.evt_mesh_config_client_dcd_data.data.len);
+        if (dcd) {
+          __dcd_set(cache, dcd);
+        }
       }
       break;
 
@@ -121,7 +146,19 @@ int getdcd_inprg(const struct gecko_cmd_packet *evt, config_cache_t *cache)
       switch (evt->data.evt_mesh_config_client_dcd_data_end.result) {
         case bg_err_success:
           RETRY_CLEAR(cache);
+          if (!cache->dcd) {
+            /* Page 0 is missing or malformed, nothing to configure with */
+            FAIL_P(cache, bg_err_mesh_no_data_available);
+            err_set_to_end(cache, bg_err_mesh_no_data_available, bgevent_em);
+            break;
+          }
+          if (!cache->plan) {
+            FAIL_P(cache, bg_err_out_of_memory);
+            err_set_to_end(cache, bg_err_out_of_memory, bgevent_em);
+            break;
+          }
           SUC_P(cache);
+          dcd_cache_learn(cache->node, cache->dcd);
           if (cache->node->err > ERROR_BIT(get_dcd_em)
               && cache->node->err < ERROR_BIT(end_em)) {
             for (int a = addappkey_em; a < end_em; a++) {
@@ -213,88 +250,3 @@ bool is_getdcd_pkts(uint32_t evtid)
   }
   return 0;
 }
-
-static void __dcd_store(const uint8_t *data,
-                        uint8_t len,
-                        config_cache_t *cache)
-{
-  uint8_t i = 0, eles = 0, sigm_cnt = 0, vm_cnt = 0;
-  dcd_t *dcd = &cache->dcd;
-  i = 12;
-  sigm_cnt = data[i];
-  vm_cnt = data[i + 1];
-  i += 2;
-  do {
-    i += sizeof(uint16_t) * sigm_cnt;
-    i += sizeof(uint16_t) * vm_cnt * 2;
-    eles++;
-  } while (i < len);
-
-  dcd->element_cnt = eles;
-
-  i = 8;
-  dcd->feature = BUILD_UINT16(data[i], data[i + 1]);
-  i += 2;
-  if (dcd->elems) {
-    free(dcd->elems);
-  }
-  dcd->elems = (elem_t *)calloc(dcd->element_cnt, sizeof(elem_t));
-  i += 2;   /* skip loc */
-  for (uint8_t e = 0; e < dcd->element_cnt; e++) {
-    if (e) {
-      i += 2;   /* skip loc */
-    }
-    dcd->elems[e].sigm_cnt = data[i++];
-    dcd->elems[e].vm_cnt = data[i++];
-    if (dcd->elems[e].sigm_cnt) {
-      if (dcd->elems[e].sig_models) {
-        free(dcd->elems[e].sig_models);
-      }
-      dcd->elems[e].sig_models = (uint16_t *)calloc(dcd->elems[e].sigm_cnt,
-                                                    sizeof(uint16_t));
-      uint8_t offset = 0;
-      for (uint8_t ms = 0; ms < dcd->elems[e].sigm_cnt; ms++) {
-        uint16_t mdid = BUILD_UINT16(data[i], data[i + 1]);
-        if (mdid == GENERIC_ONOFF_SERVER_MDID) {
-          cache->node->models.func |= ONOFF_SV_BIT;
-        } else if (mdid == LIGHT_LIGHTNESS_SERVER_MDID) {
-          cache->node->models.func |= LIGHTNESS_SV_BIT;
-        } else if (mdid == LIGHT_CTL_SERVER_MDID) {
-          cache->node->models.func |= CTL_SV_BIT;
-        } else if (mdid == SENSOR_SERVER_MDID) {
-          cache->node->models.func |= SENSOR_SV_BIT;
-        }
-#if 0
-        if (mdid == GENERIC_ONOFF_CLIENT_MDID) {
-          CS_LOG("-|||>>>OnOff Client Node (Switch)<<<|||-\n");
-        } else if (mdid == GENERIC_ONOFF_SERVER_MDID) {
-          CS_LOG("-|||>>>OnOff Server Node (Light)<<<|||-\n");
-        }
-#endif
-        i += 2;
-        if (mdid == CONFIGURATION_CLIENT_MDID
-            || mdid == CONFIGURATION_SERVER_MDID) {
-          offset++;
-          continue;
-        }
-        dcd->elems[e].sig_models[ms - offset] = mdid;
-      }
-      dcd->elems[e].sigm_cnt -= offset;
-    }
-    nodeset_func(cache->node->addr, cache->node->models.func);
-
-    if (dcd->elems[e].vm_cnt) {
-      if (dcd->elems[e].vm) {
-        free(dcd->elems[e].vm);
-      }
-      dcd->elems[e].vm = (vendor_model_t *)calloc(dcd->elems[e].vm_cnt,
-                                                  sizeof(vendor_model_t));
-      for (uint8_t ms = 0; ms < dcd->elems[e].vm_cnt; ms++) {
-        dcd->elems[e].vm[ms].vid = BUILD_UINT16(data[i], data[i + 1]);
-        i += 2;
-        dcd->elems[e].vm[ms].mid = BUILD_UINT16(data[i], data[i + 1]);
-        i += 2;
-      }
-    }
-  }
-}
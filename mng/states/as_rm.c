@@ -6,29 +6,32 @@
  ************************************************************************/
 
 /* Includes *********************************************************** */
+#define LOG_MODULE log_mod_dev_config
 #include "projconfig.h"
 #include "dev_config.h"
 #include "utils.h"
 #include "logging.h"
+#include "trace.h"
+#include "acc_rto.h"
 
 /* Defines  *********************************************************** */
-#define ONCE_P(cache)               \
-  do {                              \
-    LOGV("Node[0x%04x]:  --- RM\n", \
-         cache->node->addr);        \
+#define ONCE_P(cache)       \
+  do {                      \
+    TRC(trc_rm,             \
+        cache->node->addr); \
   } while (0)
 
-#define SUC_P(cache)                     \
-  do {                                   \
-    LOGD("Node[0x%04x]:  --- SUCCESS\n", \
-         cache->node->addr);             \
+#define SUC_P(cache)        \
+  do {                      \
+    TRC(trc_rm_suc,         \
+        cache->node->addr); \
   } while (0)
 
-#define FAIL_P(cache, err)                               \
-  do {                                                   \
-    LOGE("Node[0x%04x]:  --- RM FAILED, Err <0x%04x>\n", \
-         cache->node->addr,                              \
-         err);                                           \
+#define FAIL_P(cache, err) \
+  do {                     \
+    TRC(trc_rm_fail,       \
+        cache->node->addr, \
+        err);              \
   } while (0)
 
 /* Global Variables *************************************************** */
@@ -46,6 +49,10 @@ static int __rm(config_cache_t *cache, mng_t *mng)
   struct gecko_msg_mesh_config_client_reset_node_rsp_t *rsp;
 
   /* First one, should set */
+  if (!acc_shape(cache)) {
+    return asr_throttled;
+  }
+  acc_rto_arm(cache);
   rsp = gecko_cmd_mesh_config_client_reset_node(
     mng->cfg->subnets[0].netkey.id,
     cache->node->addr);
@@ -6,6 +6,7 @@
  ************************************************************************/
 
 /* Includes *********************************************************** */
+#define LOG_MODULE log_mod_dev_config
 #include "host_gecko.h"
 #include "projconfig.h"
 #include "dev_config.h"
@@ -15,6 +16,8 @@
 #include "gecko_bglib.h"
 #include "cli.h"
 #include "stat.h"
+#include "ddb_cache.h"
+#include "rpc.h"
 /* Defines  *********************************************************** */
 
 /* Global Variables *************************************************** */
@@ -48,10 +51,14 @@ static void __on_success(config_cache_t *cache)
   nodeset_errbits(cache->node->addr, 0);
   nodeset_done(cache->node->addr, 0);
   nodeset_func(cache->node->addr, 0);
+  rpc_notify_node(rpc_evt_removed, cache->node->uuid, cache->node->addr, 0);
   nodes_rm(cache->node->addr);
   ret = gecko_cmd_mesh_prov_ddb_delete(*(uuid_128 *)cache->node->uuid)->result;
   if (bg_err_success != ret) {
     LOGBGE("ddb delete", ret);
+    ddb_cache_invalidate();
+  } else {
+    ddb_cache_del(cache->node->uuid);
   }
 }
 
@@ -6,52 +6,25 @@
  ************************************************************************/
 
 /* Includes *********************************************************** */
+#define LOG_MODULE log_mod_dev_config
 #include "projconfig.h"
 #include "dev_config.h"
 #include "utils.h"
 #include "logging.h"
+#include "trace.h"
+#include "cfg_digest.h"
+#include "acc_rto.h"
 /* Defines  *********************************************************** */
-#define SET_TTL_MSG \
-  "Node[0x%04x]:  --- Set [TTL(%d)]\n"
-#define SET_TTL_SUC_MSG \
-  "Node[0x%04x]:  --- Set [TTL(%d)] SUCCESS\n"
-#define SET_TTL_FAIL_MSG \
-  "Node[0x%04x]:  --- Set [TTL(%d)] FAILED, Err <0x%04x>\n"
-
-#define SET_FRIEND_MSG \
-  "Node[0x%04x]:  --- Set [Friend(%s)]\n"
-#define SET_FRIEND_SUC_MSG \
-  "Node[0x%04x]:  --- Set [Friend(%s)] SUCCESS\n"
-#define SET_FRIEND_FAIL_MSG \
-  "Node[0x%04x]:  --- Set [Friend(%s)] FAILED, Err <0x%04x>\n"
-
-#define SET_RELAY_MSG \
-  "Node[0x%04x]:  --- Set [Relay(%s)]\n"
-#define SET_RELAY_SUC_MSG \
-  "Node[0x%04x]:  --- Set [Relay(%s)] SUCCESS\n"
-#define SET_RELAY_FAIL_MSG \
-  "Node[0x%04x]:  --- Set [Relay(%s)] FAILED, Err <0x%04x>\n"
-
-#define SET_PROXY_MSG \
-  "Node[0x%04x]:  --- Set [Proxy(%s)]\n"
-#define SET_PROXY_SUC_MSG \
-  "Node[0x%04x]:  --- Set [Proxy(%s)] SUCCESS\n"
-#define SET_PROXY_FAIL_MSG \
-  "Node[0x%04x]:  --- Set [Proxy(%s)] FAILED, Err <0x%04x>\n"
-
-#define SET_NETTX_MSG \
-  "Node[0x%04x]:  --- Set [nettx:count-interval(%d-%dms)]\n"
-#define SET_NETTX_SUC_MSG \
-  "Node[0x%04x]:  --- Set [nettx:count-interval(%d-%dms)] SUCCESS\n"
-#define SET_NETTX_FAIL_MSG \
-  "Node[0x%04x]:  --- Set [nettx:count-interval(%d-%dms)] FAILED, Err <0x%04x>\n"
-
-#define SET_SNB_MSG \
-  "Node[0x%04x]:  --- Set [SNB(%s)]\n"
-#define SET_SNB_SUC_MSG \
-  "Node[0x%04x]:  --- Set [SNB(%s)] SUCCESS\n"
-#define SET_SNB_FAIL_MSG \
-  "Node[0x%04x]:  --- Set [SNB(%s)] FAILED, Err <0x%04x>\n"
+#define TRC_SET(pt, process, err, ...)    \
+  do {                                    \
+    if ((process) == once_em) {           \
+      TRC(pt, __VA_ARGS__);               \
+    } else if ((process) == success_em) { \
+      TRC(pt##_suc, __VA_ARGS__);         \
+    } else if ((process) == failed_em) {  \
+      TRC(pt##_fail, __VA_ARGS__, (err)); \
+    }                                     \
+  } while (0)
 
 #define ELEMENT_ITERATOR_INDEX  0
 #define MODEL_ITERATOR_INDEX  1
@@ -122,6 +95,12 @@ static int __setconfig(config_cache_t *cache, mng_t *mng)
   int which;
 
   which = __next_config_item(cache);
+  if (which != -1) {
+    if (!acc_shape(cache)) {
+      return asr_throttled;
+    }
+    acc_rto_arm(cache);
+  }
 
   switch (which) {
     case RELAY_BITOFS:
@@ -200,7 +179,9 @@ static int __setconfig(config_cache_t *cache, mng_t *mng)
 
 bool setconfig_guard(const config_cache_t *cache)
 {
-  return cache->node->config.features.current ^ cache->node->config.features.target;
+  return IS_BIT_SET(cache->redo, dg_config)
+         && (cache->node->config.features.current
+             ^ cache->node->config.features.target);
 }
 
 int setconfig_entry(config_cache_t *cache, func_guard guard)
@@ -375,141 +356,32 @@ static void set_configs_print_state(int which,
                                     config_cache_t *cache,
                                     uint16_t err)
 {
+  uint16_t addr = cache->node->addr;
+  int on = IS_BIT_SET(cache->node->config.features.target, which) ? 1 : 0;
+
   switch (which) {
     case RELAY_BITOFS:
-      switch (process) {
-        case once_em:
-          LOGV(SET_RELAY_MSG,
-               cache->node->addr,
-               IS_BIT_SET(cache->node->config.features.target, RELAY_BITOFS) ? "ON" : "OFF");
-          break;
-        case success_em:
-          LOGD(SET_RELAY_SUC_MSG,
-               cache->node->addr,
-               IS_BIT_SET(cache->node->config.features.target, RELAY_BITOFS) ? "ON" : "OFF");
-          break;
-        case failed_em:
-          LOGE(SET_RELAY_FAIL_MSG,
-               cache->node->addr,
-               IS_BIT_SET(cache->node->config.features.target, RELAY_BITOFS) ? "ON" : "OFF",
-               err);
-          break;
-        default:
-          return;
-      }
+      TRC_SET(trc_setrelay, process, err, addr, on);
       break;
     case PROXY_BITOFS:
-      switch (process) {
-        case once_em:
-          LOGV(SET_PROXY_MSG,
-               cache->node->addr,
-               IS_BIT_SET(cache->node->config.features.target, PROXY_BITOFS) ? "ON" : "OFF");
-          break;
-        case success_em:
-          LOGD(SET_PROXY_SUC_MSG,
-               cache->node->addr,
-               IS_BIT_SET(cache->node->config.features.target, PROXY_BITOFS) ? "ON" : "OFF");
-          break;
-        case failed_em:
-          LOGE(SET_PROXY_FAIL_MSG,
-               cache->node->addr,
-               IS_BIT_SET(cache->node->config.features.target, PROXY_BITOFS) ? "ON" : "OFF",
-               err);
-          break;
-        default:
-          return;
-      }
+      TRC_SET(trc_setproxy, process, err, addr, on);
       break;
     case FRIEND_BITOFS:
-      switch (process) {
-        case once_em:
-          LOGV(SET_FRIEND_MSG,
-               cache->node->addr,
-               IS_BIT_SET(cache->node->config.features.target, FRIEND_BITOFS) ? "ON" : "OFF");
-          break;
-        case success_em:
-          LOGD(SET_FRIEND_SUC_MSG,
-               cache->node->addr,
-               IS_BIT_SET(cache->node->config.features.target, FRIEND_BITOFS) ? "ON" : "OFF");
-          break;
-        case failed_em:
-          LOGE(SET_FRIEND_FAIL_MSG,
-               cache->node->addr,
-               IS_BIT_SET(cache->node->config.features.target, FRIEND_BITOFS) ? "ON" : "OFF",
-               err);
-          break;
-        default:
-          return;
-      }
+      TRC_SET(trc_setfriend, process, err, addr, on);
       break;
     case TTL_BITOFS:
-      switch (process) {
-        case once_em:
-          LOGV(SET_TTL_MSG,
-               cache->node->addr,
-               *cache->node->config.ttl);
-          break;
-        case success_em:
-          LOGD(SET_TTL_SUC_MSG,
-               cache->node->addr,
-               *cache->node->config.ttl);
-          break;
-        case failed_em:
-          LOGE(SET_TTL_FAIL_MSG,
-               cache->node->addr,
-               *cache->node->config.ttl,
-               err);
-          break;
-        default:
-          return;
-      }
+      TRC_SET(trc_setttl, process, err, addr, *cache->node->config.ttl);
       break;
     case NETTX_BITOFS:
-      switch (process) {
-        case once_em:
-          LOGV(SET_NETTX_MSG,
-               cache->node->addr,
-               cache->node->config.net_txp->cnt,
-               cache->node->config.net_txp->intv);
-          break;
-        case success_em:
-          LOGD(SET_NETTX_SUC_MSG,
-               cache->node->addr,
-               cache->node->config.net_txp->cnt,
-               cache->node->config.net_txp->intv);
-          break;
-        case failed_em:
-          LOGE(SET_NETTX_FAIL_MSG,
-               cache->node->addr,
-               cache->node->config.net_txp->cnt,
-               cache->node->config.net_txp->intv,
-               err);
-          break;
-        default:
-          return;
-      }
+      TRC_SET(trc_setnettx,
+              process,
+              err,
+              addr,
+              cache->node->config.net_txp->cnt,
+              cache->node->config.net_txp->intv);
       break;
     case SNB_BITOFS:
-      switch (process) {
-        case once_em:
-          LOGV(SET_SNB_MSG,
-               cache->node->addr,
-               IS_BIT_SET(cache->node->config.features.target, SNB_BITOFS) ? "ON" : "OFF");
-          break;
-        case success_em:
-          LOGD(SET_SNB_SUC_MSG,
-               cache->node->addr,
-               IS_BIT_SET(cache->node->config.features.target, SNB_BITOFS) ? "ON" : "OFF");
-          break;
-        case failed_em:
-          LOGE(SET_SNB_FAIL_MSG,
-               cache->node->addr,
-               IS_BIT_SET(cache->node->config.features.target, SNB_BITOFS) ? "ON" : "OFF",
-               err);
-          break;
-        default:
-          return;
-      }
+      TRC_SET(trc_setsnb, process, err, addr, on);
       break;
     default:
       return;
@@ -6,55 +6,52 @@
  ************************************************************************/
 
 /* Includes *********************************************************** */
+#define LOG_MODULE log_mod_dev_config
 #include "projconfig.h"
 #include "dev_config.h"
 #include "utils.h"
 #include "logging.h"
+#include "trace.h"
+#include "acc_plan.h"
+#include "cfg_digest.h"
+#include "acc_rto.h"
 
 /* Defines  *********************************************************** */
-#define SET_PUB_MSG \
-  "Node[0x%04x]:  --- Pub [Element-Model(%d-%04x:%04x) -> 0x%04x]\n"
-#define SET_PUB_SUC_MSG \
-  "Node[0x%04x]:  --- Pub [Element-Model(%d-%04x:%04x) -> 0x%04x] SUCCESS\n"
-#define SET_PUB_FAIL_MSG \
-  "Node[0x%04x]:  --- Pub [Element-Model(%d-%04x:%04x) -> 0x%04x] FAILED, Err <0x%04x>\n"
-
-#define ELEMENT_ITERATOR_INDEX  0
-#define MODEL_ITERATOR_INDEX  1
+#define CUR_OP(cache) acc_plan_op((cache), plan_setpub)
 /* Global Variables *************************************************** */
 
 /* Static Variables *************************************************** */
 
 /* Static Functions Declaractions ************************************* */
-#define ONCE_P(cache)                              \
-  do {                                             \
-    LOGV(SET_PUB_MSG,                              \
-         cache->node->addr,                        \
-         cache->iterators[ELEMENT_ITERATOR_INDEX], \
-         cache->vnm.vd,                            \
-         cache->vnm.md,                            \
-         cache->node->config.pub->addr);           \
+#define ONCE_P(cache)                             \
+  do {                                            \
+    TRC(trc_setpub,                               \
+        cache->node->addr,                        \
+        CUR_OP(cache)->elem,                      \
+        cache->vnm.vd,                            \
+        cache->vnm.md,                            \
+        cache->node->config.pub->addr);           \
   } while (0)
 
-#define SUC_P(cache)                               \
-  do {                                             \
-    LOGD(SET_PUB_SUC_MSG,                          \
-         cache->node->addr,                        \
-         cache->iterators[ELEMENT_ITERATOR_INDEX], \
-         cache->vnm.vd,                            \
-         cache->vnm.md,                            \
-         cache->node->config.pub->addr);           \
+#define SUC_P(cache)                              \
+  do {                                            \
+    TRC(trc_setpub_suc,                           \
+        cache->node->addr,                        \
+        CUR_OP(cache)->elem,                      \
+        cache->vnm.vd,                            \
+        cache->vnm.md,                            \
+        cache->node->config.pub->addr);           \
   } while (0)
 
-#define FAIL_P(cache, err)                         \
-  do {                                             \
-    LOGE(SET_PUB_FAIL_MSG,                         \
-         cache->node->addr,                        \
-         cache->iterators[ELEMENT_ITERATOR_INDEX], \
-         cache->vnm.vd,                            \
-         cache->vnm.md,                            \
-         cache->node->config.pub->addr,            \
-         err);                                     \
+#define FAIL_P(cache, err)                        \
+  do {                                            \
+    TRC(trc_setpub_fail,                          \
+        cache->node->addr,                        \
+        CUR_OP(cache)->elem,                      \
+        cache->vnm.vd,                            \
+        cache->vnm.md,                            \
+        cache->node->config.pub->addr,            \
+        err);                                     \
   } while (0)
 
 /* Global Variables *************************************************** */
@@ -64,43 +61,32 @@ static const uint32_t events[] = {
   gecko_evt_mesh_config_client_model_pub_status_id
 };
 
-static const uint16_t not_pub_models[] = {
-  0x1301,
-  0x1007,
-  0x1304,
-  0x1204
-};
-
 #define RELATE_EVENTS_NUM() (sizeof(events) / sizeof(uint32_t))
-#define NSPT_PUB_MODEL_NUM() (sizeof(not_pub_models) / sizeof(uint16_t))
 /* Static Variables *************************************************** */
 
 /* Static Functions Declaractions ************************************* */
-static int iter_setpub(config_cache_t *cache);
-
 static int __setpub(config_cache_t *cache, mng_t *mng)
 {
   int ret;
   uint16_t key_id = 0;
   struct gecko_msg_mesh_config_client_set_model_pub_rsp_t *rsp;
+  const acc_op_t *op = CUR_OP(cache);
 
-  cache->vnm.vd =
-    cache->iterators[MODEL_ITERATOR_INDEX] >= cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].sigm_cnt
-    ? cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].vm[cache->iterators[MODEL_ITERATOR_INDEX] - cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].sigm_cnt].vid
-    : 0xFFFF;
-  cache->vnm.md =
-    cache->iterators[MODEL_ITERATOR_INDEX] >= cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].sigm_cnt
-    ? cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].vm[cache->iterators[MODEL_ITERATOR_INDEX] - cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].sigm_cnt].mid
-    : cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].sig_models[cache->iterators[MODEL_ITERATOR_INDEX]];
+  cache->vnm.vd = op->vd;
+  cache->vnm.md = op->md;
   ret = appkey_by_refid(mng,
                         cache->node->config.pub->aki,
                         &key_id);
   ASSERT(ret == asr_suc);
 
+  if (!acc_shape(cache)) {
+    return asr_throttled;
+  }
+  acc_rto_arm(cache);
   rsp = gecko_cmd_mesh_config_client_set_model_pub(
     mng->cfg->subnets[0].netkey.id,
     cache->node->addr,
-    cache->iterators[ELEMENT_ITERATOR_INDEX],
+    op->elem,
     cache->vnm.vd,
     cache->vnm.md,
     cache->node->config.pub->addr,
@@ -131,7 +117,8 @@ static int __setpub(config_cache_t *cache, mng_t *mng)
 
 bool setpub_guard(const config_cache_t *cache)
 {
-  if (!cache->node->config.pub
+  if (!IS_BIT_SET(cache->redo, dg_pub)
+      || !cache->node->config.pub
       || !cache->node->config.bindings
       || !cache->node->config.bindings->len) {
     return false;
@@ -150,7 +137,11 @@ int setpub_entry(config_cache_t *cache, func_guard guard)
     LOGW("State[%s] Guard Not Passed\n", state_names[cache->state]);
     return asr_tonext;
   }
-
+  cache->iterators[PLAN_OP_ITERATOR_INDEX] = 0;
+  if (!CUR_OP(cache)) {
+    /* None of the models publishes */
+    return asr_tonext;
+  }
   return __setpub(cache, get_mng());
 }
 
@@ -195,7 +186,7 @@ int setpub_inprg(const struct gecko_cmd_packet *evt, config_cache_t *cache)
           return asr_suc;
       }
 
-      if (iter_setpub(cache) == 1) {
+      if (acc_plan_next(cache, plan_setpub) == 1) {
         cache->next_state = -1;
         return asr_suc;
       }
@@ -261,46 +252,3 @@ bool is_setpub_pkts(uint32_t evtid)
   }
   return 0;
 }
-
-static inline bool __pub_supported(uint16_t md)
-{
-  for (int i = 0; i < NSPT_PUB_MODEL_NUM(); i++) {
-    if (not_pub_models[i] == md) {
-      return false;
-    }
-  }
-  return true;
-}
-
-static int iter_setpub(config_cache_t *cache)
-{
-  int md, increment = 0;
-
-  do {
-    if (++cache->iterators[MODEL_ITERATOR_INDEX]
-        == cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].sigm_cnt
-        + cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].vm_cnt) {
-      cache->iterators[MODEL_ITERATOR_INDEX] = 0;
-      increment = 0;
-      break;
-    } else {
-      md =
-        cache->iterators[MODEL_ITERATOR_INDEX] >= cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].sigm_cnt
-        ? cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].vm[cache->iterators[MODEL_ITERATOR_INDEX] - cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].sigm_cnt].mid
-        : cache->dcd.elems[cache->iterators[ELEMENT_ITERATOR_INDEX]].sig_models[cache->iterators[MODEL_ITERATOR_INDEX]];
-
-      if (__pub_supported(md)) {
-        increment = 1;
-        break;
-      }
-    }
-  } while (1);
-
-  if (!increment) {
-    if (++cache->iterators[ELEMENT_ITERATOR_INDEX] == cache->dcd.element_cnt) {
-      cache->iterators[ELEMENT_ITERATOR_INDEX] = 0;
-      return 1;
-    }
-  }
-  return 0;
-}
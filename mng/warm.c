@@ -0,0 +1,169 @@
+/*************************************************************************
+    > File Name: warm.c
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Validation of the running NCP target for the warm restart.
+    The NCP target kept running is only taken over if it holds the same
+    network, keys and devices as the config, otherwise it's reset and set up
+    from the config as on a cold start. The DDB is compared with the nodes of
+    the config by a digest over the UUIDs and addresses.
+ ************************************************************************/
+
+/* Includes *********************************************************** */
+#define LOG_MODULE log_mod_mng
+#include <stdlib.h>
+#include <string.h>
+
+#include "projconfig.h"
+#include "warm.h"
+#include "ddb_cache.h"
+#include "cfg.h"
+#include "generic_parser.h"
+#include "gecko_bglib.h"
+#include "logging.h"
+#include "utils.h"
+
+/* Defines  *********************************************************** */
+#define KEY_TYPE_NET  0
+#define KEY_TYPE_APP  1
+
+/* Global Variables *************************************************** */
+
+/* Static Variables *************************************************** */
+
+/* Static Functions Declaractions ************************************* */
+/*
+ * Find the key in the NCP target, the network index is only checked for the
+ * appkeys.
+ */
+static bool key_found(int type, const meshkey_t *key, uint16_t netkey_id)
+{
+  struct gecko_msg_mesh_test_get_key_count_rsp_t *crsp;
+  struct gecko_msg_mesh_test_get_key_rsp_t *krsp;
+  uint32_t cnt;
+
+  crsp = gecko_cmd_mesh_test_get_key_count(type);
+  if (crsp->result != bg_err_success) {
+    LOGBGE("get key count", crsp->result);
+    return false;
+  }
+  cnt = crsp->count;
+  for (uint32_t i = 0; i < cnt; i++) {
+    krsp = gecko_cmd_mesh_test_get_key(type, i, 1);
+    if (krsp->result != bg_err_success) {
+      LOGBGE("get key", krsp->result);
+      return false;
+    }
+    if (krsp->id == key->id
+        && !memcmp(krsp->key.data, key->val, 16)
+        && (type == KEY_TYPE_NET || krsp->network == netkey_id)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static err_t keys_validate(mng_t *mng)
+{
+  subnet_t *sn = mng->cfg->subnets;
+  int active = 0;
+
+  if (!sn || !sn->netkey.done) {
+    LOGW("Warm: No Netkey Created in Config\n");
+    return err(ec_state);
+  }
+  if (!key_found(KEY_TYPE_NET, &sn->netkey, 0)) {
+    LOGW("Warm: Netkey[%d] Not in NCP Target\n", sn->netkey.id);
+    return err(ec_state);
+  }
+  for (int i = 0; i < sn->appkey_num; i++) {
+    if (!sn->appkey[i].done) {
+      continue;
+    }
+    if (!key_found(KEY_TYPE_APP, &sn->appkey[i], sn->netkey.id)) {
+      LOGW("Warm: Appkey[%d] Not in NCP Target\n", sn->appkey[i].id);
+      return err(ec_state);
+    }
+    active++;
+  }
+  sn->active_appkey_num = active;
+  return ec_success;
+}
+
+static err_t ivi_validate(mng_t *mng)
+{
+  err_t e;
+  struct gecko_msg_mesh_node_get_ivupdate_state_rsp_t *rsp;
+
+  rsp = gecko_cmd_mesh_node_get_ivupdate_state();
+  if (rsp->result != bg_err_success) {
+    LOGBGE("get ivupdate state", rsp->result);
+    return err(ec_bgrsp);
+  }
+  if (rsp->ivindex < mng->cfg->ivi) {
+    LOGW("Warm: NCP Target IV Index %u Behind Config %u\n",
+         rsp->ivindex, mng->cfg->ivi);
+    return err(ec_state);
+  }
+  if (rsp->ivindex != mng->cfg->ivi) {
+    /* The network moved on while the host was away */
+    mng->cfg->ivi = rsp->ivindex;
+    EC(ec_success, provset_ivi(&mng->cfg->ivi));
+  }
+  return ec_success;
+}
+
+static err_t ddb_validate(void)
+{
+  err_t e;
+  uint16list_t *addrs;
+  node_t *n;
+  uint32_t digest, ddb_digest;
+  int cnt = 0, ddb_cnt;
+
+  EC(ec_success, ddb_cache_sync());
+  ddb_digest = ddb_cache_digest(&ddb_cnt);
+
+  digest = 0;
+  if (NULL != (addrs = get_node_addrs())) {
+    for (int i = 0; i < addrs->len; i++) {
+      if (NULL == (n = cfgdb_node_get(addrs->data[i]))) {
+        continue;
+      }
+      digest += ddb_cache_dev_hash(n->uuid, n->addr);
+      cnt++;
+    }
+    free(addrs->data);
+    free(addrs);
+  }
+
+  if (cnt != ddb_cnt || digest != ddb_digest) {
+    LOGW("Warm: %d Nodes in Config, %d Devices in NCP Target DDB%s\n",
+         cnt, ddb_cnt, cnt == ddb_cnt ? ", Not the Same" : "");
+    return err(ec_state);
+  }
+  return ec_success;
+}
+
+err_t warm_validate(mng_t *mng)
+{
+  err_t e;
+  struct gecko_msg_mesh_node_get_element_address_rsp_t *rsp;
+
+  rsp = gecko_cmd_mesh_node_get_element_address(0);
+  if (rsp->result != bg_err_success) {
+    /* Not a provisioner with a network yet */
+    LOGBGE("get element address", rsp->result);
+    return err(ec_state);
+  }
+  if (rsp->address != mng->cfg->addr) {
+    LOGW("Warm: NCP Target Address 0x%04x, 0x%04x in Config\n",
+         rsp->address, mng->cfg->addr);
+    return err(ec_state);
+  }
+  EC(ec_success, ivi_validate(mng));
+  EC(ec_success, keys_validate(mng));
+  EC(ec_success, ddb_validate());
+  LOGM("Warm: NCP Target Agrees with Config\n");
+  return ec_success;
+}
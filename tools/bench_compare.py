@@ -0,0 +1,55 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# File Name: bench_compare.py
+# Author: Kevin
+# Created Time: 2026-10-19
+# Description: compare two result files of the micro-benchmarks
+#
+# Usage: bench_compare.py base.json new.json [threshold_percent]
+#
+# Prints the time per operation of each benchmark in both files and the
+# change, marks the ones slower than the threshold (5% by default) and exits
+# with 1 if any, so it can gate a build.
+
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        doc = json.load(f)
+    return doc, {(r['name'], r['size']): r['ns_per_op'] for r in doc['results']}
+
+
+def main():
+    if len(sys.argv) < 3:
+        print('Usage: %s base.json new.json [threshold_percent]' % sys.argv[0])
+        sys.exit(2)
+    threshold = float(sys.argv[3]) if len(sys.argv) > 3 else 5.0
+    base_doc, base = load(sys.argv[1])
+    new_doc, new = load(sys.argv[2])
+
+    print('%-28s %8s %14s %14s %8s' % ('benchmark', 'size',
+                                       base_doc.get('git', 'base'),
+                                       new_doc.get('git', 'new'), 'change'))
+    slower = 0
+    for key in list(base) + [k for k in new if k not in base]:
+        b, n = base.get(key), new.get(key)
+        if b is None or n is None:
+            print('%-28s %8d %14s %14s' % (key[0], key[1],
+                                           '-' if b is None else '%.1f' % b,
+                                           '-' if n is None else '%.1f' % n))
+            continue
+        change = (n - b) * 100.0 / b if b else 0.0
+        mark = ''
+        if change > threshold:
+            mark = ' <<'
+            slower += 1
+        print('%-28s %8d %14.1f %14.1f %+7.1f%%%s' % (key[0], key[1], b, n,
+                                                       change, mark))
+    sys.exit(1 if slower else 0)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,54 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# File Name: bgapi_names_gen.py
+# Author: Kevin
+# Created Time: 2026-10-19
+# Description: scan host_gecko.h for the command and event IDs and map them to
+# the names in bgapi_names.c, which is compiled on its own and declared in
+# bgapi_names.h, run from the root of the project
+
+import re
+
+in_file = "hal/ble_stack/inc/host/host_gecko.h"
+out_file = "hal/bgapi_names.c"
+
+id_re = re.compile(r"^#define gecko_(cmd|evt)_(\w+)_id\s")
+
+
+def get_ids(host_gecko_h):
+    cmds = []
+    evts = []
+
+    with open(host_gecko_h, "r") as fp:
+        for line in fp:
+            m = id_re.match(line)
+            if not m:
+                continue
+            if m.group(1) == "cmd":
+                cmds.append(m.group(2))
+            else:
+                evts.append(m.group(2))
+    return cmds, evts
+
+
+def render(name, kind, ids):
+    s = "\nconst bgapi_name_t %s[] = {\n" % name
+    for i in ids:
+        s += "  { gecko_%s_%s_id, \"%s\" },\n" % (kind, i, i)
+    s += "};\n"
+    s += "const int %s_num = ARR_LEN(%s);\n" % (name, name)
+    return s
+
+
+if __name__ == '__main__':
+    cmds, evts = get_ids(in_file)
+    content = "/* Generated by tools/bgapi_names_gen.py, do not edit */\n"
+    content += "#include \"host_gecko.h\"\n"
+    content += "#include \"utils.h\"\n"
+    content += "#include \"bgapi_names.h\"\n"
+    content += render("bgapi_cmd_names", "cmd", cmds)
+    content += render("bgapi_evt_names", "evt", evts)
+    with open(out_file, "w") as fp:
+        fp.write(content)
+    print("%d commands, %d events" % (len(cmds), len(evts)))
@@ -0,0 +1,212 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# File Name: mesh_config_gen.py
+# Author: Kevin
+# Created Time: 2026-10-19
+# Description: generate the prov.json, nwk.json and templates.json of a
+# synthetic network for the load tests. The UUID of device n is
+# "nwmng-simdev" followed by n in big endian, same as the virtual devices of
+# hal/ncp_sim, so ncp_sim -n <nodes + backlog> serves all of them.
+
+import argparse
+import json
+import os
+import random
+
+UUID_PREFIX = b"nwmng-simdev"
+GROUP_BASE = 0xC000
+# Unicast addresses are assigned from here, the provisioner takes the first
+PROV_ADDR = 0x0001
+RM_FLAG = 0x10
+BL_FLAG = 0x01
+
+
+def h8(v):
+    return "0x%02x" % v
+
+
+def h16(v):
+    return "0x%04x" % v
+
+
+def h32(v):
+    return "0x%08x" % v
+
+
+def uuid_of(idx):
+    return (UUID_PREFIX + idx.to_bytes(4, "big")).hex()
+
+
+def key_of(rnd):
+    return "".join("%02x" % rnd.randrange(256) for _ in range(16))
+
+
+def gen_prov(args, rnd):
+    appkeys = []
+    for i in range(args.appkeys):
+        appkeys.append({
+            "RefId": h16(i),
+            "Id": h16(0),
+            "Value": key_of(rnd),
+            "Done": h8(0),
+        })
+    return {
+        "Address": h16(PROV_ADDR),
+        "IVI": h32(0),
+        "TTL": h8(9),
+        "SyncTime": h32(0),
+        "TX Parameters": {"Count": h8(3), "Interval": h16(30)},
+        "Config Timeout": {"Normal": h16(5000), "LPN": h16(15000)},
+        "Subnets": [{
+            "RefId": h16(0),
+            "Id": h16(0),
+            "Value": key_of(rnd),
+            "Done": h8(0),
+            "AppKey": appkeys,
+        }],
+    }
+
+
+def gen_templates(args):
+    tmpls = []
+    for t in range(args.templates):
+        lpn = t < args.lpn_templates
+        tmpl = {"RefId": h16(t + 1)}
+        if not lpn:
+            tmpl["TTL"] = h8(5)
+        tmpl["Features"] = {
+            "Low Power": h8(1 if lpn else 0),
+            "Proxy": h8(0 if lpn else 1),
+            "Friend": h8(0 if lpn else 1),
+            "Relay": {
+                "Enable": h8(0 if lpn else 1),
+                "Count": h8(0 if lpn else 2),
+                "Interval": h16(0 if lpn else 50),
+            },
+        }
+        if args.pub:
+            tmpl["Publish To"] = {
+                "Address": h16(GROUP_BASE + t % args.groups),
+                "AppKey": h16(0),
+                "Period": h32(0 if lpn else 10000),
+                "TTL": h8(5),
+                "TX Parameters": {"Count": h8(3), "Interval": h16(500)},
+            }
+        if not lpn:
+            tmpl["Secure Network Beacon"] = h8(1)
+            tmpl["TX Parameters"] = {"Count": h8(3), "Interval": h16(30)}
+        tmpl["Bind Appkeys"] = [h16(i) for i in range(min(args.bind,
+                                                          args.appkeys))]
+        tmpl["Subscribe from"] = [h16(GROUP_BASE + (t + j + 1) % args.groups)
+                                  for j in range(min(args.sub, args.groups))]
+        tmpls.append(tmpl)
+    return {"Templates": tmpls, "Backlog": []}
+
+
+def node_of(idx, addr, tmpl, rmorbl, done):
+    return {
+        "UUID": uuid_of(idx),
+        "Address": h16(addr),
+        "Err": h32(0),
+        "Template ID": h8(tmpl),
+        "RM_Blacklist": h8(rmorbl),
+        "Functionality": h8(0),
+        "Done": h8(done),
+    }
+
+
+def gen_nwk(args, rnd):
+    nodes = []
+    addr = PROV_ADDR + 1
+    provisioned = set(rnd.sample(range(args.nodes),
+                                 args.nodes * args.provisioned // 100))
+    flagged = sorted(provisioned)
+    rnd.shuffle(flagged)
+    rm = set(flagged[:len(flagged) * args.rm // 100])
+    bl = set(flagged[len(rm):len(rm) + len(flagged) * args.bl // 100])
+
+    for i in range(args.nodes):
+        tmpl = i % args.templates + 1
+        if i in provisioned:
+            rmorbl = RM_FLAG if i in rm else BL_FLAG if i in bl else 0
+            nodes.append(node_of(i, addr, tmpl, rmorbl, 1))
+            # An element per node is enough for the config, leave a gap for
+            # the multi-element devices of ncp_sim
+            addr += 2
+        else:
+            nodes.append(node_of(i, 0, tmpl, 0, 0))
+    backlog = [node_of(args.nodes + i, 0, 0, 0, 0)
+               for i in range(args.backlog)]
+    return {
+        "SyncTime": h32(0),
+        "Subnets": [{"RefId": h16(0), "Nodes": nodes}],
+        "Backlog": backlog,
+    }
+
+
+def dump(path, obj):
+    with open(path, "w") as fp:
+        json.dump(obj, fp, indent=2, separators=(",", ":"))
+        fp.write("\n")
+
+
+def check(args):
+    if not 0 < args.templates <= 0xff:
+        raise SystemExit("templates must be 1 to 255, the node refers to it "
+                         "by 1 byte")
+    if args.lpn_templates > args.templates:
+        raise SystemExit("more LPN templates than templates")
+    if PROV_ADDR + 1 + 2 * args.nodes > 0x7fff:
+        raise SystemExit("too many nodes for the unicast addresses")
+    if args.groups <= 0 or args.appkeys <= 0:
+        raise SystemExit("groups and appkeys must be positive")
+    for v in (args.provisioned, args.rm, args.bl):
+        if not 0 <= v <= 100:
+            raise SystemExit("percentages must be 0 to 100")
+
+
+if __name__ == '__main__':
+    ap = argparse.ArgumentParser(
+        description="Generate the config files of a synthetic network")
+    ap.add_argument("-o", "--out", default="tools/mesh_config/gen",
+                    help="output directory, default tools/mesh_config/gen")
+    ap.add_argument("-n", "--nodes", type=int, default=1000,
+                    help="nodes in the network, default 1000")
+    ap.add_argument("-t", "--templates", type=int, default=4,
+                    help="templates, the nodes use them in turn, default 4")
+    ap.add_argument("-l", "--lpn-templates", type=int, default=0,
+                    help="templates of low power nodes among them, default 0")
+    ap.add_argument("-a", "--appkeys", type=int, default=1,
+                    help="application keys, default 1")
+    ap.add_argument("-g", "--groups", type=int, default=16,
+                    help="group addresses to publish and subscribe, "
+                         "default 16")
+    ap.add_argument("--sub", type=int, default=2,
+                    help="groups each template subscribes from, default 2")
+    ap.add_argument("--bind", type=int, default=1,
+                    help="appkeys each template binds, default 1")
+    ap.add_argument("--no-pub", dest="pub", action="store_false",
+                    help="no publication in the templates")
+    ap.add_argument("-b", "--backlog", type=int, default=0,
+                    help="devices in the backlog, default 0")
+    ap.add_argument("-p", "--provisioned", type=int, default=0,
+                    help="percent of the nodes already provisioned and "
+                         "configured, default 0")
+    ap.add_argument("--rm", type=int, default=0,
+                    help="percent of the provisioned nodes to remove")
+    ap.add_argument("--bl", type=int, default=0,
+                    help="percent of the provisioned nodes to blacklist")
+    ap.add_argument("-s", "--seed", type=int, default=1,
+                    help="random seed, the same seed gives the same files")
+    args = ap.parse_args()
+    check(args)
+
+    rnd = random.Random(args.seed)
+    if not os.path.isdir(args.out):
+        os.makedirs(args.out)
+    dump(os.path.join(args.out, "prov.json"), gen_prov(args, rnd))
+    dump(os.path.join(args.out, "templates.json"), gen_templates(args))
+    dump(os.path.join(args.out, "nwk.json"), gen_nwk(args, rnd))
+    print("%d nodes, %d in backlog, %d templates written to %s"
+          % (args.nodes, args.backlog, args.templates, args.out))
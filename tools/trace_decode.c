@@ -0,0 +1,166 @@
+/*************************************************************************
+    > File Name: trace_decode.c
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Decode a binary trace file written by the logging module.
+    > The trace points and the string table are read from the file header,
+    > so a file from an older build decodes as long as the version matches.
+ ************************************************************************/
+
+/* Includes *********************************************************** */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "trace.h"
+
+/* Defines  *********************************************************** */
+#define TRACE_MAGIC "NWTRACE"
+#define TRACE_VERSION 1
+#define LINE_SIZE 1024
+
+/* Static Variables *************************************************** */
+static trace_point_t *points = NULL;
+static uint32_t npoints = 0;
+static char **strtab = NULL;
+static uint32_t nstr = 0;
+
+/* Static Functions Declaractions ************************************* */
+static int get(FILE *fp, void *p, size_t len)
+{
+  return fread(p, 1, len, fp) == len ? 0 : -1;
+}
+
+static char *get_str(FILE *fp)
+{
+  uint16_t len;
+  char *s;
+
+  if (get(fp, &len, sizeof(len))) {
+    return NULL;
+  }
+  s = malloc(len + 1);
+  if (!s) {
+    return NULL;
+  }
+  if (get(fp, s, len)) {
+    free(s);
+    return NULL;
+  }
+  s[len] = '\0';
+  return s;
+}
+
+static int read_header(FILE *fp)
+{
+  char magic[sizeof(TRACE_MAGIC)];
+  uint32_t version;
+  int8_t lvl;
+
+  if (get(fp, magic, sizeof(magic)) || memcmp(magic, TRACE_MAGIC, sizeof(magic))) {
+    fprintf(stderr, "not a trace file\n");
+    return -1;
+  }
+  if (get(fp, &version, sizeof(version)) || version != TRACE_VERSION) {
+    fprintf(stderr, "unsupported trace version\n");
+    return -1;
+  }
+  if (get(fp, &npoints, sizeof(npoints))) {
+    return -1;
+  }
+  points = calloc(npoints, sizeof(trace_point_t));
+  if (!points) {
+    return -1;
+  }
+  for (uint32_t i = 0; i < npoints; i++) {
+    if (get(fp, &lvl, sizeof(lvl))) {
+      return -1;
+    }
+    points[i].lvl = lvl;
+    points[i].name = get_str(fp);
+    points[i].fmt = get_str(fp);
+    if (!points[i].name || !points[i].fmt) {
+      return -1;
+    }
+  }
+  if (get(fp, &nstr, sizeof(nstr))) {
+    return -1;
+  }
+  strtab = calloc(nstr ? nstr : 1, sizeof(char *));
+  if (!strtab) {
+    return -1;
+  }
+  for (uint32_t i = 0; i < nstr; i++) {
+    strtab[i] = get_str(fp);
+    if (!strtab[i]) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+static const char *lvl_flag(int lvl)
+{
+  switch (lvl) {
+    case LVL_AST: return AST_FLAG;
+    case LVL_ERR: return ERR_FLAG;
+    case LVL_WRN: return WRN_FLAG;
+    case LVL_MSG: return MSG_FLAG;
+    case LVL_DBG: return DBG_FLAG;
+    default: return VER_FLAG;
+  }
+}
+
+static int decode(FILE *fp)
+{
+  uint32_t sec, args[TRACE_MAX_ARGS];
+  uint16_t id, line;
+  uint8_t nargs;
+  char msg[LINE_SIZE], tstr[32];
+  time_t t;
+  struct tm tm;
+  unsigned long n = 0;
+
+  while (!get(fp, &sec, sizeof(sec))) {
+    if (get(fp, &id, sizeof(id)) || get(fp, &line, sizeof(line))
+        || get(fp, &nargs, sizeof(nargs)) || nargs > TRACE_MAX_ARGS
+        || get(fp, args, nargs * sizeof(uint32_t))) {
+      fprintf(stderr, "truncated record after %lu records\n", n);
+      return -1;
+    }
+    if (id >= npoints) {
+      fprintf(stderr, "unknown trace id %u\n", id);
+      return -1;
+    }
+    t = sec;
+    localtime_r(&t, &tm);
+    strftime(tstr, sizeof(tstr), "%F %X", &tm);
+    trace_format(msg, sizeof(msg), points[id].fmt, args, nargs,
+                 (const char *const *)strtab, (int)nstr);
+    printf("[%s][%s:%-5u]%s: %s", tstr, points[id].name, line,
+           lvl_flag(points[id].lvl), msg);
+    n++;
+  }
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  FILE *fp;
+  int ret;
+
+  if (argc != 2) {
+    printf("Usage: %s <trace file>\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+  fp = fopen(argv[1], "rb");
+  if (!fp) {
+    perror(argv[1]);
+    return EXIT_FAILURE;
+  }
+  ret = read_header(fp) || decode(fp);
+  fclose(fp);
+  return ret ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,79 @@
+/*************************************************************************
+    > File Name: lat_hist.c
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description:
+ ************************************************************************/
+
+/* Includes *********************************************************** */
+#include <time.h>
+#include "lat_hist.h"
+#include "utils.h"
+
+/* Defines  *********************************************************** */
+
+/* Global Variables *************************************************** */
+
+/* Static Variables *************************************************** */
+
+/* Static Functions Declaractions ************************************* */
+uint64_t lat_now_us(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static int lat_hist_idx(uint64_t us)
+{
+  uint32_t v = us > UINT32_MAX ? UINT32_MAX : (uint32_t)us;
+  int shift;
+
+  if (v < (1 << (LAT_HIST_SUB_BITS + 1))) {
+    return v;
+  }
+  /* Keep the LAT_HIST_SUB_BITS + 1 most significant bits */
+  shift = 31 - utils_clz(v) - LAT_HIST_SUB_BITS;
+  return (shift << LAT_HIST_SUB_BITS) + (v >> shift);
+}
+
+static uint64_t lat_hist_highest(int idx)
+{
+  int shift = (idx >> LAT_HIST_SUB_BITS) - 1;
+
+  if (shift <= 0) {
+    return idx;
+  }
+  return ((uint64_t)(idx - (shift << LAT_HIST_SUB_BITS) + 1) << shift) - 1;
+}
+
+void lat_hist_record(lat_hist_t *h, uint64_t us)
+{
+  h->buckets[lat_hist_idx(us)]++;
+  h->cnt++;
+  h->sum += us;
+  if (us > h->max) {
+    h->max = us;
+  }
+}
+
+uint64_t lat_hist_percentile(const lat_hist_t *h, double p)
+{
+  uint64_t want, sum = 0, v;
+
+  if (!h->cnt) {
+    return 0;
+  }
+  want = (uint64_t)(p * h->cnt / 100.0 + 0.5);
+  if (want < 1) {
+    want = 1;
+  }
+  for (int i = 0; i < LAT_HIST_BUCKETS; i++) {
+    sum += h->buckets[i];
+    if (sum >= want) {
+      v = lat_hist_highest(i);
+      return v < h->max ? v : h->max;
+    }
+  }
+  return h->max;
+}
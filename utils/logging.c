@@ -13,11 +13,36 @@
 #include <string.h>
 #include <unistd.h>
 #include <errno.h>
+#include <pthread.h>
 
 #include "logging.h"
+#include "trace.h"
 #include "utils.h"
 /* Defines  *********************************************************** */
 #define LOGBUF_SIZE 1024
+/*
+ * Log records are put to a ring by the callers and written to the file by a
+ * background thread. Size of the ring must be power of 2.
+ */
+#define LOG_RING_SIZE 1024
+#define LOG_RING_MASK (LOG_RING_SIZE - 1)
+/* Slots only records with level WRN or higher may use */
+#define LOG_RING_RESERVED 64
+#define LOG_MSG_SIZE  480
+/* Bytes the writer collects before writing them out */
+#define LOG_WBUF_SIZE (64 * 1024)
+/* Sleep time of the writer if the ring is empty */
+#define LOG_WRITER_IDLE_US  10000
+
+/*
+ * Binary trace file, all integers in host byte order
+ * header: magic, u32 version, u32 number of trace points,
+ *         each point - u8 level, u16 name length, name, u16 format length, format
+ *         u32 number of strings, each string - u16 length, string
+ * record: u32 time, u16 trace id, u16 line, u8 number of arguments, u32 arguments
+ */
+#define TRACE_MAGIC "NWTRACE"
+#define TRACE_VERSION 1
 /*
  * Format of file and line information in the log message: [file:line]
  */
@@ -33,55 +58,104 @@
 #endif
 
 /* Global Variables *************************************************** */
+int log_mod_lvls[log_mod_max] = {
+  LVL_VER, LVL_VER, LVL_VER, LVL_VER, LVL_VER
+};
 
 /* Static Variables *************************************************** */
 typedef struct {
   FILE *fp;
-  log_lvl_t level;
   bool tostdout;
-  size_t log_len;
-  char *buf;
 }logcfg_t;
 
 static logcfg_t lcfg = {
   NULL,
-  LVL_VER,
-  0,
-  0,
-  NULL
+  0
+};
+
+static const char *mod_names[log_mod_max] = {
+  "default",
+  "mng",
+  "dev_config",
+  "json_parser",
+  "hal"
+};
+
+/*
+ * The slot is free for the producer when seq equals its position and ready for
+ * the writer when seq equals position + 1.
+ */
+enum {
+  rec_text,
+  rec_raw,
+  rec_trace
 };
 
+typedef struct {
+  unsigned long seq;
+  time_t t;
+  const char *file_name;
+  unsigned int line;
+  int lvl;
+  unsigned char kind;
+  unsigned char nargs;
+  unsigned short id;
+  unsigned short len;
+  union {
+    char msg[LOG_MSG_SIZE];
+    uint32_t args[TRACE_MAX_ARGS];
+  }u;
+}logrec_t;
+
+static struct {
+  logrec_t recs[LOG_RING_SIZE];
+  unsigned long tail; /* Next position to reserve, shared by producers */
+  unsigned long head; /* Next position to write, writer only */
+  unsigned long dropped;
+  unsigned long dropped_reported;
+  pthread_t tid;
+  bool running;
+  bool stop;
+}ring;
+
+static char wbuf[LOG_WBUF_SIZE];
+
+/* Binary trace file, accessed by the writer under tlock */
+static pthread_mutex_t tlock = PTHREAD_MUTEX_INITIALIZER;
+static FILE *tfp = NULL;
+static char tbuf[LOG_WBUF_SIZE];
+
 /* Static Functions Declaractions ************************************* */
 
 /**
  * @brief get_now_str - fill the @param{str} with time as [Time]
  *
+ * @param t - time to fill
  * @param str - buffer to be filled
  * @param input_len - length of the buffer
  * @param len - real filled length
  *
  * @return @ref{err_t}
  */
-static err_t fill_time(char *str,
+static err_t fill_time(time_t t,
+                       char *str,
                        size_t input_len,
                        size_t *len)
 {
-  time_t t;
-  struct tm *tm;
+  struct tm tm;
   size_t r;
 
   if (!str || !len || !input_len) {
     return err(ec_param_null);
   }
 
-  time(&t);
-  tm = localtime(&t);
+  localtime_r(&t, &tm);
 
   str[0] = '[';
   r = strftime(str + 1,
                input_len - 1,
                "%F %X",
-               tm);
+               &tm);
   if (r == 0 || r + 2 > input_len) {
     return err(ec_length_leak);
   }
@@ -192,54 +266,408 @@ static err_t fill_lvl(int lvl,
   return ec_success;
 }
 
+/* Fill the prefix of a log message, return the length of it or 0 */
+static size_t fill_prefix(time_t t,
+                          const char *file_name,
+                          unsigned int line,
+                          int lvl,
+                          char *str,
+                          size_t input_len)
+{
+  err_t e;
+  size_t len;
+
+  ECG(ec_success, fill_time(t, str, input_len, &len), out);
+  ECG(ec_success, fill_file_line(file_name, line, str, input_len, len, &len), out);
+  ECG(ec_success, fill_lvl(lvl, str, input_len, len, &len), out);
+  return len;
+
+  out:
+  return 0;
+}
+
+static void write_out(const char *buf, size_t len)
+{
+  if (!len) {
+    return;
+  }
+  if (lcfg.fp) {
+    fwrite(buf, 1, len, lcfg.fp);
+    fflush(lcfg.fp);
+  }
+  if (lcfg.tostdout) {
+    fwrite(buf, 1, len, stdout);
+    fflush(stdout);
+  }
+}
+
+/**
+ * @brief ring_reserve - reserve a slot in the ring, never blocks
+ *
+ * @param lvl - level of the record, low levels can't use the reserved slots
+ *
+ * @return the slot or NULL if the ring is full
+ */
+static logrec_t *ring_reserve(int lvl)
+{
+  unsigned long pos, seq;
+  logrec_t *rec;
+
+  pos = __atomic_load_n(&ring.tail, __ATOMIC_RELAXED);
+  for (;;) {
+    if (lvl > LVL_WRN
+        && pos - __atomic_load_n(&ring.head, __ATOMIC_ACQUIRE)
+        >= LOG_RING_SIZE - LOG_RING_RESERVED) {
+      return NULL;
+    }
+    rec = &ring.recs[pos & LOG_RING_MASK];
+    seq = __atomic_load_n(&rec->seq, __ATOMIC_ACQUIRE);
+    if (seq == pos) {
+      if (__atomic_compare_exchange_n(&ring.tail, &pos, pos + 1, true,
+                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        return rec;
+      }
+    } else if ((long)(seq - pos) < 0) {
+      return NULL;
+    } else {
+      pos = __atomic_load_n(&ring.tail, __ATOMIC_RELAXED);
+    }
+  }
+}
+
+static void ring_commit(logrec_t *rec)
+{
+  unsigned long pos = rec->seq;
+  __atomic_store_n(&rec->seq, pos + 1, __ATOMIC_RELEASE);
+}
+
+#define TRACE_REC_MAX_LEN (9 + 4 * TRACE_MAX_ARGS)
+
+static size_t put_u16(char *p, uint16_t v)
+{
+  memcpy(p, &v, sizeof(v));
+  return sizeof(v);
+}
+
+static size_t put_u32(char *p, uint32_t v)
+{
+  memcpy(p, &v, sizeof(v));
+  return sizeof(v);
+}
+
+static size_t trace_rec_pack(const logrec_t *rec, char *p)
+{
+  size_t len = 0;
+
+  len += put_u32(p + len, (uint32_t)rec->t);
+  len += put_u16(p + len, rec->id);
+  len += put_u16(p + len, (uint16_t)rec->line);
+  p[len++] = rec->nargs;
+  memcpy(p + len, rec->u.args, rec->nargs * sizeof(uint32_t));
+  return len + rec->nargs * sizeof(uint32_t);
+}
+
+static void trace_put_str(FILE *fp, const char *str)
+{
+  char b[2];
+  uint16_t l = strlen(str);
+
+  put_u16(b, l);
+  fwrite(b, 1, sizeof(b), fp);
+  fwrite(str, 1, l, fp);
+}
+
+/* The header makes a trace file decodable without the matching binary */
+static void trace_header_write(FILE *fp)
+{
+  const char *const *strtab;
+  int nstr;
+  char b[4];
+
+  fwrite(TRACE_MAGIC, 1, sizeof(TRACE_MAGIC), fp);
+  put_u32(b, TRACE_VERSION);
+  fwrite(b, 1, 4, fp);
+  put_u32(b, trc_max);
+  fwrite(b, 1, 4, fp);
+  for (int i = 0; i < trc_max; i++) {
+    b[0] = (char)trace_points[i].lvl;
+    fwrite(b, 1, 1, fp);
+    trace_put_str(fp, trace_points[i].name);
+    trace_put_str(fp, trace_points[i].fmt);
+  }
+  strtab = trace_get_strtab(&nstr);
+  put_u32(b, strtab ? nstr : 0);
+  fwrite(b, 1, 4, fp);
+  for (int i = 0; strtab && i < nstr; i++) {
+    trace_put_str(fp, strtab[i]);
+  }
+}
+
+/**
+ * @brief ring_drain - format the ready records and write them in batches
+ *
+ * @return number of records written
+ */
+static int ring_drain(void)
+{
+  size_t wlen = 0, tlen = 0, plen;
+  unsigned long dropped;
+  logrec_t *rec;
+  int n = 0;
+
+  pthread_mutex_lock(&tlock);
+  for (;;) {
+    rec = &ring.recs[ring.head & LOG_RING_MASK];
+    if (__atomic_load_n(&rec->seq, __ATOMIC_ACQUIRE) != ring.head + 1) {
+      break;
+    }
+    if (rec->kind == rec_trace && tfp) {
+      if (tlen + TRACE_REC_MAX_LEN > LOG_WBUF_SIZE) {
+        fwrite(tbuf, 1, tlen, tfp);
+        tlen = 0;
+      }
+      tlen += trace_rec_pack(rec, tbuf + tlen);
+      goto next;
+    }
+    if (wlen + LOGBUF_SIZE > LOG_WBUF_SIZE) {
+      write_out(wbuf, wlen);
+      wlen = 0;
+    }
+    plen = rec->kind == rec_raw ? 0 : fill_prefix(rec->t, rec->file_name, rec->line,
+                                                  rec->lvl, wbuf + wlen,
+                                                  LOG_WBUF_SIZE - wlen);
+    if (rec->kind == rec_trace) {
+      int nstr;
+      const char *const *strtab = trace_get_strtab(&nstr);
+      wlen += plen + trace_format(wbuf + wlen + plen, LOG_WBUF_SIZE - wlen - plen,
+                                  trace_points[rec->id].fmt, rec->u.args,
+                                  rec->nargs, strtab, nstr);
+    } else {
+      memcpy(wbuf + wlen + plen, rec->u.msg, rec->len);
+      wlen += plen + rec->len;
+    }
+
+    next:
+
+    __atomic_store_n(&rec->seq, ring.head + LOG_RING_SIZE, __ATOMIC_RELEASE);
+    __atomic_store_n(&ring.head, ring.head + 1, __ATOMIC_RELEASE);
+    n++;
+  }
+
+  dropped = __atomic_load_n(&ring.dropped, __ATOMIC_RELAXED);
+  if (dropped != ring.dropped_reported) {
+    if (wlen + LOGBUF_SIZE > LOG_WBUF_SIZE) {
+      write_out(wbuf, wlen);
+      wlen = 0;
+    }
+    plen = fill_prefix(time(NULL), __FILE__, __LINE__, LVL_WRN,
+                       wbuf + wlen, LOG_WBUF_SIZE - wlen);
+    wlen += plen;
+    wlen += snprintf(wbuf + wlen, LOG_WBUF_SIZE - wlen,
+                     "%lu log records dropped, %lu in total\n",
+                     dropped - ring.dropped_reported, dropped);
+    ring.dropped_reported = dropped;
+  }
+  write_out(wbuf, wlen);
+  if (tfp && tlen) {
+    fwrite(tbuf, 1, tlen, tfp);
+    fflush(tfp);
+  }
+  pthread_mutex_unlock(&tlock);
+  return n;
+}
+
+static void *log_writer(void *arg)
+{
+  while (!__atomic_load_n(&ring.stop, __ATOMIC_ACQUIRE)) {
+    if (!ring_drain()) {
+      usleep(LOG_WRITER_IDLE_US);
+    }
+  }
+  ring_drain();
+  return NULL;
+}
+
+static void writer_stop(void)
+{
+  if (!ring.running) {
+    return;
+  }
+  __atomic_store_n(&ring.stop, true, __ATOMIC_RELEASE);
+  pthread_join(ring.tid, NULL);
+  ring.running = false;
+}
+
+/* Format and write in the caller, used for asserts and if no writer runs */
+static err_t log_sync(const char *file_name,
+                      unsigned int line,
+                      int lvl,
+                      const char *fmt,
+                      va_list valist)
+{
+  char buf[LOGBUF_SIZE];
+  size_t len;
+  int r;
+
+  len = fill_prefix(time(NULL), file_name, line, lvl, buf, LOGBUF_SIZE);
+  if (!len) {
+    return err(ec_length_leak);
+  }
+  r = vsnprintf(buf + len, LOGBUF_SIZE - len, fmt, valist);
+  if (r > 0) {
+    len = MIN(len + r, LOGBUF_SIZE - 1);
+  }
+  if (ring.running) {
+    /* Keep the order with what is already in the ring */
+    logging_flush();
+  }
+  write_out(buf, len);
+  return ec_success;
+}
+
 err_t __log(const char *file_name,
             unsigned int line,
             int lvl,
             const char *fmt,
             ...)
 {
-  err_t e;
+  err_t e = ec_success;
   va_list valist;
+  logrec_t *rec;
+  int r;
 
-  if (lvl > (int)lcfg.level) {
+  if (!lcfg.fp && !lcfg.tostdout) {
     return ec_success;
   }
-  lcfg.buf = calloc(1, LOGBUF_SIZE);
-
-  ECG(ec_success,
-      fill_time(lcfg.buf, LOGBUF_SIZE, &lcfg.log_len),
-      out);
-  ECG(ec_success,
-      fill_file_line(file_name, line, lcfg.buf, LOGBUF_SIZE,
-                     lcfg.log_len, &lcfg.log_len),
-      out);
-  ECG(ec_success,
-      fill_lvl(lvl, lcfg.buf, LOGBUF_SIZE,
-               lcfg.log_len, &lcfg.log_len),
-      out);
 
   va_start(valist, fmt);
-  vsnprintf(lcfg.buf + lcfg.log_len,
-            LOGBUF_SIZE - lcfg.log_len,
-            fmt,
-            valist);
-  if (lcfg.fp) {
-    fprintf(lcfg.fp, "%s", lcfg.buf);
-    fflush(lcfg.fp);
+  if (lvl == LVL_AST || !ring.running) {
+    e = log_sync(file_name, line, lvl, fmt, valist);
+    goto out;
   }
-  if (lcfg.tostdout) {
-    printf("%s", lcfg.buf);
-    fflush(lcfg.fp);
+
+  rec = ring_reserve(lvl);
+  if (!rec) {
+    __atomic_add_fetch(&ring.dropped, 1, __ATOMIC_RELAXED);
+    e = err(ec_length_leak);
+    goto out;
+  }
+  rec->t = time(NULL);
+  rec->file_name = file_name;
+  rec->line = line;
+  rec->lvl = lvl;
+  rec->kind = rec_text;
+  r = vsnprintf(rec->u.msg, LOG_MSG_SIZE, fmt, valist);
+  if (r < 0) {
+    r = 0;
+  } else if (r >= LOG_MSG_SIZE) {
+    /* Truncated, keep the line ending */
+    r = LOG_MSG_SIZE - 1;
+    rec->u.msg[r - 1] = '\n';
   }
+  rec->len = r;
+  ring_commit(rec);
 
   out:
-  if (lcfg.buf) {
-    free(lcfg.buf);
-    lcfg.buf = NULL;
-  }
+  va_end(valist);
   return e;
 }
 
+err_t __trace(const char *file_name,
+              unsigned int line,
+              trace_id_t id,
+              int nargs,
+              const uint32_t *args)
+{
+  logrec_t *rec;
+
+  if (!ring.running) {
+    /* No writer, format in place */
+    char buf[LOGBUF_SIZE];
+    int nstr;
+    const char *const *strtab = trace_get_strtab(&nstr);
+    size_t len;
+
+    if (!lcfg.fp && !lcfg.tostdout) {
+      return ec_success;
+    }
+    len = fill_prefix(time(NULL), file_name, line, trace_points[id].lvl,
+                      buf, LOGBUF_SIZE);
+    len += trace_format(buf + len, LOGBUF_SIZE - len, trace_points[id].fmt,
+                        args, nargs, strtab, nstr);
+    write_out(buf, len);
+    return ec_success;
+  }
+
+  rec = ring_reserve(trace_points[id].lvl);
+  if (!rec) {
+    __atomic_add_fetch(&ring.dropped, 1, __ATOMIC_RELAXED);
+    return err(ec_length_leak);
+  }
+  rec->t = time(NULL);
+  rec->file_name = file_name;
+  rec->line = line;
+  rec->lvl = trace_points[id].lvl;
+  rec->kind = rec_trace;
+  rec->id = id;
+  rec->nargs = MIN(nargs, TRACE_MAX_ARGS);
+  memcpy(rec->u.args, args, rec->nargs * sizeof(uint32_t));
+  ring_commit(rec);
+  return ec_success;
+}
+
+err_t logging_trace_start(const char *path)
+{
+  FILE *fp;
+
+  logging_flush();
+  fp = fopen(path, "wb");
+  if (!fp) {
+    return err(ec_file_ope);
+  }
+  trace_header_write(fp);
+  pthread_mutex_lock(&tlock);
+  if (tfp) {
+    fclose(tfp);
+  }
+  tfp = fp;
+  pthread_mutex_unlock(&tlock);
+  return ec_success;
+}
+
+void logging_trace_stop(void)
+{
+  logging_flush();
+  pthread_mutex_lock(&tlock);
+  if (tfp) {
+    fclose(tfp);
+    tfp = NULL;
+  }
+  pthread_mutex_unlock(&tlock);
+}
+
+int logging_trace_on(void)
+{
+  return tfp != NULL;
+}
+
+void logging_flush(void)
+{
+  unsigned long tail = __atomic_load_n(&ring.tail, __ATOMIC_ACQUIRE);
+
+  if (!ring.running || pthread_equal(pthread_self(), ring.tid)) {
+    return;
+  }
+  while ((long)(__atomic_load_n(&ring.head, __ATOMIC_ACQUIRE) - tail) < 0) {
+    usleep(1000);
+  }
+}
+
+unsigned long get_logging_dropped(void)
+{
+  return __atomic_load_n(&ring.dropped, __ATOMIC_RELAXED);
+}
+
 void logging_demo(void)
 {
   const char *msg[] = {
@@ -260,12 +688,21 @@ void logging_demo(void)
 
 void log_n(void)
 {
-  if (lcfg.fp) {
-    fprintf(lcfg.fp, "\n");
+  logrec_t *rec;
+
+  if (!ring.running) {
+    write_out("\n", 1);
+    return;
   }
-  if (lcfg.tostdout) {
-    printf("\n");
+  rec = ring_reserve(LVL_VER);
+  if (!rec) {
+    __atomic_add_fetch(&ring.dropped, 1, __ATOMIC_RELAXED);
+    return;
   }
+  rec->kind = rec_raw;
+  rec->u.msg[0] = '\n';
+  rec->len = 1;
+  ring_commit(rec);
 }
 
 static void log_welcome(void)
@@ -308,14 +745,31 @@ err_t logging_init(const char *path,
   }
   setlinebuf(lcfg.fp);
   lcfg.tostdout = tostdout;
-  lcfg.level = lvl_threshold;
+  for (int i = 0; i < log_mod_max; i++) {
+    log_mod_lvls[i] = lvl_threshold;
+  }
 
   log_welcome();
+
+  for (int i = 0; i < LOG_RING_SIZE; i++) {
+    ring.recs[i].seq = i;
+  }
+  ring.tail = ring.head = 0;
+  ring.stop = false;
+  if (0 != (ret = pthread_create(&ring.tid, NULL, log_writer, NULL))) {
+    /* Still works, just synchronously */
+    fprintf(stderr, "Create log writer error[%d], log synchronously\n", ret);
+  } else {
+    ring.running = true;
+    atexit(writer_stop);
+  }
   return ec_success;
 }
 
 void logging_deinit(void)
 {
+  writer_stop();
+  logging_trace_stop();
   if (lcfg.fp) {
     fclose(lcfg.fp);
   }
@@ -335,12 +789,39 @@ int get_logging_tostdout(void)
 
 void set_logging_lvl_threshold(log_lvl_t lvl)
 {
-  if (lcfg.fp) {
-    lcfg.level = lvl;
+  for (int i = 0; i < log_mod_max; i++) {
+    set_logging_mod_lvl_threshold(i, lvl);
   }
 }
 
 int get_logging_lvl_threshold(void)
 {
-  return lcfg.fp ? lcfg.level : LVL_VER;
+  return get_logging_mod_lvl_threshold(log_mod_default);
+}
+
+void set_logging_mod_lvl_threshold(log_mod_t mod, log_lvl_t lvl)
+{
+  if (lcfg.fp && mod < log_mod_max) {
+    log_mod_lvls[mod] = lvl;
+  }
+}
+
+int get_logging_mod_lvl_threshold(log_mod_t mod)
+{
+  return lcfg.fp && mod < log_mod_max ? log_mod_lvls[mod] : LVL_VER;
+}
+
+log_mod_t get_logging_mod(const char *name)
+{
+  for (int i = 0; i < log_mod_max; i++) {
+    if (!strcmp(name, mod_names[i])) {
+      return i;
+    }
+  }
+  return log_mod_max;
+}
+
+const char *get_logging_mod_name(log_mod_t mod)
+{
+  return mod < log_mod_max ? mod_names[mod] : "";
 }
@@ -6,40 +6,54 @@ static const char *source_files[] = {
     "nwk", /* 5 */
     "bgevt_hdr", /* 6 */
     "dev_bl", /* 7 */
-    "stat", /* 8 */
-    "demo", /* 9 */
-    "dev_config", /* 10 */
-    "as_rmend", /* 11 */
-    "as_end", /* 12 */
-    "as_setpub", /* 13 */
-    "as_bindappkey", /* 14 */
-    "as_rm", /* 15 */
-    "as_setconfig", /* 16 */
-    "as_getdcd", /* 17 */
-    "as_addappkey", /* 18 */
-    "as_addsub", /* 19 */
-    "cfg", /* 20 */
-    "cfgdb", /* 21 */
-    "generic_parser", /* 22 */
-    "json_parser", /* 23 */
-    "cli", /* 24 */
-    "cli_print", /* 25 */
-    "src_names", /* 26 */
-    "utils_print", /* 27 */
-    "utils", /* 28 */
-    "err", /* 29 */
-    "logging", /* 30 */
-    "startup", /* 31 */
-    "bg_uart_cbs", /* 32 */
-    "socket_handler", /* 33 */
-    "gecko_bglib", /* 34 */
-    "uart_posix", /* 35 */
-    "sl_bgapi", /* 36 */
-    "sl_security", /* 37 */
-    "main", /* 38 */
-    "sl_poll", /* 39 */
-    "uart_win", /* 40 */
-    "uart_posix", /* 41 */
-    "platform", /* 42 */
-    "read_char", /* 43 */
-};
\ No newline at end of file
+    "bgapi_stat", /* 8 */
+    "bgapi_cap", /* 9 */
+    "stat", /* 10 */
+    "metrics", /* 11 */
+    "demo", /* 12 */
+    "dev_config", /* 13 */
+    "dcd_cache", /* 14 */
+    "acc_plan", /* 15 */
+    "cfg_digest", /* 16 */
+    "acc_sched", /* 17 */
+    "acc_rto", /* 18 */
+    "shaper", /* 19 */
+    "ddb_cache", /* 20 */
+    "warm", /* 21 */
+    "cmd_ring", /* 22 */
+    "rpc", /* 23 */
+    "as_rmend", /* 24 */
+    "as_end", /* 25 */
+    "as_setpub", /* 26 */
+    "as_bindappkey", /* 27 */
+    "as_rm", /* 28 */
+    "as_setconfig", /* 29 */
+    "as_getdcd", /* 30 */
+    "as_addappkey", /* 31 */
+    "as_addsub", /* 32 */
+    "cfg", /* 33 */
+    "cfgdb", /* 34 */
+    "generic_parser", /* 35 */
+    "json_parser", /* 36 */
+    "cli", /* 37 */
+    "cli_print", /* 38 */
+    "src_names", /* 39 */
+    "utils_print", /* 40 */
+    "utils", /* 41 */
+    "err", /* 42 */
+    "logging", /* 43 */
+    "timeline", /* 44 */
+    "startup", /* 45 */
+    "bg_uart_cbs", /* 46 */
+    "socket_handler", /* 47 */
+    "gecko_bglib", /* 48 */
+    "uart_posix", /* 49 */
+    "sl_bgapi", /* 50 */
+    "sl_security", /* 51 */
+    "main", /* 52 */
+    "sl_poll", /* 53 */
+    "uart_win", /* 54 */
+    "uart_posix", /* 55 */
+    "platform", /* 56 */
+    "read_char", /* 57 */
+};
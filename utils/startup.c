@@ -8,6 +8,7 @@
 /* Includes *********************************************************** */
 #include <stdio.h>
 #include <stdlib.h>
+#include <float.h>
 
 #include <setjmp.h>
 #include <pthread.h>
@@ -19,6 +20,8 @@
 #include "mng.h"
 #include "nwk.h"
 #include "cfg.h"
+#include "metrics.h"
+#include "rpc.h"
 
 /* Defines  *********************************************************** */
 #define CONFIG_CACHE_COMMENT                                                   \
@@ -48,7 +51,6 @@ enum {
 #define ARG_KEY_SOCK_ENC "Socket Encription"
 
 /* Global Variables *************************************************** */
-pthread_mutex_t qlock = PTHREAD_MUTEX_INITIALIZER;
 jmp_buf initjmpbuf;
 
 /* Static Variables *************************************************** */
@@ -115,6 +117,12 @@ int cli_proc(int argc, char *argv[])
   signal(SIGTTOU, SIG_IGN);
 #endif
   setprojargs(argc, argv);
+  if (projargs.metrics[0] && ec_success != (e = metrics_start(projargs.metrics))) {
+    elog(e);
+  }
+  if (projargs.rpc[0] && ec_success != (e = rpc_start(projargs.rpc))) {
+    elog(e);
+  }
 
   ret = setjmp(initjmpbuf);
   LOGM("Program <VERSION - %d.%d.%d> Started Up, Initialization Bitmap - 0x%x\n",
@@ -151,6 +159,16 @@ int cli_proc(int argc, char *argv[])
   }
   mng_info.started = true;
 
+  if (projargs.script[0]) {
+    ret = cli_batch(projargs.script);
+    /* The exit handlers reset the NCP target, no BGAPI calls after them */
+    mng_stop();
+    if (0 != (tmp = pthread_join(mng_info.tid, NULL))) {
+      err_exit_en(tmp, "pthread_join");
+    }
+    mng_info.started = false;
+    exit(ret);
+  }
   cli_mainloop(NULL);
 
   if (0 != (ret = pthread_join(mng_info.tid, NULL))) {
@@ -171,7 +189,16 @@ static void print_usage(const char *name)
                   "       -b baud_rate                        Valid in Insecure Mode\n"
                   "       -s server_domain_socket_path        Valid in Secure Mode\n"
                   "       -c client_domain_socket_path        Valid in Secure Mode\n"
-                  "       -e is_domain_socket_encrypted[1/0]  Valid in Secure Mode\n",
+                  "       -e is_domain_socket_encrypted[1/0]  Valid in Secure Mode\n"
+                  "       -M metrics_port_or_socket_path      Serve the metrics in Prometheus format\n"
+                  "       -R capture_file                     Capture the BGAPI frames to the file\n"
+                  "       -P capture_file[:speed]             Replay a capture instead of the NCP target,\n"
+                  "                                           speed - 1 original(default), N N times faster, 0 max\n"
+                  "       -w                                  Warm restart, attach to the running NCP target\n"
+                  "                                           and keep it running on exit\n"
+                  "       -x script_file                      Run the commands in the file, - for stdin,\n"
+                  "                                           and exit with 0 if all succeed\n"
+                  "       -J rpc_socket_path                  Serve the JSON-RPC control socket\n",
           name);
   exit(EXIT_FAILURE);
 }
@@ -184,7 +211,8 @@ const proj_args_t *getprojargs(void)
 static void store_args(lbitmap_t *dirty, int argc, char *argv[])
 {
   int c;
-  while (-1 != (c = getopt(argc, argv, "m:p:b:s:c:e:f:"))) {
+  char *sp, *end;
+  while (-1 != (c = getopt(argc, argv, "m:p:b:s:c:e:f:M:R:P:wx:J:"))) {
     switch (c) {
       case 'm':
         BIT_SET(*dirty, ARG_DIRTY_ENC);
@@ -218,6 +246,40 @@ static void store_args(lbitmap_t *dirty, int argc, char *argv[])
         BIT_SET(*dirty, ARG_DIRTY_SOCK_ENC);
         projargs.sock.enc = (bool)atoi(optarg);
         break;
+      case 'M':
+        snprintf(projargs.metrics, FILE_PATH_MAX, "%s", optarg);
+        break;
+      case 'R':
+        snprintf(projargs.capture, FILE_PATH_MAX, "%s", optarg);
+        break;
+      case 'P':
+        snprintf(projargs.replay, FILE_PATH_MAX, "%s", optarg);
+        projargs.replay_speed = 1;
+        if (NULL != (sp = strrchr(projargs.replay, ':'))) {
+          *sp++ = '\0';
+          if (!strcmp(sp, "max")) {
+            projargs.replay_speed = 0;
+          } else {
+            projargs.replay_speed = strtod(sp, &end);
+            /* Also rejects nan and inf */
+            if (end == sp || *end != '\0'
+                || !(projargs.replay_speed >= 0
+                     && projargs.replay_speed <= DBL_MAX)) {
+              printf("-P speed [%s] INVALID\n", sp);
+              print_usage(argv[0]);
+            }
+          }
+        }
+        break;
+      case 'w':
+        projargs.warm = true;
+        break;
+      case 'x':
+        snprintf(projargs.script, FILE_PATH_MAX, "%s", optarg);
+        break;
+      case 'J':
+        snprintf(projargs.rpc, FILE_PATH_MAX, "%s", optarg);
+        break;
       default:
         printf("Argument Not Realized\n");
         print_usage(argv[0]);
@@ -349,9 +411,9 @@ static void setprojargs(int argc, char *argv[])
     }
   }
 
-  /* Sanity check */
-  if ((projargs.enc && (!projargs.sock.srv[0] || !projargs.sock.clt[0]))
-      || (!projargs.enc && (!projargs.serial.port[0] || !projargs.serial.br))) {
+  /* Sanity check, the replay needs no NCP target */
+  if (!projargs.replay[0] && ((projargs.enc && (!projargs.sock.srv[0] || !projargs.sock.clt[0]))
+      || (!projargs.enc && (!projargs.serial.port[0] || !projargs.serial.br)))) {
     printf("**Arguments ERROR** - check the arguments and the .config file\n");
     print_usage(argv[0]);
     exit(1);
@@ -406,6 +468,10 @@ static void setprojargs(int argc, char *argv[])
     *r = '\0';
   }
 
+  if (projargs.replay[0]) {
+    /* The capture is in plain text, no socket to poll */
+    projargs.enc = false;
+  }
   projargs.initialized = true;
 }
 /**  @} */
@@ -0,0 +1,226 @@
+/*************************************************************************
+    > File Name: timeline.c
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Timeline recorder in the Trace Event Format of Chrome
+ ************************************************************************/
+
+/* Includes *********************************************************** */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "projconfig.h"
+#include "timeline.h"
+#include "lat_hist.h"
+#include "utils.h"
+
+/* Defines  *********************************************************** */
+/* Records kept in memory before they are formatted to the file */
+#define TL_BUF_RECS   1024
+#define TL_FILE_BUF   (64 * 1024)
+
+#if MAX_CONCURRENT_CONFIG_NODES > TL_LANE_PROV_BASE
+#error "Not enough timeline lanes for the config slots"
+#endif
+#if MAX_PROV_SESSIONS > TL_LANE_KR_BASE - TL_LANE_PROV_BASE
+#error "Not enough timeline lanes for the provisioning sessions"
+#endif
+
+typedef struct {
+  uint64_t ts;
+  uint64_t dur;
+  const char *name;
+  const char *key;
+  uint32_t val;
+  uint8_t lane;
+  char ph;
+}tl_rec_t;
+
+typedef struct {
+  bool open;
+  uint64_t ts;
+  const char *name;
+  const char *key;
+  uint32_t val;
+}tl_slice_t;
+
+/* Global Variables *************************************************** */
+
+/* Static Variables *************************************************** */
+static struct {
+  volatile int on;
+  FILE *fp;
+  char *fbuf;
+  uint64_t t0;
+  int num;
+  tl_rec_t recs[TL_BUF_RECS];
+  tl_slice_t slices[tl_lane_max];
+} tl = { 0 };
+
+/* Static Functions Declaractions ************************************* */
+static const char *lane_cat(int lane)
+{
+  if (lane < tl_lane_prov) {
+    return "config";
+  } else if (lane < tl_lane_kr) {
+    return "prov";
+  }
+  return "kr";
+}
+
+static void lane_meta(int lane, const char *fmt, int idx)
+{
+  char name[32];
+
+  snprintf(name, sizeof(name), fmt, idx);
+  fprintf(tl.fp,
+          ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+          "\"args\":{\"name\":\"%s\"}}"
+          ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+          "\"args\":{\"sort_index\":%d}}",
+          lane, name, lane, lane);
+}
+
+static void flush(void)
+{
+  const tl_rec_t *r;
+
+  for (int i = 0; i < tl.num; i++) {
+    r = &tl.recs[i];
+    fprintf(tl.fp,
+            ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%llu,",
+            r->name, lane_cat(r->lane), r->ph, (unsigned long long)r->ts);
+    if (r->ph == 'X') {
+      fprintf(tl.fp, "\"dur\":%llu,", (unsigned long long)r->dur);
+    } else {
+      fprintf(tl.fp, "\"s\":\"t\",");
+    }
+    fprintf(tl.fp, "\"pid\":1,\"tid\":%d", r->lane);
+    if (r->key) {
+      fprintf(tl.fp, ",\"args\":{\"%s\":\"0x%04x\"}", r->key, r->val);
+    }
+    fprintf(tl.fp, "}");
+  }
+  tl.num = 0;
+}
+
+static tl_rec_t *rec_new(void)
+{
+  if (tl.num == TL_BUF_RECS) {
+    flush();
+  }
+  return &tl.recs[tl.num++];
+}
+
+int timeline_on(void)
+{
+  return tl.on;
+}
+
+void __timeline_end(int lane)
+{
+  tl_rec_t *r;
+  tl_slice_t *s;
+
+  if (!tl.on || lane < 0 || lane >= tl_lane_max) {
+    return;
+  }
+  s = &tl.slices[lane];
+  if (!s->open) {
+    return;
+  }
+  r = rec_new();
+  r->ph = 'X';
+  r->lane = lane;
+  r->ts = s->ts;
+  r->dur = lat_now_us() - tl.t0 - s->ts;
+  r->name = s->name;
+  r->key = s->key;
+  r->val = s->val;
+  s->open = false;
+}
+
+void __timeline_slice(int lane, const char *name, const char *key, uint32_t val)
+{
+  tl_slice_t *s;
+
+  if (!tl.on || lane < 0 || lane >= tl_lane_max) {
+    return;
+  }
+  __timeline_end(lane);
+  s = &tl.slices[lane];
+  s->open = true;
+  s->ts = lat_now_us() - tl.t0;
+  s->name = name;
+  s->key = key;
+  s->val = val;
+}
+
+void __timeline_instant(int lane, const char *name, const char *key, uint32_t val)
+{
+  tl_rec_t *r;
+
+  if (!tl.on || lane < 0 || lane >= tl_lane_max) {
+    return;
+  }
+  r = rec_new();
+  r->ph = 'i';
+  r->lane = lane;
+  r->ts = lat_now_us() - tl.t0;
+  r->dur = 0;
+  r->name = name;
+  r->key = key;
+  r->val = val;
+}
+
+err_t timeline_start(const char *path)
+{
+  FILE *fp;
+  char *fbuf;
+
+  timeline_stop();
+  fp = fopen(path, "w");
+  if (!fp) {
+    return err(ec_file_ope);
+  }
+  fbuf = malloc(TL_FILE_BUF);
+  if (fbuf) {
+    setvbuf(fp, fbuf, _IOFBF, TL_FILE_BUF);
+  }
+  tl.fp = fp;
+  tl.fbuf = fbuf;
+  tl.num = 0;
+  memset(tl.slices, 0, sizeof(tl.slices));
+  tl.t0 = lat_now_us();
+
+  fprintf(tl.fp, "[{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+          "\"args\":{\"name\":\"nwmng\"}}");
+  for (int i = 0; i < MAX_CONCURRENT_CONFIG_NODES; i++) {
+    lane_meta(tl_lane_config + i, "config slot %d", i);
+  }
+  for (int i = 0; i < MAX_PROV_SESSIONS; i++) {
+    lane_meta(tl_lane_prov + i, "prov session %d", i);
+  }
+  lane_meta(tl_lane_kr, "key refresh", 0);
+  tl.on = 1;
+  return ec_success;
+}
+
+void timeline_stop(void)
+{
+  if (!tl.on) {
+    return;
+  }
+  for (int i = 0; i < tl_lane_max; i++) {
+    __timeline_end(i);
+  }
+  tl.on = 0;
+  flush();
+  fprintf(tl.fp, "\n]\n");
+  fclose(tl.fp);
+  free(tl.fbuf);
+  tl.fp = NULL;
+  tl.fbuf = NULL;
+}
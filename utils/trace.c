@@ -0,0 +1,109 @@
+/*************************************************************************
+    > File Name: trace.c
+    > Author: Kevin
+    > Created Time: 2026-10-19
+    > Description: Trace point table and the formatter shared by the log
+    > writer and the trace decoder
+ ************************************************************************/
+
+/* Includes *********************************************************** */
+#include <stdio.h>
+#include <string.h>
+
+#include "trace.h"
+
+/* Defines  *********************************************************** */
+#define SPEC_MAX_LEN  16
+
+/* Global Variables *************************************************** */
+#define TRACE_TABLE(id, lvl, fmt) { #id, lvl, fmt },
+const trace_point_t trace_points[] = {
+  TRACE_POINTS(TRACE_TABLE)
+};
+
+/* Static Variables *************************************************** */
+static const char *const *trace_strtab = NULL;
+static int trace_strnum = 0;
+
+/* Static Functions Declaractions ************************************* */
+void trace_set_strtab(const char *const *strtab, int num)
+{
+  trace_strtab = strtab;
+  trace_strnum = num;
+}
+
+const char *const *trace_get_strtab(int *num)
+{
+  *num = trace_strnum;
+  return trace_strtab;
+}
+
+size_t trace_format(char *buf,
+                    size_t size,
+                    const char *fmt,
+                    const uint32_t *args,
+                    int nargs,
+                    const char *const *strtab,
+                    int nstr)
+{
+  char spec[SPEC_MAX_LEN];
+  size_t len = 0, sl;
+  int argi = 0, r;
+  uint32_t a;
+
+  if (!buf || !size) {
+    return 0;
+  }
+  while (*fmt && len + 1 < size) {
+    if (*fmt != '%') {
+      buf[len++] = *fmt++;
+      continue;
+    }
+    if (fmt[1] == '%') {
+      buf[len++] = '%';
+      fmt += 2;
+      continue;
+    }
+    /* Copy flags, width and precision, skip length modifiers */
+    spec[0] = *fmt++;
+    sl = 1;
+    while (*fmt && strchr("-+ #0123456789.", *fmt) && sl < SPEC_MAX_LEN - 2) {
+      spec[sl++] = *fmt++;
+    }
+    while (*fmt && strchr("hlLqjzt", *fmt)) {
+      fmt++;
+    }
+    if (!*fmt) {
+      break;
+    }
+    spec[sl++] = *fmt;
+    spec[sl] = '\0';
+
+    a = argi < nargs ? args[argi] : 0;
+    argi++;
+    switch (*fmt++) {
+      case 'd':
+      case 'i':
+        r = snprintf(buf + len, size - len, spec, (int)(int32_t)a);
+        break;
+      case 's':
+        if (strtab && a < (uint32_t)nstr) {
+          r = snprintf(buf + len, size - len, spec, strtab[a]);
+        } else {
+          r = snprintf(buf + len, size - len, "<%u>", a);
+        }
+        break;
+      default:
+        r = snprintf(buf + len, size - len, spec, (unsigned int)a);
+        break;
+    }
+    if (r > 0) {
+      len += r;
+    }
+  }
+  if (len >= size) {
+    len = size - 1;
+  }
+  buf[len] = '\0';
+  return len;
+}